@@ -0,0 +1,306 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the AVX-512 kernels against the AVX2 (or, where there is no AVX2
+// version, SSE2) kernels they replace. MatchesBaseline checks the two produce
+// identical output; DISABLED_Speed reports the gain of each kernel. Run it
+// with --gtest_also_run_disabled_tests
+//     --gtest_filter=AVX512/Avx512SpeedTest.DISABLED_Speed/*
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "vp9/common/vp9_filter.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+#if HAVE_AVX512
+using libvpx_test::ACMRandom;
+
+const int kStride = 128;
+const int kBlockSize = 64;
+const int kNumCoeffs = 1024;
+// The convolve source starts 3 rows and columns into its buffer so the
+// filter taps stay inside it.
+const int kConvolveOffset = 3 * kStride + 3;
+
+struct KernelData {
+  DECLARE_ALIGNED(64, uint8_t, src[kStride * (kBlockSize + 8)]);
+  DECLARE_ALIGNED(64, uint8_t, ref[kStride * (kBlockSize + 8)]);
+  DECLARE_ALIGNED(64, uint8_t, second_pred[kBlockSize * kBlockSize]);
+  DECLARE_ALIGNED(64, uint8_t, dst[kStride * kBlockSize]);
+  DECLARE_ALIGNED(64, int16_t, residual[kNumCoeffs]);
+  DECLARE_ALIGNED(64, tran_low_t, coeff[kNumCoeffs]);
+  DECLARE_ALIGNED(64, tran_low_t, dqcoeff[kNumCoeffs]);
+  DECLARE_ALIGNED(64, tran_low_t, out_coeff[kNumCoeffs]);
+  DECLARE_ALIGNED(64, tran_low_t, out_dqcoeff[kNumCoeffs]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+  int16_t scan[kNumCoeffs];
+  // Scalar results of the kernel under test.
+  uint32_t results[4];
+  int64_t results64[2];
+  uint16_t eob;
+};
+
+typedef void (*KernelThunk)(KernelData *data);
+
+template <unsigned int (*fn)(const uint8_t *, int, const uint8_t *, int)>
+void RunSad(KernelData *d) {
+  d->results[0] = fn(d->src, kStride, d->ref, kStride);
+}
+
+template <unsigned int (*fn)(const uint8_t *, int, const uint8_t *, int,
+                             const uint8_t *)>
+void RunSadAvg(KernelData *d) {
+  d->results[0] = fn(d->src, kStride, d->ref, kStride, d->second_pred);
+}
+
+template <void (*fn)(const uint8_t *, int, const uint8_t *const[], int,
+                     uint32_t *)>
+void RunSadX4d(KernelData *d) {
+  const uint8_t *const refs[4] = { d->ref, d->ref + 1, d->ref + kStride,
+                                   d->ref + kStride + 1 };
+  fn(d->src, kStride, refs, kStride, d->results);
+}
+
+template <unsigned int (*fn)(const uint8_t *, int, const uint8_t *, int,
+                             unsigned int *)>
+void RunVariance(KernelData *d) {
+  d->results[0] = fn(d->src, kStride, d->ref, kStride, &d->results[1]);
+}
+
+template <void (*fn)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                     const InterpKernel *, int, int, int, int, int, int),
+          int w, int h>
+void RunConvolve(KernelData *d) {
+  fn(d->src + kConvolveOffset, kStride, d->dst, kStride,
+     vp9_filter_kernels[EIGHTTAP], 5, 16, 11, 16, w, h);
+}
+
+template <void (*fn)(const int16_t *, tran_low_t *, int)>
+void RunFdct(KernelData *d) {
+  fn(d->residual, d->out_coeff, 32);
+}
+
+template <int64_t (*fn)(const tran_low_t *, const tran_low_t *, intptr_t,
+                        int64_t *)>
+void RunBlockError(KernelData *d) {
+  d->results64[0] = fn(d->coeff, d->dqcoeff, kNumCoeffs, &d->results64[1]);
+}
+
+template <int64_t (*fn)(const tran_low_t *, const tran_low_t *, int)>
+void RunBlockErrorFp(KernelData *d) {
+  d->results64[0] = fn(d->coeff, d->dqcoeff, kNumCoeffs);
+}
+
+template <void (*fn)(const tran_low_t *, intptr_t, int, const int16_t *,
+                     const int16_t *, tran_low_t *, tran_low_t *,
+                     const int16_t *, uint16_t *, const int16_t *,
+                     const int16_t *)>
+void RunQuantizeFp(KernelData *d) {
+  // vp9_quantize_fp is used for blocks up to 16x16.
+  fn(d->coeff, 256, 0, d->round, d->quant, d->out_coeff, d->out_dqcoeff,
+     d->dequant, &d->eob, d->scan, d->scan);
+}
+
+struct KernelParam {
+  KernelParam(const char *name, KernelThunk baseline, KernelThunk avx512,
+              int iterations)
+      : name(name), baseline(baseline), avx512(avx512),
+        iterations(iterations) {}
+
+  const char *name;
+  KernelThunk baseline;
+  KernelThunk avx512;
+  int iterations;
+};
+
+::std::ostream &operator<<(::std::ostream &os, const KernelParam &p) {
+  return os << p.name;
+}
+
+class Avx512SpeedTest : public ::testing::TestWithParam<KernelParam> {
+ protected:
+  virtual void SetUp() {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    data_ = reinterpret_cast<KernelData *>(
+        vpx_memalign(64, sizeof(KernelData)));
+    ASSERT_TRUE(data_ != NULL);
+    for (int i = 0; i < kStride * (kBlockSize + 8); ++i) {
+      data_->src[i] = rnd.Rand8();
+      data_->ref[i] = rnd.Rand8();
+    }
+    for (int i = 0; i < kBlockSize * kBlockSize; ++i) {
+      data_->second_pred[i] = rnd.Rand8();
+    }
+    for (int i = 0; i < kNumCoeffs; ++i) {
+      data_->residual[i] = rnd.Rand8() - rnd.Rand8();
+      // Mostly small coefficients so that quantization skips some rows.
+      data_->coeff[i] = (i & 64) ? rnd.Rand8() - 128 : (rnd.Rand8() >> 5) - 4;
+      data_->dqcoeff[i] = data_->coeff[i] + (rnd.Rand8() >> 4) - 8;
+      data_->scan[i] = i;
+    }
+    for (int i = 0; i < 8; ++i) {
+      data_->round[i] = i ? 24 : 32;
+      data_->quant[i] = i ? (1 << 16) / 48 : (1 << 16) / 64;
+      data_->dequant[i] = i ? 48 : 64;
+    }
+  }
+
+  virtual void TearDown() {
+    vpx_free(data_);
+    libvpx_test::ClearSystemState();
+  }
+
+  // Runs fn and returns a copy of everything it can write.
+  void RunOnce(KernelThunk fn, KernelData *out) {
+    memset(data_->dst, 0, sizeof(data_->dst));
+    memset(data_->out_coeff, 0, sizeof(data_->out_coeff));
+    memset(data_->out_dqcoeff, 0, sizeof(data_->out_dqcoeff));
+    memset(data_->results, 0, sizeof(data_->results));
+    memset(data_->results64, 0, sizeof(data_->results64));
+    data_->eob = 0;
+    fn(data_);
+    memcpy(out, data_, sizeof(*out));
+  }
+
+  int64_t Time(KernelThunk fn, int iterations) {
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < iterations; ++i) fn(data_);
+    vpx_usec_timer_mark(&timer);
+    return vpx_usec_timer_elapsed(&timer);
+  }
+
+  KernelData *data_;
+};
+
+TEST_P(Avx512SpeedTest, MatchesBaseline) {
+  const KernelParam &p = GetParam();
+  KernelData *const expected = reinterpret_cast<KernelData *>(
+      vpx_memalign(64, sizeof(KernelData)));
+  KernelData *const actual = reinterpret_cast<KernelData *>(
+      vpx_memalign(64, sizeof(KernelData)));
+  ASSERT_TRUE(expected != NULL && actual != NULL);
+  RunOnce(p.baseline, expected);
+  RunOnce(p.avx512, actual);
+  EXPECT_EQ(0, memcmp(expected->dst, actual->dst, sizeof(expected->dst)));
+  EXPECT_EQ(0, memcmp(expected->out_coeff, actual->out_coeff,
+                      sizeof(expected->out_coeff)));
+  EXPECT_EQ(0, memcmp(expected->out_dqcoeff, actual->out_dqcoeff,
+                      sizeof(expected->out_dqcoeff)));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(expected->results[i], actual->results[i]) << "result " << i;
+  }
+  EXPECT_EQ(expected->results64[0], actual->results64[0]);
+  EXPECT_EQ(expected->results64[1], actual->results64[1]);
+  EXPECT_EQ(expected->eob, actual->eob);
+  vpx_free(expected);
+  vpx_free(actual);
+}
+
+TEST_P(Avx512SpeedTest, DISABLED_Speed) {
+  const KernelParam &p = GetParam();
+  // Warm up the caches before timing.
+  Time(p.baseline, p.iterations / 10);
+  Time(p.avx512, p.iterations / 10);
+  const int64_t baseline_time = Time(p.baseline, p.iterations);
+  const int64_t avx512_time = Time(p.avx512, p.iterations);
+  printf("%-28s baseline: %7d us  avx512: %7d us  gain: %.2fx\n", p.name,
+         static_cast<int>(baseline_time), static_cast<int>(avx512_time),
+         static_cast<double>(baseline_time) /
+             static_cast<double>(avx512_time > 0 ? avx512_time : 1));
+}
+
+#define SAD_PARAMS(w, h)                                                       \
+  KernelParam("sad" #w "x" #h, &RunSad<vpx_sad##w##x##h##_avx2>,               \
+              &RunSad<vpx_sad##w##x##h##_avx512>, 40000000 / (w * h / 64)),    \
+      KernelParam("sad" #w "x" #h "_avg",                                      \
+                  &RunSadAvg<vpx_sad##w##x##h##_avg_avx2>,                     \
+                  &RunSadAvg<vpx_sad##w##x##h##_avg_avx512>,                   \
+                  40000000 / (w * h / 64))
+
+#define VARIANCE_PARAMS(w, h)                                                  \
+  KernelParam("variance" #w "x" #h,                                            \
+              &RunVariance<vpx_variance##w##x##h##_avx2>,                      \
+              &RunVariance<vpx_variance##w##x##h##_avx512>,                    \
+              40000000 / (w * h / 64))
+
+#define CONVOLVE_PARAMS(name, w, h)                                            \
+  KernelParam(#name "_" #w "x" #h,                                             \
+              &RunConvolve<vpx_##name##_avx2, w, h>,                           \
+              &RunConvolve<vpx_##name##_avx512, w, h>, 4000000 / (w * h / 64))
+
+const KernelParam kKernels[] = {
+  SAD_PARAMS(64, 64),
+  SAD_PARAMS(64, 32),
+  SAD_PARAMS(32, 64),
+  SAD_PARAMS(32, 32),
+  SAD_PARAMS(32, 16),
+  KernelParam("sad64x64x4d", &RunSadX4d<vpx_sad64x64x4d_avx2>,
+              &RunSadX4d<vpx_sad64x64x4d_avx512>, 500000),
+  KernelParam("sad64x32x4d (vs sse2)", &RunSadX4d<vpx_sad64x32x4d_sse2>,
+              &RunSadX4d<vpx_sad64x32x4d_avx512>, 1000000),
+  KernelParam("sad32x64x4d (vs sse2)", &RunSadX4d<vpx_sad32x64x4d_sse2>,
+              &RunSadX4d<vpx_sad32x64x4d_avx512>, 1000000),
+  KernelParam("sad32x32x4d", &RunSadX4d<vpx_sad32x32x4d_avx2>,
+              &RunSadX4d<vpx_sad32x32x4d_avx512>, 2000000),
+  KernelParam("sad32x16x4d (vs sse2)", &RunSadX4d<vpx_sad32x16x4d_sse2>,
+              &RunSadX4d<vpx_sad32x16x4d_avx512>, 4000000),
+  VARIANCE_PARAMS(64, 64),
+  VARIANCE_PARAMS(64, 32),
+  VARIANCE_PARAMS(32, 64),
+  VARIANCE_PARAMS(32, 32),
+  VARIANCE_PARAMS(32, 16),
+  CONVOLVE_PARAMS(convolve8_horiz, 64, 64),
+  CONVOLVE_PARAMS(convolve8_horiz, 32, 32),
+  CONVOLVE_PARAMS(convolve8_avg_horiz, 64, 64),
+  CONVOLVE_PARAMS(convolve8_vert, 64, 64),
+  CONVOLVE_PARAMS(convolve8_vert, 32, 32),
+  CONVOLVE_PARAMS(convolve8_avg_vert, 64, 64),
+  CONVOLVE_PARAMS(convolve8, 64, 64),
+  CONVOLVE_PARAMS(convolve8, 32, 32),
+  CONVOLVE_PARAMS(convolve8_avg, 64, 64),
+#if !CONFIG_VP9_HIGHBITDEPTH
+  KernelParam("fdct32x32", &RunFdct<vpx_fdct32x32_avx2>,
+              &RunFdct<vpx_fdct32x32_avx512>, 100000),
+  KernelParam("fdct32x32_rd", &RunFdct<vpx_fdct32x32_rd_avx2>,
+              &RunFdct<vpx_fdct32x32_rd_avx512>, 100000),
+#endif  // !CONFIG_VP9_HIGHBITDEPTH
+  KernelParam("block_error", &RunBlockError<vp9_block_error_avx2>,
+              &RunBlockError<vp9_block_error_avx512>, 1000000),
+  KernelParam("block_error_fp", &RunBlockErrorFp<vp9_block_error_fp_avx2>,
+              &RunBlockErrorFp<vp9_block_error_fp_avx512>, 1000000),
+  KernelParam("quantize_fp", &RunQuantizeFp<vp9_quantize_fp_avx2>,
+              &RunQuantizeFp<vp9_quantize_fp_avx512>, 2000000),
+};
+
+#undef SAD_PARAMS
+#undef VARIANCE_PARAMS
+#undef CONVOLVE_PARAMS
+
+INSTANTIATE_TEST_CASE_P(AVX512, Avx512SpeedTest,
+                        ::testing::ValuesIn(kKernels));
+#endif  // HAVE_AVX512
+
+}  // namespace
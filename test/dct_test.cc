@@ -26,6 +26,7 @@
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_integer.h"
 #include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
 
 using libvpx_test::ACMRandom;
 using libvpx_test::Buffer;
@@ -416,6 +417,71 @@ class TransTestBase : public ::testing::TestWithParam<DctParam> {
     }
   }
 
+  void RunInvSpeedTest() {
+    if (pixel_size_ == 1 && bit_depth_ > VPX_BITS_8) return;
+    // Keep runtime stable with transform size.
+    const int count_test_block = 500000000 / (size_ * size_);
+    Buffer<int16_t> in = Buffer<int16_t>(size_, size_, 4);
+    ASSERT_TRUE(in.Init());
+    Buffer<tran_low_t> coeff = Buffer<tran_low_t>(size_, size_, 0, 16);
+    ASSERT_TRUE(coeff.Init());
+
+    InitMem();
+    for (int h = 0; h < size_; ++h) {
+      for (int w = 0; w < size_; ++w) {
+        in.TopLeftPixel()[h * in.stride() + w] =
+            pixel_size_ == 1
+                ? src_[h * stride_ + w] - dst_[h * stride_ + w]
+                : reinterpret_cast<uint16_t *>(src_)[h * stride_ + w] -
+                      reinterpret_cast<uint16_t *>(dst_)[h * stride_ + w];
+      }
+    }
+    fwd_txfm_ref(in, &coeff, size_, tx_type_);
+
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < count_test_block; ++i) RunInvTxfm(coeff, dst_);
+    libvpx_test::ClearSystemState();
+    vpx_usec_timer_mark(&timer);
+    const int elapsed_time =
+        static_cast<int>(vpx_usec_timer_elapsed(&timer) / 1000);
+    printf("inv txfm %dx%d (type %d, %s %d) time: %5d ms\n", size_, size_,
+           tx_type_, (pixel_size_ == 1) ? "bitdepth" : "high bitdepth",
+           bit_depth_, elapsed_time);
+  }
+
+  void RunFwdSpeedTest() {
+    if (pixel_size_ == 1 && bit_depth_ > VPX_BITS_8) return;
+    // Keep runtime stable with transform size.
+    const int count_test_block = 500000000 / (size_ * size_);
+    Buffer<int16_t> in = Buffer<int16_t>(size_, size_, 8, size_ == 4 ? 0 : 16);
+    ASSERT_TRUE(in.Init());
+    Buffer<tran_low_t> coeff = Buffer<tran_low_t>(size_, size_, 0, 16);
+    ASSERT_TRUE(coeff.Init());
+
+    InitMem();
+    for (int h = 0; h < size_; ++h) {
+      for (int w = 0; w < size_; ++w) {
+        in.TopLeftPixel()[h * in.stride() + w] =
+            pixel_size_ == 1
+                ? src_[h * stride_ + w] - dst_[h * stride_ + w]
+                : reinterpret_cast<uint16_t *>(src_)[h * stride_ + w] -
+                      reinterpret_cast<uint16_t *>(dst_)[h * stride_ + w];
+      }
+    }
+
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < count_test_block; ++i) RunFwdTxfm(in, &coeff);
+    libvpx_test::ClearSystemState();
+    vpx_usec_timer_mark(&timer);
+    const int elapsed_time =
+        static_cast<int>(vpx_usec_timer_elapsed(&timer) / 1000);
+    printf("fwd txfm %dx%d (type %d, %s %d) time: %5d ms\n", size_, size_,
+           tx_type_, (pixel_size_ == 1) ? "bitdepth" : "high bitdepth",
+           bit_depth_, elapsed_time);
+  }
+
   FhtFunc fwd_txfm_;
   FhtFuncRef fwd_txfm_ref;
   IhtWithBdFunc inv_txfm_;
@@ -454,6 +520,8 @@ TEST_P(TransDCT, MemCheck) { RunMemCheck(); }
 
 TEST_P(TransDCT, InvAccuracyCheck) { RunInvAccuracyCheck(1); }
 
+TEST_P(TransDCT, DISABLED_InvSpeed) { RunInvSpeedTest(); }
+
 static const FuncInfo dct_c_func_info[] = {
 #if CONFIG_VP9_HIGHBITDEPTH
   { &fdct_wrapper<vpx_highbd_fdct4x4_c>,
@@ -526,17 +594,27 @@ INSTANTIATE_TEST_CASE_P(SSSE3, TransDCT,
                                                      VPX_BITS_8)));
 #endif  // HAVE_SSSE3 && !CONFIG_VP9_HIGHBITDEPTH && VPX_ARCH_X86_64
 
-#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
-static const FuncInfo dct_avx2_func_info = {
-  &fdct_wrapper<vpx_fdct32x32_avx2>, &idct_wrapper<vpx_idct32x32_1024_add_sse2>,
-  32, 1
+#if HAVE_AVX2
+static const FuncInfo dct_avx2_func_info[] = {
+#if !CONFIG_VP9_HIGHBITDEPTH
+  // TODO(johannkoenig): high bit depth fdct32x32.
+  { &fdct_wrapper<vpx_fdct32x32_avx2>,
+    &idct_wrapper<vpx_idct32x32_1024_add_sse2>, 32, 1 },
+#endif  // !CONFIG_VP9_HIGHBITDEPTH
+  { &fdct_wrapper<vpx_fdct16x16_c>, &idct_wrapper<vpx_idct16x16_256_add_avx2>,
+    16, 1 },
+  { &fdct_wrapper<vpx_fdct32x32_c>,
+    &idct_wrapper<vpx_idct32x32_1024_add_avx2>, 32, 1 }
 };
 
-// TODO(johannkoenig): high bit depth fdct32x32.
-INSTANTIATE_TEST_CASE_P(AVX2, TransDCT,
-                        ::testing::Values(make_tuple(0, &dct_avx2_func_info, 0,
-                                                     VPX_BITS_8)));
-#endif  // HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2, TransDCT,
+    ::testing::Combine(
+        ::testing::Range(0, static_cast<int>(sizeof(dct_avx2_func_info) /
+                                             sizeof(dct_avx2_func_info[0]))),
+        ::testing::Values(dct_avx2_func_info), ::testing::Values(0),
+        ::testing::Values(VPX_BITS_8)));
+#endif  // HAVE_AVX2
 
 #if HAVE_NEON
 static const FuncInfo dct_neon_func_info[4] = {
@@ -605,6 +683,10 @@ TEST_P(TransHT, MemCheck) { RunMemCheck(); }
 
 TEST_P(TransHT, InvAccuracyCheck) { RunInvAccuracyCheck(1); }
 
+TEST_P(TransHT, DISABLED_InvSpeed) { RunInvSpeedTest(); }
+
+TEST_P(TransHT, DISABLED_FwdSpeed) { RunFwdSpeedTest(); }
+
 static const FuncInfo ht_c_func_info[] = {
 #if CONFIG_VP9_HIGHBITDEPTH
   { &vp9_highbd_fht4x4_c, &highbd_iht_wrapper<vp9_highbd_iht4x4_16_add_c>, 4,
@@ -669,6 +751,28 @@ INSTANTIATE_TEST_CASE_P(SSE2, TransHT,
                                            ::testing::Values(VPX_BITS_8)));
 #endif  // HAVE_SSE2
 
+#if HAVE_AVX2
+static const FuncInfo ht_avx2_func_info[] = {
+#if CONFIG_VP9_HIGHBITDEPTH
+  { &vp9_highbd_fht4x4_avx2, &highbd_iht_wrapper<vp9_highbd_iht4x4_16_add_c>,
+    4, 2 },
+  { &vp9_highbd_fht8x8_avx2, &highbd_iht_wrapper<vp9_highbd_iht8x8_64_add_c>,
+    8, 2 },
+  { &vp9_highbd_fht16x16_avx2,
+    &highbd_iht_wrapper<vp9_highbd_iht16x16_256_add_c>, 16, 2 },
+#endif
+  { &vp9_fht16x16_avx2, &iht_wrapper<vp9_iht16x16_256_add_avx2>, 16, 1 }
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, TransHT,
+    ::testing::Combine(
+        ::testing::Range(0, static_cast<int>(sizeof(ht_avx2_func_info) /
+                                             sizeof(ht_avx2_func_info[0]))),
+        ::testing::Values(ht_avx2_func_info), ::testing::Range(0, 4),
+        ::testing::Values(VPX_BITS_8, VPX_BITS_10, VPX_BITS_12)));
+#endif  // HAVE_AVX2
+
 #if HAVE_SSE4_1 && CONFIG_VP9_HIGHBITDEPTH
 static const FuncInfo ht_sse4_1_func_info[3] = {
   { &vp9_highbd_fht4x4_c, &highbd_iht_wrapper<vp9_highbd_iht4x4_16_add_sse4_1>,
@@ -8,6 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
@@ -192,4 +199,297 @@ TEST(EncodeAPI, MultiResEncode) {
   }
 }
 
+#if CONFIG_VP9_ENCODER
+TEST(EncodeAPI, RowMTThreadStats) {
+  const int kWidth = 640;
+  const int kHeight = 360;
+  const int kThreads = 4;
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_row_mt_thread_stats_t stats;
+  vpx_image_t img;
+
+  ASSERT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_threads = kThreads;
+  cfg.g_lag_in_frames = 0;
+  ASSERT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  // Row based multi-threading is only used below speed 5 in good quality.
+  ASSERT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 4), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 1), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_ROW_MT, 1), VPX_CODEC_OK);
+
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_GET_ROW_MT_THREAD_STATS,
+                              (vpx_row_mt_thread_stats_t *)NULL),
+            VPX_CODEC_INVALID_PARAM);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_GET_ROW_MT_THREAD_STATS, &stats),
+            VPX_CODEC_OK);
+  EXPECT_EQ(stats.num_threads, 0);
+
+  ASSERT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < kWidth * kHeight * 3 / 2; ++j) {
+      img.img_data[j] = static_cast<uint8_t>((j * 7 + i * 13) ^ (j >> 9));
+    }
+    ASSERT_EQ(vpx_codec_encode(&enc, &img, i, 1, 0, VPX_DL_GOOD_QUALITY),
+              VPX_CODEC_OK);
+  }
+  vpx_img_free(&img);
+
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_GET_ROW_MT_THREAD_STATS, &stats),
+            VPX_CODEC_OK);
+  EXPECT_EQ(stats.num_threads, kThreads);
+  int64_t busy_us = 0;
+  for (int i = 0; i < stats.num_threads; ++i) {
+    EXPECT_GE(stats.busy_us[i], 0);
+    EXPECT_GE(stats.idle_us[i], 0);
+    busy_us += stats.busy_us[i];
+  }
+  EXPECT_GT(busy_us, 0);
+
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+// Encodes kNumFrames realtime frames with row based multi-threading and
+// returns the compressed frames back to back.
+std::string EncodeRowMT(int threads, unsigned int lpf_opt) {
+  const int kWidth = 352;
+  const int kHeight = 288;
+  const int kNumFrames = 10;
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+  std::string data;
+
+  EXPECT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_threads = threads;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_end_usage = VPX_CBR;
+  cfg.rc_target_bitrate = 300;
+  EXPECT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 1), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_ROW_MT, 1), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_LOOP_FILTER_OPT, lpf_opt),
+            VPX_CODEC_OK);
+
+  EXPECT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+  for (int i = 0; i <= kNumFrames; ++i) {
+    if (i < kNumFrames) {
+      for (int j = 0; j < kWidth * kHeight * 3 / 2; ++j) {
+        const int x = j % kWidth + i * 3;
+        const int y = j / kWidth + i;
+        img.img_data[j] = static_cast<uint8_t>(((x >> 3) ^ (y >> 3)) * 37);
+      }
+    }
+    EXPECT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img : NULL, i, 1, 0,
+                               VPX_DL_REALTIME),
+              VPX_CODEC_OK);
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      data.append(static_cast<const char *>(pkt->data.frame.buf),
+                  pkt->data.frame.sz);
+    }
+  }
+  vpx_img_free(&img);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+  return data;
+}
+
+// Loop filtering rows while they are encoded does not change the output.
+TEST(EncodeAPI, RowMTLoopFilterOpt) {
+  const std::string expected = EncodeRowMT(1, 0);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_TRUE(EncodeRowMT(1, 1) == expected);
+  EXPECT_TRUE(EncodeRowMT(4, 0) == expected);
+  EXPECT_TRUE(EncodeRowMT(4, 1) == expected);
+}
+
+// Encodes kNumFrames good quality frames with alt-ref frames and returns the
+// pts and size of each frame packet followed by the compressed frames.
+std::string EncodePipelined(unsigned int pipelined) {
+  const int kWidth = 352;
+  const int kHeight = 288;
+  const int kNumFrames = 20;
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+  std::string pkts;
+  std::string data;
+
+  EXPECT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_threads = 2;
+  cfg.g_lag_in_frames = 10;
+  cfg.rc_target_bitrate = 300;
+  EXPECT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 4), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_ENABLEAUTOALTREF, 1),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_PIPELINED_ENCODE, pipelined),
+            VPX_CODEC_OK);
+
+  EXPECT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+  for (int i = 0; i < kNumFrames + 10; ++i) {
+    if (i < kNumFrames) {
+      for (int j = 0; j < kWidth * kHeight * 3 / 2; ++j) {
+        const int x = j % kWidth + i * 3;
+        const int y = j / kWidth + i;
+        img.img_data[j] = static_cast<uint8_t>(((x >> 3) ^ (y >> 3)) * 37);
+      }
+    }
+    // Controls apply from the next frame on.
+    if (i == kNumFrames / 2) {
+      EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 5), VPX_CODEC_OK);
+    }
+    EXPECT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img : NULL, i, 1, 0,
+                               VPX_DL_GOOD_QUALITY),
+              VPX_CODEC_OK);
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      char buf[64];
+      snprintf(buf, sizeof(buf), "%d:%d ",
+               static_cast<int>(pkt->data.frame.pts),
+               static_cast<int>(pkt->data.frame.sz));
+      pkts += buf;
+      data.append(static_cast<const char *>(pkt->data.frame.buf),
+                  pkt->data.frame.sz);
+    }
+  }
+  vpx_img_free(&img);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+  return pkts + data;
+}
+
+// Encoding frames on an internal thread does not change the output.
+TEST(EncodeAPI, PipelinedEncode) {
+  const std::string expected = EncodePipelined(0);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_TRUE(EncodePipelined(1) == expected);
+}
+
+// Images the encoder handed back, which are scribbled over to catch reads
+// after their release.
+void ReleaseSource(void *user_priv, const vpx_image_t *img) {
+  std::vector<const vpx_image_t *> *const released =
+      static_cast<std::vector<const vpx_image_t *> *>(user_priv);
+  for (int plane = 0; plane < 3; ++plane) {
+    const int shift = plane ? 1 : 0;
+    for (unsigned int y = 0; y < (img->d_h + shift) >> shift; ++y) {
+      memset(img->planes[plane] + y * img->stride[plane], 0,
+             (img->d_w + shift) >> shift);
+    }
+  }
+  released->push_back(img);
+}
+
+// Encodes kNumFrames good quality frames with alt-ref frames, each from its
+// own image, and returns the compressed frames back to back. With hold set
+// the encoder may keep the images instead of copying them, which it does for
+// padded images.
+std::string EncodeSourceRef(bool hold, bool padded,
+                            std::vector<const vpx_image_t *> *released) {
+  const int kWidth = 350;
+  const int kHeight = 286;
+  const int kNumFrames = 20;
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img[kNumFrames];
+  std::string data;
+
+  EXPECT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 10;
+  cfg.rc_target_bitrate = 300;
+  EXPECT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 4), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc, VP8E_SET_ENABLEAUTOALTREF, 1),
+            VPX_CODEC_OK);
+  if (hold) {
+    vpx_codec_release_source_cb_t cb = { ReleaseSource, released };
+    EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_SOURCE_RELEASE_CB, &cb),
+              VPX_CODEC_OK);
+  }
+
+  for (int i = 0; i < kNumFrames + 10; ++i) {
+    if (i < kNumFrames) {
+      const int border = padded ? VPX_SOURCE_BORDER_IN_PIXELS : 0;
+      EXPECT_TRUE(vpx_img_alloc(&img[i], VPX_IMG_FMT_I420,
+                                kWidth + 2 * border, kHeight + 2 * border,
+                                32) != NULL);
+      EXPECT_EQ(vpx_img_set_rect(&img[i], border, border, kWidth, kHeight),
+                0);
+      for (int plane = 0; plane < 3; ++plane) {
+        const int shift = plane ? 1 : 0;
+        for (int y = 0; y < (kHeight + shift) >> shift; ++y) {
+          for (int x = 0; x < (kWidth + shift) >> shift; ++x) {
+            img[i].planes[plane][y * img[i].stride[plane] + x] =
+                static_cast<uint8_t>((((x + i * 3) >> 3) ^ ((y + i) >> 3)) *
+                                     (37 + plane));
+          }
+        }
+      }
+    }
+    EXPECT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img[i] : NULL, i, 1, 0,
+                               VPX_DL_GOOD_QUALITY),
+              VPX_CODEC_OK);
+    // Images the encoder can't hold are copied and released right away.
+    if (hold && !padded) {
+      EXPECT_EQ(static_cast<int>(released->size()),
+                std::min(i + 1, kNumFrames));
+    } else if (hold && i < kNumFrames) {
+      EXPECT_LT(static_cast<int>(released->size()), i + 1);
+    }
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      data.append(static_cast<const char *>(pkt->data.frame.buf),
+                  pkt->data.frame.sz);
+    }
+  }
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+
+  if (hold) {
+    // Each image is released once, in the order it was encoded.
+    EXPECT_EQ(static_cast<int>(released->size()), kNumFrames);
+    for (int i = 0; i < static_cast<int>(released->size()); ++i) {
+      EXPECT_EQ((*released)[i], &img[i]);
+    }
+  }
+  for (int i = 0; i < kNumFrames; ++i) vpx_img_free(&img[i]);
+  return data;
+}
+
+// Holding source images by reference does not change the output.
+TEST(EncodeAPI, SourceReleaseCallback) {
+  std::vector<const vpx_image_t *> released;
+  const std::string expected = EncodeSourceRef(false, true, &released);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_TRUE(EncodeSourceRef(true, true, &released) == expected);
+  released.clear();
+  EXPECT_TRUE(EncodeSourceRef(true, false, &released) == expected);
+}
+#endif  // CONFIG_VP9_ENCODER
+
 }  // namespace
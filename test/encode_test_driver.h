@@ -167,6 +167,9 @@ class Encoder {
 
   void set_deadline(unsigned long deadline) { deadline_ = deadline; }
 
+  // The codec context, for tests that inspect the encoder's internal state.
+  vpx_codec_ctx_t *GetEncoder() { return &encoder_; }
+
  protected:
   virtual vpx_codec_iface_t *CodecInterface() const = 0;
 
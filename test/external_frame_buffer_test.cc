@@ -115,14 +115,29 @@ class ExternalFrameBufferList {
   }
 
   // Checks that the vpx_image_t data is contained within the external frame
-  // buffer private data passed back in the vpx_image_t.
+  // buffer private data passed back in the vpx_image_t, i.e. that the planes
+  // were not copied out of the frame buffer they were decoded to.
   void CheckImageFrameBuffer(const vpx_image_t *img) {
     if (img->fb_priv != NULL) {
       const struct ExternalFrameBuffer *const ext_fb =
           reinterpret_cast<ExternalFrameBuffer *>(img->fb_priv);
-
-      ASSERT_TRUE(img->planes[0] >= ext_fb->data &&
-                  img->planes[0] < (ext_fb->data + ext_fb->size));
+      const int bytes_per_sample =
+          (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+
+      for (int plane = 0; plane < 3; ++plane) {
+        const int w = plane ? (img->d_w + img->x_chroma_shift) >>
+                                  img->x_chroma_shift
+                            : img->d_w;
+        const int h = plane ? (img->d_h + img->y_chroma_shift) >>
+                                  img->y_chroma_shift
+                            : img->d_h;
+        const uint8_t *const last = img->planes[plane] +
+                                    (h - 1) * img->stride[plane] +
+                                    w * bytes_per_sample - 1;
+        ASSERT_TRUE(img->planes[plane] >= ext_fb->data &&
+                    last < (ext_fb->data + ext_fb->size))
+            << "plane " << plane;
+      }
     }
   }
 
@@ -286,7 +301,8 @@ const char kVP9NonRefTestFile[] = "vp90-2-22-svc_1280x720_1.webm";
 // Class for testing passing in external frame buffers to libvpx.
 class ExternalFrameBufferTest : public ::testing::Test {
  protected:
-  ExternalFrameBufferTest() : video_(NULL), decoder_(NULL), num_buffers_(0) {}
+  ExternalFrameBufferTest()
+      : video_(NULL), decoder_(NULL), num_buffers_(0), zero_copy_align_(0) {}
 
   virtual void SetUp() {
     video_ = new libvpx_test::WebMVideoSource(kVP9TestFile);
@@ -342,13 +358,30 @@ class ExternalFrameBufferTest : public ::testing::Test {
 
     // Get decompressed data
     while ((img = dec_iter.Next()) != NULL) {
+      if (zero_copy_align_ > 0) {
+        ASSERT_TRUE(img->fb_priv != NULL);
+        for (int plane = 0; plane < 3; ++plane) {
+          EXPECT_EQ(0, img->stride[plane] % zero_copy_align_);
+          EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(img->planes[plane]) %
+                            zero_copy_align_);
+        }
+      }
       fb_list_.CheckImageFrameBuffer(img);
     }
   }
 
+  // Has the decoder output frames without copying them, with the strides and
+  // the start of the planes aligned to |align|.
+  void SetZeroCopyOutput(int align) {
+    decoder_->Control(VP9D_SET_ZERO_COPY_OUTPUT, align);
+    decoder_->Control(VP9_SET_BYTE_ALIGNMENT, align);
+    zero_copy_align_ = align;
+  }
+
   libvpx_test::WebMVideoSource *video_;
   libvpx_test::VP9Decoder *decoder_;
   int num_buffers_;
+  int zero_copy_align_;
   ExternalFrameBufferList fb_list_;
 };
 
@@ -499,6 +532,23 @@ TEST_F(ExternalFrameBufferTest, SetAfterDecode) {
                                     release_vp9_frame_buffer));
 }
 
+TEST_F(ExternalFrameBufferTest, ZeroCopyOutput) {
+  const int num_buffers = VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
+  SetZeroCopyOutput(256);
+  ASSERT_EQ(VPX_CODEC_OK,
+            SetFrameBufferFunctions(num_buffers, get_vp9_frame_buffer,
+                                    release_vp9_frame_buffer));
+  ASSERT_EQ(VPX_CODEC_OK, DecodeRemainingFrames());
+}
+
+TEST_F(ExternalFrameBufferTest, ZeroCopyOutputInvalidParams) {
+  decoder_->Control(VP9D_SET_ZERO_COPY_OUTPUT, 16, VPX_CODEC_INVALID_PARAM);
+  decoder_->Control(VP9D_SET_ZERO_COPY_OUTPUT, 96, VPX_CODEC_INVALID_PARAM);
+  decoder_->Control(VP9D_SET_ZERO_COPY_OUTPUT, 2048, VPX_CODEC_INVALID_PARAM);
+  ASSERT_EQ(VPX_CODEC_OK, DecodeOneFrame());
+  decoder_->Control(VP9D_SET_ZERO_COPY_OUTPUT, 64, VPX_CODEC_ERROR);
+}
+
 TEST_F(ExternalFrameBufferNonRefTest, ReleaseNonRefFrameBuffer) {
   const int num_buffers = VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
   ASSERT_EQ(VPX_CODEC_OK,
@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <tuple>
 
@@ -23,6 +24,7 @@
 #include "test/util.h"
 #include "vp9/common/vp9_entropy.h"
 #include "vp9/common/vp9_loopfilter.h"
+#include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx/vpx_integer.h"
 
 using libvpx_test::ACMRandom;
@@ -60,6 +62,12 @@ typedef void (*dual_loop_op_t)(Pixel *s, int p, const uint8_t *blimit0,
 typedef std::tuple<loop_op_t, loop_op_t, int> loop8_param_t;
 typedef std::tuple<dual_loop_op_t, dual_loop_op_t, int> dualloop8_param_t;
 
+// The _quad filters only have 8-bit versions, which are checked against four
+// calls of the 8-row C filter.
+typedef void (*quad_loop_op_t)(uint8_t *s, int p, const uint8_t *blimit,
+                               const uint8_t *limit, const uint8_t *thresh);
+typedef std::tuple<quad_loop_op_t, quad_loop_op_t> quadloop_param_t;
+
 void InitInput(Pixel *s, Pixel *ref_s, ACMRandom *rnd, const uint8_t limit,
                const int mask, const int32_t p, const int i) {
   uint16_t tmp_s[kNumCoeffs];
@@ -146,6 +154,21 @@ class Loop8Test6Param : public ::testing::TestWithParam<loop8_param_t> {
   loop_op_t ref_loopfilter_op_;
 };
 
+class LoopQuadTest : public ::testing::TestWithParam<quadloop_param_t> {
+ public:
+  virtual ~LoopQuadTest() {}
+  virtual void SetUp() {
+    loopfilter_op_ = GET_PARAM(0);
+    ref_loopfilter_op_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  quad_loop_op_t loopfilter_op_;
+  quad_loop_op_t ref_loopfilter_op_;
+};
+
 class Loop8Test9Param : public ::testing::TestWithParam<dualloop8_param_t> {
  public:
   virtual ~Loop8Test9Param() {}
@@ -403,6 +426,57 @@ TEST_P(Loop8Test9Param, ValueCheck) {
       << "First failed at test case " << first_failure;
 }
 
+TEST_P(LoopQuadTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  // 32 filtered rows with 8 rows above and below.
+  const int kRows = 48;
+  const int32_t p = 32;
+  DECLARE_ALIGNED(16, uint8_t, s[kRows * p]);
+  DECLARE_ALIGNED(16, uint8_t, ref_s[kRows * p]);
+  DECLARE_ALIGNED(16, uint8_t, blimit[16]);
+  DECLARE_ALIGNED(16, uint8_t, limit[16]);
+  DECLARE_ALIGNED(16, uint8_t, thresh[16]);
+  int err_count_total = 0;
+  int first_failure = -1;
+  for (int i = 0; i < number_of_iterations; ++i) {
+    memset(blimit, GetOuterThresh(&rnd), sizeof(blimit));
+    memset(limit, GetInnerThresh(&rnd), sizeof(limit));
+    memset(thresh, GetHevThresh(&rnd), sizeof(thresh));
+    // Every third block is noise. The others are rows of small steps with
+    // occasional jumps, which reach the flat filters.
+    for (int r = 0; r < kRows; ++r) {
+      int val = rnd.Rand8();
+      for (int c = 0; c < p; ++c) {
+        if (i % 3 == 0 || rnd(16) == 0) {
+          val = rnd.Rand8();
+        } else {
+          val = clamp(val + rnd(3) - 1, 0, 255);
+        }
+        s[r * p + c] = ref_s[r * p + c] = static_cast<uint8_t>(val);
+      }
+    }
+    for (int j = 0; j < 4; ++j) {
+      ref_loopfilter_op_(ref_s + 8 + p * (8 + 8 * j), p, blimit, limit,
+                         thresh);
+    }
+    ASM_REGISTER_STATE_CHECK(
+        loopfilter_op_(s + 8 + p * 8, p, blimit, limit, thresh));
+
+    int err_count = 0;
+    for (int j = 0; j < kRows * p; ++j) {
+      err_count += ref_s[j] != s[j];
+    }
+    if (err_count && !err_count_total) {
+      first_failure = i;
+    }
+    err_count_total += err_count;
+  }
+  EXPECT_EQ(0, err_count_total)
+      << "Error: LoopQuadTest, 8-row C output doesn't match quad "
+         "loopfilter output. "
+      << "First failed at test case " << first_failure;
+}
+
 using std::make_tuple;
 
 #if HAVE_SSE2
@@ -480,9 +554,40 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Values(make_tuple(&vpx_lpf_horizontal_16_avx2,
                                  &vpx_lpf_horizontal_16_c, 8),
                       make_tuple(&vpx_lpf_horizontal_16_dual_avx2,
-                                 &vpx_lpf_horizontal_16_dual_c, 8)));
+                                 &vpx_lpf_horizontal_16_dual_c, 8))));
 #endif
 
+INSTANTIATE_TEST_CASE_P(
+    C, LoopQuadTest,
+    ::testing::Values(make_tuple(&vpx_lpf_vertical_4_quad_c,
+                                 &vpx_lpf_vertical_4_c),
+                      make_tuple(&vpx_lpf_vertical_8_quad_c,
+                                 &vpx_lpf_vertical_8_c),
+                      make_tuple(&vpx_lpf_vertical_16_quad_c,
+                                 &vpx_lpf_vertical_16_c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, LoopQuadTest,
+    ::testing::Values(make_tuple(&vpx_lpf_vertical_4_quad_sse2,
+                                 &vpx_lpf_vertical_4_c),
+                      make_tuple(&vpx_lpf_vertical_8_quad_sse2,
+                                 &vpx_lpf_vertical_8_c),
+                      make_tuple(&vpx_lpf_vertical_16_quad_sse2,
+                                 &vpx_lpf_vertical_16_c)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, LoopQuadTest,
+    ::testing::Values(make_tuple(&vpx_lpf_vertical_4_quad_avx2,
+                                 &vpx_lpf_vertical_4_c),
+                      make_tuple(&vpx_lpf_vertical_8_quad_avx2,
+                                 &vpx_lpf_vertical_8_c),
+                      make_tuple(&vpx_lpf_vertical_16_quad_avx2,
+                                 &vpx_lpf_vertical_16_c)));
+#endif  // HAVE_AVX2
+
 #if HAVE_SSE2
 #if CONFIG_VP9_HIGHBITDEPTH
 INSTANTIATE_TEST_CASE_P(
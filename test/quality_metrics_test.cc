@@ -0,0 +1,346 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cmath>
+#include <tuple>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+const int kNumIterations = 200;
+const int kMaxWidth = 256;
+const int kMaxHeight = 128;
+const int kStride = kMaxWidth + 16;
+
+// The optimized versions accumulate the floating point sums in the same order
+// as the C code. Without SSE2 math the C code may keep extra precision, so an
+// exact match is only required on x86-64.
+void CheckResult(double ref, double tst) {
+#if VPX_ARCH_X86_64
+  ASSERT_EQ(ref, tst) << "C output does not match optimized output.";
+#else
+  ASSERT_NEAR(ref, tst, 1e-9 * (1 + std::fabs(ref)))
+      << "C output does not match optimized output.";
+#endif
+}
+
+// Fills src with random values below limit and dst with a noisy copy of it, so
+// that the metrics are evaluated away from their trivial values.
+template <typename Pixel>
+void FillBlocks(ACMRandom *rnd, Pixel *src, Pixel *dst, int limit) {
+  const int noise = 1 + rnd->Rand8() % 32;
+  const bool extreme = rnd->Rand8() < 16;
+  for (int i = 0; i < kMaxHeight * kStride; ++i) {
+    if (extreme) {
+      src[i] = rnd->Rand8() & 1 ? limit - 1 : 0;
+      dst[i] = rnd->Rand8() & 1 ? limit - 1 : 0;
+    } else {
+      const int v = rnd->Rand16() % limit;
+      const int d = v + rnd->Rand16() % (2 * noise + 1) - noise;
+      src[i] = v;
+      dst[i] = d < 0 ? 0 : d >= limit ? limit - 1 : d;
+    }
+  }
+}
+
+typedef double (*SsimPlaneFunc)(const uint8_t *img1, int stride_img1,
+                                const uint8_t *img2, int stride_img2,
+                                int width, int height);
+typedef std::tuple<SsimPlaneFunc, SsimPlaneFunc> SsimPlaneParam;
+
+class SsimPlaneTest : public ::testing::TestWithParam<SsimPlaneParam> {
+ public:
+  virtual ~SsimPlaneTest() {}
+  virtual void SetUp() {
+    ref_func_ = GET_PARAM(0);
+    tst_func_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  SsimPlaneFunc ref_func_;
+  SsimPlaneFunc tst_func_;
+};
+
+TEST_P(SsimPlaneTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[kMaxHeight * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kMaxHeight * kStride]);
+
+  for (int k = 0; k < kNumIterations; ++k) {
+    const int width = 8 + rnd(kMaxWidth - 7);
+    const int height = 8 + rnd(kMaxHeight - 7);
+    const int offset = rnd(kStride - width + 1);
+    FillBlocks(&rnd, src, dst, 256);
+
+    const double res_ref =
+        ref_func_(src + offset, kStride, dst, kStride, width, height);
+    double res_tst;
+    ASM_REGISTER_STATE_CHECK(res_tst = tst_func_(src + offset, kStride, dst,
+                                                 kStride, width, height));
+    CheckResult(res_ref, res_tst);
+  }
+}
+
+typedef void (*FastSsimStructureFunc)(const uint32_t *im1, const uint32_t *im2,
+                                      int w, int h, double c2, double *ssim,
+                                      uint32_t *buf);
+typedef std::tuple<FastSsimStructureFunc, FastSsimStructureFunc>
+    FastSsimStructureParam;
+
+class FastSsimStructureTest
+    : public ::testing::TestWithParam<FastSsimStructureParam> {
+ public:
+  virtual ~FastSsimStructureTest() {}
+  virtual void SetUp() {
+    ref_func_ = GET_PARAM(0);
+    tst_func_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  FastSsimStructureFunc ref_func_;
+  FastSsimStructureFunc tst_func_;
+};
+
+TEST_P(FastSsimStructureTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint32_t, im1[kMaxHeight * kMaxWidth]);
+  DECLARE_ALIGNED(16, uint32_t, im2[kMaxHeight * kMaxWidth]);
+  DECLARE_ALIGNED(16, uint32_t, buf[16 * (kMaxWidth + 8)]);
+  DECLARE_ALIGNED(16, double, ssim_ref[kMaxHeight * kMaxWidth]);
+  DECLARE_ALIGNED(16, double, ssim_tst[kMaxHeight * kMaxWidth]);
+
+  for (int k = 0; k < kNumIterations; ++k) {
+    const int w = 1 + rnd(kMaxWidth);
+    const int h = 1 + rnd(kMaxHeight);
+    // The values of level l are sums of 4^l pixels of up to 12 bits.
+    const int level = rnd(4);
+    const uint32_t limit = 1u << (12 + 2 * level);
+    const double c2 = (0.03 * 4095) * (0.03 * 4095) * (1 << 4 * level) * 16 *
+                      104;
+    for (int i = 0; i < w * h; ++i) {
+      im1[i] = rnd.RandRange(limit);
+      im2[i] = rnd(8) ? im1[i] : rnd.RandRange(limit);
+    }
+
+    ref_func_(im1, im2, w, h, c2, ssim_ref, buf);
+    ASM_REGISTER_STATE_CHECK(tst_func_(im1, im2, w, h, c2, ssim_tst, buf));
+    for (int i = 0; i < w * h; ++i) {
+      CheckResult(ssim_ref[i], ssim_tst[i]);
+    }
+  }
+}
+
+typedef double (*PsnrHvsPlaneFunc)(const uint8_t *src, int src_stride,
+                                   const uint8_t *dst, int dst_stride, int w,
+                                   int h, int step, const double csf[8][8]);
+typedef std::tuple<PsnrHvsPlaneFunc, PsnrHvsPlaneFunc> PsnrHvsPlaneParam;
+
+// Positive weights of the same magnitude as the tables in psnrhvs.c.
+void FillCsf(ACMRandom *rnd, double csf[8][8]) {
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) csf[i][j] = 0.2 + rnd->Rand16() / 32768.0;
+  }
+}
+
+class PsnrHvsPlaneTest : public ::testing::TestWithParam<PsnrHvsPlaneParam> {
+ public:
+  virtual ~PsnrHvsPlaneTest() {}
+  virtual void SetUp() {
+    ref_func_ = GET_PARAM(0);
+    tst_func_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  PsnrHvsPlaneFunc ref_func_;
+  PsnrHvsPlaneFunc tst_func_;
+};
+
+TEST_P(PsnrHvsPlaneTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[kMaxHeight * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kMaxHeight * kStride]);
+  double csf[8][8];
+
+  for (int k = 0; k < kNumIterations; ++k) {
+    const int w = 8 + rnd(kMaxWidth - 7);
+    const int h = 8 + rnd(kMaxHeight - 7);
+    const int step = rnd(2) ? 7 : 8;
+    FillBlocks(&rnd, src, dst, 256);
+    FillCsf(&rnd, csf);
+
+    const double res_ref =
+        ref_func_(src, kStride, dst, kStride, w, h, step, csf);
+    double res_tst;
+    ASM_REGISTER_STATE_CHECK(
+        res_tst = tst_func_(src, kStride, dst, kStride, w, h, step, csf));
+    CheckResult(res_ref, res_tst);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+typedef double (*HighbdSsimPlaneFunc)(const uint16_t *img1, int stride_img1,
+                                      const uint16_t *img2, int stride_img2,
+                                      int width, int height, uint32_t bd,
+                                      uint32_t shift);
+typedef std::tuple<HighbdSsimPlaneFunc, HighbdSsimPlaneFunc>
+    HighbdSsimPlaneParam;
+
+class HighbdSsimPlaneTest
+    : public ::testing::TestWithParam<HighbdSsimPlaneParam> {
+ public:
+  virtual ~HighbdSsimPlaneTest() {}
+  virtual void SetUp() {
+    ref_func_ = GET_PARAM(0);
+    tst_func_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  HighbdSsimPlaneFunc ref_func_;
+  HighbdSsimPlaneFunc tst_func_;
+};
+
+TEST_P(HighbdSsimPlaneTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint16_t, src[kMaxHeight * kStride]);
+  DECLARE_ALIGNED(16, uint16_t, dst[kMaxHeight * kStride]);
+
+  for (int k = 0; k < kNumIterations; ++k) {
+    const int width = 8 + rnd(kMaxWidth - 7);
+    const int height = 8 + rnd(kMaxHeight - 7);
+    const int offset = rnd(kStride - width + 1);
+    // The pixels have bd + shift bits, as in vpx_highbd_calc_ssim().
+    const uint32_t bd = 8 + 2 * rnd(3);
+    const uint32_t shift = rnd(2) ? 12 - bd : 0;
+    FillBlocks(&rnd, src, dst, 1 << (bd + shift));
+
+    const double res_ref = ref_func_(src + offset, kStride, dst, kStride, width,
+                                     height, bd, shift);
+    double res_tst;
+    ASM_REGISTER_STATE_CHECK(res_tst = tst_func_(src + offset, kStride, dst,
+                                                 kStride, width, height, bd,
+                                                 shift));
+    CheckResult(res_ref, res_tst);
+  }
+}
+
+typedef double (*HighbdPsnrHvsPlaneFunc)(const uint16_t *src, int src_stride,
+                                         const uint16_t *dst, int dst_stride,
+                                         int w, int h, int step,
+                                         const double csf[8][8], uint32_t bd,
+                                         uint32_t shift);
+typedef std::tuple<HighbdPsnrHvsPlaneFunc, HighbdPsnrHvsPlaneFunc>
+    HighbdPsnrHvsPlaneParam;
+
+class HighbdPsnrHvsPlaneTest
+    : public ::testing::TestWithParam<HighbdPsnrHvsPlaneParam> {
+ public:
+  virtual ~HighbdPsnrHvsPlaneTest() {}
+  virtual void SetUp() {
+    ref_func_ = GET_PARAM(0);
+    tst_func_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  HighbdPsnrHvsPlaneFunc ref_func_;
+  HighbdPsnrHvsPlaneFunc tst_func_;
+};
+
+TEST_P(HighbdPsnrHvsPlaneTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint16_t, src[kMaxHeight * kStride]);
+  DECLARE_ALIGNED(16, uint16_t, dst[kMaxHeight * kStride]);
+  double csf[8][8];
+
+  for (int k = 0; k < kNumIterations; ++k) {
+    const int w = 8 + rnd(kMaxWidth - 7);
+    const int h = 8 + rnd(kMaxHeight - 7);
+    const int step = rnd(2) ? 7 : 8;
+    // Only 10 and 12 bit planes take the high bitdepth path in vpx_psnrhvs().
+    const uint32_t bd = rnd(2) ? 10 : 12;
+    const uint32_t shift = rnd(2) ? 12 - bd : 0;
+    FillBlocks(&rnd, src, dst, 1 << (bd + shift));
+    FillCsf(&rnd, csf);
+
+    const double res_ref =
+        ref_func_(src, kStride, dst, kStride, w, h, step, csf, bd, shift);
+    double res_tst;
+    ASM_REGISTER_STATE_CHECK(res_tst = tst_func_(src, kStride, dst, kStride, w,
+                                                 h, step, csf, bd, shift));
+    CheckResult(res_ref, res_tst);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+using std::make_tuple;
+
+INSTANTIATE_TEST_CASE_P(C, SsimPlaneTest,
+                        ::testing::Values(make_tuple(&vpx_ssim_plane_c,
+                                                     &vpx_ssim_plane_c)));
+INSTANTIATE_TEST_CASE_P(
+    C, FastSsimStructureTest,
+    ::testing::Values(make_tuple(&vpx_fastssim_structure_c,
+                                 &vpx_fastssim_structure_c)));
+INSTANTIATE_TEST_CASE_P(C, PsnrHvsPlaneTest,
+                        ::testing::Values(make_tuple(&vpx_psnrhvs_plane_c,
+                                                     &vpx_psnrhvs_plane_c)));
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    C, HighbdSsimPlaneTest,
+    ::testing::Values(make_tuple(&vpx_highbd_ssim_plane_c,
+                                 &vpx_highbd_ssim_plane_c)));
+INSTANTIATE_TEST_CASE_P(
+    C, HighbdPsnrHvsPlaneTest,
+    ::testing::Values(make_tuple(&vpx_highbd_psnrhvs_plane_c,
+                                 &vpx_highbd_psnrhvs_plane_c)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, SsimPlaneTest,
+                        ::testing::Values(make_tuple(&vpx_ssim_plane_c,
+                                                     &vpx_ssim_plane_avx2)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, FastSsimStructureTest,
+    ::testing::Values(make_tuple(&vpx_fastssim_structure_c,
+                                 &vpx_fastssim_structure_avx2)));
+INSTANTIATE_TEST_CASE_P(AVX2, PsnrHvsPlaneTest,
+                        ::testing::Values(make_tuple(&vpx_psnrhvs_plane_c,
+                                                     &vpx_psnrhvs_plane_avx2)));
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HighbdSsimPlaneTest,
+    ::testing::Values(make_tuple(&vpx_highbd_ssim_plane_c,
+                                 &vpx_highbd_ssim_plane_avx2)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HighbdPsnrHvsPlaneTest,
+    ::testing::Values(make_tuple(&vpx_highbd_psnrhvs_plane_c,
+                                 &vpx_highbd_psnrhvs_plane_avx2)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+#endif  // HAVE_AVX2
+}  // namespace
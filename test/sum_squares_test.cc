@@ -119,6 +119,13 @@ INSTANTIATE_TEST_CASE_P(
                                  &vpx_sum_squares_2d_i16_sse2)));
 #endif  // HAVE_SSE2
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, SumSquaresTest,
+    ::testing::Values(make_tuple(&vpx_sum_squares_2d_i16_c,
+                                 &vpx_sum_squares_2d_i16_avx2)));
+#endif  // HAVE_AVX2
+
 #if HAVE_MSA
 INSTANTIATE_TEST_CASE_P(
     MSA, SumSquaresTest,
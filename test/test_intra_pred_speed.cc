@@ -248,6 +248,20 @@ INTRA_PRED_TEST(SSSE3, TestIntraPred32, NULL, NULL, NULL, NULL, NULL, NULL,
                 vpx_d63_predictor_32x32_ssse3, NULL)
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2
+INTRA_PRED_TEST(AVX2, TestIntraPred16, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vpx_d135_predictor_16x16_avx2,
+                vpx_d117_predictor_16x16_avx2, NULL, NULL, NULL, NULL)
+INTRA_PRED_TEST(AVX2, TestIntraPred32, vpx_dc_predictor_32x32_avx2,
+                vpx_dc_left_predictor_32x32_avx2,
+                vpx_dc_top_predictor_32x32_avx2,
+                vpx_dc_128_predictor_32x32_avx2, NULL, NULL,
+                vpx_d45_predictor_32x32_avx2, vpx_d135_predictor_32x32_avx2,
+                vpx_d117_predictor_32x32_avx2, vpx_d153_predictor_32x32_avx2,
+                vpx_d207_predictor_32x32_avx2, vpx_d63_predictor_32x32_avx2,
+                NULL)
+#endif  // HAVE_AVX2
+
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred4, vpx_dc_predictor_4x4_dspr2, NULL, NULL,
                 NULL, NULL, vpx_h_predictor_4x4_dspr2, NULL, NULL, NULL, NULL,
@@ -547,6 +561,27 @@ HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred32, NULL, NULL, NULL, NULL,
                        vpx_highbd_d63_predictor_32x32_ssse3, NULL)
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2
+HIGHBD_INTRA_PRED_TEST(
+    AVX2, TestHighbdIntraPred16, vpx_highbd_dc_predictor_16x16_avx2,
+    vpx_highbd_dc_left_predictor_16x16_avx2,
+    vpx_highbd_dc_top_predictor_16x16_avx2,
+    vpx_highbd_dc_128_predictor_16x16_avx2, NULL, NULL,
+    vpx_highbd_d45_predictor_16x16_avx2, vpx_highbd_d135_predictor_16x16_avx2,
+    vpx_highbd_d117_predictor_16x16_avx2, vpx_highbd_d153_predictor_16x16_avx2,
+    vpx_highbd_d207_predictor_16x16_avx2, vpx_highbd_d63_predictor_16x16_avx2,
+    NULL)
+HIGHBD_INTRA_PRED_TEST(
+    AVX2, TestHighbdIntraPred32, vpx_highbd_dc_predictor_32x32_avx2,
+    vpx_highbd_dc_left_predictor_32x32_avx2,
+    vpx_highbd_dc_top_predictor_32x32_avx2,
+    vpx_highbd_dc_128_predictor_32x32_avx2, NULL, NULL,
+    vpx_highbd_d45_predictor_32x32_avx2, vpx_highbd_d135_predictor_32x32_avx2,
+    vpx_highbd_d117_predictor_32x32_avx2, vpx_highbd_d153_predictor_32x32_avx2,
+    vpx_highbd_d207_predictor_32x32_avx2, vpx_highbd_d63_predictor_32x32_avx2,
+    NULL)
+#endif  // HAVE_AVX2
+
 #if HAVE_NEON
 HIGHBD_INTRA_PRED_TEST(
     NEON, TestHighbdIntraPred4, vpx_highbd_dc_predictor_4x4_neon,
@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+#include "vpx_util/vpx_thread.h"
+
+namespace {
+
+#if CONFIG_MULTITHREAD && CONFIG_VP9_DECODER
+
+const int kWidth = 352;
+const int kHeight = 288;
+const int kNumFrames = 20;
+
+typedef std::vector<uint8_t> Frame;
+
+void FillImage(vpx_image_t *img, int frame) {
+  for (int plane = 0; plane < 3; ++plane) {
+    const int w = plane ? (img->d_w + 1) >> 1 : img->d_w;
+    const int h = plane ? (img->d_h + 1) >> 1 : img->d_h;
+    for (int y = 0; y < h; ++y) {
+      uint8_t *const row = img->planes[plane] + y * img->stride[plane];
+      for (int x = 0; x < w; ++x) {
+        row[x] = static_cast<uint8_t>((x * (plane + 1) + y * 3 + frame * 4) ^
+                                      ((x >> 4) * (y >> 4)));
+      }
+    }
+  }
+}
+
+// Encodes kNumFrames frames, appending one packet per frame to frames.
+void Encode(std::vector<Frame> *frames) {
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+
+  ASSERT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 500;
+  ASSERT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8), VPX_CODEC_OK);
+  ASSERT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 16) !=
+              NULL);
+
+  for (int i = 0; i <= kNumFrames; ++i) {
+    if (i < kNumFrames) FillImage(&img, i);
+    ASSERT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img : NULL, i, 1, 0,
+                               VPX_DL_REALTIME),
+              VPX_CODEC_OK);
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames->push_back(Frame(buf, buf + pkt->data.frame.sz));
+    }
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+// Results of the completion callbacks, in the order they were called.
+struct Completions {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  std::vector<int> frames;
+  std::vector<vpx_codec_err_t> results;
+};
+
+void DecodeCallback(void *cb_priv, void *user_priv, vpx_codec_err_t res) {
+  Completions *const completions = static_cast<Completions *>(cb_priv);
+  pthread_mutex_lock(&completions->mutex);
+  completions->frames.push_back(
+      static_cast<int>(reinterpret_cast<intptr_t>(user_priv)));
+  completions->results.push_back(res);
+  pthread_cond_signal(&completions->cond);
+  pthread_mutex_unlock(&completions->mutex);
+}
+
+// Appends the md5 of every frame the decoder has ready to md5s.
+void GetFrames(vpx_codec_ctx_t *dec, std::vector<std::string> *md5s) {
+  vpx_codec_iter_t iter = NULL;
+  vpx_image_t *img;
+  while ((img = vpx_codec_get_frame(dec, &iter)) != NULL) {
+    libvpx_test::MD5 md5;
+    md5.Add(img);
+    md5s->push_back(md5.Get());
+  }
+}
+
+// An asynchronous decoder outputs the frames of a synchronous one, and calls
+// back once for every packet.
+TEST(VP9AsyncDecodeTest, MatchesSyncDecode) {
+  std::vector<Frame> frames;
+  std::vector<std::string> expected_md5;
+  std::vector<std::string> md5;
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  vpx_codec_ctx_t dec;
+
+  ASSERT_NO_FATAL_FAILURE(Encode(&frames));
+  ASSERT_EQ(static_cast<int>(frames.size()), kNumFrames);
+
+  ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  for (int i = 0; i < kNumFrames; ++i) {
+    ASSERT_EQ(vpx_codec_decode(&dec, &frames[i][0],
+                               static_cast<unsigned int>(frames[i].size()),
+                               NULL, 0),
+              VPX_CODEC_OK);
+    GetFrames(&dec, &expected_md5);
+  }
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+  ASSERT_EQ(static_cast<int>(expected_md5.size()), kNumFrames);
+
+  Completions completions;
+  pthread_mutex_init(&completions.mutex, NULL);
+  pthread_cond_init(&completions.cond, NULL);
+  cfg.threads = 4;
+  ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  for (int i = 0; i < kNumFrames; ++i) {
+    ASSERT_EQ(vpx_codec_decode_async(
+                  &dec, &frames[i][0],
+                  static_cast<unsigned int>(frames[i].size()),
+                  reinterpret_cast<void *>(static_cast<intptr_t>(i)),
+                  DecodeCallback, &completions),
+              VPX_CODEC_OK);
+    GetFrames(&dec, &md5);
+  }
+  ASSERT_EQ(vpx_codec_decode_async(&dec, NULL, 0, NULL, NULL, NULL),
+            VPX_CODEC_OK);
+
+  pthread_mutex_lock(&completions.mutex);
+  while (static_cast<int>(completions.frames.size()) < kNumFrames)
+    pthread_cond_wait(&completions.cond, &completions.mutex);
+  pthread_mutex_unlock(&completions.mutex);
+  GetFrames(&dec, &md5);
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+
+  // Frames come out in decode order, callbacks in any order.
+  EXPECT_EQ(md5, expected_md5);
+  ASSERT_EQ(static_cast<int>(completions.frames.size()), kNumFrames);
+  std::vector<int> called(kNumFrames, 0);
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(completions.results[i], VPX_CODEC_OK);
+    ASSERT_GE(completions.frames[i], 0);
+    ASSERT_LT(completions.frames[i], kNumFrames);
+    ++called[completions.frames[i]];
+  }
+  for (int i = 0; i < kNumFrames; ++i) EXPECT_EQ(called[i], 1) << i;
+
+  pthread_cond_destroy(&completions.cond);
+  pthread_mutex_destroy(&completions.mutex);
+}
+
+TEST(VP9AsyncDecodeTest, AfterSyncDecode) {
+  std::vector<Frame> frames;
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  vpx_codec_ctx_t dec;
+
+  ASSERT_NO_FATAL_FAILURE(Encode(&frames));
+  ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_decode(&dec, &frames[0][0],
+                             static_cast<unsigned int>(frames[0].size()), NULL,
+                             0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_decode_async(&dec, &frames[1][0],
+                                   static_cast<unsigned int>(frames[1].size()),
+                                   NULL, NULL, NULL),
+            VPX_CODEC_ERROR);
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+}
+
+#if CONFIG_VP8_DECODER
+TEST(VP9AsyncDecodeTest, Incapable) {
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  vpx_codec_ctx_t dec;
+  const uint8_t data[1] = { 0 };
+
+  ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp8_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_decode_async(&dec, data, sizeof(data), NULL, NULL, NULL),
+            VPX_CODEC_INCAPABLE);
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+}
+#endif  // CONFIG_VP8_DECODER
+
+#endif  // CONFIG_MULTITHREAD && CONFIG_VP9_DECODER
+
+}  // namespace
@@ -17,6 +17,7 @@
 #include "test/util.h"
 #include "test/y4m_video_source.h"
 #include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/vp9_cx_iface.h"
 
 namespace {
 // FIRSTPASS_STATS struct:
@@ -390,6 +391,114 @@ TEST_P(VPxEncoderThreadTest, EncoderResultTest) {
   EXPECT_NEAR(single_thr_psnr, multi_thr_psnr, 0.2);
 }
 
+// Pans over a fixed noise texture, so that the TPL model finds motion to
+// propagate between the frames.
+class PanningVideoSource : public ::libvpx_test::DummyVideoSource {
+ protected:
+  virtual void FillFrame() {
+    if (!img_) return;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int shift = plane ? 1 : 0;
+      const int w = (img_->d_w + shift) >> shift;
+      const int h = (img_->d_h + shift) >> shift;
+      uint8_t *const buf = img_->planes[plane];
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          const uint32_t u = (x + 3 * frame_) * 2654435761u;
+          const uint32_t v = (y + frame_ + 4096 * plane) * 40503u;
+          buf[y * img_->stride[plane] + x] = (u ^ v) >> 24;
+        }
+      }
+    }
+  }
+};
+
+class VP9TplThreadTest : public ::libvpx_test::EncoderTest,
+                         public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VP9TplThreadTest()
+      : EncoderTest(GET_PARAM(0)), encoder_initialized_(false),
+        threads_(GET_PARAM(1)), row_mt_mode_(1), pass_(0), tpl_frames_(0) {}
+  virtual ~VP9TplThreadTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 500;
+  }
+
+  virtual void BeginPassHook(unsigned int pass) {
+    encoder_initialized_ = false;
+    pass_ = pass;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource * /*video*/,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (!encoder_initialized_) {
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 1);
+      encoder->Control(VP8E_SET_CPUUSED, 2);
+      encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+      encoder->Control(VP9E_SET_TPL, 1);
+      encoder->Control(VP9E_SET_ROW_MT, row_mt_mode_);
+      encoder_initialized_ = true;
+    }
+  }
+
+  // Hashes the TPL stats of every frame of the current GOP.
+  virtual void PostEncodeFrameHook(::libvpx_test::Encoder *encoder) {
+    if (pass_ == 0) return;
+    const VP9_COMP *const cpi = vp9_get_compressor(encoder->GetEncoder());
+    ASSERT_TRUE(cpi != NULL);
+    ::libvpx_test::MD5 md5;
+    for (int i = 0; i < MAX_ARF_GOP_SIZE; ++i) {
+      const TplDepFrame *const tpl_frame = &cpi->tpl_stats[i];
+      if (!tpl_frame->is_valid) continue;
+      for (int mi_row = 0; mi_row < tpl_frame->mi_rows; ++mi_row) {
+        md5.Add(reinterpret_cast<const uint8_t *>(
+                    &tpl_frame->tpl_stats_ptr[mi_row * tpl_frame->stride]),
+                tpl_frame->mi_cols * sizeof(*tpl_frame->tpl_stats_ptr));
+      }
+      ++tpl_frames_;
+    }
+    tpl_md5_.push_back(md5.Get());
+  }
+
+  bool encoder_initialized_;
+  int threads_;
+  int row_mt_mode_;
+  unsigned int pass_;
+  int tpl_frames_;
+  std::vector<std::string> tpl_md5_;
+};
+
+TEST_P(VP9TplThreadTest, TplStatsMatch) {
+  PanningVideoSource video;
+  video.SetSize(352, 288);
+  video.set_limit(20);
+
+  // Single threaded TPL model.
+  row_mt_mode_ = 0;
+  cfg_.g_threads = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const std::vector<std::string> single_thr_md5 = tpl_md5_;
+  tpl_md5_.clear();
+  ASSERT_GT(tpl_frames_, 0);
+
+  // Row based multi-threaded TPL model, with a single thread.
+  row_mt_mode_ = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_EQ(single_thr_md5, tpl_md5_);
+  tpl_md5_.clear();
+
+  // Row based multi-threaded TPL model.
+  cfg_.g_threads = threads_;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_EQ(single_thr_md5, tpl_md5_);
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9TplThreadTest, ::testing::Values(2, 4));
+
 INSTANTIATE_TEST_CASE_P(
     VP9, VPxFirstPassEncoderThreadTest,
     ::testing::Combine(
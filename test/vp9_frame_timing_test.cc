@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+#if CONFIG_VP9_DECODER && CONFIG_VP9_ENCODER
+
+const int kWidth = 640;
+const int kHeight = 360;
+const int kNumFrames = 10;
+
+typedef std::vector<uint8_t> Frame;
+
+struct DecodeMode {
+  int threads;
+  int row_mt;
+  int lpf_opt;
+  int frame_parallel;
+};
+
+void FillImage(vpx_image_t *img, int frame) {
+  for (int plane = 0; plane < 3; ++plane) {
+    const int w = plane ? (img->d_w + 1) >> 1 : img->d_w;
+    const int h = plane ? (img->d_h + 1) >> 1 : img->d_h;
+    for (int y = 0; y < h; ++y) {
+      uint8_t *const row = img->planes[plane] + y * img->stride[plane];
+      for (int x = 0; x < w; ++x) {
+        row[x] = static_cast<uint8_t>((x * (plane + 1) + y * 3 + frame * 4) ^
+                                      ((x >> 4) * (y >> 4)));
+      }
+    }
+  }
+}
+
+// Encodes kNumFrames frames with two tile columns, appending one packet per
+// frame to frames.
+void Encode(std::vector<Frame> *frames) {
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+
+  ASSERT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 1000;
+  ASSERT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 1), VPX_CODEC_OK);
+  ASSERT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 16) !=
+              NULL);
+
+  for (int i = 0; i <= kNumFrames; ++i) {
+    if (i < kNumFrames) FillImage(&img, i);
+    ASSERT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img : NULL, i, 1, 0,
+                               VPX_DL_REALTIME),
+              VPX_CODEC_OK);
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames->push_back(Frame(buf, buf + pkt->data.frame.sz));
+    }
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+void CheckTiming(const vpx_frame_timing_t &timing, bool single_thread) {
+  EXPECT_GT(timing.total, 0);
+  EXPECT_GE(timing.header, 0);
+  EXPECT_GE(timing.parse, 0);
+  EXPECT_GE(timing.inverse_transform, 0);
+  EXPECT_GE(timing.inter_pred, 0);
+  EXPECT_GE(timing.loop_filter, 0);
+  EXPECT_GE(timing.thread_wait, 0);
+  // Each time is rounded down to microseconds on its own.
+  EXPECT_LE(timing.inverse_transform + timing.inter_pred, timing.recon + 1);
+  if (single_thread) {
+    EXPECT_LE(timing.header + timing.parse + timing.recon +
+                  timing.loop_filter + timing.thread_wait,
+              timing.total + 5);
+  }
+}
+
+// Decodes frames, returning the md5 of each output frame. Checks the timing
+// of every frame if timing is set.
+std::vector<std::string> Decode(const std::vector<Frame> &frames,
+                                const DecodeMode &mode, bool timing) {
+  std::vector<std::string> md5s;
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  vpx_codec_ctx_t dec;
+  vpx_frame_timing_t frame_timing;
+
+  cfg.threads = mode.threads;
+  EXPECT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&dec, VP9D_SET_ROW_MT, mode.row_mt),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&dec, VP9D_SET_LOOP_FILTER_OPT, mode.lpf_opt),
+            VPX_CODEC_OK);
+  EXPECT_EQ(
+      vpx_codec_control(&dec, VP9D_SET_FRAME_PARALLEL, mode.frame_parallel),
+      VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&dec, VP9D_SET_FRAME_TIMING, timing ? 1 : 0),
+            VPX_CODEC_OK);
+
+  for (size_t i = 0; i <= frames.size(); ++i) {
+    const bool flush = i == frames.size();
+    EXPECT_EQ(vpx_codec_decode(
+                  &dec, flush ? NULL : &frames[i][0],
+                  flush ? 0 : static_cast<unsigned int>(frames[i].size()),
+                  NULL, 0),
+              VPX_CODEC_OK);
+    if (!flush) {
+      if (timing) {
+        EXPECT_EQ(vpx_codec_control(&dec, VP9D_GET_FRAME_TIMING, &frame_timing),
+                  VPX_CODEC_OK);
+        CheckTiming(frame_timing, mode.threads == 1 || mode.frame_parallel);
+      } else {
+        EXPECT_EQ(vpx_codec_control(&dec, VP9D_GET_FRAME_TIMING, &frame_timing),
+                  VPX_CODEC_ERROR);
+      }
+    }
+    vpx_codec_iter_t iter = NULL;
+    vpx_image_t *img;
+    while ((img = vpx_codec_get_frame(&dec, &iter)) != NULL) {
+      libvpx_test::MD5 md5;
+      md5.Add(img);
+      md5s.push_back(md5.Get());
+    }
+  }
+  EXPECT_EQ(vpx_codec_control(&dec, VP9D_GET_FRAME_TIMING, NULL),
+            VPX_CODEC_INVALID_PARAM);
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+  return md5s;
+}
+
+// Timing each frame reports sensible stage times and leaves the output
+// unchanged, with every decoding mode.
+TEST(VP9FrameTimingTest, DecodeModes) {
+  static const DecodeMode kModes[] = {
+    { 1, 0, 0, 0 }, { 1, 1, 0, 0 }, { 4, 0, 0, 0 },
+    { 4, 0, 1, 0 }, { 4, 1, 0, 0 }, { 4, 0, 0, 1 },
+  };
+  std::vector<Frame> frames;
+
+  ASSERT_NO_FATAL_FAILURE(Encode(&frames));
+  ASSERT_EQ(static_cast<int>(frames.size()), kNumFrames);
+
+  for (size_t i = 0; i < sizeof(kModes) / sizeof(kModes[0]); ++i) {
+    SCOPED_TRACE(i);
+    const std::vector<std::string> expected_md5 =
+        Decode(frames, kModes[i], false);
+    ASSERT_EQ(static_cast<int>(expected_md5.size()), kNumFrames);
+    EXPECT_EQ(Decode(frames, kModes[i], true), expected_md5);
+  }
+}
+
+#endif  // CONFIG_VP9_DECODER && CONFIG_VP9_ENCODER
+
+}  // namespace
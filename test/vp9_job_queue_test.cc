@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "vp9/decoder/vp9_job_queue.h"
+#include "vpx_ports/vpx_timer.h"
+#include "vpx_util/vpx_thread.h"
+
+namespace {
+
+#if CONFIG_MULTITHREAD
+
+// Same size as the decoder's Job.
+struct TestJob {
+  int producer;
+  int seq;
+  int pad;
+};
+
+struct ProducerData {
+  JobQueueRowMt *jobq;
+  int producer;
+  int num_jobs;
+};
+
+struct ConsumerData {
+  JobQueueRowMt *jobq;
+  std::vector<TestJob> jobs;
+};
+
+int ProducerHook(void *arg1, void * /*arg2*/) {
+  ProducerData *const data = reinterpret_cast<ProducerData *>(arg1);
+  for (int i = 0; i < data->num_jobs; ++i) {
+    TestJob job = { data->producer, i, 0 };
+    if (vp9_jobq_queue(data->jobq, &job, sizeof(job))) return 0;
+  }
+  return 1;
+}
+
+int ConsumerHook(void *arg1, void * /*arg2*/) {
+  ConsumerData *const data = reinterpret_cast<ConsumerData *>(arg1);
+  TestJob job;
+  while (!vp9_jobq_dequeue(data->jobq, &job, sizeof(job), 1)) {
+    data->jobs.push_back(job);
+  }
+  return 1;
+}
+
+// Each thread queues a job and then takes one, the way row decode workers
+// queue follow-up jobs, until num_jobs jobs went through the queue.
+struct BenchData {
+  JobQueueRowMt *jobq;
+  int num_jobs;
+};
+
+int BenchHook(void *arg1, void * /*arg2*/) {
+  BenchData *const data = reinterpret_cast<BenchData *>(arg1);
+  TestJob job = { 0, 0, 0 };
+  for (int i = 0; i < data->num_jobs; ++i) {
+    if (vp9_jobq_queue(data->jobq, &job, sizeof(job))) return 0;
+    if (vp9_jobq_dequeue(data->jobq, &job, sizeof(job), 1)) return 0;
+  }
+  return 1;
+}
+
+class VP9JobQueueTest : public ::testing::TestWithParam<int> {
+ protected:
+  virtual void SetUp() {
+    num_threads_ = GetParam();
+    workers_.resize(num_threads_ * 2);
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      vpx_get_worker_interface()->init(&workers_[i]);
+      ASSERT_NE(vpx_get_worker_interface()->reset(&workers_[i]), 0);
+    }
+  }
+
+  virtual void TearDown() {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      vpx_get_worker_interface()->end(&workers_[i]);
+    }
+  }
+
+  void InitQueue(int num_jobs) {
+    buf_.resize(num_jobs * sizeof(TestJob));
+    ASSERT_EQ(vp9_jobq_init(&jobq_, &buf_[0], buf_.size()), 0);
+  }
+
+  void Launch(int i, VPxWorkerHook hook, void *data) {
+    workers_[i].hook = hook;
+    workers_[i].data1 = data;
+    workers_[i].data2 = NULL;
+    vpx_get_worker_interface()->launch(&workers_[i]);
+  }
+
+  int Sync(int i) { return vpx_get_worker_interface()->sync(&workers_[i]); }
+
+  int num_threads_;
+  std::vector<VPxWorker> workers_;
+  std::vector<uint8_t> buf_;
+  JobQueueRowMt jobq_;
+};
+
+TEST_P(VP9JobQueueTest, EveryJobDequeuedOnce) {
+  const int kJobsPerProducer = 20000;
+  InitQueue(num_threads_ * kJobsPerProducer);
+
+  std::vector<ConsumerData> consumers(num_threads_);
+  std::vector<ProducerData> producers(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    consumers[i].jobq = &jobq_;
+    Launch(num_threads_ + i, ConsumerHook, &consumers[i]);
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    producers[i].jobq = &jobq_;
+    producers[i].producer = i;
+    producers[i].num_jobs = kJobsPerProducer;
+    Launch(i, ProducerHook, &producers[i]);
+  }
+  for (int i = 0; i < num_threads_; ++i) EXPECT_NE(Sync(i), 0);
+  vp9_jobq_terminate(&jobq_);
+  for (int i = 0; i < num_threads_; ++i) EXPECT_NE(Sync(num_threads_ + i), 0);
+
+  std::vector<int> seen(num_threads_ * kJobsPerProducer, 0);
+  for (int i = 0; i < num_threads_; ++i) {
+    // Jobs from one producer are dequeued in the order they were queued.
+    std::vector<int> last_seq(num_threads_, -1);
+    for (size_t j = 0; j < consumers[i].jobs.size(); ++j) {
+      const TestJob &job = consumers[i].jobs[j];
+      ASSERT_GE(job.producer, 0);
+      ASSERT_LT(job.producer, num_threads_);
+      ASSERT_GT(job.seq, last_seq[job.producer]);
+      last_seq[job.producer] = job.seq;
+      ++seen[job.producer * kJobsPerProducer + job.seq];
+    }
+  }
+  for (size_t i = 0; i < seen.size(); ++i) ASSERT_EQ(seen[i], 1) << i;
+
+  vp9_jobq_deinit(&jobq_);
+}
+
+INSTANTIATE_TEST_CASE_P(VP9, VP9JobQueueTest, ::testing::Values(1, 2, 4, 8));
+
+TEST(VP9JobQueueBasicTest, DequeueAfterReset) {
+  uint8_t buf[4 * sizeof(TestJob)];
+  JobQueueRowMt jobq;
+  TestJob job = { 1, 2, 3 };
+  TestJob out;
+
+  ASSERT_EQ(vp9_jobq_init(&jobq, buf, sizeof(buf)), 0);
+  EXPECT_NE(vp9_jobq_dequeue(&jobq, &out, sizeof(out), 0), 0);
+  EXPECT_EQ(vp9_jobq_queue(&jobq, &job, sizeof(job)), 0);
+  vp9_jobq_terminate(&jobq);
+  EXPECT_EQ(vp9_jobq_dequeue(&jobq, &out, sizeof(out), 1), 0);
+  EXPECT_EQ(out.seq, 2);
+  EXPECT_NE(vp9_jobq_dequeue(&jobq, &out, sizeof(out), 1), 0);
+
+  vp9_jobq_reset(&jobq);
+  EXPECT_NE(vp9_jobq_dequeue(&jobq, &out, sizeof(out), 0), 0);
+  EXPECT_EQ(vp9_jobq_queue(&jobq, &job, sizeof(job)), 0);
+  EXPECT_EQ(vp9_jobq_dequeue(&jobq, &out, sizeof(out), 0), 0);
+  EXPECT_EQ(out.producer, 1);
+  vp9_jobq_deinit(&jobq);
+}
+
+TEST(VP9JobQueueSpeedTest, DISABLED_Speed) {
+  const int kNumJobs = 1 << 20;
+  const int kThreads[] = { 1, 2, 4, 8, 16, 32, 64 };
+  std::vector<uint8_t> buf(kNumJobs * sizeof(TestJob));
+
+  for (size_t t = 0; t < sizeof(kThreads) / sizeof(kThreads[0]); ++t) {
+    const int num_threads = kThreads[t];
+    JobQueueRowMt jobq;
+    std::vector<VPxWorker> workers(num_threads);
+    std::vector<BenchData> data(num_threads);
+    vpx_usec_timer timer;
+
+    ASSERT_EQ(vp9_jobq_init(&jobq, &buf[0], buf.size()), 0);
+    for (int i = 0; i < num_threads; ++i) {
+      vpx_get_worker_interface()->init(&workers[i]);
+      ASSERT_NE(vpx_get_worker_interface()->reset(&workers[i]), 0);
+      data[i].jobq = &jobq;
+      data[i].num_jobs = kNumJobs / num_threads;
+      workers[i].hook = BenchHook;
+      workers[i].data1 = &data[i];
+      workers[i].data2 = NULL;
+    }
+
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < num_threads; ++i) {
+      vpx_get_worker_interface()->launch(&workers[i]);
+    }
+    for (int i = 0; i < num_threads; ++i) {
+      EXPECT_NE(vpx_get_worker_interface()->sync(&workers[i]), 0);
+    }
+    vpx_usec_timer_mark(&timer);
+
+    const int64_t elapsed_time = vpx_usec_timer_elapsed(&timer);
+    const int num_jobs = data[0].num_jobs * num_threads;
+    printf("%2d threads: %8.0f jobs/sec (%d jobs in %d us)\n", num_threads,
+           num_jobs * 1000000.0 / (elapsed_time > 0 ? elapsed_time : 1),
+           num_jobs, static_cast<int>(elapsed_time));
+
+    for (int i = 0; i < num_threads; ++i) {
+      vpx_get_worker_interface()->end(&workers[i]);
+    }
+    vp9_jobq_deinit(&jobq);
+  }
+}
+
+#endif  // CONFIG_MULTITHREAD
+
+}  // namespace
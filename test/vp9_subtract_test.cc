@@ -8,6 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cstring>
+#include <tuple>
+
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vp9_rtcd.h"
@@ -18,8 +21,9 @@
 #include "test/clear_system_state.h"
 #include "test/register_state_check.h"
 #include "vp9/common/vp9_blockd.h"
-#include "vpx_ports/msvc.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/msvc.h"
 
 typedef void (*SubtractFunc)(int rows, int cols, int16_t *diff_ptr,
                              ptrdiff_t diff_stride, const uint8_t *src_ptr,
@@ -133,6 +137,10 @@ INSTANTIATE_TEST_CASE_P(C, VP9SubtractBlockTest,
 INSTANTIATE_TEST_CASE_P(SSE2, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_sse2));
 #endif
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9SubtractBlockTest,
+                        ::testing::Values(vpx_subtract_block_avx2));
+#endif
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(NEON, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_neon));
@@ -152,4 +160,74 @@ INSTANTIATE_TEST_CASE_P(VSX, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_vsx));
 #endif
 
+#if !CONFIG_VP9_HIGHBITDEPTH
+typedef void (*SubtractFdctFunc)(int16_t *diff_ptr, ptrdiff_t diff_stride,
+                                 const uint8_t *src_ptr, ptrdiff_t src_stride,
+                                 const uint8_t *pred_ptr,
+                                 ptrdiff_t pred_stride, tran_low_t *output);
+typedef void (*FdctFunc)(const int16_t *input, tran_low_t *output, int stride);
+typedef std::tuple<SubtractFdctFunc, FdctFunc> SubtractFdctParam;
+
+// Checks a fused subtract and 32x32 forward transform against
+// vpx_subtract_block_c followed by the C transform.
+class VP9SubtractFdct32x32Test
+    : public ::testing::TestWithParam<SubtractFdctParam> {
+ public:
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+};
+
+TEST_P(VP9SubtractFdct32x32Test, MatchesReference) {
+  const int kStride = 64;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const SubtractFdctFunc subtract_fdct = std::get<0>(GetParam());
+  const FdctFunc ref_fdct = std::get<1>(GetParam());
+  DECLARE_ALIGNED(16, uint8_t, src[32 * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, pred[32 * kStride]);
+  DECLARE_ALIGNED(16, int16_t, diff[32 * kStride]);
+  DECLARE_ALIGNED(16, int16_t, ref_diff[32 * kStride]);
+  DECLARE_ALIGNED(16, tran_low_t, output[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_output[32 * 32]);
+
+  for (int n = 0; n < 1000; ++n) {
+    // Alternate between random residuals and the largest ones.
+    for (int i = 0; i < 32 * kStride; ++i) {
+      if (n % 4 == 3) {
+        src[i] = (n & 4) ? 255 : 0;
+        pred[i] = (n & 4) ? 0 : 255;
+      } else {
+        src[i] = rnd.Rand8();
+        pred[i] = rnd.Rand8();
+      }
+    }
+    memset(diff, 0, sizeof(diff));
+    memset(ref_diff, 0, sizeof(ref_diff));
+
+    vpx_subtract_block_c(32, 32, ref_diff, kStride, src, kStride, pred,
+                         kStride);
+    ref_fdct(ref_diff, ref_output, kStride);
+    ASM_REGISTER_STATE_CHECK(
+        subtract_fdct(diff, kStride, src, kStride, pred, kStride, output));
+
+    ASSERT_EQ(0, memcmp(ref_diff, diff, sizeof(diff)))
+        << "residual mismatch in iteration " << n;
+    ASSERT_EQ(0, memcmp(ref_output, output, sizeof(output)))
+        << "coefficient mismatch in iteration " << n;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    C, VP9SubtractFdct32x32Test,
+    ::testing::Values(
+        std::make_tuple(&vpx_subtract_fdct32x32_c, &vpx_fdct32x32_c),
+        std::make_tuple(&vpx_subtract_fdct32x32_rd_c, &vpx_fdct32x32_rd_c)));
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9SubtractFdct32x32Test,
+    ::testing::Values(
+        std::make_tuple(&vpx_subtract_fdct32x32_avx2, &vpx_fdct32x32_c),
+        std::make_tuple(&vpx_subtract_fdct32x32_rd_avx2,
+                        &vpx_fdct32x32_rd_c)));
+#endif  // HAVE_AVX2
+#endif  // !CONFIG_VP9_HIGHBITDEPTH
 }  // namespace vp9
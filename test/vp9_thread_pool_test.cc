@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+#if CONFIG_MULTITHREAD && CONFIG_VP9_DECODER
+
+const int kWidth = 640;
+const int kHeight = 360;
+const int kNumFrames = 8;
+const int kPoolThreads = 2;
+
+typedef std::vector<uint8_t> Frame;
+
+// Number of threads in the process, or -1 where it can't be told.
+int NumProcessThreads() {
+#if defined(__linux__)
+  FILE *const file = fopen("/proc/self/status", "r");
+  char line[256];
+  int threads = -1;
+  if (file == NULL) return -1;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (sscanf(line, "Threads: %d", &threads) == 1) break;
+  }
+  fclose(file);
+  return threads;
+#else
+  return -1;
+#endif
+}
+
+void FillImage(vpx_image_t *img, int frame) {
+  for (int plane = 0; plane < 3; ++plane) {
+    const int w = plane ? (img->d_w + 1) >> 1 : img->d_w;
+    const int h = plane ? (img->d_h + 1) >> 1 : img->d_h;
+    for (int y = 0; y < h; ++y) {
+      uint8_t *const row = img->planes[plane] + y * img->stride[plane];
+      for (int x = 0; x < w; ++x) {
+        row[x] = static_cast<uint8_t>((x * (plane + 1) + y * 3 + frame * 4) ^
+                                      ((x >> 4) * (y >> 4)));
+      }
+    }
+  }
+}
+
+// Encodes kNumFrames frames with two tile columns, appending one packet per
+// frame to frames. If max_process_threads is positive, checks the process
+// does not run more threads than that while the encoder exists.
+void Encode(int threads, int max_process_threads, std::vector<Frame> *frames) {
+  vpx_codec_ctx_t enc;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+
+  ASSERT_EQ(vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_threads = threads;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 1000;
+  ASSERT_EQ(vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 1), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_ROW_MT, 1), VPX_CODEC_OK);
+  ASSERT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 16) !=
+              NULL);
+
+  for (int i = 0; i <= kNumFrames; ++i) {
+    if (i < kNumFrames) FillImage(&img, i);
+    ASSERT_EQ(vpx_codec_encode(&enc, i < kNumFrames ? &img : NULL, i, 1, 0,
+                               VPX_DL_REALTIME),
+              VPX_CODEC_OK);
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      frames->push_back(Frame(buf, buf + pkt->data.frame.sz));
+    }
+  }
+
+  if (max_process_threads > 0) {
+    EXPECT_LE(NumProcessThreads(), max_process_threads);
+  }
+  vpx_img_free(&img);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+// Decodes frame into dec and returns the md5 of the output.
+std::string DecodeFrame(vpx_codec_ctx_t *dec, const Frame &frame) {
+  libvpx_test::MD5 md5;
+  if (vpx_codec_decode(dec, &frame[0], static_cast<unsigned int>(frame.size()),
+                       NULL, 0) != VPX_CODEC_OK) {
+    return "decode error";
+  }
+  vpx_codec_iter_t iter = NULL;
+  vpx_image_t *img;
+  while ((img = vpx_codec_get_frame(dec, &iter)) != NULL) md5.Add(img);
+  return md5.Get();
+}
+
+TEST(VP9ThreadPoolTest, InvalidParams) {
+  EXPECT_EQ(vpx_codec_thread_pool_init(0), VPX_CODEC_INVALID_PARAM);
+  ASSERT_EQ(vpx_codec_thread_pool_init(1), VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_thread_pool_init(1), VPX_CODEC_INVALID_PARAM);
+  vpx_codec_thread_pool_destroy();
+  vpx_codec_thread_pool_destroy();
+}
+
+// Many multi-threaded decoders sharing the pool use no more than the pool's
+// threads and decode the same frames as a decoder with its own threads.
+TEST(VP9ThreadPoolTest, ManyDecoders) {
+  const int kNumDecoders = 32;
+  std::vector<Frame> frames;
+  std::vector<std::string> expected_md5;
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  cfg.threads = 4;
+
+  ASSERT_NO_FATAL_FAILURE(Encode(1, 0, &frames));
+  ASSERT_EQ(static_cast<int>(frames.size()), kNumFrames);
+  {
+    vpx_codec_ctx_t dec;
+    ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+              VPX_CODEC_OK);
+    for (int i = 0; i < kNumFrames; ++i) {
+      expected_md5.push_back(DecodeFrame(&dec, frames[i]));
+    }
+    EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+  }
+
+  const int base_threads = NumProcessThreads();
+  ASSERT_EQ(vpx_codec_thread_pool_init(kPoolThreads), VPX_CODEC_OK);
+
+  std::vector<vpx_codec_ctx_t> decoders(kNumDecoders);
+  for (int d = 0; d < kNumDecoders; ++d) {
+    ASSERT_EQ(vpx_codec_dec_init(&decoders[d], &vpx_codec_vp9_dx_algo, &cfg, 0),
+              VPX_CODEC_OK);
+    // Alternate between the tile and row based decoders.
+    ASSERT_EQ(vpx_codec_control(&decoders[d], VP9D_SET_ROW_MT, d & 1),
+              VPX_CODEC_OK);
+    ASSERT_EQ(vpx_codec_control(&decoders[d], VP9D_SET_LOOP_FILTER_OPT, 1),
+              VPX_CODEC_OK);
+  }
+  for (int i = 0; i < kNumFrames; ++i) {
+    for (int d = 0; d < kNumDecoders; ++d) {
+      ASSERT_EQ(DecodeFrame(&decoders[d], frames[i]), expected_md5[i])
+          << "decoder " << d << " frame " << i;
+    }
+    if (base_threads > 0) {
+      EXPECT_LE(NumProcessThreads(), base_threads + kPoolThreads);
+    }
+  }
+  for (int d = 0; d < kNumDecoders; ++d) {
+    EXPECT_EQ(vpx_codec_destroy(&decoders[d]), VPX_CODEC_OK);
+  }
+
+  vpx_codec_thread_pool_destroy();
+}
+
+// A multi-threaded encoder sharing the pool produces a decodable stream
+// without starting threads of its own.
+TEST(VP9ThreadPoolTest, Encoder) {
+  std::vector<Frame> frames;
+  const int base_threads = NumProcessThreads();
+
+  ASSERT_EQ(vpx_codec_thread_pool_init(kPoolThreads), VPX_CODEC_OK);
+  ASSERT_NO_FATAL_FAILURE(Encode(
+      4, base_threads > 0 ? base_threads + kPoolThreads : 0, &frames));
+  vpx_codec_thread_pool_destroy();
+
+  ASSERT_EQ(static_cast<int>(frames.size()), kNumFrames);
+  vpx_codec_ctx_t dec;
+  vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+  ASSERT_EQ(vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, &cfg, 0),
+            VPX_CODEC_OK);
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_NE(DecodeFrame(&dec, frames[i]), "decode error") << "frame " << i;
+  }
+  EXPECT_EQ(vpx_codec_destroy(&dec), VPX_CODEC_OK);
+}
+
+#endif  // CONFIG_MULTITHREAD && CONFIG_VP9_DECODER
+
+}  // namespace
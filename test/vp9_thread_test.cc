@@ -153,14 +153,17 @@ struct FileList {
   const char *expected_md5;
 };
 
-// Decodes |filename| with |num_threads|. Returns the md5 of the decoded frames.
-string DecodeFile(const string &filename, int num_threads) {
+// Decodes |filename| with |num_threads|, using frame parallel decoding if
+// |frame_parallel| is set. Returns the md5 of the decoded frames.
+string DecodeFile(const string &filename, int num_threads,
+                  bool frame_parallel = false) {
   libvpx_test::WebMVideoSource video(filename);
   video.Init();
 
   vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
   cfg.threads = num_threads;
   libvpx_test::VP9Decoder decoder(cfg, 0);
+  if (frame_parallel) decoder.Control(VP9D_SET_FRAME_PARALLEL, 1);
 
   libvpx_test::MD5 md5;
   for (video.Begin(); video.cxdata(); video.Next()) {
@@ -179,6 +182,14 @@ string DecodeFile(const string &filename, int num_threads) {
       md5.Add(img);
     }
   }
+
+  // Flush the frames still being decoded in frame parallel mode.
+  EXPECT_EQ(VPX_CODEC_OK, decoder.DecodeFrame(NULL, 0));
+  libvpx_test::DxDataIterator dec_iter = decoder.GetDxData();
+  const vpx_image_t *img = NULL;
+  while ((img = dec_iter.Next())) {
+    md5.Add(img);
+  }
   return string(md5.Get());
 }
 
@@ -188,6 +199,8 @@ void DecodeFiles(const FileList files[]) {
     for (int t = 1; t <= 8; ++t) {
       EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t))
           << "threads = " << t;
+      EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t, true))
+          << "threads = " << t << ", frame parallel";
     }
   }
 }
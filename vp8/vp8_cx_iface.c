@@ -1303,6 +1303,7 @@ CODEC_INTERFACE(vpx_codec_vp8_cx) = {
       NULL, /* vpx_codec_decode_fn_t     decode; */
       NULL, /* vpx_codec_frame_get_fn_t  frame_get; */
       NULL, /* vpx_codec_set_fb_fn_t     set_fb_fn; */
+      NULL, /* vpx_codec_decode_async_fn_t decode_async; */
   },
   {
       1,                  /* 1 cfg map */
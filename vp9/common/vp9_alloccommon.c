@@ -82,6 +82,8 @@ void vp9_free_ref_frame_buffers(BufferPool *pool) {
     }
     vpx_free(pool->frame_bufs[i].mvs);
     pool->frame_bufs[i].mvs = NULL;
+    vpx_free(pool->frame_bufs[i].seg_map);
+    pool->frame_bufs[i].seg_map = NULL;
     vpx_free_frame_buffer(&pool->frame_bufs[i].buf);
   }
 }
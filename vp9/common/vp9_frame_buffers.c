@@ -11,14 +11,17 @@
 #include <assert.h>
 
 #include "vp9/common/vp9_frame_buffers.h"
+#include "vp9/common/vp9_onyxc_int.h"
 #include "vpx_mem/vpx_mem.h"
 
 int vp9_alloc_internal_frame_buffers(InternalFrameBufferList *list) {
   assert(list != NULL);
   vp9_free_internal_frame_buffers(list);
 
+  // Enough buffers for every slot of the BufferPool, which includes the frames
+  // in flight in frame parallel decode.
   list->num_internal_frame_buffers =
-      VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
+      VPXMAX(VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS, FRAME_BUFFERS);
   list->int_fb = (InternalFrameBuffer *)vpx_calloc(
       list->num_internal_frame_buffers, sizeof(*list->int_fb));
   return (list->int_fb == NULL);
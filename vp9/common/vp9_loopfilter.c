@@ -371,6 +371,109 @@ static void filter_selectively_vert_row2(
   }
 }
 
+// The vertical edges of a 64x64 superblock can also be filtered a column at a
+// time, as rows are filtered independently and only the left to right order
+// within a row matters. Down a column, runs of 4 blocks with the same filter
+// and level are then filtered 32 rows at a time by the _quad functions. Only
+// x86 has _quad versions, so where the _dual functions have NEON or MIPS
+// versions pairs of _dual calls are used instead.
+#define USE_LPF_QUAD !(HAVE_NEON || HAVE_DSPR2 || HAVE_MSA)
+
+typedef void (*lpf_func)(uint8_t *s, int pitch, const uint8_t *blimit,
+                         const uint8_t *limit, const uint8_t *thresh);
+typedef void (*dual_lpf_func)(uint8_t *s, int pitch, const uint8_t *blimit0,
+                              const uint8_t *limit0, const uint8_t *thresh0,
+                              const uint8_t *blimit1, const uint8_t *limit1,
+                              const uint8_t *thresh1);
+
+// Gather the bits of column c of an 8x8 mask, one per row.
+static INLINE unsigned int column_mask(uint64_t mask, int c) {
+  unsigned int m = 0;
+  int r;
+  for (r = 0; r < MI_BLOCK_SIZE; ++r) {
+    m |= (unsigned int)((mask >> (r * MI_BLOCK_SIZE + c)) & 1) << r;
+  }
+  return m;
+}
+
+// Filter the 16-wide edges down a column. Rows are paired as in
+// filter_selectively_vert_row2(), where a _dual call uses the level of its
+// first row for both.
+static void filter_vert_column_16(uint8_t *s, int pitch, unsigned int mask,
+                                  const loop_filter_thresh *lfthr,
+                                  const uint8_t *lfl) {
+  int r;
+  for (r = 0; mask; r += 2, mask >>= 2) {
+    const loop_filter_thresh *lfi = lfthr + lfl[r << 3];
+    uint8_t *const d = s + r * 8 * pitch;
+
+    if (USE_LPF_QUAD && (mask & 0xf) == 0xf &&
+        lfl[r << 3] == lfl[(r + 2) << 3]) {
+      vpx_lpf_vertical_16_quad(d, pitch, lfi->mblim, lfi->lim, lfi->hev_thr);
+      r += 2;
+      mask >>= 2;
+    } else if ((mask & 3) == 3) {
+      vpx_lpf_vertical_16_dual(d, pitch, lfi->mblim, lfi->lim, lfi->hev_thr);
+    } else if (mask & 1) {
+      vpx_lpf_vertical_16(d, pitch, lfi->mblim, lfi->lim, lfi->hev_thr);
+    } else if (mask & 2) {
+      lfi = lfthr + lfl[(r + 1) << 3];
+      vpx_lpf_vertical_16(d + 8 * pitch, pitch, lfi->mblim, lfi->lim,
+                          lfi->hev_thr);
+    }
+  }
+}
+
+// Filter the 8 or 4-wide edges down a column.
+static void filter_vert_column(uint8_t *s, int pitch, unsigned int mask,
+                               const loop_filter_thresh *lfthr,
+                               const uint8_t *lfl, lpf_func lpf,
+                               dual_lpf_func lpf_dual, lpf_func lpf_quad) {
+  int r;
+  for (r = 0; mask; r += 2, mask >>= 2) {
+    const loop_filter_thresh *lfi0 = lfthr + lfl[r << 3];
+    const loop_filter_thresh *lfi1 = lfthr + lfl[(r + 1) << 3];
+    uint8_t *const d = s + r * 8 * pitch;
+
+    if (USE_LPF_QUAD && (mask & 0xf) == 0xf && lfi0 == lfi1 &&
+        lfl[r << 3] == lfl[(r + 2) << 3] && lfl[r << 3] == lfl[(r + 3) << 3]) {
+      lpf_quad(d, pitch, lfi0->mblim, lfi0->lim, lfi0->hev_thr);
+      r += 2;
+      mask >>= 2;
+    } else if ((mask & 3) == 3) {
+      lpf_dual(d, pitch, lfi0->mblim, lfi0->lim, lfi0->hev_thr, lfi1->mblim,
+               lfi1->lim, lfi1->hev_thr);
+    } else if (mask & 1) {
+      lpf(d, pitch, lfi0->mblim, lfi0->lim, lfi0->hev_thr);
+    } else if (mask & 2) {
+      lpf(d + 8 * pitch, pitch, lfi1->mblim, lfi1->lim, lfi1->hev_thr);
+    }
+  }
+}
+
+// Filter all the vertical edges of a 64x64 luma superblock, one column of
+// 8x8 blocks at a time. The output matches filter_selectively_vert_row2().
+static void filter_selectively_vert_sb(uint8_t *s, int pitch,
+                                       uint64_t mask_16x16, uint64_t mask_8x8,
+                                       uint64_t mask_4x4, uint64_t mask_4x4_int,
+                                       const loop_filter_thresh *lfthr,
+                                       const uint8_t *lfl) {
+  int c;
+  for (c = 0; c < MI_BLOCK_SIZE; ++c) {
+    uint8_t *const d = s + c * 8;
+    filter_vert_column_16(d, pitch, column_mask(mask_16x16, c), lfthr, lfl + c);
+    filter_vert_column(d, pitch, column_mask(mask_8x8, c), lfthr, lfl + c,
+                       vpx_lpf_vertical_8, vpx_lpf_vertical_8_dual,
+                       vpx_lpf_vertical_8_quad);
+    filter_vert_column(d, pitch, column_mask(mask_4x4, c), lfthr, lfl + c,
+                       vpx_lpf_vertical_4, vpx_lpf_vertical_4_dual,
+                       vpx_lpf_vertical_4_quad);
+    filter_vert_column(d + 4, pitch, column_mask(mask_4x4_int, c), lfthr,
+                       lfl + c, vpx_lpf_vertical_4, vpx_lpf_vertical_4_dual,
+                       vpx_lpf_vertical_4_quad);
+  }
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 static void highbd_filter_selectively_vert_row2(
     int subsampling_factor, uint16_t *s, int pitch, unsigned int mask_16x16,
@@ -1251,31 +1354,34 @@ void vp9_filter_block_plane_ss00(VP9_COMMON *const cm,
 
   assert(plane->subsampling_x == 0 && plane->subsampling_y == 0);
 
-  // Vertical pass: do 2 rows at one time
-  for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 2) {
 #if CONFIG_VP9_HIGHBITDEPTH
-    if (cm->use_highbitdepth) {
+  if (cm->use_highbitdepth) {
+    // Vertical pass: do 2 rows at one time
+    for (r = 0; r < MI_BLOCK_SIZE && mi_row + r < cm->mi_rows; r += 2) {
       // Disable filtering on the leftmost column.
       highbd_filter_selectively_vert_row2(
           plane->subsampling_x, CONVERT_TO_SHORTPTR(dst->buf), dst->stride,
           (unsigned int)mask_16x16, (unsigned int)mask_8x8,
           (unsigned int)mask_4x4, (unsigned int)mask_4x4_int, cm->lf_info.lfthr,
           &lfm->lfl_y[r << 3], (int)cm->bit_depth);
-    } else {
-#endif  // CONFIG_VP9_HIGHBITDEPTH
-      // Disable filtering on the leftmost column.
-      filter_selectively_vert_row2(
-          plane->subsampling_x, dst->buf, dst->stride, (unsigned int)mask_16x16,
-          (unsigned int)mask_8x8, (unsigned int)mask_4x4,
-          (unsigned int)mask_4x4_int, cm->lf_info.lfthr, &lfm->lfl_y[r << 3]);
-#if CONFIG_VP9_HIGHBITDEPTH
+      dst->buf += 16 * dst->stride;
+      mask_16x16 >>= 16;
+      mask_8x8 >>= 16;
+      mask_4x4 >>= 16;
+      mask_4x4_int >>= 16;
     }
+  } else
 #endif  // CONFIG_VP9_HIGHBITDEPTH
-    dst->buf += 16 * dst->stride;
-    mask_16x16 >>= 16;
-    mask_8x8 >>= 16;
-    mask_4x4 >>= 16;
-    mask_4x4_int >>= 16;
+  {
+    // Vertical pass: a column at a time, covering rows in pairs as
+    // filter_selectively_vert_row2() does.
+    const int rows = VPXMIN(MI_BLOCK_SIZE, (cm->mi_rows - mi_row + 1) & ~1);
+    const uint64_t rows_mask =
+        rows < MI_BLOCK_SIZE ? ((uint64_t)1 << (rows << 3)) - 1 : ~0ULL;
+    filter_selectively_vert_sb(dst->buf, dst->stride, mask_16x16 & rows_mask,
+                               mask_8x8 & rows_mask, mask_4x4 & rows_mask,
+                               mask_4x4_int & rows_mask, cm->lf_info.lfthr,
+                               lfm->lfl_y);
   }
 
   // Horizontal pass
@@ -13,6 +13,7 @@
 
 #include "./vpx_config.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_util/vpx_atomics.h"
 #include "vpx_util/vpx_thread.h"
 #include "./vp9_rtcd.h"
 #include "vp9/common/vp9_alloccommon.h"
@@ -37,9 +38,14 @@ extern "C" {
 #define REF_FRAMES_LOG2 3
 #define REF_FRAMES (1 << REF_FRAMES_LOG2)
 
+// Maximum number of frames decoded concurrently in frame parallel mode.
+#define MAX_FRAME_WORKERS 4
+
 // 1 scratch frame for the new frame, REFS_PER_FRAME for scaled references on
-// the encoder.
-#define FRAME_BUFFERS (REF_FRAMES + 1 + REFS_PER_FRAME)
+// the encoder. In frame parallel decode each frame worker holds one frame
+// being decoded and one decoded frame waiting to be output.
+#define FRAME_BUFFERS \
+  (REF_FRAMES + 1 + REFS_PER_FRAME + 2 * MAX_FRAME_WORKERS)
 
 #define FRAME_CONTEXTS_LOG2 2
 #define FRAME_CONTEXTS (1 << FRAME_CONTEXTS_LOG2)
@@ -72,6 +78,17 @@ typedef struct {
   int frame_index;
   vpx_codec_frame_buffer_t raw_frame_buffer;
   YV12_BUFFER_CONFIG buf;
+
+  // Segmentation map of this frame. Only used in frame parallel decode, where
+  // the map must outlive the decoder instance that produced it.
+  uint8_t *seg_map;
+
+#if CONFIG_MULTITHREAD
+  // Number of luma pixel rows, from the top, that are fully decoded and loop
+  // filtered. Only used in frame parallel decode. INT_MAX once the whole
+  // frame is done.
+  vpx_atomic_int row;
+#endif
 } RefCntBuffer;
 
 typedef struct BufferPool {
@@ -85,6 +102,14 @@ typedef struct BufferPool {
 
   // Frame buffers allocated internally by the codec.
   InternalFrameBufferList int_frame_buffers;
+
+#if CONFIG_MULTITHREAD
+  // Protects the reference counts and the frame buffer callbacks when several
+  // decoder instances share the pool in frame parallel decode.
+  pthread_mutex_t pool_mutex;
+  // Signaled when a frame buffer's decoding progress (row) advances.
+  pthread_cond_t progress_cond;
+#endif
 } BufferPool;
 
 typedef struct VP9Common {
@@ -117,7 +142,6 @@ typedef struct VP9Common {
   int ref_frame_map[REF_FRAMES]; /* maps fb_idx to reference slot */
 
   // Prepare ref_frame_map for the next frame.
-  // Only used in frame parallel decode.
   int next_ref_frame_map[REF_FRAMES];
 
   // TODO(jkoleszar): could expand active_ref_idx to 4, with 0 as intra, and
@@ -240,8 +264,14 @@ typedef struct VP9Common {
   int error_resilient_mode;
   int frame_parallel_decoding_mode;
 
+  // Decoder only: several frames are decoded concurrently, each by its own
+  // decoder instance sharing the BufferPool.
+  int frame_parallel_decode;
+
   int log2_tile_cols, log2_tile_rows;
   int byte_alignment;
+  // Decoder only: alignment of the plane strides, 0 for the default.
+  int stride_alignment;
   int skip_loop_filter;
 
   // External BufferPool passed from outside.
@@ -299,6 +329,22 @@ static INLINE YV12_BUFFER_CONFIG *get_frame_new_buffer(VP9_COMMON *cm) {
   return &cm->buffer_pool->frame_bufs[cm->new_fb_idx].buf;
 }
 
+static INLINE void lock_buffer_pool(BufferPool *const pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->pool_mutex);
+#else
+  (void)pool;
+#endif
+}
+
+static INLINE void unlock_buffer_pool(BufferPool *const pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&pool->pool_mutex);
+#else
+  (void)pool;
+#endif
+}
+
 static INLINE int get_free_fb(VP9_COMMON *cm) {
   RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
   int i;
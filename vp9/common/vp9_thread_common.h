@@ -38,6 +38,7 @@ typedef struct VP9LfSyncData {
   LFWorkerData *lfdata;
   int num_workers;         // number of allocated workers.
   int num_active_workers;  // number of scheduled workers.
+  int next_mi_row;         // next row to hand out to a loopfilter worker.
 
 #if CONFIG_MULTITHREAD
   pthread_mutex_t *lf_mutex;
@@ -21,6 +21,7 @@
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
 #include "vpx_ports/mem_ops.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/vpx_scale.h"
 #include "vpx_util/vpx_thread.h"
 #if CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
@@ -45,6 +46,7 @@
 #include "vp9/decoder/vp9_decodemv.h"
 #include "vp9/decoder/vp9_decoder.h"
 #include "vp9/decoder/vp9_dsubexp.h"
+#include "vp9/decoder/vp9_dthread.h"
 #include "vp9/decoder/vp9_job_queue.h"
 
 #define MAX_VP9_HEADER_SIZE 80
@@ -55,6 +57,25 @@ typedef int (*predict_recon_func)(TileWorkerData *twd, MODE_INFO *const mi,
 typedef void (*intra_recon_func)(TileWorkerData *twd, MODE_INFO *const mi,
                                  int plane, int row, int col, TX_SIZE tx_size);
 
+// Stage timing, see VP9D_SET_FRAME_TIMING. The time stamps are only taken
+// when enabled is set.
+static INLINE int64_t stage_start(int enabled) {
+  return enabled ? vpx_nsec_timestamp() : 0;
+}
+
+static INLINE void stage_end(int enabled, int64_t start, int64_t *stage_time) {
+  if (enabled) *stage_time += vpx_nsec_timestamp() - start;
+}
+
+static void add_stage_times(VP9StageTimes *dst, const VP9StageTimes *src) {
+  dst->parse += src->parse;
+  dst->recon += src->recon;
+  dst->inverse_transform += src->inverse_transform;
+  dst->inter_pred += src->inter_pred;
+  dst->loop_filter += src->loop_filter;
+  dst->thread_wait += src->thread_wait;
+}
+
 static int read_is_valid(const uint8_t *start, size_t len, const uint8_t *end) {
   return len != 0 && len <= (size_t)(end - start);
 }
@@ -312,13 +333,18 @@ static void predict_and_reconstruct_intra_block(TileWorkerData *twd,
   struct macroblockd_plane *const pd = &xd->plane[plane];
   PREDICTION_MODE mode = (plane == 0) ? mi->mode : mi->uv_mode;
   uint8_t *dst;
+  int64_t start;
   dst = &pd->dst.buf[4 * row * pd->dst.stride + 4 * col];
 
   if (mi->sb_type < BLOCK_8X8)
     if (plane == 0) mode = xd->mi[0]->bmi[(row << 1) + col].as_mode;
 
+  // Intra prediction is only timed here, where it can't be told apart from
+  // parsing at the superblock level.
+  start = stage_start(twd->time_stages);
   vp9_predict_intra_block(xd, pd->n4_wl, tx_size, mode, dst, pd->dst.stride,
                           dst, pd->dst.stride, col, row, plane);
+  stage_end(twd->time_stages, start, &twd->stage_times.recon);
 
   if (!mi->skip) {
     const TX_TYPE tx_type =
@@ -329,8 +355,10 @@ static void predict_and_reconstruct_intra_block(TileWorkerData *twd,
     const int eob = vp9_decode_block_tokens(twd, plane, sc, col, row, tx_size,
                                             mi->segment_id);
     if (eob > 0) {
+      start = stage_start(twd->time_stages);
       inverse_transform_block_intra(xd, plane, tx_type, tx_size, dst,
                                     pd->dst.stride, eob);
+      stage_end(twd->time_stages, start, &twd->stage_times.inverse_transform);
     }
   }
 }
@@ -379,8 +407,10 @@ static void predict_and_reconstruct_intra_block_row_mt(TileWorkerData *twd,
     const TX_TYPE tx_type =
         (plane || xd->lossless) ? DCT_DCT : intra_mode_to_tx_type_lookup[mode];
     if (*pd->eob > 0) {
+      const int64_t start = stage_start(twd->time_stages);
       inverse_transform_block_intra(xd, plane, tx_type, tx_size, dst,
                                     pd->dst.stride, *pd->eob);
+      stage_end(twd->time_stages, start, &twd->stage_times.inverse_transform);
     }
     /* Keep the alignment to 16 */
     pd->dqcoeff += (16 << (tx_size << 1));
@@ -399,7 +429,9 @@ static int reconstruct_inter_block(TileWorkerData *twd, MODE_INFO *const mi,
   uint8_t *dst = &pd->dst.buf[4 * row * pd->dst.stride + 4 * col];
 
   if (eob > 0) {
+    const int64_t start = stage_start(twd->time_stages);
     inverse_transform_block_inter(xd, plane, tx_size, dst, pd->dst.stride, eob);
+    stage_end(twd->time_stages, start, &twd->stage_times.inverse_transform);
   }
 #if CONFIG_MISMATCH_DEBUG
   {
@@ -443,9 +475,11 @@ static int reconstruct_inter_block_row_mt(TileWorkerData *twd,
 
   (void)mi;
   if (eob > 0) {
+    const int64_t start = stage_start(twd->time_stages);
     inverse_transform_block_inter(
         xd, plane, tx_size, &pd->dst.buf[4 * row * pd->dst.stride + 4 * col],
         pd->dst.stride, eob);
+    stage_end(twd->time_stages, start, &twd->stage_times.inverse_transform);
   }
   pd->dqcoeff += (16 << (tx_size << 1));
   pd->eob++;
@@ -574,11 +608,11 @@ static void extend_and_predict(TileWorkerData *twd, const uint8_t *buf_ptr1,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
 static void dec_build_inter_predictors(
-    TileWorkerData *twd, MACROBLOCKD *xd, int plane, int bw, int bh, int x,
-    int y, int w, int h, int mi_x, int mi_y, const InterpKernel *kernel,
-    const struct scale_factors *sf, struct buf_2d *pre_buf,
-    struct buf_2d *dst_buf, const MV *mv, RefCntBuffer *ref_frame_buf,
-    int is_scaled, int ref) {
+    TileWorkerData *twd, VP9Decoder *const pbi, MACROBLOCKD *xd, int plane,
+    int bw, int bh, int x, int y, int w, int h, int mi_x, int mi_y,
+    const InterpKernel *kernel, const struct scale_factors *sf,
+    struct buf_2d *pre_buf, struct buf_2d *dst_buf, const MV *mv,
+    RefCntBuffer *ref_frame_buf, int is_scaled, int ref) {
   struct macroblockd_plane *const pd = &xd->plane[plane];
   uint8_t *const dst = dst_buf->buf + dst_buf->stride * y + x;
   MV32 scaled_mv;
@@ -651,6 +685,15 @@ static void dec_build_inter_predictors(
   x0_16 += scaled_mv.col;
   y0_16 += scaled_mv.row;
 
+  if (pbi->common.frame_parallel_decode) {
+    // Wait until the rows read by the interpolation filter, including the
+    // ones used by border extension, are final in the reference frame.
+    const int y1 =
+        ((y0_16 + (h - 1) * ys) >> SUBPEL_BITS) + 1 + VP9_INTERP_EXTEND;
+    vp9_frameworker_wait(pbi->common.buffer_pool, ref_frame_buf,
+                         VPXMAX(0, y1 + 1) << pd->subsampling_y);
+  }
+
   // Get reference block pointer.
   buf_ptr = ref_frame + y0 * pre_buf->stride + x0;
   buf_stride = pre_buf->stride;
@@ -755,10 +798,10 @@ static void dec_build_inter_predictors_sb(TileWorkerData *twd,
         for (y = 0; y < num_4x4_h; ++y) {
           for (x = 0; x < num_4x4_w; ++x) {
             const MV mv = average_split_mvs(pd, mi, ref, i++);
-            dec_build_inter_predictors(twd, xd, plane, n4w_x4, n4h_x4, 4 * x,
-                                       4 * y, 4, 4, mi_x, mi_y, kernel, sf,
-                                       pre_buf, dst_buf, &mv, ref_frame_buf,
-                                       is_scaled, ref);
+            dec_build_inter_predictors(
+                twd, pbi, xd, plane, n4w_x4, n4h_x4, 4 * x, 4 * y, 4, 4, mi_x,
+                mi_y, kernel, sf, pre_buf, dst_buf, &mv, ref_frame_buf,
+                is_scaled, ref);
           }
         }
       }
@@ -772,9 +815,10 @@ static void dec_build_inter_predictors_sb(TileWorkerData *twd,
         const int n4w_x4 = 4 * num_4x4_w;
         const int n4h_x4 = 4 * num_4x4_h;
         struct buf_2d *const pre_buf = &pd->pre[ref];
-        dec_build_inter_predictors(twd, xd, plane, n4w_x4, n4h_x4, 0, 0, n4w_x4,
-                                   n4h_x4, mi_x, mi_y, kernel, sf, pre_buf,
-                                   dst_buf, &mv, ref_frame_buf, is_scaled, ref);
+        dec_build_inter_predictors(twd, pbi, xd, plane, n4w_x4, n4h_x4, 0, 0,
+                                   n4w_x4, n4h_x4, mi_x, mi_y, kernel, sf,
+                                   pre_buf, dst_buf, &mv, ref_frame_buf,
+                                   is_scaled, ref);
       }
     }
   }
@@ -964,7 +1008,9 @@ static void decode_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
     }
   } else {
     // Prediction
+    const int64_t start = stage_start(twd->time_stages);
     dec_build_inter_predictors_sb(twd, pbi, xd, mi_row, mi_col);
+    stage_end(twd->time_stages, start, &twd->stage_times.inter_pred);
 #if CONFIG_MISMATCH_DEBUG
     {
       int plane;
@@ -1048,7 +1094,9 @@ static void recon_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
                         predict_and_reconstruct_intra_block_row_mt);
   } else {
     // Prediction
+    const int64_t start = stage_start(twd->time_stages);
     dec_build_inter_predictors_sb(twd, pbi, xd, mi_row, mi_col);
+    stage_end(twd->time_stages, start, &twd->stage_times.inter_pred);
 
     // Reconstruction
     if (!mi->skip) {
@@ -1167,6 +1215,18 @@ static PARTITION_TYPE read_partition(TileWorkerData *twd, int mi_row,
   return p;
 }
 
+// Splits the time taken by decode_partition() on a superblock row, which
+// interleaves parsing and reconstruction, between the two stages. before holds
+// the stage times from when the row was started at start.
+static void end_single_pass_stages(TileWorkerData *twd, int64_t start,
+                                   const VP9StageTimes *before) {
+  VP9StageTimes *const times = &twd->stage_times;
+  if (!twd->time_stages) return;
+  times->recon += times->inverse_transform - before->inverse_transform +
+                  times->inter_pred - before->inter_pred;
+  times->parse += vpx_nsec_timestamp() - start - (times->recon - before->recon);
+}
+
 // TODO(slavarnway): eliminate bsize and subsize in future commits
 static void decode_partition(TileWorkerData *twd, VP9Decoder *const pbi,
                              int mi_row, int mi_col, BLOCK_SIZE bsize,
@@ -1472,6 +1532,11 @@ static void resize_mv_buffer(VP9_COMMON *cm) {
   CHECK_MEM_ERROR(cm, cm->cur_frame->mvs,
                   (MV_REF *)vpx_calloc(cm->mi_rows * cm->mi_cols,
                                        sizeof(*cm->cur_frame->mvs)));
+  if (cm->frame_parallel_decode) {
+    vpx_free(cm->cur_frame->seg_map);
+    CHECK_MEM_ERROR(cm, cm->cur_frame->seg_map,
+                    (uint8_t *)vpx_calloc(cm->mi_rows * cm->mi_cols, 1));
+  }
 }
 
 static void resize_context_buffers(VP9_COMMON *cm, int width, int height) {
@@ -1512,6 +1577,12 @@ static void resize_context_buffers(VP9_COMMON *cm, int width, int height) {
   }
 }
 
+// Alignment of the Y plane stride that also aligns the chroma plane stride,
+// half of it with horizontal subsampling, to cm->stride_alignment.
+static int get_stride_alignment(const VP9_COMMON *cm) {
+  return cm->stride_alignment ? cm->stride_alignment << cm->subsampling_x : 32;
+}
+
 static void setup_frame_size(VP9_COMMON *cm, struct vpx_read_bit_buffer *rb) {
   int width, height;
   BufferPool *const pool = cm->buffer_pool;
@@ -1519,18 +1590,22 @@ static void setup_frame_size(VP9_COMMON *cm, struct vpx_read_bit_buffer *rb) {
   resize_context_buffers(cm, width, height);
   setup_render_size(cm, rb);
 
-  if (vpx_realloc_frame_buffer(
+  lock_buffer_pool(pool);
+  if (vpx_realloc_frame_buffer_aligned(
           get_frame_new_buffer(cm), cm->width, cm->height, cm->subsampling_x,
           cm->subsampling_y,
 #if CONFIG_VP9_HIGHBITDEPTH
           cm->use_highbitdepth,
 #endif
           VP9_DEC_BORDER_IN_PIXELS, cm->byte_alignment,
+          get_stride_alignment(cm),
           &pool->frame_bufs[cm->new_fb_idx].raw_frame_buffer, pool->get_fb_cb,
           pool->cb_priv)) {
+    unlock_buffer_pool(pool);
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate frame buffer");
   }
+  unlock_buffer_pool(pool);
 
   pool->frame_bufs[cm->new_fb_idx].released = 0;
   pool->frame_bufs[cm->new_fb_idx].buf.subsampling_x = cm->subsampling_x;
@@ -1603,18 +1678,22 @@ static void setup_frame_size_with_refs(VP9_COMMON *cm,
   resize_context_buffers(cm, width, height);
   setup_render_size(cm, rb);
 
-  if (vpx_realloc_frame_buffer(
+  lock_buffer_pool(pool);
+  if (vpx_realloc_frame_buffer_aligned(
           get_frame_new_buffer(cm), cm->width, cm->height, cm->subsampling_x,
           cm->subsampling_y,
 #if CONFIG_VP9_HIGHBITDEPTH
           cm->use_highbitdepth,
 #endif
           VP9_DEC_BORDER_IN_PIXELS, cm->byte_alignment,
+          get_stride_alignment(cm),
           &pool->frame_bufs[cm->new_fb_idx].raw_frame_buffer, pool->get_fb_cb,
           pool->cb_priv)) {
+    unlock_buffer_pool(pool);
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate frame buffer");
   }
+  unlock_buffer_pool(pool);
 
   pool->frame_bufs[cm->new_fb_idx].released = 0;
   pool->frame_bufs[cm->new_fb_idx].buf.subsampling_x = cm->subsampling_x;
@@ -1775,10 +1854,17 @@ static void vp9_jobq_alloc(VP9Decoder *pbi) {
   const size_t jobq_size = (tile_cols * sb_rows * 2 + sb_rows) * sizeof(Job);
 
   if (jobq_size > row_mt_worker_data->jobq_size) {
+    if (row_mt_worker_data->jobq_size > 0) {
+      vp9_jobq_deinit(&row_mt_worker_data->jobq);
+      row_mt_worker_data->jobq_size = 0;
+    }
     vpx_free(row_mt_worker_data->jobq_buf);
     CHECK_MEM_ERROR(cm, row_mt_worker_data->jobq_buf, vpx_calloc(1, jobq_size));
-    vp9_jobq_init(&row_mt_worker_data->jobq, row_mt_worker_data->jobq_buf,
-                  jobq_size);
+    if (vp9_jobq_init(&row_mt_worker_data->jobq, row_mt_worker_data->jobq_buf,
+                      jobq_size)) {
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "Failed to allocate row mt job queue");
+    }
     row_mt_worker_data->jobq_size = jobq_size;
   }
 }
@@ -1890,6 +1976,17 @@ static void parse_tile_row(TileWorkerData *tile_data, VP9Decoder *pbi,
   }
 }
 
+static int dequeue_job(ThreadData *const thread_data, Job *job) {
+  RowMTWorkerData *const row_mt_worker_data =
+      thread_data->pbi->row_mt_worker_data;
+  const int timing = thread_data->pbi->frame_timing;
+  const int64_t start = stage_start(timing);
+  const int ret =
+      vp9_jobq_dequeue(&row_mt_worker_data->jobq, job, sizeof(*job), 1);
+  stage_end(timing, start, &thread_data->stage_times.thread_wait);
+  return ret;
+}
+
 static int row_decode_worker_hook(void *arg1, void *arg2) {
   ThreadData *const thread_data = (ThreadData *)arg1;
   uint8_t **data_end = (uint8_t **)arg2;
@@ -1906,7 +2003,7 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
   volatile int corrupted = 0;
   TileWorkerData *volatile tile_data_recon = NULL;
 
-  while (!vp9_jobq_dequeue(&row_mt_worker_data->jobq, &job, sizeof(job), 1)) {
+  while (!dequeue_job(thread_data, &job)) {
     int mi_col;
     const int mi_row = job.row_num;
 
@@ -1916,15 +2013,22 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
 
       if (cm->lf.filter_level && !cm->skip_loop_filter &&
           mi_row < cm->mi_rows) {
+        const int64_t start = stage_start(pbi->frame_timing);
         vp9_loopfilter_job(lf_data, lf_sync);
+        stage_end(pbi->frame_timing, start,
+                  &thread_data->stage_times.loop_filter);
       }
     } else if (job.job_type == RECON_JOB) {
       const int cur_sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
       const int is_last_row = sb_rows - 1 == cur_sb_row;
       int mi_col_start, mi_col_end;
-      if (!tile_data_recon)
+      int64_t start;
+      if (!tile_data_recon) {
         CHECK_MEM_ERROR(cm, tile_data_recon,
                         vpx_memalign(32, sizeof(TileWorkerData)));
+        tile_data_recon->time_stages = pbi->frame_timing;
+        vp9_zero(tile_data_recon->stage_times);
+      }
 
       tile_data_recon->xd = pbi->mb;
       vp9_tile_init(&tile_data_recon->xd.tile, cm, 0, job.tile_col);
@@ -1951,8 +2055,11 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
       tile_data_recon->error_info.setjmp = 1;
       tile_data_recon->xd.error_info = &tile_data_recon->error_info;
 
+      start = stage_start(tile_data_recon->time_stages);
       recon_tile_row(tile_data_recon, pbi, mi_row, is_last_row, lf_sync,
                      job.tile_col);
+      stage_end(tile_data_recon->time_stages, start,
+                &tile_data_recon->stage_times.recon);
 
       if (corrupted)
         vpx_internal_error(&tile_data_recon->error_info,
@@ -1964,6 +2071,7 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
       }
     } else if (job.job_type == PARSE_JOB) {
       TileWorkerData *const tile_data = &pbi->tile_worker_data[job.tile_col];
+      int64_t start;
 
       if (setjmp(tile_data->error_info.jmp)) {
         tile_data->error_info.setjmp = 0;
@@ -1978,7 +2086,9 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
 
       tile_data->error_info.setjmp = 1;
 
+      start = stage_start(tile_data->time_stages);
       parse_tile_row(tile_data, pbi, mi_row, job.tile_col, data_end);
+      stage_end(tile_data->time_stages, start, &tile_data->stage_times.parse);
 
       corrupted |= tile_data->xd.corrupted;
       if (corrupted)
@@ -2007,10 +2117,29 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
     }
   }
 
+  if (tile_data_recon != NULL && tile_data_recon->time_stages) {
+    add_stage_times(&thread_data->stage_times, &tile_data_recon->stage_times);
+  }
   vpx_free(tile_data_recon);
   return !corrupted;
 }
 
+static int loop_filter_worker_hook(void *arg1, void *arg2) {
+  VP9Decoder *const pbi = (VP9Decoder *)arg2;
+  const int64_t start = stage_start(pbi->frame_timing);
+  vp9_loop_filter_worker(arg1, NULL);
+  stage_end(pbi->frame_timing, start, &pbi->lf_worker_times.loop_filter);
+  return 1;
+}
+
+// Waits for worker, counting the time waited as thread wait.
+static int sync_worker(VP9Decoder *pbi, VPxWorker *worker) {
+  const int64_t start = stage_start(pbi->frame_timing);
+  const int ret = vpx_get_worker_interface()->sync(worker);
+  stage_end(pbi->frame_timing, start, &pbi->frame_times.thread_wait);
+  return ret;
+}
+
 static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end) {
   VP9_COMMON *const cm = &pbi->common;
@@ -2027,7 +2156,8 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
       pbi->lf_worker.data1 == NULL) {
     CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
                     vpx_memalign(32, sizeof(LFWorkerData)));
-    pbi->lf_worker.hook = vp9_loop_filter_worker;
+    pbi->lf_worker.hook = loop_filter_worker_hook;
+    pbi->lf_worker.data2 = pbi;
     if (pbi->max_threads > 1 && !winterface->reset(&pbi->lf_worker)) {
       vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                          "Loop filter thread creation failed");
@@ -2038,6 +2168,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
     // Be sure to sync as we might be resuming after a failed frame decode.
     winterface->sync(&pbi->lf_worker);
+    vp9_zero(pbi->lf_worker_times);
     vp9_loop_filter_data_reset(lf_data, get_frame_new_buffer(cm), cm,
                                pbi->mb.plane);
   }
@@ -2066,6 +2197,8 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
       tile_data->xd.corrupted = 0;
       tile_data->xd.counts =
           cm->frame_parallel_decoding_mode ? NULL : &cm->counts;
+      tile_data->time_stages = pbi->frame_timing;
+      vp9_zero(tile_data->stage_times);
       vp9_zero(tile_data->dqcoeff);
       vp9_tile_init(&tile_data->xd.tile, cm, tile_row, tile_col);
       setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
@@ -2083,10 +2216,14 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
       for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
         const int col =
             pbi->inv_tile_order ? tile_cols - tile_col - 1 : tile_col;
+        int64_t start;
+        VP9StageTimes before;
         tile_data = pbi->tile_worker_data + tile_cols * tile_row + col;
         vp9_tile_set_col(&tile, cm, col);
         vp9_zero(tile_data->xd.left_context);
         vp9_zero(tile_data->xd.left_seg_context);
+        start = stage_start(tile_data->time_stages);
+        before = tile_data->stage_times;
         for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
              mi_col += MI_BLOCK_SIZE) {
           if (pbi->row_mt == 1) {
@@ -2098,8 +2235,11 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                   row_mt_worker_data->dqcoeff[plane];
             }
             tile_data->xd.partition = row_mt_worker_data->partition;
+            start = stage_start(tile_data->time_stages);
             process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
                               PARSE, parse_block);
+            stage_end(tile_data->time_stages, start,
+                      &tile_data->stage_times.parse);
 
             for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
               tile_data->xd.plane[plane].eob = row_mt_worker_data->eob[plane];
@@ -2107,12 +2247,16 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                   row_mt_worker_data->dqcoeff[plane];
             }
             tile_data->xd.partition = row_mt_worker_data->partition;
+            start = stage_start(tile_data->time_stages);
             process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
                               RECON, recon_block);
+            stage_end(tile_data->time_stages, start,
+                      &tile_data->stage_times.recon);
           } else {
             decode_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4);
           }
         }
+        if (pbi->row_mt != 1) end_single_pass_stages(tile_data, start, &before);
         pbi->mb.corrupted |= tile_data->xd.corrupted;
         if (pbi->mb.corrupted)
           vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
@@ -2129,7 +2273,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         // decoding has completed: finish up the loop filter in this thread.
         if (mi_row + MI_BLOCK_SIZE >= cm->mi_rows) continue;
 
-        winterface->sync(&pbi->lf_worker);
+        sync_worker(pbi, &pbi->lf_worker);
         lf_data->start = lf_start;
         lf_data->stop = mi_row;
         if (pbi->max_threads > 1) {
@@ -2137,6 +2281,17 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         } else {
           winterface->execute(&pbi->lf_worker);
         }
+
+        // Filtering the next row may still modify up to 8 luma rows (7 chroma
+        // rows) above mi_row.
+        if (cm->frame_parallel_decode) {
+          assert(pbi->max_threads == 1);
+          vp9_frameworker_broadcast(cm->buffer_pool, cm->cur_frame,
+                                    (mi_row << MI_SIZE_LOG2) - 16);
+        }
+      } else if (cm->frame_parallel_decode) {
+        vp9_frameworker_broadcast(cm->buffer_pool, cm->cur_frame,
+                                  (mi_row + MI_BLOCK_SIZE) << MI_SIZE_LOG2);
       }
     }
   }
@@ -2144,12 +2299,21 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   // Loopfilter remaining rows in the frame.
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
+    sync_worker(pbi, &pbi->lf_worker);
     lf_data->start = lf_data->stop;
     lf_data->stop = cm->mi_rows;
     winterface->execute(&pbi->lf_worker);
   }
 
+  if (pbi->frame_timing) {
+    int n;
+    for (n = 0; n < tile_cols * tile_rows; ++n)
+      add_stage_times(&pbi->frame_times,
+                      &pbi->tile_worker_data[n].stage_times);
+    if (cm->lf.filter_level && !cm->skip_loop_filter)
+      add_stage_times(&pbi->frame_times, &pbi->lf_worker_times);
+  }
+
   // Get last tile data.
   tile_data = pbi->tile_worker_data + tile_cols * tile_rows - 1;
 
@@ -2229,12 +2393,15 @@ static int tile_worker_hook(void *arg1, void *arg2) {
 
     for (mi_row = tile->mi_row_start; mi_row < tile->mi_row_end;
          mi_row += MI_BLOCK_SIZE) {
+      const int64_t start = stage_start(tile_data->time_stages);
+      const VP9StageTimes before = tile_data->stage_times;
       vp9_zero(tile_data->xd.left_context);
       vp9_zero(tile_data->xd.left_seg_context);
       for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
            mi_col += MI_BLOCK_SIZE) {
         decode_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4);
       }
+      end_single_pass_stages(tile_data, start, &before);
       if (pbi->lpf_mt_opt && cm->lf.filter_level && !cm->skip_loop_filter) {
         const int aligned_rows = mi_cols_aligned_to_sb(cm->mi_rows);
         const int sb_rows = (aligned_rows >> MI_BLOCK_SIZE_LOG2);
@@ -2262,7 +2429,10 @@ static int tile_worker_hook(void *arg1, void *arg2) {
 
   if (pbi->lpf_mt_opt && !tile_data->xd.corrupted && cm->lf.filter_level &&
       !cm->skip_loop_filter) {
+    const int64_t start = stage_start(tile_data->time_stages);
     vp9_loopfilter_rows(lf_data, lf_sync);
+    stage_end(tile_data->time_stages, start,
+              &tile_data->stage_times.loop_filter);
   }
 
   tile_data->data_end = bit_reader_end;
@@ -2357,6 +2527,7 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     }
 
     thread_data->pbi = pbi;
+    vp9_zero(thread_data->stage_times);
 
     worker->hook = row_decode_worker_hook;
     worker->data1 = thread_data;
@@ -2368,6 +2539,8 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     tile_data->xd = pbi->mb;
     tile_data->xd.counts =
         cm->frame_parallel_decoding_mode ? NULL : &tile_data->counts;
+    tile_data->time_stages = pbi->frame_timing;
+    vp9_zero(tile_data->stage_times);
   }
 
   /* Reset the jobq to start of the jobq buffer */
@@ -2412,11 +2585,20 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     // its vpx_internal_error_info which could be propagated to the main info
     // in cm. Additionally once the threads have been synced and an error is
     // detected, there's no point in continuing to decode tiles.
-    corrupted |= !winterface->sync(worker);
+    corrupted |= !sync_worker(pbi, worker);
   }
 
   pbi->mb.corrupted = corrupted;
 
+  if (pbi->frame_timing) {
+    for (i = 0; i < tile_cols; ++i)
+      add_stage_times(&pbi->frame_times,
+                      &pbi->tile_worker_data[i].stage_times);
+    for (i = 0; i < num_workers; ++i)
+      add_stage_times(&pbi->frame_times,
+                      &row_mt_worker_data->thread_data[i].stage_times);
+  }
+
   {
     /* Set data end */
     TileWorkerData *const tile_data = &pbi->tile_worker_data[tile_cols - 1];
@@ -2469,6 +2651,8 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
     tile_data->xd = pbi->mb;
     tile_data->xd.counts =
         cm->frame_parallel_decoding_mode ? NULL : &tile_data->counts;
+    tile_data->time_stages = pbi->frame_timing;
+    vp9_zero(tile_data->stage_times);
     worker->hook = tile_worker_hook;
     worker->data1 = tile_data;
     worker->data2 = pbi;
@@ -2546,8 +2730,10 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
       // its vpx_internal_error_info which could be propagated to the main info
       // in cm. Additionally once the threads have been synced and an error is
       // detected, there's no point in continuing to decode tiles.
-      pbi->mb.corrupted |= !winterface->sync(worker);
+      pbi->mb.corrupted |= !sync_worker(pbi, worker);
       if (!bit_reader_end) bit_reader_end = tile_data->data_end;
+      if (tile_data->time_stages)
+        add_stage_times(&pbi->frame_times, &tile_data->stage_times);
     }
   }
 
@@ -2613,6 +2799,20 @@ static void read_bitdepth_colorspace_sampling(VP9_COMMON *cm,
   }
 }
 
+// Drop the reference map's holds on its frame buffers. Used in place of
+// flush_all_fb_on_key() in frame parallel decode, where the other decoder
+// instances hold frame buffers of their own.
+static void release_ref_frame_map(VP9_COMMON *cm) {
+  BufferPool *const pool = cm->buffer_pool;
+  int i;
+
+  lock_buffer_pool(pool);
+  for (i = 0; i < REF_FRAMES; ++i)
+    decrease_ref_count(cm->ref_frame_map[i], pool->frame_bufs, pool);
+  unlock_buffer_pool(pool);
+  memset(&cm->ref_frame_map, -1, sizeof(cm->ref_frame_map));
+}
+
 static INLINE void flush_all_fb_on_key(VP9_COMMON *cm) {
   if (cm->frame_type == KEY_FRAME && cm->current_video_frame > 0) {
     RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
@@ -2659,13 +2859,16 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
   if (cm->show_existing_frame) {
     // Show an existing frame directly.
     const int frame_to_show = cm->ref_frame_map[vpx_rb_read_literal(rb, 3)];
+    lock_buffer_pool(pool);
     if (frame_to_show < 0 || frame_bufs[frame_to_show].ref_count < 1) {
+      unlock_buffer_pool(pool);
       vpx_internal_error(&cm->error, VPX_CODEC_UNSUP_BITSTREAM,
                          "Buffer %d does not contain a decoded frame",
                          frame_to_show);
     }
 
     ref_cnt_fb(frame_bufs, &cm->new_fb_idx, frame_to_show);
+    unlock_buffer_pool(pool);
     pbi->refresh_frame_flags = 0;
     cm->lf.filter_level = 0;
     cm->show_frame = 1;
@@ -2692,8 +2895,12 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
 
     setup_frame_size(cm, rb);
     if (pbi->need_resync) {
-      memset(&cm->ref_frame_map, -1, sizeof(cm->ref_frame_map));
-      flush_all_fb_on_key(cm);
+      if (cm->frame_parallel_decode) {
+        release_ref_frame_map(cm);
+      } else {
+        memset(&cm->ref_frame_map, -1, sizeof(cm->ref_frame_map));
+        flush_all_fb_on_key(cm);
+      }
       pbi->need_resync = 0;
     }
   } else {
@@ -2725,7 +2932,11 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
       pbi->refresh_frame_flags = vpx_rb_read_literal(rb, REF_FRAMES);
       setup_frame_size(cm, rb);
       if (pbi->need_resync) {
-        memset(&cm->ref_frame_map, -1, sizeof(cm->ref_frame_map));
+        if (cm->frame_parallel_decode) {
+          release_ref_frame_map(cm);
+        } else {
+          memset(&cm->ref_frame_map, -1, sizeof(cm->ref_frame_map));
+        }
         pbi->need_resync = 0;
       }
     } else if (pbi->need_resync != 1) { /* Skip if need resync */
@@ -2787,6 +2998,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
   cm->frame_context_idx = vpx_rb_read_literal(rb, FRAME_CONTEXTS_LOG2);
 
   // Generate next_ref_frame_map.
+  lock_buffer_pool(pool);
   for (mask = pbi->refresh_frame_flags; mask; mask >>= 1) {
     if (mask & 1) {
       cm->next_ref_frame_map[ref_index] = cm->new_fb_idx;
@@ -2806,6 +3018,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
     if (cm->ref_frame_map[ref_index] >= 0)
       ++frame_bufs[cm->ref_frame_map[ref_index]].ref_count;
   }
+  unlock_buffer_pool(pool);
   pbi->hold_ref_buf = 1;
 
   if (frame_is_intra_only(cm) || cm->error_resilient_mode)
@@ -2905,6 +3118,30 @@ static int read_compressed_header(VP9Decoder *pbi, const uint8_t *data,
   return vpx_reader_has_error(&r);
 }
 
+// In frame parallel decode the segmentation maps live in the frame buffers, so
+// that the next frame, decoded by another decoder instance, can read this
+// frame's map while it is being written.
+static void setup_frame_parallel_seg_map(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+
+  // Cases in which the serial decoder clears last_frame_seg_map, either in
+  // vp9_setup_past_independence() or on a change of frame size.
+  if (pbi->last_seg_map_buf != NULL &&
+      (frame_is_intra_only(cm) || cm->error_resilient_mode ||
+       cm->width != cm->last_width || cm->height != cm->last_height)) {
+    lock_buffer_pool(pool);
+    decrease_ref_count((int)(pbi->last_seg_map_buf - pool->frame_bufs),
+                       pool->frame_bufs, pool);
+    unlock_buffer_pool(pool);
+    pbi->last_seg_map_buf = NULL;
+  }
+
+  cm->last_frame_seg_map =
+      pbi->last_seg_map_buf != NULL ? pbi->last_seg_map_buf->seg_map : NULL;
+  cm->current_frame_seg_map = cm->cur_frame->seg_map;
+}
+
 static struct vpx_read_bit_buffer *init_read_bit_buffer(
     VP9Decoder *pbi, struct vpx_read_bit_buffer *rb, const uint8_t *data,
     const uint8_t *data_end, uint8_t clear_data[MAX_VP9_HEADER_SIZE]) {
@@ -2951,6 +3188,7 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   struct vpx_read_bit_buffer rb;
   int context_updated = 0;
   uint8_t clear_data[MAX_VP9_HEADER_SIZE];
+  const int64_t frame_start = stage_start(pbi->frame_timing);
   const size_t first_partition_size = read_uncompressed_header(
       pbi, init_read_bit_buffer(pbi, &rb, data, data_end, clear_data));
   const int tile_rows = 1 << cm->log2_tile_rows;
@@ -2964,12 +3202,18 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
 #endif
   xd->cur_buf = new_fb;
 
+  if (pbi->frame_timing) vp9_zero(pbi->frame_times);
+
   if (!first_partition_size) {
     // showing a frame directly
     *p_data_end = data + (cm->profile <= PROFILE_2 ? 1 : 2);
+    stage_end(pbi->frame_timing, frame_start, &pbi->frame_times.header);
+    stage_end(pbi->frame_timing, frame_start, &pbi->frame_times.total);
     return;
   }
 
+  if (cm->frame_parallel_decode) setup_frame_parallel_seg_map(pbi);
+
   data += vpx_rb_bytes_read(&rb);
   if (!read_is_valid(data, first_partition_size, data_end))
     vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
@@ -2992,6 +3236,17 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   if (new_fb->corrupted)
     vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                        "Decode failed. Frame data header is corrupted.");
+  stage_end(pbi->frame_timing, frame_start, &pbi->frame_times.header);
+
+  // Without backward adaptation the frame context is final once the
+  // compressed header has been read, so the next frame can start now.
+  if (cm->frame_parallel_decode &&
+      (cm->frame_parallel_decoding_mode || !cm->refresh_frame_context)) {
+    context_updated = 1;
+    if (cm->refresh_frame_context)
+      cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+    vp9_frameworker_signal_context_ready(pbi);
+  }
 
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     vp9_loop_filter_frame_init(cm, cm->lf.filter_level);
@@ -3023,9 +3278,12 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
           if (!cm->skip_loop_filter) {
             // If multiple threads are used to decode tiles, then we use those
             // threads to do parallel loopfiltering.
+            const int64_t start = stage_start(pbi->frame_timing);
             vp9_loop_filter_frame_mt(
                 new_fb, cm, pbi->mb.plane, cm->lf.filter_level, 0, 0,
                 pbi->tile_workers, pbi->num_tile_workers, &pbi->lf_row_sync);
+            stage_end(pbi->frame_timing, start,
+                      &pbi->frame_times.loop_filter);
           }
         } else {
           vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
@@ -3054,4 +3312,6 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   // Non frame parallel update frame context here.
   if (cm->refresh_frame_context && !context_updated)
     cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+
+  stage_end(pbi->frame_timing, frame_start, &pbi->frame_times.total);
 }
@@ -21,6 +21,7 @@
 
 #include "vp9/decoder/vp9_decodemv.h"
 #include "vp9/decoder/vp9_decodeframe.h"
+#include "vp9/decoder/vp9_dthread.h"
 
 #include "vpx_dsp/vpx_dsp_common.h"
 
@@ -817,6 +818,16 @@ void vp9_read_mode_info(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
   MV_REF *frame_mvs = cm->cur_frame->mvs + mi_row * cm->mi_cols + mi_col;
   int w, h;
 
+  if (cm->frame_parallel_decode) {
+    // The previous frame's motion vectors and the last segmentation map may
+    // still be being written by other decoder instances.
+    const int row = (mi_row + y_mis) << MI_SIZE_LOG2;
+    if (cm->use_prev_frame_mvs)
+      vp9_frameworker_wait(cm->buffer_pool, cm->prev_frame, row);
+    if (cm->seg.enabled && pbi->last_seg_map_buf != NULL)
+      vp9_frameworker_wait(cm->buffer_pool, pbi->last_seg_map_buf, row);
+  }
+
   if (frame_is_intra_only(cm)) {
     read_intra_frame_mode_info(cm, xd, mi_row, mi_col, r, x_mis, y_mis);
   } else {
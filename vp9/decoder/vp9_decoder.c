@@ -35,6 +35,7 @@
 #include "vp9/decoder/vp9_decodeframe.h"
 #include "vp9/decoder/vp9_decoder.h"
 #include "vp9/decoder/vp9_detokenize.h"
+#include "vp9/decoder/vp9_dthread.h"
 
 static void initialize_dec(void) {
   static volatile int init_done = 0;
@@ -231,7 +232,8 @@ void vp9_decoder_remove(VP9Decoder *pbi) {
   if (pbi->row_mt == 1) {
     vp9_dec_free_row_mt_mem(pbi->row_mt_worker_data);
     if (pbi->row_mt_worker_data != NULL) {
-      vp9_jobq_deinit(&pbi->row_mt_worker_data->jobq);
+      if (pbi->row_mt_worker_data->jobq_size > 0)
+        vp9_jobq_deinit(&pbi->row_mt_worker_data->jobq);
       vpx_free(pbi->row_mt_worker_data->jobq_buf);
 #if CONFIG_MULTITHREAD
       pthread_mutex_destroy(&pbi->row_mt_worker_data->recon_done_mutex);
@@ -332,6 +334,7 @@ static void swap_frame_buffers(VP9Decoder *pbi) {
   BufferPool *const pool = cm->buffer_pool;
   RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
 
+  lock_buffer_pool(pool);
   for (mask = pbi->refresh_frame_flags; mask; mask >>= 1) {
     const int old_idx = cm->ref_frame_map[ref_index];
     // Current thread releases the holding of reference frame.
@@ -354,13 +357,40 @@ static void swap_frame_buffers(VP9Decoder *pbi) {
   pbi->hold_ref_buf = 0;
   cm->frame_to_show = get_frame_new_buffer(cm);
 
-  --frame_bufs[cm->new_fb_idx].ref_count;
+  // In frame parallel decode the new frame stays held until the frame worker's
+  // owner has output or dropped it.
+  if (!cm->frame_parallel_decode) --frame_bufs[cm->new_fb_idx].ref_count;
+  unlock_buffer_pool(pool);
 
   // Invalidate these references until the next frame starts.
   for (ref_index = 0; ref_index < 3; ref_index++)
     cm->frame_refs[ref_index].idx = -1;
 }
 
+// Frame parallel decode: drop the holds taken on the previous frame's buffers
+// when the decoder state was copied from the previous frame worker.
+static void release_prev_frame_bufs(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  RefCntBuffer *const frame_bufs = pool->frame_bufs;
+
+  if (pbi->hold_prev_buf) {
+    lock_buffer_pool(pool);
+    if (cm->prev_frame != NULL)
+      decrease_ref_count((int)(cm->prev_frame - frame_bufs), frame_bufs, pool);
+    if (pbi->last_seg_map_buf != NULL)
+      decrease_ref_count((int)(pbi->last_seg_map_buf - frame_bufs), frame_bufs,
+                         pool);
+    unlock_buffer_pool(pool);
+    pbi->hold_prev_buf = 0;
+  }
+
+  // The segmentation maps belong to frame buffers that other decoder instances
+  // may be using. Make sure nothing in this instance writes to them.
+  cm->last_frame_seg_map = NULL;
+  cm->current_frame_seg_map = NULL;
+}
+
 static void release_fb_on_decoder_exit(VP9Decoder *pbi) {
   const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
   VP9_COMMON *volatile const cm = &pbi->common;
@@ -375,9 +405,22 @@ static void release_fb_on_decoder_exit(VP9Decoder *pbi) {
     winterface->sync(&pbi->tile_workers[i]);
   }
 
+  if (cm->frame_parallel_decode) {
+    // The next frame worker may already be decoding from next_ref_frame_map,
+    // so complete the reference update as if the frame had been decoded.
+    if (pbi->hold_ref_buf == 1) {
+      swap_frame_buffers(pbi);
+    } else {
+      memcpy(cm->next_ref_frame_map, cm->ref_frame_map,
+             sizeof(cm->next_ref_frame_map));
+    }
+    return;
+  }
+
   // Release all the reference buffers if worker thread is holding them.
   if (pbi->hold_ref_buf == 1) {
     int ref_index = 0, mask;
+    lock_buffer_pool(pool);
     for (mask = pbi->refresh_frame_flags; mask; mask >>= 1) {
       const int old_idx = cm->ref_frame_map[ref_index];
       // Current thread releases the holding of reference frame.
@@ -395,6 +438,7 @@ static void release_fb_on_decoder_exit(VP9Decoder *pbi) {
       const int old_idx = cm->ref_frame_map[ref_index];
       decrease_ref_count(old_idx, frame_bufs, pool);
     }
+    unlock_buffer_pool(pool);
     pbi->hold_ref_buf = 0;
   }
 }
@@ -425,8 +469,12 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   pbi->ready_for_new_data = 0;
 
+  lock_buffer_pool(pool);
   // Check if the previous frame was a frame without any references to it.
-  if (cm->new_fb_idx >= 0 && frame_bufs[cm->new_fb_idx].ref_count == 0 &&
+  // In frame parallel decode the new frame is released by the frame worker's
+  // owner once it has been output.
+  if (!cm->frame_parallel_decode && cm->new_fb_idx >= 0 &&
+      frame_bufs[cm->new_fb_idx].ref_count == 0 &&
       !frame_bufs[cm->new_fb_idx].released) {
     pool->release_fb_cb(pool->cb_priv,
                         &frame_bufs[cm->new_fb_idx].raw_frame_buffer);
@@ -435,9 +483,15 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   // Find a free frame buffer. Return error if can not find any.
   cm->new_fb_idx = get_free_fb(cm);
+  unlock_buffer_pool(pool);
   if (cm->new_fb_idx == INVALID_IDX) {
     pbi->ready_for_new_data = 1;
     release_fb_on_decoder_exit(pbi);
+    if (cm->frame_parallel_decode) {
+      pbi->need_resync = 1;
+      vp9_frameworker_signal_context_ready(pbi);
+      release_prev_frame_bufs(pbi);
+    }
     vpx_clear_system_state();
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Unable to find free frame buffer");
@@ -449,13 +503,29 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   pbi->hold_ref_buf = 0;
   pbi->cur_buf = &frame_bufs[cm->new_fb_idx];
+  if (cm->frame_parallel_decode)
+    vp9_frameworker_broadcast(pool, cm->cur_frame, -1);
 
   if (setjmp(cm->error.jmp)) {
     cm->error.setjmp = 0;
     pbi->ready_for_new_data = 1;
     release_fb_on_decoder_exit(pbi);
+    // Unblock the frames predicting from this one before the buffer can be
+    // reused.
+    if (cm->frame_parallel_decode) {
+      pbi->cur_buf->buf.corrupted = 1;
+      vp9_frameworker_broadcast(pool, cm->cur_frame, INT_MAX);
+    }
     // Release current frame.
+    lock_buffer_pool(pool);
     decrease_ref_count(cm->new_fb_idx, frame_bufs, pool);
+    unlock_buffer_pool(pool);
+    if (cm->frame_parallel_decode) {
+      // Let the next frame start; it will wait for a key frame.
+      pbi->need_resync = 1;
+      vp9_frameworker_signal_context_ready(pbi);
+      release_prev_frame_bufs(pbi);
+    }
     vpx_clear_system_state();
     return -1;
   }
@@ -467,19 +537,33 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   vpx_clear_system_state();
 
-  if (!cm->show_existing_frame) {
-    cm->last_show_frame = cm->show_frame;
-    cm->prev_frame = cm->cur_frame;
-    if (cm->seg.enabled) vp9_swap_current_and_last_seg_map(cm);
-  }
-
   if (cm->show_frame) cm->cur_show_frame_fb_idx = cm->new_fb_idx;
 
-  // Update progress in frame parallel decode.
-  cm->last_width = cm->width;
-  cm->last_height = cm->height;
-  if (cm->show_frame) {
-    cm->current_video_frame++;
+  if (cm->frame_parallel_decode) {
+    // The decoder state for the next frame is handed over by
+    // vp9_frameworker_copy_context() rather than updated here.
+    if (cm->show_existing_frame) {
+      vp9_frameworker_wait(pool, &frame_bufs[cm->new_fb_idx], INT_MAX);
+    } else {
+      vp9_frameworker_broadcast(pool, cm->cur_frame, INT_MAX);
+    }
+    // Signal first: the next frame takes its own hold on the buffers this
+    // frame used as its previous frame when it repeats an existing frame.
+    vp9_frameworker_signal_context_ready(pbi);
+    release_prev_frame_bufs(pbi);
+  } else {
+    if (!cm->show_existing_frame) {
+      cm->last_show_frame = cm->show_frame;
+      cm->prev_frame = cm->cur_frame;
+      if (cm->seg.enabled) vp9_swap_current_and_last_seg_map(cm);
+    }
+
+    // Update progress in frame parallel decode.
+    cm->last_width = cm->width;
+    cm->last_height = cm->height;
+    if (cm->show_frame) {
+      cm->current_video_frame++;
+    }
   }
 
   cm->error.setjmp = 0;
@@ -33,10 +33,24 @@ extern "C" {
 
 typedef enum JobType { PARSE_JOB, RECON_JOB, LPF_JOB } JobType;
 
+// Time spent in each stage of decoding a frame, in nanoseconds. See
+// VP9D_SET_FRAME_TIMING.
+typedef struct VP9StageTimes {
+  int64_t total;
+  int64_t header;
+  int64_t parse;
+  int64_t recon;
+  int64_t inverse_transform;  // part of recon
+  int64_t inter_pred;         // part of recon
+  int64_t loop_filter;
+  int64_t thread_wait;
+} VP9StageTimes;
+
 typedef struct ThreadData {
   struct VP9Decoder *pbi;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  VP9StageTimes stage_times;
 } ThreadData;
 
 typedef struct TileBuffer {
@@ -52,6 +66,8 @@ typedef struct TileWorkerData {
   FRAME_COUNTS counts;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  int time_stages;  // accumulate stage_times
+  VP9StageTimes stage_times;
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
   /* dqcoeff are shared by all the planes. So planes must be decoded serially */
   DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
@@ -124,6 +140,18 @@ typedef struct VP9Decoder {
   int row_mt;
   int lpf_mt_opt;
   RowMTWorkerData *row_mt_worker_data;
+
+  // Frame parallel decode.
+  VPxWorker *frame_worker_owner;  // frame worker that owns this decoder.
+  // Frame buffer holding last_frame_seg_map, NULL for an all zero map.
+  RefCntBuffer *last_seg_map_buf;
+  int hold_prev_buf;  // hold cm->prev_frame and last_seg_map_buf.
+
+  // Stage timing. frame_times holds the times of the last frame decoded,
+  // summed over all threads.
+  int frame_timing;
+  VP9StageTimes frame_times;
+  VP9StageTimes lf_worker_times;  // accumulated by lf_worker
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi, size_t size,
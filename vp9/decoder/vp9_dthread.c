@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/decoder/vp9_decoder.h"
+#include "vp9/decoder/vp9_dthread.h"
+
+void vp9_frameworker_wait(BufferPool *const pool, RefCntBuffer *const ref_buf,
+                          int row) {
+#if CONFIG_MULTITHREAD
+  if (vpx_atomic_load_acquire(&ref_buf->row) >= row) return;
+
+  pthread_mutex_lock(&pool->pool_mutex);
+  while (vpx_atomic_load_acquire(&ref_buf->row) < row)
+    pthread_cond_wait(&pool->progress_cond, &pool->pool_mutex);
+  pthread_mutex_unlock(&pool->pool_mutex);
+#else
+  (void)pool;
+  (void)ref_buf;
+  (void)row;
+#endif
+}
+
+void vp9_frameworker_broadcast(BufferPool *const pool, RefCntBuffer *const buf,
+                               int row) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->pool_mutex);
+  vpx_atomic_store_release(&buf->row, row);
+  pthread_cond_broadcast(&pool->progress_cond);
+  pthread_mutex_unlock(&pool->pool_mutex);
+#else
+  (void)pool;
+  (void)buf;
+  (void)row;
+#endif
+}
+
+void vp9_frameworker_signal_context_ready(VP9Decoder *const pbi) {
+  FrameWorkerData *const frame_worker_data =
+      (FrameWorkerData *)pbi->frame_worker_owner->data1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&frame_worker_data->stats_mutex);
+  frame_worker_data->frame_context_ready = 1;
+  pthread_cond_signal(&frame_worker_data->stats_cond);
+  pthread_mutex_unlock(&frame_worker_data->stats_mutex);
+#else
+  frame_worker_data->frame_context_ready = 1;
+#endif
+}
+
+void vp9_frameworker_wait_context_ready(FrameWorkerData *const frame_worker) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&frame_worker->stats_mutex);
+  while (!frame_worker->frame_context_ready)
+    pthread_cond_wait(&frame_worker->stats_cond, &frame_worker->stats_mutex);
+  pthread_mutex_unlock(&frame_worker->stats_mutex);
+#else
+  (void)frame_worker;
+#endif
+}
+
+void vp9_frameworker_signal_decoded(FrameWorkerData *const frame_worker) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&frame_worker->stats_mutex);
+  frame_worker->frame_decoded = 1;
+  pthread_mutex_unlock(&frame_worker->stats_mutex);
+#else
+  frame_worker->frame_decoded = 1;
+#endif
+}
+
+int vp9_frameworker_is_decoded(FrameWorkerData *const frame_worker) {
+  int frame_decoded;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&frame_worker->stats_mutex);
+  frame_decoded = frame_worker->frame_decoded;
+  pthread_mutex_unlock(&frame_worker->stats_mutex);
+#else
+  frame_decoded = frame_worker->frame_decoded;
+#endif
+  return frame_decoded;
+}
+
+void vp9_frameworker_copy_context(VP9Decoder *const dst,
+                                  const VP9Decoder *const src) {
+  VP9_COMMON *const cm = &dst->common;
+  const VP9_COMMON *const src_cm = &src->common;
+  BufferPool *const pool = cm->buffer_pool;
+  // A shown existing frame leaves everything but the output untouched.
+  const int show_existing = src_cm->show_existing_frame;
+
+  lock_buffer_pool(pool);
+  // With a single frame worker dst and src are the same decoder and the
+  // reference map has already been updated by swap_frame_buffers().
+  if (dst != src) {
+    memcpy(cm->ref_frame_map,
+           show_existing ? src_cm->ref_frame_map : src_cm->next_ref_frame_map,
+           sizeof(cm->ref_frame_map));
+  }
+
+  // Hold the buffers providing the previous frame's motion vectors and the
+  // last segmentation map until dst is done with them.
+  cm->prev_frame = show_existing ? src_cm->prev_frame : src_cm->cur_frame;
+  dst->last_seg_map_buf = (show_existing || !src_cm->seg.enabled)
+                              ? src->last_seg_map_buf
+                              : src_cm->cur_frame;
+  if (cm->prev_frame != NULL) ++cm->prev_frame->ref_count;
+  if (dst->last_seg_map_buf != NULL) ++dst->last_seg_map_buf->ref_count;
+  dst->hold_prev_buf = 1;
+  unlock_buffer_pool(pool);
+
+  cm->last_show_frame =
+      show_existing ? src_cm->last_show_frame : src_cm->show_frame;
+  cm->last_width = show_existing ? src_cm->last_width : src_cm->width;
+  cm->last_height = show_existing ? src_cm->last_height : src_cm->height;
+  cm->current_video_frame = src_cm->current_video_frame + src_cm->show_frame;
+  if (dst == src) return;
+
+  cm->frame_type = src_cm->frame_type;
+  cm->intra_only = src_cm->intra_only;
+
+  cm->bit_depth = src_cm->bit_depth;
+#if CONFIG_VP9_HIGHBITDEPTH
+  cm->use_highbitdepth = src_cm->use_highbitdepth;
+#endif
+  cm->subsampling_x = src_cm->subsampling_x;
+  cm->subsampling_y = src_cm->subsampling_y;
+  cm->color_space = src_cm->color_space;
+  cm->color_range = src_cm->color_range;
+
+  cm->seg = src_cm->seg;
+  memcpy(cm->lf.ref_deltas, src_cm->lf.ref_deltas, sizeof(cm->lf.ref_deltas));
+  memcpy(cm->lf.mode_deltas, src_cm->lf.mode_deltas,
+         sizeof(cm->lf.mode_deltas));
+  memcpy(cm->frame_contexts, src_cm->frame_contexts,
+         FRAME_CONTEXTS * sizeof(*cm->frame_contexts));
+
+  dst->need_resync = src->need_resync;
+}
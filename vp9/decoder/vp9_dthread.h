@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_DECODER_VP9_DTHREAD_H_
+#define VPX_VP9_DECODER_VP9_DTHREAD_H_
+
+#include "./vpx_config.h"
+#include "vpx_util/vpx_thread.h"
+#include "vpx/internal/vpx_codec_internal.h"
+
+#include "vp9/common/vp9_onyxc_int.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9Decoder;
+
+// WorkerData for the FrameWorker thread. It contains all the information of
+// the worker and decode structures for decoding a frame.
+typedef struct FrameWorkerData {
+  struct VP9Decoder *pbi;
+  const uint8_t *data;
+  const uint8_t *data_end;
+  size_t data_size;
+  void *user_priv;
+  int result;
+
+  // The frame is the last one of its packet and may be returned to the
+  // application if it is shown.
+  int output_candidate;
+
+  // Copy of the compressed frame. The application's buffer is only valid
+  // during the decode call.
+  uint8_t *scratch_buffer;
+  size_t scratch_buffer_size;
+
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t stats_mutex;
+  pthread_cond_t stats_cond;
+#endif
+
+  // The decoder state needed by the next frame is final.
+  int frame_context_ready;
+
+  // The frame worker is done with the frame.
+  int frame_decoded;
+
+  // Completion callback of the packet passed to vpx_codec_decode_async(), set
+  // on the worker decoding its last frame.
+  vpx_codec_decode_cb_fn_t decode_cb;
+  void *decode_cb_priv;
+} FrameWorkerData;
+
+// Wait until ref_buf has been decoded and loop filtered to at least the given
+// luma pixel row.
+void vp9_frameworker_wait(BufferPool *const pool, RefCntBuffer *const ref_buf,
+                          int row);
+
+// Report that buf has been decoded and loop filtered up to the given luma
+// pixel row. INT_MAX marks the whole frame as done.
+void vp9_frameworker_broadcast(BufferPool *const pool, RefCntBuffer *const buf,
+                               int row);
+
+// Called by the frame worker once the decoder state consumed by the next frame
+// (reference map, entropy contexts, segmentation and loop filter deltas) is
+// final.
+void vp9_frameworker_signal_context_ready(struct VP9Decoder *const pbi);
+
+// Block until the frame worker has signaled its context as ready.
+void vp9_frameworker_wait_context_ready(FrameWorkerData *const frame_worker);
+
+// Called by the frame worker once it is done with the frame.
+void vp9_frameworker_signal_decoded(FrameWorkerData *const frame_worker);
+
+// Returns 1 if the frame worker is done with the frame, without waiting.
+int vp9_frameworker_is_decoded(FrameWorkerData *const frame_worker);
+
+// Start dst's next frame from the state src leaves behind, as if dst decoded
+// src's frame itself. src must have signaled its context as ready and dst must
+// be idle.
+void vp9_frameworker_copy_context(struct VP9Decoder *const dst,
+                                  const struct VP9Decoder *const src);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_DECODER_VP9_DTHREAD_H_
@@ -9,39 +9,56 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include <string.h>
 
 #include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
 
 #include "vp9/decoder/vp9_job_queue.h"
 
-void vp9_jobq_init(JobQueueRowMt *jobq, uint8_t *buf, size_t buf_size) {
+int vp9_jobq_init(JobQueueRowMt *jobq, uint8_t *buf, size_t buf_size) {
+  assert(buf_size <= INT_MAX);
+  jobq->buf_base = buf;
+  jobq->buf_size = (int)buf_size;
 #if CONFIG_MULTITHREAD
+  {
+    // Jobs are at least as large as an int, this covers every job slot.
+    const int num_slots = (int)(buf_size / sizeof(*jobq->ready));
+    int i;
+    jobq->ready =
+        (vpx_atomic_int *)vpx_malloc((num_slots + 1) * sizeof(*jobq->ready));
+    if (jobq->ready == NULL) return 1;
+    for (i = 0; i < num_slots; ++i) vpx_atomic_init(&jobq->ready[i], 0);
+  }
+  jobq->generation = 0;
+  vpx_atomic_init(&jobq->num_waiting, 0);
   pthread_mutex_init(&jobq->mutex, NULL);
   pthread_cond_init(&jobq->cond, NULL);
 #endif
-  jobq->buf_base = buf;
-  jobq->buf_wr = buf;
-  jobq->buf_rd = buf;
-  jobq->buf_end = buf + buf_size;
-  jobq->terminate = 0;
+  vp9_jobq_reset(jobq);
+  return 0;
 }
 
+// Must not be called while other threads are using the queue.
 void vp9_jobq_reset(JobQueueRowMt *jobq) {
 #if CONFIG_MULTITHREAD
-  pthread_mutex_lock(&jobq->mutex);
-#endif
-  jobq->buf_wr = jobq->buf_base;
-  jobq->buf_rd = jobq->buf_base;
+  ++jobq->generation;
+  vpx_atomic_init(&jobq->wr, 0);
+  vpx_atomic_init(&jobq->rd, 0);
+  vpx_atomic_init(&jobq->terminate, 0);
+#else
+  jobq->wr = 0;
+  jobq->rd = 0;
   jobq->terminate = 0;
-#if CONFIG_MULTITHREAD
-  pthread_mutex_unlock(&jobq->mutex);
 #endif
 }
 
 void vp9_jobq_deinit(JobQueueRowMt *jobq) {
   vp9_jobq_reset(jobq);
 #if CONFIG_MULTITHREAD
+  vpx_free(jobq->ready);
+  jobq->ready = NULL;
   pthread_mutex_destroy(&jobq->mutex);
   pthread_cond_destroy(&jobq->cond);
 #endif
@@ -49,76 +66,111 @@ void vp9_jobq_deinit(JobQueueRowMt *jobq) {
 
 void vp9_jobq_terminate(JobQueueRowMt *jobq) {
 #if CONFIG_MULTITHREAD
+  vpx_atomic_store_release(&jobq->terminate, 1);
   pthread_mutex_lock(&jobq->mutex);
-#endif
-  jobq->terminate = 1;
-#if CONFIG_MULTITHREAD
   pthread_cond_broadcast(&jobq->cond);
   pthread_mutex_unlock(&jobq->mutex);
+#else
+  jobq->terminate = 1;
 #endif
 }
 
-int vp9_jobq_queue(JobQueueRowMt *jobq, void *job, size_t job_size) {
-  int ret = 0;
 #if CONFIG_MULTITHREAD
+static INLINE int job_ready(const JobQueueRowMt *jobq, int offset, int size) {
+  return offset <= jobq->buf_size - size &&
+         vpx_atomic_load_acquire(&jobq->ready[offset / size]) ==
+             jobq->generation;
+}
+
+static INLINE void wake_consumer(JobQueueRowMt *jobq) {
   pthread_mutex_lock(&jobq->mutex);
+  pthread_cond_signal(&jobq->cond);
+  pthread_mutex_unlock(&jobq->mutex);
+}
 #endif
-  if (jobq->buf_end >= jobq->buf_wr + job_size) {
-    memcpy(jobq->buf_wr, job, job_size);
-    jobq->buf_wr = jobq->buf_wr + job_size;
+
+int vp9_jobq_queue(JobQueueRowMt *jobq, void *job, size_t job_size) {
 #if CONFIG_MULTITHREAD
-    pthread_cond_signal(&jobq->cond);
-#endif
-    ret = 0;
-  } else {
+  const int size = (int)job_size;
+  const int offset = vpx_atomic_fetch_add(&jobq->wr, size);
+
+  assert(job_size >= sizeof(*jobq->ready));
+  if (offset > jobq->buf_size - size) {
     /* Wrap around case is not supported */
     assert(0);
-    ret = 1;
+    return 1;
   }
-#if CONFIG_MULTITHREAD
-  pthread_mutex_unlock(&jobq->mutex);
+  memcpy(jobq->buf_base + offset, job, job_size);
+  // Producers do not wait for each other: a consumer reaching this slot
+  // before the job is marked ready sleeps until it is.
+  vpx_atomic_store_release(&jobq->ready[offset / size], jobq->generation);
+
+  // The read-modify-write orders this load after the store above, so either
+  // a consumer going to sleep sees the job or it is seen waiting here.
+  if (vpx_atomic_fetch_add(&jobq->num_waiting, 0) > 0) wake_consumer(jobq);
+  return 0;
+#else
+  if (jobq->wr > jobq->buf_size - (int)job_size) {
+    /* Wrap around case is not supported */
+    assert(0);
+    return 1;
+  }
+  memcpy(jobq->buf_base + jobq->wr, job, job_size);
+  jobq->wr += (int)job_size;
+  return 0;
 #endif
-  return ret;
 }
 
 int vp9_jobq_dequeue(JobQueueRowMt *jobq, void *job, size_t job_size,
                      int blocking) {
-  int ret = 0;
 #if CONFIG_MULTITHREAD
-  pthread_mutex_lock(&jobq->mutex);
-#endif
-  if (jobq->buf_end >= jobq->buf_rd + job_size) {
-    while (1) {
-      if (jobq->buf_wr >= jobq->buf_rd + job_size) {
-        memcpy(job, jobq->buf_rd, job_size);
-        jobq->buf_rd = jobq->buf_rd + job_size;
-        ret = 0;
-        break;
-      } else {
-        /* If all the entries have been dequeued, then break and return */
-        if (jobq->terminate == 1) {
-          ret = 1;
-          break;
-        }
-        if (blocking == 1) {
-#if CONFIG_MULTITHREAD
-          pthread_cond_wait(&jobq->cond, &jobq->mutex);
-#endif
-        } else {
-          /* If there is no job available,
-           * and this is non blocking call then return fail */
-          ret = 1;
-          break;
+  const int size = (int)job_size;
+
+  while (1) {
+    // Sample terminate first: all jobs are ready before it is set, so a job
+    // that is not ready afterwards will never be queued.
+    const int terminate = vpx_atomic_load_acquire(&jobq->terminate);
+    const int rd = vpx_atomic_load_acquire(&jobq->rd);
+
+    if (job_ready(jobq, rd, size)) {
+      if (vpx_atomic_compare_exchange(&jobq->rd, rd, rd + size)) {
+        // Jobs are never overwritten before the next reset, so the copy can
+        // be done after the job has been claimed.
+        memcpy(job, jobq->buf_base + rd, job_size);
+        // Jobs may have become ready while the consumer woken for them was
+        // waiting on an earlier slot; hand the next one to a sleeper.
+        if (vpx_atomic_load_acquire(&jobq->num_waiting) > 0 &&
+            job_ready(jobq, rd + size, size)) {
+          wake_consumer(jobq);
         }
+        return 0;
       }
+      continue;
     }
-  } else {
-    /* Wrap around case is not supported */
-    ret = 1;
+
+    /* If all the entries have been dequeued, then break and return */
+    if (terminate) return 1;
+    /* If there is no job available,
+     * and this is non blocking call then return fail */
+    if (!blocking) return 1;
+
+    vpx_atomic_fetch_add(&jobq->num_waiting, 1);
+    pthread_mutex_lock(&jobq->mutex);
+    while (!job_ready(jobq, vpx_atomic_load_acquire(&jobq->rd), size) &&
+           !vpx_atomic_load_acquire(&jobq->terminate)) {
+      pthread_cond_wait(&jobq->cond, &jobq->mutex);
+    }
+    pthread_mutex_unlock(&jobq->mutex);
+    vpx_atomic_fetch_add(&jobq->num_waiting, -1);
   }
-#if CONFIG_MULTITHREAD
-  pthread_mutex_unlock(&jobq->mutex);
+#else
+  (void)blocking;
+  if (jobq->rd > jobq->buf_size - (int)job_size ||
+      jobq->wr < jobq->rd + (int)job_size) {
+    return 1;
+  }
+  memcpy(job, jobq->buf_base + jobq->rd, job_size);
+  jobq->rd += (int)job_size;
+  return 0;
 #endif
-
-  return ret;
 }
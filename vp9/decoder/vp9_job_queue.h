@@ -11,30 +11,56 @@
 #ifndef VPX_VP9_DECODER_VP9_JOB_QUEUE_H_
 #define VPX_VP9_DECODER_VP9_JOB_QUEUE_H_
 
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_util/vpx_atomics.h"
 #include "vpx_util/vpx_thread.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bounded multi-producer, multi-consumer job queue. Jobs are queued and
+// dequeued without taking a lock; the mutex and condition variable are only
+// used to put consumers to sleep while no job is ready. The buffer does not
+// wrap around, it must be large enough to hold every job queued between two
+// resets.
 typedef struct {
   // Pointer to buffer base which contains the jobs
   uint8_t *buf_base;
 
-  // Pointer to current address where new job can be added
-  uint8_t *volatile buf_wr;
+  // Size of the job buffer in bytes
+  int buf_size;
+
+#if CONFIG_MULTITHREAD
+  // One entry per job slot, set to generation once the job has been written
+  vpx_atomic_int *ready;
 
-  // Pointer to current address from where next job can be obtained
-  uint8_t *volatile buf_rd;
+  // Incremented on reset so the ready entries do not need to be cleared
+  int generation;
 
-  // Pointer to end of job buffer
-  uint8_t *buf_end;
+  // Offset where next job can be added
+  vpx_atomic_int wr;
 
-  int terminate;
+  // Offset from where next job can be obtained
+  vpx_atomic_int rd;
+
+  vpx_atomic_int terminate;
+
+  // Number of consumers sleeping, or about to sleep, on cond
+  vpx_atomic_int num_waiting;
 
-#if CONFIG_MULTITHREAD
   pthread_mutex_t mutex;
   pthread_cond_t cond;
+#else
+  int wr;
+  int rd;
+  int terminate;
 #endif
 } JobQueueRowMt;
 
-void vp9_jobq_init(JobQueueRowMt *jobq, uint8_t *buf, size_t buf_size);
+// Returns 0 on success and 1 if memory could not be allocated.
+int vp9_jobq_init(JobQueueRowMt *jobq, uint8_t *buf, size_t buf_size);
 void vp9_jobq_reset(JobQueueRowMt *jobq);
 void vp9_jobq_deinit(JobQueueRowMt *jobq);
 void vp9_jobq_terminate(JobQueueRowMt *jobq);
@@ -42,4 +68,8 @@ int vp9_jobq_queue(JobQueueRowMt *jobq, void *job, size_t job_size);
 int vp9_jobq_dequeue(JobQueueRowMt *jobq, void *job, size_t job_size,
                      int blocking);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // VPX_VP9_DECODER_VP9_JOB_QUEUE_H_
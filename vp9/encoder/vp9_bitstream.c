@@ -1070,11 +1070,13 @@ static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
   memset(cm->above_seg_context, 0,
          sizeof(*cm->above_seg_context) * mi_cols_aligned_to_sb(cm->mi_cols));
 
-  // Encoding tiles in parallel is done only for realtime mode now. In other
-  // modes the speed up is insignificant and requires further testing to ensure
-  // that it does not make the overall process worse in any case.
-  if (cpi->oxcf.mode == REALTIME && cpi->num_workers > 1 && tile_rows == 1 &&
-      tile_cols > 1) {
+  // Encoding tiles in parallel is done only for realtime mode and row based
+  // multi-threading now, where the workers are otherwise idle until the next
+  // frame. In other cases the speed up is insignificant and requires further
+  // testing to ensure that it does not make the overall process worse in any
+  // case.
+  if ((cpi->oxcf.mode == REALTIME || cpi->row_mt) && cpi->num_workers > 1 &&
+      tile_rows == 1 && tile_cols > 1) {
     return encode_tiles_mt(cpi, data_ptr);
   }
 
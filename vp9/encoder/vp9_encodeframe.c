@@ -5811,6 +5811,13 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, ThreadData *td,
         cpi->count_lastgolden_frame_usage[sboffset] = x->lastgolden_frame_usage;
     }
 
+    // Build the loop filter masks before the rows below may go on, so the
+    // row mt loop filter finds them once the next row is encoded.
+    if (cpi->lpf_mt_opt && cm->lf.filter_level) {
+      vp9_setup_mask(cm, mi_row, mi_col, mi, cm->mi_stride,
+                     get_lfm(&cm->lf, mi_row, mi_col));
+    }
+
     (*(cpi->row_mt_sync_write_ptr))(&tile_data->row_mt_sync, sb_row,
                                     sb_col_in_tile, num_sb_cols);
   }
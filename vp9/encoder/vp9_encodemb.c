@@ -335,6 +335,26 @@ static INLINE void fdct32x32(int rd_transform, const int16_t *src,
     vpx_fdct32x32(src, dst, src_stride);
 }
 
+// Subtract pred from src into diff and transform the residual. Without high
+// bitdepth the two steps are fused, so the residual is not read back.
+static INLINE void subtract_fdct32x32(int rd_transform, int16_t *diff,
+                                      int diff_stride, const uint8_t *src,
+                                      int src_stride, const uint8_t *pred,
+                                      int pred_stride, tran_low_t *dst) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  vpx_subtract_block(32, 32, diff, diff_stride, src, src_stride, pred,
+                     pred_stride);
+  fdct32x32(rd_transform, diff, dst, diff_stride);
+#else
+  if (rd_transform)
+    vpx_subtract_fdct32x32_rd(diff, diff_stride, src, src_stride, pred,
+                              pred_stride, dst);
+  else
+    vpx_subtract_fdct32x32(diff, diff_stride, src, src_stride, pred,
+                           pred_stride, dst);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 static INLINE void highbd_fdct32x32(int rd_transform, const int16_t *src,
                                     tran_low_t *dst, int src_stride) {
@@ -961,9 +981,8 @@ void vp9_encode_block_intra(int plane, int block, int row, int col,
   switch (tx_size) {
     case TX_32X32:
       if (!x->skip_recode) {
-        vpx_subtract_block(32, 32, src_diff, diff_stride, src, src_stride, dst,
-                           dst_stride);
-        fdct32x32(x->use_lp32x32fdct, src_diff, coeff, diff_stride);
+        subtract_fdct32x32(x->use_lp32x32fdct, src_diff, diff_stride, src,
+                           src_stride, dst, dst_stride, coeff);
         vpx_quantize_b_32x32(coeff, 1024, x->skip_block, p->zbin, p->round,
                              p->quant, p->quant_shift, qcoeff, dqcoeff,
                              pd->dequant, eob, scan_order->scan,
@@ -1027,6 +1027,7 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
 #endif
 
   vp9_free_ref_frame_buffers(cm->buffer_pool);
+  for (i = 0; i < FRAME_BUFFERS; ++i) vp9_pyramid_free(&cpi->frame_pyramid[i]);
 #if CONFIG_VP9_POSTPROC
   vp9_free_postproc_buffers(cm);
 #endif
@@ -3293,15 +3294,32 @@ void vp9_update_reference_frames(VP9_COMP *cpi) {
   if (is_one_pass_cbr_svc(cpi)) vp9_svc_update_ref_frame(cpi);
 }
 
+static int is_reference_frame(const VP9_COMP *cpi) {
+  if (cpi->use_svc &&
+      cpi->svc.temporal_layering_mode == VP9E_TEMPORAL_LAYERING_MODE_BYPASS)
+    return !cpi->svc.non_reference_frame;
+  return cpi->common.frame_type == KEY_FRAME || cpi->refresh_last_frame ||
+         cpi->refresh_golden_frame || cpi->refresh_alt_ref_frame;
+}
+
+// Returns 1 if the row mt workers can loop filter the frame while encoding
+// it. The filter level must be known before encoding, which holds when it is
+// picked from q, and the mode info of a row must not change once the row is
+// encoded, which holds for the non-rd path without a recode loop.
+static int use_lpf_mt_opt(const VP9_COMP *cpi) {
+  return cpi->oxcf.lpf_opt && cpi->row_mt && cpi->sf.use_nonrd_pick_mode &&
+         !cpi->sf.frame_parameter_update &&
+         cpi->sf.lpf_pick == LPF_PICK_FROM_Q &&
+         cpi->sf.recode_loop == DISALLOW_RECODE &&
+         !cpi->common.show_existing_frame && !cpi->rc.is_src_frame_alt_ref &&
+         // ambient_err is measured on the unfiltered frame.
+         !(cpi->rc.next_key_frame_forced && cpi->rc.frames_to_key == 1) &&
+         is_reference_frame(cpi);
+}
+
 static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
-  int is_reference_frame =
-      (cm->frame_type == KEY_FRAME || cpi->refresh_last_frame ||
-       cpi->refresh_golden_frame || cpi->refresh_alt_ref_frame);
-  if (cpi->use_svc &&
-      cpi->svc.temporal_layering_mode == VP9E_TEMPORAL_LAYERING_MODE_BYPASS)
-    is_reference_frame = !cpi->svc.non_reference_frame;
 
   // Skip loop filter in show_existing_frame mode.
   if (cm->show_existing_frame) {
@@ -3324,7 +3342,9 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
           (!cpi->rc.this_key_frame_forced)) {
         lf->last_filt_level = 0;
       }
-      vp9_pick_filter_level(cpi->Source, cpi, cpi->sf.lpf_pick);
+      // With lpf_mt_opt the level was picked before encoding the frame.
+      if (!cpi->lpf_mt_opt)
+        vp9_pick_filter_level(cpi->Source, cpi, cpi->sf.lpf_pick);
       lf->last_filt_level = lf->filter_level;
     } else {
       lf->filter_level = 0;
@@ -3334,7 +3354,7 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
     cpi->time_pick_lpf += vpx_usec_timer_elapsed(&timer);
   }
 
-  if (lf->filter_level > 0 && is_reference_frame) {
+  if (lf->filter_level > 0 && is_reference_frame(cpi) && !cpi->lpf_mt_opt) {
     vp9_build_mask_frame(cm, lf->filter_level, 0);
 
     if (cpi->num_workers > 1)
@@ -3345,7 +3365,23 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
       vp9_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
   }
 
-  vpx_extend_frame_inner_borders(cm->frame_to_show);
+  // The borders are extended once the frame is known to be a reference.
+  cpi->border_pending[cm->new_fb_idx] = 1;
+}
+
+// Extends the inner borders of the reconstructed frames held in the reference
+// slots. Frames that were not kept as a reference are never extended.
+static void extend_pending_ref_borders(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  int i;
+
+  for (i = 0; i < REF_FRAMES; ++i) {
+    const int idx = cm->ref_frame_map[i];
+    if (idx != INVALID_IDX && cpi->border_pending[idx]) {
+      vpx_extend_frame_inner_borders(&cm->buffer_pool->frame_bufs[idx].buf);
+      cpi->border_pending[idx] = 0;
+    }
+  }
 }
 
 static INLINE void alloc_frame_mvs(VP9_COMMON *const cm, int buffer_idx) {
@@ -5177,6 +5213,16 @@ static void encode_frame_to_data_rate(VP9_COMP *cpi, size_t *size,
   save_encode_params(cpi);
 #endif  // CONFIG_CONSISTENT_RECODE || CONFIG_RATE_CTRL
 
+  cpi->lpf_mt_opt = use_lpf_mt_opt(cpi);
+
+  // The rd search of the tiles may run on several threads.
+  if (cpi->sf.use_pyramid_me >= 2 && !frame_is_intra_only(cm)) {
+    MV_REFERENCE_FRAME ref_frame;
+    vp9_prepare_pyramid(cpi, cpi->un_scaled_source);
+    for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame)
+      vp9_prepare_pyramid(cpi, get_ref_frame_buffer(cpi, ref_frame));
+  }
+
   if (cpi->sf.recode_loop == DISALLOW_RECODE) {
     if (!encode_without_recode_loop(cpi, size, dest)) return;
   } else {
@@ -5417,9 +5463,17 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
 
   vpx_usec_timer_start(&timer);
 
-  if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
-                         use_highbitdepth, frame_flags))
+  if (cpi->source_ref != NULL) {
+    const vpx_image_t *const img = cpi->source_ref;
+    cpi->source_ref = NULL;
+    if (vp9_lookahead_push_ref(cpi->lookahead, sd, time_stamp, end_time,
+                               use_highbitdepth, frame_flags,
+                               &cpi->release_source_cb, img))
+      res = -1;
+  } else if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
+                                use_highbitdepth, frame_flags)) {
     res = -1;
+  }
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
 
@@ -5919,12 +5973,11 @@ static void init_tpl_stats(VP9_COMP *cpi) {
 }
 
 #if CONFIG_NON_GREEDY_MV
-static uint32_t full_pixel_motion_search(VP9_COMP *cpi, ThreadData *td,
-                                         MotionField *motion_field,
-                                         int frame_idx, uint8_t *cur_frame_buf,
-                                         uint8_t *ref_frame_buf, int stride,
-                                         BLOCK_SIZE bsize, int mi_row,
-                                         int mi_col, MV *mv) {
+static uint32_t full_pixel_motion_search(
+    VP9_COMP *cpi, ThreadData *td, MotionField *motion_field, int frame_idx,
+    uint8_t *cur_frame_buf, uint8_t *ref_frame_buf, int stride,
+    const ImagePyramid *cur_pyramid, const ImagePyramid *ref_pyramid,
+    BLOCK_SIZE bsize, int mi_row, int mi_col, MV *mv) {
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
@@ -5953,6 +6006,8 @@ static uint32_t full_pixel_motion_search(VP9_COMP *cpi, ThreadData *td,
   step_param = VPXMIN(step_param, MAX_MVSEARCH_STEPS - 2);
 
   vp9_set_mv_search_range(&x->mv_limits, &best_ref_mv1);
+  vp9_pyramid_seed_mv(cpi, x, bsize, cur_pyramid, ref_pyramid, mi_row, mi_col,
+                      &best_ref_mv1_full);
 
   nb_full_mv_num =
       vp9_prepare_nb_full_mvs(motion_field, mi_row, mi_col, nb_full_mvs);
@@ -5997,11 +6052,11 @@ static uint32_t sub_pixel_motion_search(VP9_COMP *cpi, ThreadData *td,
 }
 
 #else  // CONFIG_NON_GREEDY_MV
-static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
-                                              uint8_t *cur_frame_buf,
-                                              uint8_t *ref_frame_buf,
-                                              int stride, BLOCK_SIZE bsize,
-                                              MV *mv) {
+static uint32_t motion_compensated_prediction(
+    VP9_COMP *cpi, ThreadData *td, uint8_t *cur_frame_buf,
+    uint8_t *ref_frame_buf, int stride, const ImagePyramid *cur_pyramid,
+    const ImagePyramid *ref_pyramid, BLOCK_SIZE bsize, int mi_row, int mi_col,
+    MV *mv) {
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
@@ -6030,6 +6085,8 @@ static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
   step_param = VPXMIN(step_param, MAX_MVSEARCH_STEPS - 2);
 
   vp9_set_mv_search_range(&x->mv_limits, &best_ref_mv1);
+  vp9_pyramid_seed_mv(cpi, x, bsize, cur_pyramid, ref_pyramid, mi_row, mi_col,
+                      &best_ref_mv1_full);
 
   vp9_full_pixel_search(cpi, x, bsize, &best_ref_mv1_full, step_param,
                         search_method, sadpb, cond_cost_list(cpi, cost_list),
@@ -6249,7 +6306,7 @@ static void set_mv_limits(const VP9_COMMON *cm, MACROBLOCK *x, int mi_row,
       ((cm->mi_cols - 1 - mi_col) * MI_SIZE) + (17 - 2 * VP9_INTERP_EXTEND);
 }
 
-static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
+static void mode_estimation(VP9_COMP *cpi, ThreadData *td,
                             struct scale_factors *sf, GF_PICTURE *gf_picture,
                             int frame_idx, TplDepFrame *tpl_frame,
                             int16_t *src_diff, tran_low_t *coeff,
@@ -6258,7 +6315,8 @@ static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
                             YV12_BUFFER_CONFIG *ref_frame[], uint8_t *predictor,
                             int64_t *recon_error, int64_t *sse) {
   VP9_COMMON *cm = &cpi->common;
-  ThreadData *td = &cpi->td;
+  MACROBLOCK *const x = &td->mb;
+  MACROBLOCKD *const xd = &x->e_mbd;
 
   const int bw = 4 << b_width_log2_lookup[bsize];
   const int bh = 4 << b_height_log2_lookup[bsize];
@@ -6338,14 +6396,15 @@ static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
     if (ref_frame[rf_idx] == NULL) continue;
 
 #if CONFIG_NON_GREEDY_MV
-    (void)td;
     motion_field = vp9_motion_field_info_get_motion_field(
         &cpi->motion_field_info, frame_idx, rf_idx, bsize);
     mv = vp9_motion_field_mi_get_mv(motion_field, mi_row, mi_col);
 #else
-    motion_compensated_prediction(cpi, td, xd->cur_buf->y_buffer + mb_y_offset,
-                                  ref_frame[rf_idx]->y_buffer + mb_y_offset,
-                                  xd->cur_buf->y_stride, bsize, &mv.as_mv);
+    motion_compensated_prediction(
+        cpi, td, xd->cur_buf->y_buffer + mb_y_offset,
+        ref_frame[rf_idx]->y_buffer + mb_y_offset, xd->cur_buf->y_stride,
+        cpi->tpl_frame_ctx.cur_pyramid, cpi->tpl_frame_ctx.ref_pyramid[rf_idx],
+        bsize, mi_row, mi_col, &mv.as_mv);
 #endif
 
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -6754,7 +6813,8 @@ static void predict_mv_mode_arr(VP9_COMP *cpi, MACROBLOCK *x,
 
 static void do_motion_search(VP9_COMP *cpi, ThreadData *td,
                              MotionField *motion_field, int frame_idx,
-                             YV12_BUFFER_CONFIG *ref_frame, BLOCK_SIZE bsize,
+                             YV12_BUFFER_CONFIG *ref_frame,
+                             const ImagePyramid *ref_pyramid, BLOCK_SIZE bsize,
                              int mi_row, int mi_col) {
   VP9_COMMON *cm = &cpi->common;
   MACROBLOCK *x = &td->mb;
@@ -6769,8 +6829,9 @@ static void do_motion_search(VP9_COMP *cpi, ThreadData *td,
     uint8_t *ref_frame_buf = ref_frame->y_buffer + mb_y_offset;
     const int stride = xd->cur_buf->y_stride;
     full_pixel_motion_search(cpi, td, motion_field, frame_idx, cur_frame_buf,
-                             ref_frame_buf, stride, bsize, mi_row, mi_col,
-                             &mv.as_mv);
+                             ref_frame_buf, stride,
+                             cpi->tpl_frame_ctx.cur_pyramid, ref_pyramid, bsize,
+                             mi_row, mi_col, &mv.as_mv);
     sub_pixel_motion_search(cpi, td, cur_frame_buf, ref_frame_buf, stride,
                             bsize, &mv.as_mv);
     vp9_motion_field_mi_set_mv(motion_field, mi_row, mi_col, mv);
@@ -6803,26 +6864,23 @@ static void build_motion_field(
     for (mi_row = 0; mi_row < cm->mi_rows; mi_row += mi_height) {
       for (mi_col = 0; mi_col < cm->mi_cols; mi_col += mi_width) {
         do_motion_search(cpi, td, motion_field, frame_idx, ref_frame[rf_idx],
-                         bsize, mi_row, mi_col);
+                         cpi->tpl_frame_ctx.ref_pyramid[rf_idx], bsize, mi_row,
+                         mi_col);
       }
     }
   }
 }
 #endif  // CONFIG_NON_GREEDY_MV
 
-static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
-                              int frame_idx, BLOCK_SIZE bsize) {
-  TplDepFrame *tpl_frame = &cpi->tpl_stats[frame_idx];
-  YV12_BUFFER_CONFIG *this_frame = gf_picture[frame_idx].frame;
-  YV12_BUFFER_CONFIG *ref_frame[MAX_INTER_REF_FRAMES] = { NULL, NULL, NULL };
-
-  VP9_COMMON *cm = &cpi->common;
-  struct scale_factors sf;
-  int rdmult, idx;
-  ThreadData *td = &cpi->td;
-  MACROBLOCK *x = &td->mb;
-  MACROBLOCKD *xd = &x->e_mbd;
-  int mi_row, mi_col;
+void vp9_mc_flow_dispenser_row(VP9_COMP *cpi, ThreadData *td, int sb_row,
+                               int mi_col_start, int mi_col_end) {
+  VP9_COMMON *const cm = &cpi->common;
+  TplFrameCtx *const tpl_ctx = &cpi->tpl_frame_ctx;
+  TplDepFrame *tpl_frame = &cpi->tpl_stats[tpl_ctx->frame_idx];
+  MACROBLOCKD *const xd = &td->mb.e_mbd;
+  MODE_INFO **const mi_grid = xd->mi;
+  MODE_INFO mi;
+  MODE_INFO *mi_ptr = &mi;
 
 #if CONFIG_VP9_HIGHBITDEPTH
   DECLARE_ALIGNED(16, uint16_t, predictor16[32 * 32 * 3]);
@@ -6836,29 +6894,75 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   DECLARE_ALIGNED(16, tran_low_t, qcoeff[32 * 32]);
   DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
 
+  const BLOCK_SIZE bsize = tpl_ctx->bsize;
   const TX_SIZE tx_size = max_txsize_lookup[bsize];
   const int mi_height = num_8x8_blocks_high_lookup[bsize];
   const int mi_width = num_8x8_blocks_wide_lookup[bsize];
+  const int mi_row_end = VPXMIN((sb_row + 1) * MI_BLOCK_SIZE, cm->mi_rows);
   int64_t recon_error, sse;
+  int mi_row, mi_col;
+
+  // The mode info of the block being estimated is local, rows running on
+  // other threads use their own.
+  memset(&mi, 0, sizeof(mi));
+  xd->mi = &mi_ptr;
+  xd->cur_buf = tpl_ctx->gf_picture[tpl_ctx->frame_idx].frame;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+    predictor = CONVERT_TO_BYTEPTR(predictor16);
+  else
+    predictor = predictor8;
+#endif
+
+  for (mi_row = sb_row * MI_BLOCK_SIZE; mi_row < mi_row_end;
+       mi_row += mi_height) {
+    for (mi_col = mi_col_start; mi_col < mi_col_end; mi_col += mi_width) {
+      mode_estimation(cpi, td, &tpl_ctx->sf, tpl_ctx->gf_picture,
+                      tpl_ctx->frame_idx, tpl_frame, src_diff, coeff, qcoeff,
+                      dqcoeff, mi_row, mi_col, bsize, tx_size,
+                      tpl_ctx->ref_frame, predictor, &recon_error, &sse);
+      tpl_model_store(tpl_frame->tpl_stats_ptr, mi_row, mi_col, bsize,
+                      tpl_frame->stride);
+    }
+  }
+
+  xd->mi = mi_grid;
+}
+
+static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
+                              int frame_idx, BLOCK_SIZE bsize) {
+  TplDepFrame *tpl_frame = &cpi->tpl_stats[frame_idx];
+  TplFrameCtx *const tpl_ctx = &cpi->tpl_frame_ctx;
+  YV12_BUFFER_CONFIG *this_frame = gf_picture[frame_idx].frame;
+  YV12_BUFFER_CONFIG **ref_frame = tpl_ctx->ref_frame;
+
+  VP9_COMMON *cm = &cpi->common;
+  int rdmult, idx;
+  ThreadData *td = &cpi->td;
+  MACROBLOCK *x = &td->mb;
+  MACROBLOCKD *xd = &x->e_mbd;
+  const int mi_height = num_8x8_blocks_high_lookup[bsize];
+  const int mi_width = num_8x8_blocks_wide_lookup[bsize];
+  int mi_row, mi_col;
 #if CONFIG_NON_GREEDY_MV
   int square_block_idx;
   int rf_idx;
 #endif
 
+  tpl_ctx->gf_picture = gf_picture;
+  tpl_ctx->frame_idx = frame_idx;
+  tpl_ctx->bsize = bsize;
+
   // Setup scaling factor
 #if CONFIG_VP9_HIGHBITDEPTH
   vp9_setup_scale_factors_for_frame(
-      &sf, this_frame->y_crop_width, this_frame->y_crop_height,
+      &tpl_ctx->sf, this_frame->y_crop_width, this_frame->y_crop_height,
       this_frame->y_crop_width, this_frame->y_crop_height,
       cpi->common.use_highbitdepth);
-
-  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
-    predictor = CONVERT_TO_BYTEPTR(predictor16);
-  else
-    predictor = predictor8;
 #else
   vp9_setup_scale_factors_for_frame(
-      &sf, this_frame->y_crop_width, this_frame->y_crop_height,
+      &tpl_ctx->sf, this_frame->y_crop_width, this_frame->y_crop_height,
       this_frame->y_crop_width, this_frame->y_crop_height);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
@@ -6866,7 +6970,22 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   // unavailable, the pointer will be set to Null.
   for (idx = 0; idx < MAX_INTER_REF_FRAMES; ++idx) {
     int rf_idx = gf_picture[frame_idx].ref_frame[idx];
-    if (rf_idx != -1) ref_frame[idx] = gf_picture[rf_idx].frame;
+    ref_frame[idx] = rf_idx != -1 ? gf_picture[rf_idx].frame : NULL;
+  }
+
+  // The pyramids are built before the motion searches, which may run on
+  // several threads.
+  tpl_ctx->cur_pyramid = NULL;
+  if (cpi->sf.use_pyramid_me) {
+    vp9_prepare_pyramid(cpi, this_frame);
+    tpl_ctx->cur_pyramid = vp9_get_pyramid(cpi, this_frame);
+  }
+  for (idx = 0; idx < MAX_INTER_REF_FRAMES; ++idx) {
+    tpl_ctx->ref_pyramid[idx] = NULL;
+    if (tpl_ctx->cur_pyramid != NULL) {
+      vp9_prepare_pyramid(cpi, ref_frame[idx]);
+      tpl_ctx->ref_pyramid[idx] = vp9_get_pyramid(cpi, ref_frame[idx]);
+    }
   }
 
   xd->mi = cm->mi_grid_visible;
@@ -6900,15 +7019,21 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   }
 #endif
 
+  if (cpi->row_mt) {
+    vp9_tpl_row_mt(cpi);
+  } else {
+    const int sb_rows =
+        mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+    int sb_row;
+    for (sb_row = 0; sb_row < sb_rows; ++sb_row)
+      vp9_mc_flow_dispenser_row(cpi, td, sb_row, 0, cm->mi_cols);
+  }
+
+  // Motion flow dependency dispenser. The stats only propagate to the
+  // reference frames, and do so in raster order once all the rows are done,
+  // so the result does not depend on the number of threads.
   for (mi_row = 0; mi_row < cm->mi_rows; mi_row += mi_height) {
     for (mi_col = 0; mi_col < cm->mi_cols; mi_col += mi_width) {
-      mode_estimation(cpi, x, xd, &sf, gf_picture, frame_idx, tpl_frame,
-                      src_diff, coeff, qcoeff, dqcoeff, mi_row, mi_col, bsize,
-                      tx_size, ref_frame, predictor, &recon_error, &sse);
-      // Motion flow dependency dispenser.
-      tpl_model_store(tpl_frame->tpl_stats_ptr, mi_row, mi_col, bsize,
-                      tpl_frame->stride);
-
       tpl_model_update(cpi->tpl_stats, tpl_frame->tpl_stats_ptr, mi_row, mi_col,
                        bsize);
     }
@@ -7321,6 +7446,9 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 
   vpx_usec_timer_start(&cmptimer);
 
+  extend_pending_ref_borders(cpi);
+  vp9_invalidate_frame_pyramids(cpi);
+
   vp9_set_high_precision_mv(cpi, ALTREF_HIGH_PRECISION_MV);
 
   // Is multi-arf enabled.
@@ -44,6 +44,7 @@
 #include "vp9/encoder/vp9_mbgraph.h"
 #include "vp9/encoder/vp9_mcomp.h"
 #include "vp9/encoder/vp9_noise_estimate.h"
+#include "vp9/encoder/vp9_pyramid.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -283,6 +284,8 @@ typedef struct VP9EncoderConfig {
   int row_mt;
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
+  // Loop filter rows while the row based multi-threaded encoder encodes.
+  int lpf_opt;
 } VP9EncoderConfig;
 
 static INLINE int is_lossless_requested(const VP9EncoderConfig *cfg) {
@@ -327,6 +330,21 @@ typedef struct TplDepFrame {
 
 #define TPL_DEP_COST_SCALE_LOG2 4
 
+struct GF_PICTURE;
+
+// The frame the TPL model is being built for, shared by the superblock row
+// jobs that estimate its stats.
+typedef struct TplFrameCtx {
+  struct GF_PICTURE *gf_picture;
+  int frame_idx;
+  YV12_BUFFER_CONFIG *ref_frame[MAX_INTER_REF_FRAMES];
+  // Pyramids seeding the motion search, NULL when not used.
+  const ImagePyramid *cur_pyramid;
+  const ImagePyramid *ref_pyramid[MAX_INTER_REF_FRAMES];
+  struct scale_factors sf;
+  BLOCK_SIZE bsize;
+} TplFrameCtx;
+
 // TODO(jingning) All spatially adaptive variables should go to TileDataEnc.
 typedef struct TileDataEnc {
   TileInfo tile_info;
@@ -344,8 +362,11 @@ typedef struct TileDataEnc {
 
 typedef struct RowMTInfo {
   JobQueueHandle job_queue_hdl;
+  // Number of threads currently taking jobs from the tile.
 #if CONFIG_MULTITHREAD
-  pthread_mutex_t job_mutex;
+  vpx_atomic_int num_workers;
+#else
+  int num_workers;
 #endif
 } RowMTInfo;
 
@@ -370,6 +391,11 @@ typedef struct MultiThreadHandle {
 
   RowMTInfo row_mt_info[MAX_NUM_TILE_COLS];
   int thread_id_to_tile_id[MAX_NUM_THREADS];  // Mapping of threads to tiles
+
+  // Time each thread spent running jobs and waiting for them, accumulated
+  // over all row based multi-threaded stages, in microseconds.
+  int64_t thread_busy_time[MAX_NUM_THREADS];
+  int64_t thread_idle_time[MAX_NUM_THREADS];
 } MultiThreadHandle;
 
 typedef struct RD_COUNTS {
@@ -580,6 +606,10 @@ typedef struct VP9_COMP {
   VP9EncoderConfig oxcf;
   struct lookahead_ctx *lookahead;
   struct lookahead_entry *alt_ref_source;
+  // Image the next vp9_receive_raw_frame() call may hold by reference, handed
+  // to release_source_cb by the lookahead. Cleared once the lookahead owns it.
+  const vpx_image_t *source_ref;
+  vpx_codec_release_source_cb_t release_source_cb;
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -595,6 +625,7 @@ typedef struct VP9_COMP {
 
   BLOCK_SIZE tpl_bsize;
   TplDepFrame tpl_stats[MAX_ARF_GOP_SIZE];
+  TplFrameCtx tpl_frame_ctx;
   YV12_BUFFER_CONFIG *tpl_recon_frames[REF_FRAMES];
   EncFrameBuf enc_frame_buf[REF_FRAMES];
 #if CONFIG_MULTITHREAD
@@ -627,6 +658,14 @@ typedef struct VP9_COMP {
 
   int ref_fb_idx[REF_FRAMES];
 
+  // Set for frame buffers whose inner borders have not been extended since
+  // they were reconstructed. See extend_pending_ref_borders().
+  uint8_t border_pending[FRAME_BUFFERS];
+
+  // Pyramids of the frame buffers, prepared on demand for the pyramid motion
+  // search. See vp9_prepare_pyramid().
+  ImagePyramid frame_pyramid[FRAME_BUFFERS];
+
   int refresh_last_frame;
   int refresh_golden_frame;
   int refresh_alt_ref_frame;
@@ -845,6 +884,9 @@ typedef struct VP9_COMP {
 
   int row_mt;
   unsigned int row_mt_bit_exact;
+  // Set when the row mt workers loop filter the current frame's rows as soon
+  // as the rows below them are encoded.
+  int lpf_mt_opt;
 
   // Previous Partition Info
   BLOCK_SIZE *prev_partition;
@@ -958,7 +1000,8 @@ void vp9_remove_compressor(VP9_COMP *cpi);
 void vp9_change_config(VP9_COMP *cpi, const VP9EncoderConfig *oxcf);
 
 // receive a frames worth of data. caller can assume that a copy of this
-// frame is made and not just a copy of the pointer..
+// frame is made and not just a copy of the pointer, unless source_ref is set
+// to the image sd describes.
 int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
                           int64_t end_time);
@@ -1093,6 +1136,12 @@ int64_t vp9_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
                              const YV12_BUFFER_CONFIG *b);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+// Estimates the TPL stats of the blocks of cpi->tpl_frame_ctx in superblock
+// row sb_row, between columns mi_col_start and mi_col_end. The rows only
+// write the stats of their own blocks, so they may be processed in any order.
+void vp9_mc_flow_dispenser_row(VP9_COMP *cpi, ThreadData *td, int sb_row,
+                               int mi_col_start, int mi_col_end);
+
 void vp9_scale_references(VP9_COMP *cpi);
 
 void vp9_update_reference_frames(VP9_COMP *cpi);
@@ -13,8 +13,10 @@
 #include "vp9/encoder/vp9_ethread.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/encoder/vp9_multi_thread.h"
+#include "vp9/encoder/vp9_picklpf.h"
 #include "vp9/encoder/vp9_temporal_filter.h"
 #include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/vpx_timer.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
   int i, j, k, l, m, n;
@@ -169,6 +171,28 @@ static void launch_enc_workers(VP9_COMP *cpi, VPxWorkerHook hook, void *data2,
   }
 }
 
+// Runs a row based multi-threaded stage. The time each worker did not spend
+// running jobs is accounted as idle.
+static void launch_row_mt_workers(VP9_COMP *cpi, VPxWorkerHook hook,
+                                  int num_workers) {
+  MultiThreadHandle *const multi_thread_ctxt = &cpi->multi_thread_ctxt;
+  struct vpx_usec_timer timer;
+  int64_t elapsed_time;
+  int i;
+
+  vpx_usec_timer_start(&timer);
+  launch_enc_workers(cpi, hook, multi_thread_ctxt, num_workers);
+  vpx_usec_timer_mark(&timer);
+  elapsed_time = vpx_usec_timer_elapsed(&timer);
+
+  for (i = 0; i < num_workers; i++) {
+    const int64_t job_time = cpi->tile_thr_data[i].job_time;
+    multi_thread_ctxt->thread_busy_time[i] += job_time;
+    multi_thread_ctxt->thread_idle_time[i] +=
+        VPXMAX(elapsed_time - job_time, 0);
+  }
+}
+
 void vp9_encode_tiles_mt(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   const int tile_cols = 1 << cm->log2_tile_cols;
@@ -418,6 +442,9 @@ static int first_pass_worker_hook(void *arg1, void *arg2) {
           multi_thread_ctxt, thread_data->tile_completion_status, &cur_tile_id,
           tile_cols);
     } else {
+      struct vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+
       tile_col = proc_job->tile_col_id;
       tile_row = proc_job->tile_row_id;
 
@@ -429,6 +456,9 @@ static int first_pass_worker_hook(void *arg1, void *arg2) {
       fp_acc_data.image_data_start_row = INVALID_ROW;
       vp9_first_pass_encode_tile_mb_row(cpi, thread_data->td, &fp_acc_data,
                                         this_tile, &best_ref_mv, mb_row);
+
+      vpx_usec_timer_mark(&timer);
+      thread_data->job_time += vpx_usec_timer_elapsed(&timer);
     }
   }
   return 0;
@@ -471,8 +501,7 @@ void vp9_encode_fp_row_mt(VP9_COMP *cpi) {
     }
   }
 
-  launch_enc_workers(cpi, first_pass_worker_hook, multi_thread_ctxt,
-                     num_workers);
+  launch_row_mt_workers(cpi, first_pass_worker_hook, num_workers);
 
   first_tile_col = &cpi->tile_data[0];
   for (i = 1; i < tile_cols; i++) {
@@ -507,6 +536,9 @@ static int temporal_filter_worker_hook(void *arg1, void *arg2) {
           multi_thread_ctxt, thread_data->tile_completion_status, &cur_tile_id,
           tile_cols);
     } else {
+      struct vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+
       tile_col = proc_job->tile_col_id;
       tile_row = proc_job->tile_row_id;
       this_tile = &cpi->tile_data[tile_row * tile_cols + tile_col];
@@ -516,6 +548,9 @@ static int temporal_filter_worker_hook(void *arg1, void *arg2) {
 
       vp9_temporal_filter_iterate_row_c(cpi, thread_data->td, mb_row,
                                         mb_col_start, mb_col_end);
+
+      vpx_usec_timer_mark(&timer);
+      thread_data->job_time += vpx_usec_timer_elapsed(&timer);
     }
   }
   return 0;
@@ -555,16 +590,127 @@ void vp9_temporal_filter_row_mt(VP9_COMP *cpi) {
     }
   }
 
-  launch_enc_workers(cpi, temporal_filter_worker_hook, multi_thread_ctxt,
-                     num_workers);
+  launch_row_mt_workers(cpi, temporal_filter_worker_hook, num_workers);
 }
 #endif  // !CONFIG_REALTIME_ONLY
 
+static int tpl_worker_hook(void *arg1, void *arg2) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  MultiThreadHandle *multi_thread_ctxt = (MultiThreadHandle *)arg2;
+  VP9_COMP *const cpi = thread_data->cpi;
+  const VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  int end_of_frame;
+  int thread_id = thread_data->thread_id;
+  int cur_tile_id = multi_thread_ctxt->thread_id_to_tile_id[thread_id];
+  JobNode *proc_job = NULL;
+
+  end_of_frame = 0;
+  while (0 == end_of_frame) {
+    // Get the next job in the queue
+    proc_job =
+        (JobNode *)vp9_enc_grp_get_next_job(multi_thread_ctxt, cur_tile_id);
+    if (NULL == proc_job) {
+      // Query for the status of other tiles
+      end_of_frame = vp9_get_tiles_proc_status(
+          multi_thread_ctxt, thread_data->tile_completion_status, &cur_tile_id,
+          tile_cols);
+    } else {
+      const TileInfo *const tile_info =
+          &cpi->tile_data[proc_job->tile_col_id].tile_info;
+      struct vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+
+      vp9_mc_flow_dispenser_row(cpi, thread_data->td,
+                                proc_job->vert_unit_row_num,
+                                tile_info->mi_col_start, tile_info->mi_col_end);
+
+      vpx_usec_timer_mark(&timer);
+      thread_data->job_time += vpx_usec_timer_elapsed(&timer);
+    }
+  }
+  return 0;
+}
+
+void vp9_tpl_row_mt(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  MultiThreadHandle *multi_thread_ctxt = &cpi->multi_thread_ctxt;
+  int num_workers = cpi->num_workers ? cpi->num_workers : 1;
+  int i;
+
+  if (multi_thread_ctxt->allocated_tile_cols < tile_cols ||
+      multi_thread_ctxt->allocated_tile_rows < tile_rows ||
+      multi_thread_ctxt->allocated_vert_unit_rows < cm->mb_rows) {
+    vp9_row_mt_mem_dealloc(cpi);
+    vp9_init_tile_data(cpi);
+    vp9_row_mt_mem_alloc(cpi);
+  } else {
+    vp9_init_tile_data(cpi);
+  }
+
+  create_enc_workers(cpi, num_workers);
+
+  vp9_assign_tile_to_thread(multi_thread_ctxt, tile_cols, cpi->num_workers);
+
+  vp9_prepare_job_queue(cpi, TPL_JOB);
+
+  for (i = 0; i < num_workers; i++) {
+    EncWorkerData *thread_data;
+    thread_data = &cpi->tile_thr_data[i];
+
+    // Before estimating the frame, copy the thread data from cpi.
+    if (thread_data->td != &cpi->td) {
+      thread_data->td->mb = cpi->td.mb;
+    }
+  }
+
+  launch_row_mt_workers(cpi, tpl_worker_hook, num_workers);
+}
+
+// Picks the loop filter level and sets up the loop filter of the frame ahead
+// of encoding it, so the row mt workers can filter its rows.
+static void lpf_mt_init(VP9_COMP *cpi, int num_workers) {
+  VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  struct loopfilter *const lf = &cm->lf;
+  VP9LfSync *const lf_sync = &cpi->lf_row_sync;
+  int i;
+
+  if (xd->lossless) {
+    lf->filter_level = 0;
+    return;
+  }
+  // The level only depends on q with LPF_PICK_FROM_Q, see use_lpf_mt_opt().
+  vp9_pick_filter_level(cpi->Source, cpi, cpi->sf.lpf_pick);
+  if (!lf->filter_level) return;
+
+  vp9_loop_filter_frame_init(cm, lf->filter_level);
+  vp9_lpf_mt_init(lf_sync, cm, lf->filter_level, num_workers);
+  for (i = 0; i < num_workers; ++i) {
+    vp9_loop_filter_data_reset(&lf_sync->lfdata[i], get_frame_new_buffer(cm),
+                               cm, xd->plane);
+  }
+}
+
+// Lets the loop filter know the tile is done with the encoded row. The masks
+// of the row's superblocks were built while encoding them.
+static void lpf_mt_row_done(VP9_COMP *cpi, int mi_row) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+
+  vp9_set_row(&cpi->lf_row_sync, 1 << cm->log2_tile_cols, sb_row,
+              sb_row == sb_rows - 1, 0);
+}
+
 static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
   EncWorkerData *const thread_data = (EncWorkerData *)arg1;
   MultiThreadHandle *multi_thread_ctxt = (MultiThreadHandle *)arg2;
   VP9_COMP *const cpi = thread_data->cpi;
   const VP9_COMMON *const cm = &cpi->common;
+  const int lpf_mt_opt = cpi->lpf_mt_opt && cm->lf.filter_level;
   const int tile_cols = 1 << cm->log2_tile_cols;
   int tile_row, tile_col;
   int end_of_frame;
@@ -584,13 +730,31 @@ static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
           multi_thread_ctxt, thread_data->tile_completion_status, &cur_tile_id,
           tile_cols);
     } else {
+      struct vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+
       tile_col = proc_job->tile_col_id;
       tile_row = proc_job->tile_row_id;
       mi_row = proc_job->vert_unit_row_num * MI_BLOCK_SIZE;
 
       vp9_encode_sb_row(cpi, thread_data->td, tile_row, tile_col, mi_row);
+      if (lpf_mt_opt) lpf_mt_row_done(cpi, mi_row);
+
+      vpx_usec_timer_mark(&timer);
+      thread_data->job_time += vpx_usec_timer_elapsed(&timer);
     }
   }
+
+  // All encode jobs have been taken, so the rows left to filter only wait on
+  // rows other workers are encoding.
+  if (lpf_mt_opt) {
+    struct vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    vp9_loopfilter_rows(&cpi->lf_row_sync.lfdata[thread_id],
+                        &cpi->lf_row_sync);
+    vpx_usec_timer_mark(&timer);
+    thread_data->job_time += vpx_usec_timer_elapsed(&timer);
+  }
   return 0;
 }
 
@@ -620,6 +784,8 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
 
   vp9_multi_thread_tile_init(cpi);
 
+  if (cpi->lpf_mt_opt) lpf_mt_init(cpi, num_workers);
+
   for (i = 0; i < num_workers; i++) {
     EncWorkerData *thread_data;
     thread_data = &cpi->tile_thr_data[i];
@@ -651,8 +817,7 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
     }
   }
 
-  launch_enc_workers(cpi, enc_row_mt_worker_hook, multi_thread_ctxt,
-                     num_workers);
+  launch_row_mt_workers(cpi, enc_row_mt_worker_hook, num_workers);
 
   for (i = 0; i < num_workers; i++) {
     VPxWorker *const worker = &cpi->workers[i];
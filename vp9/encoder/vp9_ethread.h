@@ -11,6 +11,8 @@
 #ifndef VPX_VP9_ENCODER_VP9_ETHREAD_H_
 #define VPX_VP9_ENCODER_VP9_ETHREAD_H_
 
+#include "vpx/vpx_integer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -28,6 +30,9 @@ typedef struct EncWorkerData {
   int start;
   int thread_id;
   int tile_completion_status[MAX_NUM_TILE_COLS];
+  // Time spent running row based multi-threading jobs in the current stage,
+  // in microseconds.
+  int64_t job_time;
 } EncWorkerData;
 
 // Encoder row synchronization
@@ -65,6 +70,8 @@ void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync);
 
 void vp9_temporal_filter_row_mt(struct VP9_COMP *cpi);
 
+void vp9_tpl_row_mt(struct VP9_COMP *cpi);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -21,6 +21,10 @@ extern "C" {
 void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
+// Extends the borders of frame as vp9_copy_and_extend_frame() does for a
+// copy, writing to the memory around its planes.
+void vp9_extend_frame_in_place(YV12_BUFFER_CONFIG *frame);
+
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
                                          YV12_BUFFER_CONFIG *dst, int srcy,
                                          int srcx, int srch, int srcw);
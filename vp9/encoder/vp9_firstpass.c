@@ -35,6 +35,7 @@
 #include "vp9/encoder/vp9_extend.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#include "vp9/encoder/vp9_pyramid.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_rd.h"
 #include "vpx_dsp/variance.h"
@@ -390,8 +391,10 @@ static int get_search_range(const VP9_COMP *cpi) {
 }
 
 static void first_pass_motion_search(VP9_COMP *cpi, MACROBLOCK *x,
-                                     const MV *ref_mv, MV *best_mv,
-                                     int *best_motion_err) {
+                                     const MV *ref_mv,
+                                     const ImagePyramid *cur_pyramid,
+                                     const ImagePyramid *ref_pyramid,
+                                     MV *best_mv, int *best_motion_err) {
   MACROBLOCKD *const xd = &x->e_mbd;
   MV tmp_mv = { 0, 0 };
   MV ref_mv_full = { ref_mv->row >> 3, ref_mv->col >> 3 };
@@ -414,6 +417,10 @@ static void first_pass_motion_search(VP9_COMP *cpi, MACROBLOCK *x,
   }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+  vp9_pyramid_seed_mv(cpi, x, bsize, cur_pyramid, ref_pyramid,
+                      -xd->mb_to_top_edge >> (3 + MI_SIZE_LOG2),
+                      -xd->mb_to_left_edge >> (3 + MI_SIZE_LOG2), &ref_mv_full);
+
   // Center the initial step/diamond search on best mv.
   tmp_err = cpi->diamond_search_sad(x, &cpi->ss_cfg, &ref_mv_full, &tmp_mv,
                                     step_param, x->sadperbit16, &num00,
@@ -838,6 +845,9 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
   YV12_BUFFER_CONFIG *gld_yv12 = get_ref_frame_buffer(cpi, GOLDEN_FRAME);
   YV12_BUFFER_CONFIG *const new_yv12 = get_frame_new_buffer(cm);
   const YV12_BUFFER_CONFIG *first_ref_buf = lst_yv12;
+  // The pyramid of the last source stands in for the one of the last frame.
+  const ImagePyramid *cur_pyramid = NULL;
+  const ImagePyramid *last_pyramid = NULL;
 
   MODE_INFO mi_above, mi_left;
 
@@ -853,6 +863,11 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
   xd->mi = cm->mi_grid_visible + xd->mi_stride * (mb_row << 1) + mb_col_start;
   xd->mi[0] = cm->mi + xd->mi_stride * (mb_row << 1) + mb_col_start;
 
+  if (cpi->sf.use_pyramid_me && !frame_is_intra_only(cm)) {
+    cur_pyramid = vp9_get_pyramid(cpi, cpi->Source);
+    last_pyramid = vp9_get_pyramid(cpi, cpi->unscaled_last_source);
+  }
+
   for (i = 0; i < MAX_MB_PLANE; ++i) {
     p[i].coeff = ctx->coeff_pbuf[i][1];
     p[i].qcoeff = ctx->qcoeff_pbuf[i][1];
@@ -1084,7 +1099,8 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
       if (raw_motion_error > NZ_MOTION_PENALTY) {
         // Test last reference frame using the previous best mv as the
         // starting point (best reference) for the search.
-        first_pass_motion_search(cpi, x, best_ref_mv, &mv, &motion_error);
+        first_pass_motion_search(cpi, x, best_ref_mv, cur_pyramid,
+                                 last_pyramid, &mv, &motion_error);
 
         v_fn_ptr.vf = get_block_variance_fn(bsize);
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -1099,7 +1115,8 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
         // 0,0 based search as well.
         if (!is_zero_mv(best_ref_mv)) {
           tmp_err = INT_MAX;
-          first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv, &tmp_err);
+          first_pass_motion_search(cpi, x, &zero_mv, NULL, NULL, &tmp_mv,
+                                   &tmp_err);
 
           if (tmp_err < motion_error) {
             motion_error = tmp_err;
@@ -1128,7 +1145,8 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
                                                  &xd->plane[0].pre[0]);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
-          first_pass_motion_search(cpi, x, &zero_mv, &tmp_mv, &gf_motion_error);
+          first_pass_motion_search(cpi, x, &zero_mv, NULL, NULL, &tmp_mv,
+                                   &gf_motion_error);
 
           if (gf_motion_error < motion_error && gf_motion_error < this_error)
             ++(fp_acc_data->second_ref_count);
@@ -1377,6 +1395,13 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
     vp9_setup_pre_planes(xd, 0, first_ref_buf, 0, 0, NULL);
   }
 
+  // The pyramids are shared by the row workers.
+  if (cpi->sf.use_pyramid_me) {
+    vp9_prepare_pyramid(cpi, cpi->Source);
+    if (!frame_is_intra_only(cm))
+      vp9_prepare_pyramid(cpi, cpi->unscaled_last_source);
+  }
+
   xd->mi = cm->mi_grid_visible;
   xd->mi[0] = cm->mi;
 
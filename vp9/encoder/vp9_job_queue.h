@@ -11,10 +11,14 @@
 #ifndef VPX_VP9_ENCODER_VP9_JOB_QUEUE_H_
 #define VPX_VP9_ENCODER_VP9_JOB_QUEUE_H_
 
+#include "./vpx_config.h"
+#include "vpx_util/vpx_atomics.h"
+
 typedef enum {
   FIRST_PASS_JOB,
   ENCODE_JOB,
   ARNR_JOB,
+  TPL_JOB,
   NUM_JOB_TYPES,
 } JOB_TYPE;
 
@@ -27,20 +31,24 @@ typedef struct {
 
 // Job queue element parameters
 typedef struct {
-  // Pointer to the next link in the job queue
-  void *next;
-
   // Job information context of the module
   JobNode job_info;
 } JobQueue;
 
 // Job queue handle
 typedef struct {
-  // Pointer to the next link in the job queue
-  void *next;
-
-  // Counter to store the number of jobs picked up for processing
+  // First job of the tile. The jobs of a tile are stored contiguously and
+  // handed out in order, since each row depends on the row above.
+  JobQueue *first;
+
+  // Counter to store the number of jobs picked up for processing. A thread
+  // claims the next job by incrementing it, so it may exceed the number of
+  // jobs once the queue is empty.
+#if CONFIG_MULTITHREAD
+  vpx_atomic_int num_jobs_acquired;
+#else
   int num_jobs_acquired;
+#endif
 } JobQueueHandle;
 
 #endif  // VPX_VP9_ENCODER_VP9_JOB_QUEUE_H_
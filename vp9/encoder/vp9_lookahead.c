@@ -29,12 +29,34 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx, int *idx) {
   return buf;
 }
 
+// Hands a frame held by reference back to the application.
+static void release_ref(struct lookahead_entry *buf) {
+  if (buf->ref_img != NULL) {
+    buf->release_cb.release_source(buf->release_cb.user_priv, buf->ref_img);
+    buf->ref_img = NULL;
+    buf->extend_pending = 0;
+    buf->img = buf->copy_img;
+  }
+}
+
+// Frames held by reference get their border on first use.
+static void extend_ref(struct lookahead_entry *buf) {
+  if (buf->extend_pending) {
+    vp9_extend_frame_in_place(&buf->img);
+    buf->extend_pending = 0;
+  }
+}
+
 void vp9_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
     if (ctx->buf) {
       int i;
 
-      for (i = 0; i < ctx->max_sz; i++) vpx_free_frame_buffer(&ctx->buf[i].img);
+      for (i = 0; i < ctx->max_sz; i++) {
+        release_ref(&ctx->buf[i]);
+        vpx_free_frame_buffer(&ctx->buf[i].copy_img);
+        vp9_pyramid_free(&ctx->buf[i].pyramid);
+      }
       free(ctx->buf);
     }
     free(ctx);
@@ -66,14 +88,17 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
     ctx->buf = calloc(depth, sizeof(*ctx->buf));
     ctx->next_show_idx = 0;
     if (!ctx->buf) goto bail;
-    for (i = 0; i < depth; i++)
+    for (i = 0; i < depth; i++) {
       if (vpx_alloc_frame_buffer(
-              &ctx->buf[i].img, width, height, subsampling_x, subsampling_y,
+              &ctx->buf[i].copy_img, width, height, subsampling_x,
+              subsampling_y,
 #if CONFIG_VP9_HIGHBITDEPTH
               use_highbitdepth,
 #endif
               VP9_ENC_BORDER_IN_PIXELS, legacy_byte_alignment))
         goto bail;
+      ctx->buf[i].img = ctx->buf[i].copy_img;
+    }
   }
   return ctx;
 bail:
@@ -114,6 +139,7 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
   if (vp9_lookahead_full(ctx)) return 1;
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  release_ref(buf);
 
   new_dimensions = width != buf->img.y_crop_width ||
                    height != buf->img.y_crop_height ||
@@ -189,7 +215,72 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
 #if USE_PARTIAL_COPY
   }
 #endif
+  buf->copy_img = buf->img;
+  buf->pyramid.valid = 0;
+
+  buf->ts_start = ts_start;
+  buf->ts_end = ts_end;
+  buf->flags = flags;
+  buf->show_idx = ctx->next_show_idx;
+  ++ctx->next_show_idx;
+  return 0;
+}
+
+int vp9_lookahead_push_ref(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+                           int64_t ts_start, int64_t ts_end,
+                           int use_highbitdepth, vpx_enc_frame_flags_t flags,
+                           const vpx_codec_release_source_cb_t *release_cb,
+                           const vpx_image_t *img) {
+  struct lookahead_entry *buf;
+  YV12_BUFFER_CONFIG frame;
+  const int aligned_width = (src->y_crop_width + 7) & ~7;
+  const int aligned_height = (src->y_crop_height + 7) & ~7;
+
+  if (vp9_lookahead_full(ctx)) {
+    release_cb->release_source(release_cb->user_priv, img);
+    return 1;
+  }
+
+  // The temporal filter, the TPL model and the motion search on source frames
+  // use the same offsets into frames of the same size, so src can only be held
+  // if its strides match those of the buffers frames are copied to.
+  if (src->y_stride != ctx->buf[ctx->write_idx].copy_img.y_stride ||
+      src->uv_stride != ctx->buf[ctx->write_idx].copy_img.uv_stride) {
+    const int res = vp9_lookahead_push(ctx, src, ts_start, ts_end,
+                                       use_highbitdepth, flags);
+    release_cb->release_source(release_cb->user_priv, img);
+    return res;
+  }
+
+  // Describe src the way vpx_alloc_frame_buffer() lays out a copy of it.
+  memset(&frame, 0, sizeof(frame));
+  frame.y_crop_width = src->y_crop_width;
+  frame.y_crop_height = src->y_crop_height;
+  frame.y_width = aligned_width;
+  frame.y_height = aligned_height;
+  frame.y_stride = src->y_stride;
+  frame.uv_crop_width = src->uv_crop_width;
+  frame.uv_crop_height = src->uv_crop_height;
+  frame.uv_width = aligned_width >> src->subsampling_x;
+  frame.uv_height = aligned_height >> src->subsampling_y;
+  frame.uv_stride = src->uv_stride;
+  frame.y_buffer = src->y_buffer;
+  frame.u_buffer = src->u_buffer;
+  frame.v_buffer = src->v_buffer;
+  frame.subsampling_x = src->subsampling_x;
+  frame.subsampling_y = src->subsampling_y;
+  frame.border = VP9_ENC_BORDER_IN_PIXELS;
+  frame.flags = src->flags;
 
+  ctx->sz++;
+  buf = pop(ctx, &ctx->write_idx);
+  release_ref(buf);
+
+  buf->img = frame;
+  buf->ref_img = img;
+  buf->release_cb = *release_cb;
+  buf->extend_pending = 1;
+  buf->pyramid.valid = 0;
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
   buf->flags = flags;
@@ -205,6 +296,15 @@ struct lookahead_entry *vp9_lookahead_pop(struct lookahead_ctx *ctx,
   if (ctx && ctx->sz && (drain || ctx->sz == ctx->max_sz - MAX_PRE_FRAMES)) {
     buf = pop(ctx, &ctx->read_idx);
     ctx->sz--;
+    // The frames of backward peeks made before this pop may still be in use,
+    // the one before them is not. When the queue is full, its slot holds a
+    // queued frame and it was released by vp9_lookahead_push().
+    if (ctx->sz + MAX_PRE_FRAMES + 2 <= ctx->max_sz) {
+      int index = ctx->read_idx - 2 - MAX_PRE_FRAMES;
+      if (index < 0) index += ctx->max_sz;
+      release_ref(&ctx->buf[index]);
+    }
+    extend_ref(buf);
   }
   return buf;
 }
@@ -229,6 +329,7 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
     }
   }
 
+  if (buf != NULL) extend_ref(buf);
   return buf;
 }
 
@@ -12,8 +12,10 @@
 #define VPX_VP9_ENCODER_VP9_LOOKAHEAD_H_
 
 #include "vpx_scale/yv12config.h"
+#include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 #include "vpx/vpx_integer.h"
+#include "vp9/encoder/vp9_pyramid.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +29,13 @@ struct lookahead_entry {
   int64_t ts_end;
   int show_idx; /*The show_idx of this frame*/
   vpx_enc_frame_flags_t flags;
+  // Application image img points into when the frame is held by reference,
+  // NULL if img is a copy in copy_img.
+  const vpx_image_t *ref_img;
+  vpx_codec_release_source_cb_t release_cb;
+  int extend_pending; /* The border of ref_img is not extended yet */
+  YV12_BUFFER_CONFIG copy_img; /* Buffer frames are copied to */
+  ImagePyramid pyramid;        /* Built on demand from img */
 };
 
 // The max of past frames we want to keep in the queue.
@@ -96,6 +105,24 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
                        int64_t ts_start, int64_t ts_end, int use_highbitdepth,
                        vpx_enc_frame_flags_t flags);
 
+/**\brief Enqueue a source buffer held by reference
+ *
+ * Like vp9_lookahead_push(), but the frame is not copied if src has the
+ * strides of the lookahead buffers: img, which src describes, is then passed
+ * to release_cb once the frame is no longer read, and the border of src is
+ * extended in place when the frame is first peeked or popped. Otherwise the
+ * frame is copied and img released right away. img is released on failure
+ * too.
+ *
+ * \param[in] release_cb  Callback releasing img
+ * \param[in] img         Application image src points into
+ */
+int vp9_lookahead_push_ref(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+                           int64_t ts_start, int64_t ts_end,
+                           int use_highbitdepth, vpx_enc_frame_flags_t flags,
+                           const vpx_codec_release_source_cb_t *release_cb,
+                           const vpx_image_t *img);
+
 /**\brief Get the next source buffer to encode
  *
  *
@@ -18,13 +18,14 @@
 #include "vpx_ports/system_state.h"
 #include "vp9/encoder/vp9_segmentation.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#include "vp9/encoder/vp9_pyramid.h"
 #include "vp9/common/vp9_blockd.h"
 #include "vp9/common/vp9_reconinter.h"
 #include "vp9/common/vp9_reconintra.h"
 
-static unsigned int do_16x16_motion_iteration(VP9_COMP *cpi, const MV *ref_mv,
-                                              MV *dst_mv, int mb_row,
-                                              int mb_col) {
+static unsigned int do_16x16_motion_iteration(
+    VP9_COMP *cpi, const MV *ref_mv, const ImagePyramid *cur_pyramid,
+    const ImagePyramid *ref_pyramid, MV *dst_mv, int mb_row, int mb_col) {
   MACROBLOCK *const x = &cpi->td.mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
@@ -42,6 +43,8 @@ static unsigned int do_16x16_motion_iteration(VP9_COMP *cpi, const MV *ref_mv,
 
   ref_full.col = ref_mv->col >> 3;
   ref_full.row = ref_mv->row >> 3;
+  vp9_pyramid_seed_mv(cpi, x, BLOCK_16X16, cur_pyramid, ref_pyramid,
+                      mb_row << 1, mb_col << 1, &ref_full);
 
   mv_sf->search_method = HEX;
   vp9_full_pixel_search(cpi, x, BLOCK_16X16, &ref_full, step_param,
@@ -75,6 +78,8 @@ static unsigned int do_16x16_motion_iteration(VP9_COMP *cpi, const MV *ref_mv,
 }
 
 static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
+                                  const ImagePyramid *cur_pyramid,
+                                  const ImagePyramid *ref_pyramid,
                                   int_mv *dst_mv, int mb_row, int mb_col) {
   MACROBLOCK *const x = &cpi->td.mb;
   MACROBLOCKD *const xd = &x->e_mbd;
@@ -89,7 +94,8 @@ static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
 
   // Test last reference frame using the previous best mv as the
   // starting point (best reference) for the search
-  tmp_err = do_16x16_motion_iteration(cpi, ref_mv, &tmp_mv, mb_row, mb_col);
+  tmp_err = do_16x16_motion_iteration(cpi, ref_mv, cur_pyramid, ref_pyramid,
+                                      &tmp_mv, mb_row, mb_col);
   if (tmp_err < err) {
     err = tmp_err;
     dst_mv->as_mv = tmp_mv;
@@ -101,8 +107,8 @@ static int do_16x16_motion_search(VP9_COMP *cpi, const MV *ref_mv,
     unsigned int tmp_err;
     MV zero_ref_mv = { 0, 0 }, tmp_mv;
 
-    tmp_err =
-        do_16x16_motion_iteration(cpi, &zero_ref_mv, &tmp_mv, mb_row, mb_col);
+    tmp_err = do_16x16_motion_iteration(cpi, &zero_ref_mv, NULL, NULL, &tmp_mv,
+                                        mb_row, mb_col);
     if (tmp_err < err) {
       dst_mv->as_mv = tmp_mv;
       err = tmp_err;
@@ -160,8 +166,10 @@ static void update_mbgraph_mb_stats(VP9_COMP *cpi, MBGRAPH_MB_STATS *stats,
                                     YV12_BUFFER_CONFIG *buf, int mb_y_offset,
                                     YV12_BUFFER_CONFIG *golden_ref,
                                     const MV *prev_golden_ref_mv,
-                                    YV12_BUFFER_CONFIG *alt_ref, int mb_row,
-                                    int mb_col) {
+                                    YV12_BUFFER_CONFIG *alt_ref,
+                                    const ImagePyramid *cur_pyramid,
+                                    const ImagePyramid *gld_pyramid,
+                                    int mb_row, int mb_col) {
   MACROBLOCK *const x = &cpi->td.mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   int intra_error;
@@ -185,8 +193,9 @@ static void update_mbgraph_mb_stats(VP9_COMP *cpi, MBGRAPH_MB_STATS *stats,
     xd->plane[0].pre[0].buf = golden_ref->y_buffer + mb_y_offset;
     xd->plane[0].pre[0].stride = golden_ref->y_stride;
     g_motion_error =
-        do_16x16_motion_search(cpi, prev_golden_ref_mv,
-                               &stats->ref[GOLDEN_FRAME].m.mv, mb_row, mb_col);
+        do_16x16_motion_search(cpi, prev_golden_ref_mv, cur_pyramid,
+                               gld_pyramid, &stats->ref[GOLDEN_FRAME].m.mv,
+                               mb_row, mb_col);
     stats->ref[GOLDEN_FRAME].err = g_motion_error;
   } else {
     stats->ref[GOLDEN_FRAME].err = INT_MAX;
@@ -223,6 +232,13 @@ static void update_mbgraph_frame_stats(VP9_COMP *cpi,
   MV gld_top_mv = { 0, 0 };
   MODE_INFO mi_local;
   MODE_INFO mi_above, mi_left;
+  const ImagePyramid *cur_pyramid = NULL;
+  const ImagePyramid *gld_pyramid = NULL;
+
+  if (cpi->sf.use_pyramid_me) {
+    cur_pyramid = vp9_get_pyramid(cpi, buf);
+    gld_pyramid = vp9_get_pyramid(cpi, golden_ref);
+  }
 
   vp9_zero(mi_local);
   // Set up limit values for motion vectors to prevent them extending outside
@@ -257,7 +273,8 @@ static void update_mbgraph_frame_stats(VP9_COMP *cpi,
       MBGRAPH_MB_STATS *mb_stats = &stats->mb_stats[offset + mb_col];
 
       update_mbgraph_mb_stats(cpi, mb_stats, buf, mb_y_in_offset, golden_ref,
-                              &gld_left_mv, alt_ref, mb_row, mb_col);
+                              &gld_left_mv, alt_ref, cur_pyramid, gld_pyramid,
+                              mb_row, mb_col);
       gld_left_mv = mb_stats->ref[GOLDEN_FRAME].m.mv.as_mv;
       if (mb_col == 0) {
         gld_top_mv = gld_left_mv;
@@ -382,6 +399,12 @@ void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
            cm->mb_rows * cm->mb_cols * sizeof(*cpi->mbgraph_stats[i].mb_stats));
   }
 
+  if (cpi->sf.use_pyramid_me) {
+    vp9_prepare_pyramid(cpi, golden_ref);
+    for (i = 0; i < n_frames; i++)
+      vp9_prepare_pyramid(cpi, &vp9_lookahead_peek(cpi->lookahead, i)->img);
+  }
+
   // do motion search to find contribution of each reference to data
   // later on in this GF group
   // FIXME really, the GF/last MC search should be done forward, and
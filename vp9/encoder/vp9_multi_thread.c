@@ -15,40 +15,48 @@
 #include "vp9/encoder/vp9_multi_thread.h"
 #include "vp9/encoder/vp9_temporal_filter.h"
 
-void *vp9_enc_grp_get_next_job(MultiThreadHandle *multi_thread_ctxt,
-                               int tile_id) {
-  RowMTInfo *row_mt_info;
-  JobQueueHandle *job_queue_hdl = NULL;
-  void *next = NULL;
-  JobNode *job_info = NULL;
+static INLINE int get_num_jobs_acquired(JobQueueHandle *job_queue_hdl) {
 #if CONFIG_MULTITHREAD
-  pthread_mutex_t *mutex_handle = NULL;
+  return vpx_atomic_load_acquire(&job_queue_hdl->num_jobs_acquired);
+#else
+  return job_queue_hdl->num_jobs_acquired;
 #endif
+}
 
-  row_mt_info = (RowMTInfo *)(&multi_thread_ctxt->row_mt_info[tile_id]);
-  job_queue_hdl = (JobQueueHandle *)&row_mt_info->job_queue_hdl;
+static INLINE void add_tile_worker(RowMTInfo *row_mt_info, int value) {
 #if CONFIG_MULTITHREAD
-  mutex_handle = &row_mt_info->job_mutex;
+  vpx_atomic_fetch_add(&row_mt_info->num_workers, value);
+#else
+  row_mt_info->num_workers += value;
 #endif
+}
 
-// lock the mutex for queue access
+static INLINE int get_tile_workers(RowMTInfo *row_mt_info) {
 #if CONFIG_MULTITHREAD
-  pthread_mutex_lock(mutex_handle);
+  return vpx_atomic_load_acquire(&row_mt_info->num_workers);
+#else
+  return row_mt_info->num_workers;
 #endif
-  next = job_queue_hdl->next;
-  if (NULL != next) {
-    JobQueue *job_queue = (JobQueue *)next;
-    job_info = &job_queue->job_info;
-    // Update the next job in the queue
-    job_queue_hdl->next = job_queue->next;
-    job_queue_hdl->num_jobs_acquired++;
-  }
+}
+
+void *vp9_enc_grp_get_next_job(MultiThreadHandle *multi_thread_ctxt,
+                               int tile_id) {
+  RowMTInfo *const row_mt_info = &multi_thread_ctxt->row_mt_info[tile_id];
+  JobQueueHandle *const job_queue_hdl = &row_mt_info->job_queue_hdl;
+  const int jobs_per_tile_col = multi_thread_ctxt->jobs_per_tile_col;
+  int job_num;
+
+  // Don't bump the counter of a tile that is known to be done.
+  if (get_num_jobs_acquired(job_queue_hdl) >= jobs_per_tile_col) return NULL;
 
 #if CONFIG_MULTITHREAD
-  pthread_mutex_unlock(mutex_handle);
+  job_num = vpx_atomic_fetch_add(&job_queue_hdl->num_jobs_acquired, 1);
+#else
+  job_num = job_queue_hdl->num_jobs_acquired++;
 #endif
+  if (job_num >= jobs_per_tile_col) return NULL;
 
-  return job_info;
+  return &job_queue_hdl->first[job_num].job_info;
 }
 
 void vp9_row_mt_alloc_rd_thresh(VP9_COMP *const cpi,
@@ -87,14 +95,6 @@ void vp9_row_mt_mem_alloc(VP9_COMP *cpi) {
   multi_thread_ctxt->job_queue =
       (JobQueue *)vpx_memalign(32, total_jobs * sizeof(JobQueue));
 
-#if CONFIG_MULTITHREAD
-  // Create mutex for each tile
-  for (tile_col = 0; tile_col < tile_cols; tile_col++) {
-    RowMTInfo *row_mt_info = &multi_thread_ctxt->row_mt_info[tile_col];
-    pthread_mutex_init(&row_mt_info->job_mutex, NULL);
-  }
-#endif
-
   // Allocate memory for row based multi-threading
   for (tile_col = 0; tile_col < tile_cols; tile_col++) {
     TileDataEnc *this_tile = &cpi->tile_data[tile_col];
@@ -136,15 +136,6 @@ void vp9_row_mt_mem_dealloc(VP9_COMP *cpi) {
   // Deallocate memory for job queue
   if (multi_thread_ctxt->job_queue) vpx_free(multi_thread_ctxt->job_queue);
 
-#if CONFIG_MULTITHREAD
-  // Destroy mutex for each tile
-  for (tile_col = 0; tile_col < multi_thread_ctxt->allocated_tile_cols;
-       tile_col++) {
-    RowMTInfo *row_mt_info = &multi_thread_ctxt->row_mt_info[tile_col];
-    if (row_mt_info) pthread_mutex_destroy(&row_mt_info->job_mutex);
-  }
-#endif
-
   // Free row based multi-threading sync memory
   for (tile_col = 0; tile_col < multi_thread_ctxt->allocated_tile_cols;
        tile_col++) {
@@ -201,29 +192,11 @@ void vp9_assign_tile_to_thread(MultiThreadHandle *multi_thread_ctxt,
 
 int vp9_get_job_queue_status(MultiThreadHandle *multi_thread_ctxt,
                              int cur_tile_id) {
-  RowMTInfo *row_mt_info;
-  JobQueueHandle *job_queue_hndl;
-#if CONFIG_MULTITHREAD
-  pthread_mutex_t *mutex;
-#endif
-  int num_jobs_remaining;
+  RowMTInfo *const row_mt_info = &multi_thread_ctxt->row_mt_info[cur_tile_id];
+  const int num_jobs_acquired =
+      get_num_jobs_acquired(&row_mt_info->job_queue_hdl);
 
-  row_mt_info = &multi_thread_ctxt->row_mt_info[cur_tile_id];
-  job_queue_hndl = &row_mt_info->job_queue_hdl;
-#if CONFIG_MULTITHREAD
-  mutex = &row_mt_info->job_mutex;
-#endif
-
-#if CONFIG_MULTITHREAD
-  pthread_mutex_lock(mutex);
-#endif
-  num_jobs_remaining =
-      multi_thread_ctxt->jobs_per_tile_col - job_queue_hndl->num_jobs_acquired;
-#if CONFIG_MULTITHREAD
-  pthread_mutex_unlock(mutex);
-#endif
-
-  return (num_jobs_remaining);
+  return VPXMAX(multi_thread_ctxt->jobs_per_tile_col - num_jobs_acquired, 0);
 }
 
 void vp9_prepare_job_queue(VP9_COMP *cpi, JOB_TYPE job_type) {
@@ -241,6 +214,7 @@ void vp9_prepare_job_queue(VP9_COMP *cpi, JOB_TYPE job_type) {
     case ARNR_JOB:
       jobs_per_tile_col = ((cm->mi_rows + TF_ROUND) >> TF_SHIFT);
       break;
+    case TPL_JOB: jobs_per_tile_col = sb_rows; break;
     default: assert(0);
   }
 
@@ -253,23 +227,23 @@ void vp9_prepare_job_queue(VP9_COMP *cpi, JOB_TYPE job_type) {
   // Job queue preparation
   for (tile_col = 0; tile_col < tile_cols; tile_col++) {
     RowMTInfo *tile_ctxt = &multi_thread_ctxt->row_mt_info[tile_col];
-    JobQueue *job_queue_curr, *job_queue_temp;
     int tile_row = 0;
 
-    tile_ctxt->job_queue_hdl.next = (void *)job_queue;
+    tile_ctxt->job_queue_hdl.first = job_queue;
+#if CONFIG_MULTITHREAD
+    vpx_atomic_init(&tile_ctxt->job_queue_hdl.num_jobs_acquired, 0);
+    vpx_atomic_init(&tile_ctxt->num_workers, 0);
+#else
     tile_ctxt->job_queue_hdl.num_jobs_acquired = 0;
-
-    job_queue_curr = job_queue;
-    job_queue_temp = job_queue;
+    tile_ctxt->num_workers = 0;
+#endif
 
     // loop over all the vertical rows
     for (job_row_num = 0, jobs_per_tile = 0; job_row_num < jobs_per_tile_col;
          job_row_num++, jobs_per_tile++) {
-      job_queue_curr->job_info.vert_unit_row_num = job_row_num;
-      job_queue_curr->job_info.tile_col_id = tile_col;
-      job_queue_curr->job_info.tile_row_id = tile_row;
-      job_queue_curr->next = (void *)(job_queue_temp + 1);
-      job_queue_curr = ++job_queue_temp;
+      job_queue[job_row_num].job_info.vert_unit_row_num = job_row_num;
+      job_queue[job_row_num].job_info.tile_col_id = tile_col;
+      job_queue[job_row_num].job_info.tile_row_id = tile_row;
 
       if (ENCODE_JOB == job_type) {
         if (jobs_per_tile >=
@@ -280,21 +254,21 @@ void vp9_prepare_job_queue(VP9_COMP *cpi, JOB_TYPE job_type) {
       }
     }
 
-    // Set the last pointer to NULL
-    job_queue_curr += -1;
-    job_queue_curr->next = (void *)NULL;
-
     // Move to the next tile
     job_queue += jobs_per_tile_col;
   }
 
   for (i = 0; i < cpi->num_workers; i++) {
     EncWorkerData *thread_data;
+    const int tile_id = multi_thread_ctxt->thread_id_to_tile_id[i];
     thread_data = &cpi->tile_thr_data[i];
     thread_data->thread_id = i;
+    thread_data->job_time = 0;
 
     for (tile_col = 0; tile_col < tile_cols; tile_col++)
       thread_data->tile_completion_status[tile_col] = 0;
+
+    add_tile_worker(&multi_thread_ctxt->row_mt_info[tile_id], 1);
   }
 }
 
@@ -302,22 +276,34 @@ int vp9_get_tiles_proc_status(MultiThreadHandle *multi_thread_ctxt,
                               int *tile_completion_status, int *cur_tile_id,
                               int tile_cols) {
   int tile_col;
-  int tile_id = -1;  // Stores the tile ID with minimum proc done
+  int tile_id = -1;  // Stores the tile ID with the most work left per thread
   int max_num_jobs_remaining = 0;
+  int max_num_workers = 0;
   int num_jobs_remaining;
 
   // Mark the completion to avoid check in the loop
   tile_completion_status[*cur_tile_id] = 1;
+  add_tile_worker(&multi_thread_ctxt->row_mt_info[*cur_tile_id], -1);
   // Check for the status of all the tiles
   for (tile_col = 0; tile_col < tile_cols; tile_col++) {
     if (tile_completion_status[tile_col] == 0) {
       num_jobs_remaining =
           vp9_get_job_queue_status(multi_thread_ctxt, tile_col);
       // Mark the completion to avoid checks during future switches across tiles
-      if (num_jobs_remaining == 0) tile_completion_status[tile_col] = 1;
-      if (num_jobs_remaining > max_num_jobs_remaining) {
-        max_num_jobs_remaining = num_jobs_remaining;
-        tile_id = tile_col;
+      if (num_jobs_remaining == 0) {
+        tile_completion_status[tile_col] = 1;
+      } else {
+        // Rows of a tile can only run a few superblocks apart, so prefer the
+        // tile with the most jobs left for each thread already working on it
+        // over the one with the most jobs left.
+        const int num_workers =
+            get_tile_workers(&multi_thread_ctxt->row_mt_info[tile_col]);
+        if ((int64_t)num_jobs_remaining * (max_num_workers + 1) >
+            (int64_t)max_num_jobs_remaining * (num_workers + 1)) {
+          max_num_jobs_remaining = num_jobs_remaining;
+          max_num_workers = num_workers;
+          tile_id = tile_col;
+        }
       }
     }
   }
@@ -325,9 +311,9 @@ int vp9_get_tiles_proc_status(MultiThreadHandle *multi_thread_ctxt,
   if (-1 == tile_id) {
     return 1;
   } else {
-    // Update the cur ID to the next tile ID that will be processed,
-    // which will be the least processed tile
+    // Update the cur ID to the next tile ID that will be processed
     *cur_tile_id = tile_id;
+    add_tile_worker(&multi_thread_ctxt->row_mt_info[tile_id], 1);
     return 0;
   }
 }
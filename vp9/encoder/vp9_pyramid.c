@@ -0,0 +1,284 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <limits.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/common/vp9_common_data.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_lookahead.h"
+#include "vp9/encoder/vp9_pyramid.h"
+
+// Levels smaller than this are not worth searching.
+#define PYRAMID_MIN_SIZE 16
+
+// The search compares PYRAMID_BLOCK x PYRAMID_BLOCK windows centered on the
+// block at each level, so the coarse levels see the block and its
+// surroundings. The coarsest level is searched exhaustively over
+// +/-PYRAMID_SEARCH_RANGE and each finer level refines the scaled up vector
+// by +/-1.
+#define PYRAMID_BLOCK 8
+#define PYRAMID_SEARCH_RANGE 4
+
+static void downscale_plane(const uint8_t *src, int src_stride, int src_width,
+                            int src_height, uint8_t *dst, int dst_stride,
+                            int dst_width, int dst_height) {
+  int r, c;
+  for (r = 0; r < dst_height; ++r) {
+    const uint8_t *const src0 = src + 2 * r * src_stride;
+    const uint8_t *const src1 =
+        2 * r + 1 < src_height ? src0 + src_stride : src0;
+    for (c = 0; c < dst_width; ++c) {
+      const int c0 = 2 * c;
+      const int c1 = VPXMIN(c0 + 1, src_width - 1);
+      dst[c] = (src0[c0] + src0[c1] + src1[c0] + src1[c1] + 2) >> 2;
+    }
+    dst += dst_stride;
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void highbd_downscale_plane(const uint16_t *src, int src_stride,
+                                   int src_width, int src_height, uint8_t *dst,
+                                   int dst_stride, int dst_width,
+                                   int dst_height, int bit_depth) {
+  const int shift = 2 + bit_depth - 8;
+  const int round = 1 << (shift - 1);
+  int r, c;
+  for (r = 0; r < dst_height; ++r) {
+    const uint16_t *const src0 = src + 2 * r * src_stride;
+    const uint16_t *const src1 =
+        2 * r + 1 < src_height ? src0 + src_stride : src0;
+    for (c = 0; c < dst_width; ++c) {
+      const int c0 = 2 * c;
+      const int c1 = VPXMIN(c0 + 1, src_width - 1);
+      dst[c] = (src0[c0] + src0[c1] + src1[c0] + src1[c1] + round) >> shift;
+    }
+    dst += dst_stride;
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+static int alloc_pyramid(ImagePyramid *pyramid, int width, int height) {
+  size_t size = 0;
+  int level_width = width;
+  int level_height = height;
+  int i;
+
+  pyramid->num_levels = 0;
+  for (i = 0; i < MAX_PYRAMID_LEVELS; ++i) {
+    level_width = (level_width + 1) >> 1;
+    level_height = (level_height + 1) >> 1;
+    if (level_width < PYRAMID_MIN_SIZE || level_height < PYRAMID_MIN_SIZE)
+      break;
+    pyramid->level_width[i] = level_width;
+    pyramid->level_height[i] = level_height;
+    pyramid->level_stride[i] = (level_width + 15) & ~15;
+    size += (size_t)pyramid->level_stride[i] * level_height;
+    ++pyramid->num_levels;
+  }
+
+  if (size > pyramid->buffer_alloc_sz) {
+    vpx_free(pyramid->buffer_alloc);
+    pyramid->buffer_alloc_sz = 0;
+    pyramid->buffer_alloc = (uint8_t *)vpx_memalign(16, size);
+    if (pyramid->buffer_alloc == NULL) return -1;
+    pyramid->buffer_alloc_sz = size;
+  }
+
+  size = 0;
+  for (i = 0; i < pyramid->num_levels; ++i) {
+    pyramid->level_buf[i] = pyramid->buffer_alloc + size;
+    size += (size_t)pyramid->level_stride[i] * pyramid->level_height[i];
+  }
+  return 0;
+}
+
+int vp9_pyramid_build(ImagePyramid *pyramid, const YV12_BUFFER_CONFIG *frame,
+                      int bit_depth) {
+  int i;
+
+  pyramid->valid = 0;
+  if (alloc_pyramid(pyramid, frame->y_crop_width, frame->y_crop_height))
+    return -1;
+  pyramid->width = frame->y_crop_width;
+  pyramid->height = frame->y_crop_height;
+
+  for (i = 0; i < pyramid->num_levels; ++i) {
+    if (i == 0) {
+#if CONFIG_VP9_HIGHBITDEPTH
+      if (frame->flags & YV12_FLAG_HIGHBITDEPTH) {
+        highbd_downscale_plane(
+            CONVERT_TO_SHORTPTR(frame->y_buffer), frame->y_stride,
+            frame->y_crop_width, frame->y_crop_height, pyramid->level_buf[0],
+            pyramid->level_stride[0], pyramid->level_width[0],
+            pyramid->level_height[0], bit_depth);
+        continue;
+      }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+      downscale_plane(frame->y_buffer, frame->y_stride, frame->y_crop_width,
+                      frame->y_crop_height, pyramid->level_buf[0],
+                      pyramid->level_stride[0], pyramid->level_width[0],
+                      pyramid->level_height[0]);
+    } else {
+      downscale_plane(pyramid->level_buf[i - 1], pyramid->level_stride[i - 1],
+                      pyramid->level_width[i - 1],
+                      pyramid->level_height[i - 1], pyramid->level_buf[i],
+                      pyramid->level_stride[i], pyramid->level_width[i],
+                      pyramid->level_height[i]);
+    }
+  }
+#if !CONFIG_VP9_HIGHBITDEPTH
+  (void)bit_depth;
+#endif
+
+  pyramid->valid = 1;
+  return 0;
+}
+
+void vp9_pyramid_free(ImagePyramid *pyramid) {
+  vpx_free(pyramid->buffer_alloc);
+  vp9_zero(*pyramid);
+}
+
+int vp9_pyramid_motion_search(const ImagePyramid *cur, const ImagePyramid *ref,
+                              int mi_row, int mi_col, BLOCK_SIZE bsize,
+                              MV *mv) {
+  const int center_row =
+      mi_row * MI_SIZE + (num_4x4_blocks_high_lookup[bsize] << 1);
+  const int center_col =
+      mi_col * MI_SIZE + (num_4x4_blocks_wide_lookup[bsize] << 1);
+  int best_row = 0, best_col = 0;
+  int level;
+
+  if (cur == NULL || ref == NULL || !cur->valid || !ref->valid ||
+      cur->width != ref->width || cur->height != ref->height ||
+      cur->num_levels == 0)
+    return 0;
+
+  for (level = cur->num_levels - 1; level >= 0; --level) {
+    const int width = cur->level_width[level];
+    const int height = cur->level_height[level];
+    const int cur_stride = cur->level_stride[level];
+    const int ref_stride = ref->level_stride[level];
+    const int range =
+        level == cur->num_levels - 1 ? PYRAMID_SEARCH_RANGE : 1;
+    // Position of the window in the level.
+    const int y = clamp((center_row >> (level + 1)) - PYRAMID_BLOCK / 2, 0,
+                        height - PYRAMID_BLOCK);
+    const int x = clamp((center_col >> (level + 1)) - PYRAMID_BLOCK / 2, 0,
+                        width - PYRAMID_BLOCK);
+    const uint8_t *const src = cur->level_buf[level] + y * cur_stride + x;
+    const uint8_t *const pre = ref->level_buf[level] + y * ref_stride + x;
+    // The reference window stays inside the level.
+    const int row_center = clamp(best_row, -y, height - PYRAMID_BLOCK - y);
+    const int col_center = clamp(best_col, -x, width - PYRAMID_BLOCK - x);
+    const int row_min = VPXMAX(row_center - range, -y);
+    const int row_max = VPXMIN(row_center + range, height - PYRAMID_BLOCK - y);
+    const int col_min = VPXMAX(col_center - range, -x);
+    const int col_max = VPXMIN(col_center + range, width - PYRAMID_BLOCK - x);
+    unsigned int best_sad = vpx_sad8x8(
+        src, cur_stride, pre + row_center * ref_stride + col_center,
+        ref_stride);
+    int r, c;
+
+    best_row = row_center;
+    best_col = col_center;
+    for (r = row_min; r <= row_max; ++r) {
+      for (c = col_min; c <= col_max; ++c) {
+        unsigned int sad;
+        if (r == row_center && c == col_center) continue;
+        sad = vpx_sad8x8(src, cur_stride, pre + r * ref_stride + c, ref_stride);
+        if (sad < best_sad) {
+          best_sad = sad;
+          best_row = r;
+          best_col = c;
+        }
+      }
+    }
+
+    // Scale up to the next level, the finest level is at half resolution.
+    best_row *= 2;
+    best_col *= 2;
+  }
+
+  mv->row = best_row;
+  mv->col = best_col;
+  return 1;
+}
+
+static ImagePyramid *find_pyramid(VP9_COMP *cpi,
+                                  const YV12_BUFFER_CONFIG *frame) {
+  BufferPool *const pool = cpi->common.buffer_pool;
+  int i;
+
+  if (frame == NULL) return NULL;
+  for (i = 0; i < FRAME_BUFFERS; ++i) {
+    if (frame == &pool->frame_bufs[i].buf) return &cpi->frame_pyramid[i];
+  }
+  if (cpi->lookahead != NULL) {
+    for (i = 0; i < cpi->lookahead->max_sz; ++i) {
+      struct lookahead_entry *const buf = &cpi->lookahead->buf[i];
+      if (frame == &buf->img) return &buf->pyramid;
+    }
+  }
+  return NULL;
+}
+
+void vp9_prepare_pyramid(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *frame) {
+  ImagePyramid *const pyramid = find_pyramid(cpi, frame);
+
+  if (pyramid != NULL && !pyramid->valid &&
+      vp9_pyramid_build(pyramid, frame, (int)cpi->common.bit_depth)) {
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_MEM_ERROR,
+                       "Failed to allocate image pyramid");
+  }
+}
+
+const ImagePyramid *vp9_get_pyramid(VP9_COMP *cpi,
+                                    const YV12_BUFFER_CONFIG *frame) {
+  const ImagePyramid *const pyramid = find_pyramid(cpi, frame);
+  return pyramid != NULL && pyramid->valid ? pyramid : NULL;
+}
+
+void vp9_invalidate_frame_pyramids(VP9_COMP *cpi) {
+  int i;
+  for (i = 0; i < FRAME_BUFFERS; ++i) cpi->frame_pyramid[i].valid = 0;
+}
+
+void vp9_pyramid_seed_mv(const VP9_COMP *cpi, const MACROBLOCK *x,
+                         BLOCK_SIZE bsize, const ImagePyramid *cur,
+                         const ImagePyramid *ref, int mi_row, int mi_col,
+                         MV *start_mv) {
+  const struct buf_2d *const src = &x->plane[0].src;
+  const struct buf_2d *const pre = &x->e_mbd.plane[0].pre[0];
+  const MvLimits *const limits = &x->mv_limits;
+  MV start = *start_mv;
+  MV mv;
+
+  if (!vp9_pyramid_motion_search(cur, ref, mi_row, mi_col, bsize, &mv)) return;
+
+  clamp_mv(&mv, limits->col_min, limits->col_max, limits->row_min,
+           limits->row_max);
+  clamp_mv(&start, limits->col_min, limits->col_max, limits->row_min,
+           limits->row_max);
+  if (mv.row == start.row && mv.col == start.col) return;
+
+  if (cpi->fn_ptr[bsize].sdf(src->buf, src->stride,
+                             pre->buf + mv.row * pre->stride + mv.col,
+                             pre->stride) <
+      cpi->fn_ptr[bsize].sdf(src->buf, src->stride,
+                             pre->buf + start.row * pre->stride + start.col,
+                             pre->stride))
+    *start_mv = mv;
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_PYRAMID_H_
+#define VPX_VP9_ENCODER_VP9_PYRAMID_H_
+
+#include "vpx/vpx_integer.h"
+#include "vpx_scale/yv12config.h"
+#include "vp9/common/vp9_enums.h"
+#include "vp9/common/vp9_mv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Levels of 1/2, 1/4 and 1/8 of the frame size.
+#define MAX_PYRAMID_LEVELS 3
+
+// Downscaled copies of the luma plane of a frame, stored as 8 bit samples
+// whatever the bit depth of the frame.
+typedef struct ImagePyramid {
+  int valid;
+  int width;  // Size of the frame the pyramid was built from.
+  int height;
+  int num_levels;
+  int level_width[MAX_PYRAMID_LEVELS];
+  int level_height[MAX_PYRAMID_LEVELS];
+  int level_stride[MAX_PYRAMID_LEVELS];
+  uint8_t *level_buf[MAX_PYRAMID_LEVELS];
+  uint8_t *buffer_alloc;
+  size_t buffer_alloc_sz;
+} ImagePyramid;
+
+struct VP9_COMP;
+struct macroblock;
+
+// Builds the pyramid of frame. Returns -1 if memory could not be allocated.
+int vp9_pyramid_build(ImagePyramid *pyramid, const YV12_BUFFER_CONFIG *frame,
+                      int bit_depth);
+
+void vp9_pyramid_free(ImagePyramid *pyramid);
+
+// Estimates the full pixel motion of the block at mi_row, mi_col of cur in ref
+// by a coarse to fine search of their pyramids. Returns 0 if the pyramids
+// cannot be searched.
+int vp9_pyramid_motion_search(const ImagePyramid *cur, const ImagePyramid *ref,
+                              int mi_row, int mi_col, BLOCK_SIZE bsize,
+                              MV *mv);
+
+// Builds the pyramid of frame if it is a lookahead frame or a frame buffer of
+// the encoder. Pyramids have to be prepared before the motion searches using
+// them start, as those may run on several threads.
+void vp9_prepare_pyramid(struct VP9_COMP *cpi, const YV12_BUFFER_CONFIG *frame);
+
+// Returns the prepared pyramid of frame, or NULL if there is none.
+const ImagePyramid *vp9_get_pyramid(struct VP9_COMP *cpi,
+                                    const YV12_BUFFER_CONFIG *frame);
+
+// Marks the pyramids of the frame buffers as stale. Their content is rewritten
+// as frames get encoded.
+void vp9_invalidate_frame_pyramids(struct VP9_COMP *cpi);
+
+// Replaces the full pixel start_mv of a motion search of the block in x by the
+// pyramid estimate when the latter has a lower sad. The source and the
+// reference buffers of x must be set up for the block.
+void vp9_pyramid_seed_mv(const struct VP9_COMP *cpi,
+                         const struct macroblock *x, BLOCK_SIZE bsize,
+                         const ImagePyramid *cur, const ImagePyramid *ref,
+                         int mi_row, int mi_col, MV *start_mv);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_PYRAMID_H_
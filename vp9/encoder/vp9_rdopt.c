@@ -39,6 +39,7 @@
 #include "vp9/encoder/vp9_encodemv.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#include "vp9/encoder/vp9_pyramid.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -2579,6 +2580,13 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
   mvp_full.col >>= 3;
   mvp_full.row >>= 3;
 
+  if (cpi->sf.use_pyramid_me >= 2 && bsize >= BLOCK_16X16 &&
+      scaled_ref_frame == NULL) {
+    vp9_pyramid_seed_mv(cpi, x, bsize, vp9_get_pyramid(cpi, cpi->Source),
+                        vp9_get_pyramid(cpi, get_ref_frame_buffer(cpi, ref)),
+                        mi_row, mi_col, &mvp_full);
+  }
+
 #if CONFIG_NON_GREEDY_MV
   bestsme = vp9_full_pixel_diamond_new(cpi, x, bsize, &mvp_full, step_param,
                                        lambda, 1, nb_full_mvs, nb_full_mv_num,
@@ -302,6 +302,11 @@ typedef struct SPEED_FEATURES {
   // Temporal dependency model based encoding mode optimization
   int enable_tpl_model;
 
+  // Seed motion searches with a coarse to fine search on downscaled frames.
+  // 0: off. 1: first pass, mbgraph and TPL model searches. 2: also the rd mode
+  // search of blocks of 16x16 and above.
+  int use_pyramid_me;
+
   // Use transform domain distortion. Use pixel domain distortion in speed 0
   // and certain situations in higher speed to improve the RD model precision.
   int allow_txfm_domain_distortion;
@@ -0,0 +1,350 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_temporal_filter.h"
+#include "vp9/encoder/x86/temporal_filter_constants.h"
+
+// This follows temporal_filter_avx2.c with 32-bit squared differences, so
+// each pass works on a column of 8 pixels.
+
+// HIGHBD_NEIGHBOR_CONSTANT_n for each count n used by the filter.
+static const uint32_t highbd_neighbor_constants[14] = {
+  0,
+  0,
+  0,
+  0,
+  HIGHBD_NEIGHBOR_CONSTANT_4,
+  HIGHBD_NEIGHBOR_CONSTANT_5,
+  HIGHBD_NEIGHBOR_CONSTANT_6,
+  HIGHBD_NEIGHBOR_CONSTANT_7,
+  HIGHBD_NEIGHBOR_CONSTANT_8,
+  HIGHBD_NEIGHBOR_CONSTANT_9,
+  HIGHBD_NEIGHBOR_CONSTANT_10,
+  HIGHBD_NEIGHBOR_CONSTANT_11,
+  0,
+  HIGHBD_NEIGHBOR_CONSTANT_13
+};
+
+// Store the squared differences of a row of width pixels to dist, with a zero
+// value either side of the row.
+static INLINE void highbd_store_dist_row(const uint16_t *src,
+                                         const uint16_t *pre,
+                                         unsigned int width, uint32_t *dist) {
+  unsigned int i;
+
+  dist[-1] = 0;
+  for (i = 0; i < width; i += 8) {
+    const __m256i s =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+    const __m256i p =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(pre + i)));
+    const __m256i d = _mm256_sub_epi32(s, p);
+    _mm256_storeu_si256((__m256i *)(dist + i), _mm256_mullo_epi32(d, d));
+  }
+  dist[width] = 0;
+}
+
+static INLINE __m256i highbd_load_dist(const uint32_t *dist) {
+  return _mm256_loadu_si256((const __m256i *)dist);
+}
+
+// Sum each of 8 values in a row with its left and right neighbours.
+static INLINE __m256i highbd_sum_row_3(const uint32_t *dist) {
+  const __m256i sum =
+      _mm256_add_epi32(highbd_load_dist(dist - 1), highbd_load_dist(dist));
+  return _mm256_add_epi32(sum, highbd_load_dist(dist + 1));
+}
+
+// Load 4 values and repeat each of them, for the chroma of 8 luma pixels with
+// horizontal subsampling.
+static INLINE __m256i highbd_load_dist_dup(const uint32_t *dist) {
+  const __m256i d =
+      _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *)dist));
+  return _mm256_or_si256(d, _mm256_slli_epi64(d, 32));
+}
+
+// Sum each pair of the 16 values in d0 and d1, for the luma of 8 chroma pixels
+// with horizontal subsampling.
+static INLINE __m256i highbd_sum_pairs(const __m256i d0, const __m256i d1) {
+  return _mm256_permute4x64_epi64(_mm256_hadd_epi32(d0, d1), 0xd8);
+}
+
+// Return the multipliers for a row of 8 pixels that sum values from the given
+// number of rows plus extra values from the other planes. edge flags the
+// pixels on the left and right edges of the block.
+static INLINE __m256i highbd_get_mul_constants(const __m256i edge, int rows,
+                                               int extra) {
+  return _mm256_blendv_epi8(
+      _mm256_set1_epi32((int)highbd_neighbor_constants[3 * rows + extra]),
+      _mm256_set1_epi32((int)highbd_neighbor_constants[2 * rows + extra]),
+      edge);
+}
+
+static INLINE __m256i highbd_get_weights(const __m256i is_left, int left,
+                                         int right) {
+  return _mm256_blendv_epi8(_mm256_set1_epi32(right), _mm256_set1_epi32(left),
+                            is_left);
+}
+
+// Scale the sum of the values around each pixel to the modifier of the C
+// code. The division is the high half of a 32x32 bit product, which is
+// formed separately for the even and the odd lanes.
+static INLINE __m256i highbd_get_modifier(const __m256i sum, const __m256i mul,
+                                          const __m128i strength,
+                                          const __m256i rounding,
+                                          const __m256i weight) {
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(sum, mul), 32);
+  const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(sum, 32),
+                                       _mm256_srli_epi64(mul, 32));
+  __m256i mod = _mm256_blend_epi32(even, odd, 0xaa);
+  mod = _mm256_add_epi32(mod, rounding);
+  mod = _mm256_srl_epi32(mod, strength);
+  mod = _mm256_min_epu32(mod, sixteen);
+  return _mm256_mullo_epi32(_mm256_sub_epi32(sixteen, mod), weight);
+}
+
+// Add the modifiers of 8 pixels to count, and the modifiers multiplied by pred
+// to accumulator.
+static INLINE void highbd_accumulate_and_store(const __m256i mod,
+                                               const uint16_t *pred,
+                                               uint16_t *count,
+                                               uint32_t *accumulator) {
+  const __m128i mod_u16 = _mm_packus_epi32(_mm256_castsi256_si128(mod),
+                                           _mm256_extracti128_si256(mod, 1));
+  const __m256i pred_u32 =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)pred));
+  const __m256i accum =
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)accumulator),
+                       _mm256_mullo_epi32(mod, pred_u32));
+
+  _mm_storeu_si128(
+      (__m128i *)count,
+      _mm_adds_epu16(_mm_loadu_si128((const __m128i *)count), mod_u16));
+  _mm256_storeu_si256((__m256i *)accumulator, accum);
+}
+
+// Flag which of the 8 pixels starting at column col are on the left or right
+// edge of a block of the given width, and which are in its left half.
+static INLINE void highbd_get_column_masks(unsigned int col,
+                                           unsigned int width, __m256i *edge,
+                                           __m256i *is_left) {
+  const __m256i cols =
+      _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                       _mm256_set1_epi32((int)col));
+  *edge = _mm256_or_si256(
+      _mm256_cmpeq_epi32(cols, _mm256_setzero_si256()),
+      _mm256_cmpeq_epi32(cols, _mm256_set1_epi32((int)width - 1)));
+  *is_left = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)width / 2), cols);
+}
+
+static void highbd_apply_temporal_filter_luma(
+    const uint16_t *y_pre, int y_pre_stride, unsigned int block_width,
+    unsigned int block_height, int ss_x, int ss_y, const __m128i strength,
+    const __m256i rounding, const int *blk_fw, int use_whole_blk,
+    uint32_t *y_accum, uint16_t *y_count, const uint32_t *y_dist,
+    const uint32_t *u_dist, const uint32_t *v_dist) {
+  unsigned int row, col;
+
+  for (col = 0; col < block_width; col += 8) {
+    const uint32_t *dist = y_dist + col;
+    const uint16_t *pre = y_pre + col;
+    uint16_t *count = y_count + col;
+    uint32_t *accum = y_accum + col;
+    __m256i edge, is_left, mul_edge, mul_middle, top_weight, bottom_weight;
+    __m256i sum_prev = _mm256_setzero_si256();
+    __m256i sum_cur = highbd_sum_row_3(dist);
+
+    highbd_get_column_masks(col, block_width, &edge, &is_left);
+    // Each pixel also sums one u and one v value.
+    mul_edge = highbd_get_mul_constants(edge, 2, 2);
+    mul_middle = highbd_get_mul_constants(edge, 3, 2);
+    if (use_whole_blk) {
+      top_weight = bottom_weight = _mm256_set1_epi32(blk_fw[0]);
+    } else {
+      top_weight = highbd_get_weights(is_left, blk_fw[0], blk_fw[1]);
+      bottom_weight = highbd_get_weights(is_left, blk_fw[2], blk_fw[3]);
+    }
+
+    for (row = 0; row < block_height; ++row) {
+      const int uv_offset = (row >> ss_y) * DIST_STRIDE + (col >> ss_x);
+      const __m256i sum_next = row + 1 < block_height
+                                   ? highbd_sum_row_3(dist + DIST_STRIDE)
+                                   : _mm256_setzero_si256();
+      __m256i sum =
+          _mm256_add_epi32(_mm256_add_epi32(sum_prev, sum_cur), sum_next);
+
+      if (ss_x) {
+        sum = _mm256_add_epi32(sum, highbd_load_dist_dup(u_dist + uv_offset));
+        sum = _mm256_add_epi32(sum, highbd_load_dist_dup(v_dist + uv_offset));
+      } else {
+        sum = _mm256_add_epi32(sum, highbd_load_dist(u_dist + uv_offset));
+        sum = _mm256_add_epi32(sum, highbd_load_dist(v_dist + uv_offset));
+      }
+
+      sum = highbd_get_modifier(
+          sum, (row == 0 || row == block_height - 1) ? mul_edge : mul_middle,
+          strength, rounding,
+          row < block_height / 2 ? top_weight : bottom_weight);
+      highbd_accumulate_and_store(sum, pre, count, accum);
+
+      sum_prev = sum_cur;
+      sum_cur = sum_next;
+      dist += DIST_STRIDE;
+      pre += y_pre_stride;
+      count += block_width;
+      accum += block_width;
+    }
+  }
+}
+
+static void highbd_apply_temporal_filter_chroma(
+    const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride,
+    unsigned int uv_width, unsigned int uv_height, int ss_x, int ss_y,
+    const __m128i strength, const __m256i rounding, const int *blk_fw,
+    int use_whole_blk, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum,
+    uint16_t *v_count, const uint32_t *y_dist, const uint32_t *u_dist,
+    const uint32_t *v_dist) {
+  // Each pixel also sums the luma values it covers.
+  const int extra = (1 + ss_x) * (1 + ss_y);
+  unsigned int row, col;
+
+  for (col = 0; col < uv_width; col += 8) {
+    const uint32_t *u = u_dist + col;
+    const uint32_t *v = v_dist + col;
+    const uint32_t *y = y_dist + (col << ss_x);
+    __m256i edge, is_left, mul_edge, mul_middle, top_weight, bottom_weight;
+    __m256i u_prev = _mm256_setzero_si256(), v_prev = _mm256_setzero_si256();
+    __m256i u_cur = highbd_sum_row_3(u), v_cur = highbd_sum_row_3(v);
+    unsigned int offset = col;
+
+    highbd_get_column_masks(col, uv_width, &edge, &is_left);
+    mul_edge = highbd_get_mul_constants(edge, 2, extra);
+    mul_middle = highbd_get_mul_constants(edge, 3, extra);
+    if (use_whole_blk) {
+      top_weight = bottom_weight = _mm256_set1_epi32(blk_fw[0]);
+    } else {
+      top_weight = highbd_get_weights(is_left, blk_fw[0], blk_fw[1]);
+      bottom_weight = highbd_get_weights(is_left, blk_fw[2], blk_fw[3]);
+    }
+
+    for (row = 0; row < uv_height; ++row) {
+      const __m256i u_next = row + 1 < uv_height
+                                 ? highbd_sum_row_3(u + DIST_STRIDE)
+                                 : _mm256_setzero_si256();
+      const __m256i v_next = row + 1 < uv_height
+                                 ? highbd_sum_row_3(v + DIST_STRIDE)
+                                 : _mm256_setzero_si256();
+      const __m256i mul =
+          (row == 0 || row == uv_height - 1) ? mul_edge : mul_middle;
+      const __m256i weight = row < uv_height / 2 ? top_weight : bottom_weight;
+      __m256i y_sum, u_sum, v_sum;
+
+      if (ss_x) {
+        __m256i y0 = highbd_load_dist(y), y1 = highbd_load_dist(y + 8);
+        if (ss_y) {
+          y0 = _mm256_add_epi32(y0, highbd_load_dist(y + DIST_STRIDE));
+          y1 = _mm256_add_epi32(y1, highbd_load_dist(y + DIST_STRIDE + 8));
+        }
+        y_sum = highbd_sum_pairs(y0, y1);
+      } else {
+        y_sum = highbd_load_dist(y);
+        if (ss_y) {
+          y_sum = _mm256_add_epi32(y_sum, highbd_load_dist(y + DIST_STRIDE));
+        }
+      }
+
+      u_sum = _mm256_add_epi32(_mm256_add_epi32(u_prev, u_cur), u_next);
+      v_sum = _mm256_add_epi32(_mm256_add_epi32(v_prev, v_cur), v_next);
+      u_sum = highbd_get_modifier(_mm256_add_epi32(u_sum, y_sum), mul,
+                                  strength, rounding, weight);
+      v_sum = highbd_get_modifier(_mm256_add_epi32(v_sum, y_sum), mul,
+                                  strength, rounding, weight);
+      highbd_accumulate_and_store(u_sum, u_pre + row * uv_pre_stride + col,
+                                  u_count + offset, u_accum + offset);
+      highbd_accumulate_and_store(v_sum, v_pre + row * uv_pre_stride + col,
+                                  v_count + offset, v_accum + offset);
+
+      u_prev = u_cur;
+      u_cur = u_next;
+      v_prev = v_cur;
+      v_cur = v_next;
+      u += DIST_STRIDE;
+      v += DIST_STRIDE;
+      y += DIST_STRIDE << ss_y;
+      offset += uv_width;
+    }
+  }
+}
+
+void vp9_highbd_apply_temporal_filter_avx2(
+    const uint16_t *y_src, int y_src_stride, const uint16_t *y_pre,
+    int y_pre_stride, const uint16_t *u_src, const uint16_t *v_src,
+    int uv_src_stride, const uint16_t *u_pre, const uint16_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const int *const blk_fw,
+    int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count) {
+  const unsigned int uv_width = block_width >> ss_x,
+                     uv_height = block_height >> ss_y;
+  const __m128i strength_u128 = _mm_cvtsi32_si128(strength);
+  const __m256i rounding = _mm256_set1_epi32((1 << strength) >> 1);
+  DECLARE_ALIGNED(32, uint32_t, y_dist[BH * DIST_STRIDE]);
+  DECLARE_ALIGNED(32, uint32_t, u_dist[BH * DIST_STRIDE]);
+  DECLARE_ALIGNED(32, uint32_t, v_dist[BH * DIST_STRIDE]);
+  unsigned int row;
+
+  assert(block_width <= BW && "block width too large");
+  assert(block_height <= BH && "block height too large");
+  assert(block_width % 16 == 0 && "block width must be multiple of 16");
+  assert(block_height % 2 == 0 && "block height must be even");
+  assert((ss_x == 0 || ss_x == 1) && (ss_y == 0 || ss_y == 1) &&
+         "invalid chroma subsampling");
+  assert(strength >= 4 && strength <= 14 &&
+         "invalid adjusted temporal filter strength");
+  assert(blk_fw[0] >= 0 && "filter weight must be positive");
+  assert(
+      (use_whole_blk || (blk_fw[1] >= 0 && blk_fw[2] >= 0 && blk_fw[3] >= 0)) &&
+      "subblock filter weight must be positive");
+  assert(blk_fw[0] <= 2 && "sublock filter weight must be less than 2");
+  assert(
+      (use_whole_blk || (blk_fw[1] <= 2 && blk_fw[2] <= 2 && blk_fw[3] <= 2)) &&
+      "subblock filter weight must be less than 2");
+
+  for (row = 0; row < block_height; ++row) {
+    highbd_store_dist_row(y_src + row * y_src_stride,
+                          y_pre + row * y_pre_stride, block_width,
+                          y_dist + 1 + row * DIST_STRIDE);
+  }
+  for (row = 0; row < uv_height; ++row) {
+    highbd_store_dist_row(u_src + row * uv_src_stride,
+                          u_pre + row * uv_pre_stride, uv_width,
+                          u_dist + 1 + row * DIST_STRIDE);
+    highbd_store_dist_row(v_src + row * uv_src_stride,
+                          v_pre + row * uv_pre_stride, uv_width,
+                          v_dist + 1 + row * DIST_STRIDE);
+  }
+
+  highbd_apply_temporal_filter_luma(
+      y_pre, y_pre_stride, block_width, block_height, ss_x, ss_y,
+      strength_u128, rounding, blk_fw, use_whole_blk, y_accum, y_count,
+      y_dist + 1, u_dist + 1, v_dist + 1);
+  highbd_apply_temporal_filter_chroma(
+      u_pre, v_pre, uv_pre_stride, uv_width, uv_height, ss_x, ss_y,
+      strength_u128, rounding, blk_fw, use_whole_blk, u_accum, u_count,
+      v_accum, v_count, y_dist + 1, u_dist + 1, v_dist + 1);
+}
@@ -0,0 +1,816 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+
+// The 16x16 transform works on 16-bit values like vp9_fht16x16_sse2(), with
+// each register holding a full row of 16 columns.
+static INLINE void load_buffer_16x16_avx2(const int16_t *input,
+                                          __m256i *const in, int stride) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i a = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+    in[i] = _mm256_slli_epi16(a, 2);
+  }
+}
+
+// (x + 1 + (x < 0)) >> 2
+static INLINE void right_shift_16x16_avx2(__m256i *const in) {
+  const __m256i one = _mm256_set1_epi16(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    const __m256i a = _mm256_sub_epi16(_mm256_add_epi16(in[i], one), sign);
+    in[i] = _mm256_srai_epi16(a, 2);
+  }
+}
+
+static INLINE void write_buffer_16x16_avx2(tran_low_t *output,
+                                           const __m256i *const in) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    const __m128i lo = _mm256_castsi256_si128(in[i]);
+    const __m128i hi = _mm256_extracti128_si256(in[i], 1);
+    _mm256_storeu_si256((__m256i *)(output + i * 16),
+                        _mm256_cvtepi16_epi32(lo));
+    _mm256_storeu_si256((__m256i *)(output + i * 16 + 8),
+                        _mm256_cvtepi16_epi32(hi));
+#else
+    _mm256_storeu_si256((__m256i *)(output + i * 16), in[i]);
+#endif
+  }
+}
+
+// 16-point 1-D DCT of 16 columns, following fdct16_8col() in
+// vp9_dct_intrin_sse2.c.
+static void fdct16_16col_avx2(__m256i *const in /*in[16]*/) {
+  __m256i i[8], s[8], p[8], t[8], u[4];
+  int k;
+
+  // stage 1
+  for (k = 0; k < 8; ++k) {
+    i[k] = _mm256_add_epi16(in[k], in[15 - k]);
+    s[7 - k] = _mm256_sub_epi16(in[k], in[15 - k]);
+  }
+  for (k = 0; k < 4; ++k) {
+    p[k] = _mm256_add_epi16(i[k], i[7 - k]);
+    p[7 - k] = _mm256_sub_epi16(i[k], i[7 - k]);
+  }
+
+  u[0] = _mm256_add_epi16(p[0], p[3]);
+  u[1] = _mm256_add_epi16(p[1], p[2]);
+  u[2] = _mm256_sub_epi16(p[1], p[2]);
+  u[3] = _mm256_sub_epi16(p[0], p[3]);
+
+  in[0] = madd_round_shift_pack_avx2(u[0], u[1], cospi_16_64, cospi_16_64);
+  in[8] = madd_round_shift_pack_avx2(u[0], u[1], cospi_16_64, -cospi_16_64);
+  in[4] = madd_round_shift_pack_avx2(u[2], u[3], cospi_24_64, cospi_8_64);
+  in[12] = madd_round_shift_pack_avx2(u[2], u[3], -cospi_8_64, cospi_24_64);
+
+  u[0] = madd_round_shift_pack_avx2(p[5], p[6], -cospi_16_64, cospi_16_64);
+  u[1] = madd_round_shift_pack_avx2(p[5], p[6], cospi_16_64, cospi_16_64);
+
+  t[0] = _mm256_add_epi16(p[4], u[0]);
+  t[1] = _mm256_sub_epi16(p[4], u[0]);
+  t[2] = _mm256_sub_epi16(p[7], u[1]);
+  t[3] = _mm256_add_epi16(p[7], u[1]);
+
+  in[2] = madd_round_shift_pack_avx2(t[0], t[3], cospi_28_64, cospi_4_64);
+  in[6] = madd_round_shift_pack_avx2(t[1], t[2], -cospi_20_64, cospi_12_64);
+  in[10] = madd_round_shift_pack_avx2(t[1], t[2], cospi_12_64, cospi_20_64);
+  in[14] = madd_round_shift_pack_avx2(t[0], t[3], -cospi_4_64, cospi_28_64);
+
+  // stage 2
+  t[2] = madd_round_shift_pack_avx2(s[2], s[5], -cospi_16_64, cospi_16_64);
+  t[3] = madd_round_shift_pack_avx2(s[3], s[4], -cospi_16_64, cospi_16_64);
+  t[4] = madd_round_shift_pack_avx2(s[3], s[4], cospi_16_64, cospi_16_64);
+  t[5] = madd_round_shift_pack_avx2(s[2], s[5], cospi_16_64, cospi_16_64);
+
+  // stage 3
+  p[0] = _mm256_add_epi16(s[0], t[3]);
+  p[1] = _mm256_add_epi16(s[1], t[2]);
+  p[2] = _mm256_sub_epi16(s[1], t[2]);
+  p[3] = _mm256_sub_epi16(s[0], t[3]);
+  p[4] = _mm256_sub_epi16(s[7], t[4]);
+  p[5] = _mm256_sub_epi16(s[6], t[5]);
+  p[6] = _mm256_add_epi16(s[6], t[5]);
+  p[7] = _mm256_add_epi16(s[7], t[4]);
+
+  // stage 4
+  t[1] = madd_round_shift_pack_avx2(p[1], p[6], -cospi_8_64, cospi_24_64);
+  t[2] = madd_round_shift_pack_avx2(p[2], p[5], cospi_24_64, cospi_8_64);
+  t[5] = madd_round_shift_pack_avx2(p[2], p[5], cospi_8_64, -cospi_24_64);
+  t[6] = madd_round_shift_pack_avx2(p[1], p[6], cospi_24_64, cospi_8_64);
+
+  // stage 5
+  s[0] = _mm256_add_epi16(p[0], t[1]);
+  s[1] = _mm256_sub_epi16(p[0], t[1]);
+  s[2] = _mm256_add_epi16(p[3], t[2]);
+  s[3] = _mm256_sub_epi16(p[3], t[2]);
+  s[4] = _mm256_sub_epi16(p[4], t[5]);
+  s[5] = _mm256_add_epi16(p[4], t[5]);
+  s[6] = _mm256_sub_epi16(p[7], t[6]);
+  s[7] = _mm256_add_epi16(p[7], t[6]);
+
+  // stage 6
+  in[1] = madd_round_shift_pack_avx2(s[0], s[7], cospi_30_64, cospi_2_64);
+  in[9] = madd_round_shift_pack_avx2(s[1], s[6], cospi_14_64, cospi_18_64);
+  in[5] = madd_round_shift_pack_avx2(s[2], s[5], cospi_22_64, cospi_10_64);
+  in[13] = madd_round_shift_pack_avx2(s[3], s[4], cospi_6_64, cospi_26_64);
+  in[3] = madd_round_shift_pack_avx2(s[3], s[4], -cospi_26_64, cospi_6_64);
+  in[11] = madd_round_shift_pack_avx2(s[2], s[5], -cospi_10_64, cospi_22_64);
+  in[7] = madd_round_shift_pack_avx2(s[1], s[6], -cospi_18_64, cospi_14_64);
+  in[15] = madd_round_shift_pack_avx2(s[0], s[7], -cospi_2_64, cospi_30_64);
+}
+
+static void fdct16_avx2(__m256i *const in) {
+  fdct16_16col_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+}
+
+static void fadst16_avx2(__m256i *const in) {
+  adst16_16col_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+}
+
+void vp9_fht16x16_avx2(const int16_t *input, tran_low_t *output, int stride,
+                       int tx_type) {
+  __m256i in[16];
+
+  switch (tx_type) {
+    case DCT_DCT: vpx_fdct16x16_sse2(input, output, stride); break;
+    case ADST_DCT:
+      load_buffer_16x16_avx2(input, in, stride);
+      fadst16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fdct16_avx2(in);
+      write_buffer_16x16_avx2(output, in);
+      break;
+    case DCT_ADST:
+      load_buffer_16x16_avx2(input, in, stride);
+      fdct16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16_avx2(in);
+      write_buffer_16x16_avx2(output, in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      load_buffer_16x16_avx2(input, in, stride);
+      fadst16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16_avx2(in);
+      write_buffer_16x16_avx2(output, in);
+      break;
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bitdepth transforms work on 32-bit values, 8 columns per register.
+// The products need more than 32 bits for 12-bit input, so they are formed
+// with _mm256_mul_epi32(), which multiplies the even 32-bit lanes into 64-bit
+// results, and the odd lanes are handled by a second multiply after a shift.
+// Sums of products are kept in that split form until they are rounded, which
+// gives the same result as the tran_high_t arithmetic in vp9_dct.c.
+
+// Multiply the 32-bit lanes of a by c. out[0] receives the 64-bit products of
+// the even lanes and out[1] those of the odd lanes.
+static INLINE void highbd_mul_avx2(const __m256i a, const int c,
+                                   __m256i *const out /*out[2]*/) {
+  const __m256i cst = _mm256_set1_epi32(c);
+  out[0] = _mm256_mul_epi32(a, cst);
+  out[1] = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), cst);
+}
+
+// a * c0 + b * c1
+static INLINE void highbd_madd_avx2(const __m256i a, const __m256i b,
+                                    const int c0, const int c1,
+                                    __m256i *const out /*out[2]*/) {
+  __m256i t0[2], t1[2];
+  highbd_mul_avx2(a, c0, t0);
+  highbd_mul_avx2(b, c1, t1);
+  out[0] = _mm256_add_epi64(t0[0], t1[0]);
+  out[1] = _mm256_add_epi64(t0[1], t1[1]);
+}
+
+static INLINE void highbd_add_avx2(const __m256i *const a,
+                                   const __m256i *const b,
+                                   __m256i *const out /*out[2]*/) {
+  out[0] = _mm256_add_epi64(a[0], b[0]);
+  out[1] = _mm256_add_epi64(a[1], b[1]);
+}
+
+static INLINE void highbd_sub_avx2(const __m256i *const a,
+                                   const __m256i *const b,
+                                   __m256i *const out /*out[2]*/) {
+  out[0] = _mm256_sub_epi64(a[0], b[0]);
+  out[1] = _mm256_sub_epi64(a[1], b[1]);
+}
+
+// fdct_round_shift() of the 64-bit products, joined back into 32-bit lanes.
+// The results fit in 32 bits, so the logical shifts give the same low bits as
+// an arithmetic shift would.
+static INLINE __m256i highbd_round_shift_avx2(const __m256i *const in) {
+  const __m256i rounding = _mm256_set1_epi64x(DCT_CONST_ROUNDING);
+  const __m256i even = _mm256_add_epi64(in[0], rounding);
+  const __m256i odd = _mm256_add_epi64(in[1], rounding);
+  return _mm256_blend_epi32(_mm256_srli_epi64(even, DCT_CONST_BITS),
+                            _mm256_slli_epi64(odd, 32 - DCT_CONST_BITS), 0xaa);
+}
+
+static INLINE __m256i highbd_mul_round_shift_avx2(const __m256i a,
+                                                  const int c) {
+  __m256i t[2];
+  highbd_mul_avx2(a, c, t);
+  return highbd_round_shift_avx2(t);
+}
+
+static INLINE __m256i highbd_madd_round_shift_avx2(const __m256i a,
+                                                   const __m256i b,
+                                                   const int c0,
+                                                   const int c1) {
+  __m256i t[2];
+  highbd_madd_avx2(a, b, c0, c1, t);
+  return highbd_round_shift_avx2(t);
+}
+
+static INLINE __m256i highbd_add_round_shift_avx2(const __m256i *const a,
+                                                  const __m256i *const b) {
+  __m256i t[2];
+  highbd_add_avx2(a, b, t);
+  return highbd_round_shift_avx2(t);
+}
+
+static INLINE __m256i highbd_sub_round_shift_avx2(const __m256i *const a,
+                                                  const __m256i *const b) {
+  __m256i t[2];
+  highbd_sub_avx2(a, b, t);
+  return highbd_round_shift_avx2(t);
+}
+
+static INLINE __m256i highbd_negate_avx2(const __m256i a) {
+  return _mm256_sub_epi32(_mm256_setzero_si256(), a);
+}
+
+// Transpose the 4x4 blocks of 32-bit values within each 128-bit lane.
+static INLINE void highbd_transpose_32bit_4x4_avx2(const __m256i *const in,
+                                                   __m256i *const out) {
+  // a0: 00 10 01 11
+  // a1: 20 30 21 31
+  // a2: 02 12 03 13
+  // a3: 22 32 23 33
+  const __m256i a0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i a1 = _mm256_unpacklo_epi32(in[2], in[3]);
+  const __m256i a2 = _mm256_unpackhi_epi32(in[0], in[1]);
+  const __m256i a3 = _mm256_unpackhi_epi32(in[2], in[3]);
+
+  out[0] = _mm256_unpacklo_epi64(a0, a1);
+  out[1] = _mm256_unpackhi_epi64(a0, a1);
+  out[2] = _mm256_unpacklo_epi64(a2, a3);
+  out[3] = _mm256_unpackhi_epi64(a2, a3);
+}
+
+static INLINE void highbd_transpose_32bit_8x8_avx2(const __m256i *const in,
+                                                   __m256i *const out) {
+  __m256i t[8];
+  int i;
+
+  highbd_transpose_32bit_4x4_avx2(in, t);
+  highbd_transpose_32bit_4x4_avx2(in + 4, t + 4);
+  for (i = 0; i < 4; ++i) {
+    out[i] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x20);
+    out[i + 4] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x31);
+  }
+}
+
+// in0 holds columns 0-7 of each row and in1 columns 8-15.
+static INLINE void highbd_transpose_32bit_16x16_avx2(__m256i *const in0,
+                                                     __m256i *const in1) {
+  __m256i t[8];
+  int i;
+
+  highbd_transpose_32bit_8x8_avx2(in0, in0);
+  highbd_transpose_32bit_8x8_avx2(in1 + 8, in1 + 8);
+  highbd_transpose_32bit_8x8_avx2(in1, t);
+  highbd_transpose_32bit_8x8_avx2(in0 + 8, in1);
+  for (i = 0; i < 8; ++i) in0[i + 8] = t[i];
+}
+
+static INLINE __m256i highbd_load_row_avx2(const int16_t *input,
+                                           const int shift) {
+  const __m128i a = _mm_loadu_si128((const __m128i *)input);
+  return _mm256_slli_epi32(_mm256_cvtepi16_epi32(a), shift);
+}
+
+// 4x4 blocks only use the low 128-bit lane of each register.
+static INLINE void highbd_load_buffer_4x4_avx2(const int16_t *input,
+                                               __m256i *const in, int stride) {
+  const __m256i bias = _mm256_setr_epi32(1, 0, 0, 0, 0, 0, 0, 0);
+  __m256i nonzero;
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    const __m128i a = _mm_loadl_epi64((const __m128i *)(input + i * stride));
+    in[i] = _mm256_slli_epi32(_mm256_cvtepi16_epi32(a), 4);
+  }
+
+  // The C code adds 1 to a nonzero dc input.
+  nonzero = _mm256_cmpeq_epi32(in[0], _mm256_setzero_si256());
+  in[0] = _mm256_add_epi32(in[0], _mm256_andnot_si256(nonzero, bias));
+}
+
+// (x + 1) >> 2
+static INLINE void highbd_write_buffer_4x4_avx2(tran_low_t *output,
+                                                const __m256i *const in) {
+  const __m256i one = _mm256_set1_epi32(1);
+  int i;
+  for (i = 0; i < 4; ++i) {
+    const __m256i a = _mm256_srai_epi32(_mm256_add_epi32(in[i], one), 2);
+    _mm_storeu_si128((__m128i *)(output + i * 4), _mm256_castsi256_si128(a));
+  }
+}
+
+// (x + (x < 0)) >> 1
+static INLINE void highbd_write_buffer_8x8_avx2(tran_low_t *output,
+                                                const __m256i *const in) {
+  int i;
+  for (i = 0; i < 8; ++i) {
+    const __m256i a = _mm256_sub_epi32(in[i], _mm256_srai_epi32(in[i], 31));
+    _mm256_storeu_si256((__m256i *)(output + i * 8), _mm256_srai_epi32(a, 1));
+  }
+}
+
+// (x + 1 + (x < 0)) >> 2
+static INLINE void highbd_right_shift_16x16_avx2(__m256i *const in0,
+                                                 __m256i *const in1) {
+  const __m256i one = _mm256_set1_epi32(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i a0 = _mm256_sub_epi32(_mm256_add_epi32(in0[i], one),
+                                        _mm256_srai_epi32(in0[i], 31));
+    const __m256i a1 = _mm256_sub_epi32(_mm256_add_epi32(in1[i], one),
+                                        _mm256_srai_epi32(in1[i], 31));
+    in0[i] = _mm256_srai_epi32(a0, 2);
+    in1[i] = _mm256_srai_epi32(a1, 2);
+  }
+}
+
+static void highbd_fdct4_avx2(__m256i *const in) {
+  const __m256i s0 = _mm256_add_epi32(in[0], in[3]);
+  const __m256i s1 = _mm256_add_epi32(in[1], in[2]);
+  const __m256i s2 = _mm256_sub_epi32(in[1], in[2]);
+  const __m256i s3 = _mm256_sub_epi32(in[0], in[3]);
+
+  in[0] = highbd_mul_round_shift_avx2(_mm256_add_epi32(s0, s1), cospi_16_64);
+  in[2] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(s0, s1), cospi_16_64);
+  in[1] = highbd_madd_round_shift_avx2(s2, s3, cospi_24_64, cospi_8_64);
+  in[3] = highbd_madd_round_shift_avx2(s2, s3, -cospi_8_64, cospi_24_64);
+  highbd_transpose_32bit_4x4_avx2(in, in);
+}
+
+static void highbd_fadst4_avx2(__m256i *const in) {
+  const __m256i s7 =
+      _mm256_sub_epi32(_mm256_add_epi32(in[0], in[1]), in[3]);
+  __m256i x0[2], x1[2], x2[2], x3[2], t[2];
+
+  highbd_madd_avx2(in[0], in[1], sinpi_1_9, sinpi_2_9, x0);
+  highbd_mul_avx2(in[3], sinpi_4_9, t);
+  highbd_add_avx2(x0, t, x0);
+  highbd_mul_avx2(s7, sinpi_3_9, x1);
+  highbd_madd_avx2(in[0], in[1], sinpi_4_9, -sinpi_1_9, x2);
+  highbd_mul_avx2(in[3], sinpi_2_9, t);
+  highbd_add_avx2(x2, t, x2);
+  highbd_mul_avx2(in[2], sinpi_3_9, x3);
+
+  in[0] = highbd_add_round_shift_avx2(x0, x3);
+  in[1] = highbd_round_shift_avx2(x1);
+  in[2] = highbd_sub_round_shift_avx2(x2, x3);
+  highbd_sub_avx2(x2, x0, t);
+  in[3] = highbd_add_round_shift_avx2(t, x3);
+  highbd_transpose_32bit_4x4_avx2(in, in);
+}
+
+static void highbd_fdct8_avx2(__m256i *const in) {
+  __m256i s[8], x[4], t[2];
+  int i;
+
+  // stage 1
+  for (i = 0; i < 4; ++i) {
+    s[i] = _mm256_add_epi32(in[i], in[7 - i]);
+    s[7 - i] = _mm256_sub_epi32(in[i], in[7 - i]);
+  }
+
+  x[0] = _mm256_add_epi32(s[0], s[3]);
+  x[1] = _mm256_add_epi32(s[1], s[2]);
+  x[2] = _mm256_sub_epi32(s[1], s[2]);
+  x[3] = _mm256_sub_epi32(s[0], s[3]);
+  in[0] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[0], x[1]),
+                                      cospi_16_64);
+  in[4] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[0], x[1]),
+                                      cospi_16_64);
+  in[2] = highbd_madd_round_shift_avx2(x[2], x[3], cospi_24_64, cospi_8_64);
+  in[6] = highbd_madd_round_shift_avx2(x[2], x[3], -cospi_8_64, cospi_24_64);
+
+  // stage 2
+  t[0] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(s[6], s[5]),
+                                     cospi_16_64);
+  t[1] = highbd_mul_round_shift_avx2(_mm256_add_epi32(s[6], s[5]),
+                                     cospi_16_64);
+
+  // stage 3
+  x[0] = _mm256_add_epi32(s[4], t[0]);
+  x[1] = _mm256_sub_epi32(s[4], t[0]);
+  x[2] = _mm256_sub_epi32(s[7], t[1]);
+  x[3] = _mm256_add_epi32(s[7], t[1]);
+
+  // stage 4
+  in[1] = highbd_madd_round_shift_avx2(x[0], x[3], cospi_28_64, cospi_4_64);
+  in[3] = highbd_madd_round_shift_avx2(x[2], x[1], cospi_12_64, -cospi_20_64);
+  in[5] = highbd_madd_round_shift_avx2(x[1], x[2], cospi_12_64, cospi_20_64);
+  in[7] = highbd_madd_round_shift_avx2(x[3], x[0], cospi_28_64, -cospi_4_64);
+  highbd_transpose_32bit_8x8_avx2(in, in);
+}
+
+static void highbd_fadst8_avx2(__m256i *const in) {
+  __m256i x[8], a[4][2], b[4][2];
+
+  // stage 1
+  highbd_madd_avx2(in[7], in[0], cospi_2_64, cospi_30_64, a[0]);
+  highbd_madd_avx2(in[7], in[0], cospi_30_64, -cospi_2_64, b[0]);
+  highbd_madd_avx2(in[5], in[2], cospi_10_64, cospi_22_64, a[1]);
+  highbd_madd_avx2(in[5], in[2], cospi_22_64, -cospi_10_64, b[1]);
+  highbd_madd_avx2(in[3], in[4], cospi_18_64, cospi_14_64, a[2]);
+  highbd_madd_avx2(in[3], in[4], cospi_14_64, -cospi_18_64, b[2]);
+  highbd_madd_avx2(in[1], in[6], cospi_26_64, cospi_6_64, a[3]);
+  highbd_madd_avx2(in[1], in[6], cospi_6_64, -cospi_26_64, b[3]);
+
+  x[0] = highbd_add_round_shift_avx2(a[0], a[2]);
+  x[1] = highbd_add_round_shift_avx2(b[0], b[2]);
+  x[2] = highbd_add_round_shift_avx2(a[1], a[3]);
+  x[3] = highbd_add_round_shift_avx2(b[1], b[3]);
+  x[4] = highbd_sub_round_shift_avx2(a[0], a[2]);
+  x[5] = highbd_sub_round_shift_avx2(b[0], b[2]);
+  x[6] = highbd_sub_round_shift_avx2(a[1], a[3]);
+  x[7] = highbd_sub_round_shift_avx2(b[1], b[3]);
+
+  // stage 2
+  highbd_madd_avx2(x[4], x[5], cospi_8_64, cospi_24_64, a[0]);
+  highbd_madd_avx2(x[4], x[5], cospi_24_64, -cospi_8_64, b[0]);
+  highbd_madd_avx2(x[6], x[7], -cospi_24_64, cospi_8_64, a[1]);
+  highbd_madd_avx2(x[6], x[7], cospi_8_64, cospi_24_64, b[1]);
+
+  in[0] = _mm256_add_epi32(x[0], x[2]);
+  in[7] = highbd_negate_avx2(_mm256_add_epi32(x[1], x[3]));
+  x[2] = _mm256_sub_epi32(x[0], x[2]);
+  x[3] = _mm256_sub_epi32(x[1], x[3]);
+  in[1] = highbd_negate_avx2(highbd_add_round_shift_avx2(a[0], a[1]));
+  in[6] = highbd_add_round_shift_avx2(b[0], b[1]);
+  x[6] = highbd_sub_round_shift_avx2(a[0], a[1]);
+  x[7] = highbd_sub_round_shift_avx2(b[0], b[1]);
+
+  // stage 3
+  in[3] = highbd_negate_avx2(highbd_mul_round_shift_avx2(
+      _mm256_add_epi32(x[2], x[3]), cospi_16_64));
+  in[4] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[2], x[3]),
+                                      cospi_16_64);
+  in[2] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[6], x[7]),
+                                      cospi_16_64);
+  in[5] = highbd_negate_avx2(highbd_mul_round_shift_avx2(
+      _mm256_sub_epi32(x[6], x[7]), cospi_16_64));
+  highbd_transpose_32bit_8x8_avx2(in, in);
+}
+
+// 16-point 1-D DCT of 8 columns, following fdct16() in vp9_dct.c.
+static void highbd_fdct16_8col_avx2(__m256i *const in /*in[16]*/) {
+  __m256i input[8], step1[8], step2[8], step3[8], s[8], x[4], t[2];
+  int i;
+
+  // step 1
+  for (i = 0; i < 8; ++i) {
+    input[i] = _mm256_add_epi32(in[i], in[15 - i]);
+    step1[7 - i] = _mm256_sub_epi32(in[i], in[15 - i]);
+  }
+
+  // fdct8(step, step);
+  for (i = 0; i < 4; ++i) {
+    s[i] = _mm256_add_epi32(input[i], input[7 - i]);
+    s[7 - i] = _mm256_sub_epi32(input[i], input[7 - i]);
+  }
+
+  x[0] = _mm256_add_epi32(s[0], s[3]);
+  x[1] = _mm256_add_epi32(s[1], s[2]);
+  x[2] = _mm256_sub_epi32(s[1], s[2]);
+  x[3] = _mm256_sub_epi32(s[0], s[3]);
+  in[0] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[0], x[1]),
+                                      cospi_16_64);
+  in[8] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[0], x[1]),
+                                      cospi_16_64);
+  in[4] = highbd_madd_round_shift_avx2(x[3], x[2], cospi_8_64, cospi_24_64);
+  in[12] = highbd_madd_round_shift_avx2(x[3], x[2], cospi_24_64, -cospi_8_64);
+
+  t[0] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(s[6], s[5]),
+                                     cospi_16_64);
+  t[1] = highbd_mul_round_shift_avx2(_mm256_add_epi32(s[6], s[5]),
+                                     cospi_16_64);
+
+  x[0] = _mm256_add_epi32(s[4], t[0]);
+  x[1] = _mm256_sub_epi32(s[4], t[0]);
+  x[2] = _mm256_sub_epi32(s[7], t[1]);
+  x[3] = _mm256_add_epi32(s[7], t[1]);
+
+  in[2] = highbd_madd_round_shift_avx2(x[0], x[3], cospi_28_64, cospi_4_64);
+  in[6] = highbd_madd_round_shift_avx2(x[2], x[1], cospi_12_64, -cospi_20_64);
+  in[10] = highbd_madd_round_shift_avx2(x[1], x[2], cospi_12_64, cospi_20_64);
+  in[14] = highbd_madd_round_shift_avx2(x[3], x[0], cospi_28_64, -cospi_4_64);
+
+  // step 2
+  step2[2] = highbd_mul_round_shift_avx2(
+      _mm256_sub_epi32(step1[5], step1[2]), cospi_16_64);
+  step2[3] = highbd_mul_round_shift_avx2(
+      _mm256_sub_epi32(step1[4], step1[3]), cospi_16_64);
+  step2[4] = highbd_mul_round_shift_avx2(
+      _mm256_add_epi32(step1[4], step1[3]), cospi_16_64);
+  step2[5] = highbd_mul_round_shift_avx2(
+      _mm256_add_epi32(step1[5], step1[2]), cospi_16_64);
+
+  // step 3
+  step3[0] = _mm256_add_epi32(step1[0], step2[3]);
+  step3[1] = _mm256_add_epi32(step1[1], step2[2]);
+  step3[2] = _mm256_sub_epi32(step1[1], step2[2]);
+  step3[3] = _mm256_sub_epi32(step1[0], step2[3]);
+  step3[4] = _mm256_sub_epi32(step1[7], step2[4]);
+  step3[5] = _mm256_sub_epi32(step1[6], step2[5]);
+  step3[6] = _mm256_add_epi32(step1[6], step2[5]);
+  step3[7] = _mm256_add_epi32(step1[7], step2[4]);
+
+  // step 4
+  step2[1] = highbd_madd_round_shift_avx2(step3[1], step3[6], -cospi_8_64,
+                                          cospi_24_64);
+  step2[2] = highbd_madd_round_shift_avx2(step3[2], step3[5], cospi_24_64,
+                                          cospi_8_64);
+  step2[5] = highbd_madd_round_shift_avx2(step3[2], step3[5], cospi_8_64,
+                                          -cospi_24_64);
+  step2[6] = highbd_madd_round_shift_avx2(step3[1], step3[6], cospi_24_64,
+                                          cospi_8_64);
+
+  // step 5
+  step1[0] = _mm256_add_epi32(step3[0], step2[1]);
+  step1[1] = _mm256_sub_epi32(step3[0], step2[1]);
+  step1[2] = _mm256_add_epi32(step3[3], step2[2]);
+  step1[3] = _mm256_sub_epi32(step3[3], step2[2]);
+  step1[4] = _mm256_sub_epi32(step3[4], step2[5]);
+  step1[5] = _mm256_add_epi32(step3[4], step2[5]);
+  step1[6] = _mm256_sub_epi32(step3[7], step2[6]);
+  step1[7] = _mm256_add_epi32(step3[7], step2[6]);
+
+  // step 6
+  in[1] = highbd_madd_round_shift_avx2(step1[0], step1[7], cospi_30_64,
+                                       cospi_2_64);
+  in[9] = highbd_madd_round_shift_avx2(step1[1], step1[6], cospi_14_64,
+                                       cospi_18_64);
+  in[5] = highbd_madd_round_shift_avx2(step1[2], step1[5], cospi_22_64,
+                                       cospi_10_64);
+  in[13] = highbd_madd_round_shift_avx2(step1[3], step1[4], cospi_6_64,
+                                        cospi_26_64);
+  in[3] = highbd_madd_round_shift_avx2(step1[3], step1[4], -cospi_26_64,
+                                       cospi_6_64);
+  in[11] = highbd_madd_round_shift_avx2(step1[2], step1[5], -cospi_10_64,
+                                        cospi_22_64);
+  in[7] = highbd_madd_round_shift_avx2(step1[1], step1[6], -cospi_18_64,
+                                       cospi_14_64);
+  in[15] = highbd_madd_round_shift_avx2(step1[0], step1[7], -cospi_2_64,
+                                        cospi_30_64);
+}
+
+// 16-point 1-D ADST of 8 columns, following fadst16() in vp9_dct.c.
+static void highbd_fadst16_8col_avx2(__m256i *const in /*in[16]*/) {
+  __m256i s[16], x[16], a[8][2], b[8][2];
+  int i;
+
+  // stage 1
+  highbd_madd_avx2(in[15], in[0], cospi_1_64, cospi_31_64, a[0]);
+  highbd_madd_avx2(in[15], in[0], cospi_31_64, -cospi_1_64, b[0]);
+  highbd_madd_avx2(in[13], in[2], cospi_5_64, cospi_27_64, a[1]);
+  highbd_madd_avx2(in[13], in[2], cospi_27_64, -cospi_5_64, b[1]);
+  highbd_madd_avx2(in[11], in[4], cospi_9_64, cospi_23_64, a[2]);
+  highbd_madd_avx2(in[11], in[4], cospi_23_64, -cospi_9_64, b[2]);
+  highbd_madd_avx2(in[9], in[6], cospi_13_64, cospi_19_64, a[3]);
+  highbd_madd_avx2(in[9], in[6], cospi_19_64, -cospi_13_64, b[3]);
+  highbd_madd_avx2(in[7], in[8], cospi_17_64, cospi_15_64, a[4]);
+  highbd_madd_avx2(in[7], in[8], cospi_15_64, -cospi_17_64, b[4]);
+  highbd_madd_avx2(in[5], in[10], cospi_21_64, cospi_11_64, a[5]);
+  highbd_madd_avx2(in[5], in[10], cospi_11_64, -cospi_21_64, b[5]);
+  highbd_madd_avx2(in[3], in[12], cospi_25_64, cospi_7_64, a[6]);
+  highbd_madd_avx2(in[3], in[12], cospi_7_64, -cospi_25_64, b[6]);
+  highbd_madd_avx2(in[1], in[14], cospi_29_64, cospi_3_64, a[7]);
+  highbd_madd_avx2(in[1], in[14], cospi_3_64, -cospi_29_64, b[7]);
+
+  for (i = 0; i < 4; ++i) {
+    x[2 * i] = highbd_add_round_shift_avx2(a[i], a[i + 4]);
+    x[2 * i + 1] = highbd_add_round_shift_avx2(b[i], b[i + 4]);
+    x[2 * i + 8] = highbd_sub_round_shift_avx2(a[i], a[i + 4]);
+    x[2 * i + 9] = highbd_sub_round_shift_avx2(b[i], b[i + 4]);
+  }
+
+  // stage 2
+  highbd_madd_avx2(x[8], x[9], cospi_4_64, cospi_28_64, a[0]);
+  highbd_madd_avx2(x[8], x[9], cospi_28_64, -cospi_4_64, b[0]);
+  highbd_madd_avx2(x[10], x[11], cospi_20_64, cospi_12_64, a[1]);
+  highbd_madd_avx2(x[10], x[11], cospi_12_64, -cospi_20_64, b[1]);
+  highbd_madd_avx2(x[12], x[13], -cospi_28_64, cospi_4_64, a[2]);
+  highbd_madd_avx2(x[12], x[13], cospi_4_64, cospi_28_64, b[2]);
+  highbd_madd_avx2(x[14], x[15], -cospi_12_64, cospi_20_64, a[3]);
+  highbd_madd_avx2(x[14], x[15], cospi_20_64, cospi_12_64, b[3]);
+
+  for (i = 0; i < 4; ++i) {
+    s[i] = _mm256_add_epi32(x[i], x[i + 4]);
+    s[i + 4] = _mm256_sub_epi32(x[i], x[i + 4]);
+  }
+  s[8] = highbd_add_round_shift_avx2(a[0], a[2]);
+  s[9] = highbd_add_round_shift_avx2(b[0], b[2]);
+  s[10] = highbd_add_round_shift_avx2(a[1], a[3]);
+  s[11] = highbd_add_round_shift_avx2(b[1], b[3]);
+  s[12] = highbd_sub_round_shift_avx2(a[0], a[2]);
+  s[13] = highbd_sub_round_shift_avx2(b[0], b[2]);
+  s[14] = highbd_sub_round_shift_avx2(a[1], a[3]);
+  s[15] = highbd_sub_round_shift_avx2(b[1], b[3]);
+
+  // stage 3
+  highbd_madd_avx2(s[4], s[5], cospi_8_64, cospi_24_64, a[0]);
+  highbd_madd_avx2(s[4], s[5], cospi_24_64, -cospi_8_64, b[0]);
+  highbd_madd_avx2(s[6], s[7], -cospi_24_64, cospi_8_64, a[1]);
+  highbd_madd_avx2(s[6], s[7], cospi_8_64, cospi_24_64, b[1]);
+  highbd_madd_avx2(s[12], s[13], cospi_8_64, cospi_24_64, a[2]);
+  highbd_madd_avx2(s[12], s[13], cospi_24_64, -cospi_8_64, b[2]);
+  highbd_madd_avx2(s[14], s[15], -cospi_24_64, cospi_8_64, a[3]);
+  highbd_madd_avx2(s[14], s[15], cospi_8_64, cospi_24_64, b[3]);
+
+  x[0] = _mm256_add_epi32(s[0], s[2]);
+  x[1] = _mm256_add_epi32(s[1], s[3]);
+  x[2] = _mm256_sub_epi32(s[0], s[2]);
+  x[3] = _mm256_sub_epi32(s[1], s[3]);
+  x[4] = highbd_add_round_shift_avx2(a[0], a[1]);
+  x[5] = highbd_add_round_shift_avx2(b[0], b[1]);
+  x[6] = highbd_sub_round_shift_avx2(a[0], a[1]);
+  x[7] = highbd_sub_round_shift_avx2(b[0], b[1]);
+  x[8] = _mm256_add_epi32(s[8], s[10]);
+  x[9] = _mm256_add_epi32(s[9], s[11]);
+  x[10] = _mm256_sub_epi32(s[8], s[10]);
+  x[11] = _mm256_sub_epi32(s[9], s[11]);
+  x[12] = highbd_add_round_shift_avx2(a[2], a[3]);
+  x[13] = highbd_add_round_shift_avx2(b[2], b[3]);
+  x[14] = highbd_sub_round_shift_avx2(a[2], a[3]);
+  x[15] = highbd_sub_round_shift_avx2(b[2], b[3]);
+
+  // stage 4
+  in[7] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[2], x[3]),
+                                      -cospi_16_64);
+  in[8] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[2], x[3]),
+                                      cospi_16_64);
+  in[4] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[6], x[7]),
+                                      cospi_16_64);
+  in[11] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[7], x[6]),
+                                       cospi_16_64);
+  in[6] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[10], x[11]),
+                                      cospi_16_64);
+  in[9] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[11], x[10]),
+                                      cospi_16_64);
+  in[5] = highbd_mul_round_shift_avx2(_mm256_add_epi32(x[14], x[15]),
+                                      -cospi_16_64);
+  in[10] = highbd_mul_round_shift_avx2(_mm256_sub_epi32(x[14], x[15]),
+                                       cospi_16_64);
+
+  in[0] = x[0];
+  in[1] = highbd_negate_avx2(x[8]);
+  in[2] = x[12];
+  in[3] = highbd_negate_avx2(x[4]);
+  in[12] = x[5];
+  in[13] = highbd_negate_avx2(x[13]);
+  in[14] = x[9];
+  in[15] = highbd_negate_avx2(x[1]);
+}
+
+static void highbd_fdct16_avx2(__m256i *const in0, __m256i *const in1) {
+  highbd_fdct16_8col_avx2(in0);
+  highbd_fdct16_8col_avx2(in1);
+  highbd_transpose_32bit_16x16_avx2(in0, in1);
+}
+
+static void highbd_fadst16_avx2(__m256i *const in0, __m256i *const in1) {
+  highbd_fadst16_8col_avx2(in0);
+  highbd_fadst16_8col_avx2(in1);
+  highbd_transpose_32bit_16x16_avx2(in0, in1);
+}
+
+void vp9_highbd_fht4x4_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  __m256i in[4];
+
+  switch (tx_type) {
+    case DCT_DCT: vpx_highbd_fdct4x4_sse2(input, output, stride); break;
+    case ADST_DCT:
+      highbd_load_buffer_4x4_avx2(input, in, stride);
+      highbd_fadst4_avx2(in);
+      highbd_fdct4_avx2(in);
+      highbd_write_buffer_4x4_avx2(output, in);
+      break;
+    case DCT_ADST:
+      highbd_load_buffer_4x4_avx2(input, in, stride);
+      highbd_fdct4_avx2(in);
+      highbd_fadst4_avx2(in);
+      highbd_write_buffer_4x4_avx2(output, in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      highbd_load_buffer_4x4_avx2(input, in, stride);
+      highbd_fadst4_avx2(in);
+      highbd_fadst4_avx2(in);
+      highbd_write_buffer_4x4_avx2(output, in);
+      break;
+  }
+}
+
+void vp9_highbd_fht8x8_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  __m256i in[8];
+  int i;
+
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct8x8_sse2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 8; ++i) in[i] = highbd_load_row_avx2(input + i * stride, 2);
+
+  switch (tx_type) {
+    case ADST_DCT:
+      highbd_fadst8_avx2(in);
+      highbd_fdct8_avx2(in);
+      break;
+    case DCT_ADST:
+      highbd_fdct8_avx2(in);
+      highbd_fadst8_avx2(in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      highbd_fadst8_avx2(in);
+      highbd_fadst8_avx2(in);
+      break;
+  }
+
+  highbd_write_buffer_8x8_avx2(output, in);
+}
+
+void vp9_highbd_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  __m256i in0[16], in1[16];
+  int i;
+
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct16x16_sse2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 16; ++i) {
+    in0[i] = highbd_load_row_avx2(input + i * stride, 2);
+    in1[i] = highbd_load_row_avx2(input + i * stride + 8, 2);
+  }
+
+  switch (tx_type) {
+    case ADST_DCT:
+      highbd_fadst16_avx2(in0, in1);
+      highbd_right_shift_16x16_avx2(in0, in1);
+      highbd_fdct16_avx2(in0, in1);
+      break;
+    case DCT_ADST:
+      highbd_fdct16_avx2(in0, in1);
+      highbd_right_shift_16x16_avx2(in0, in1);
+      highbd_fadst16_avx2(in0, in1);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      highbd_fadst16_avx2(in0, in1);
+      highbd_right_shift_16x16_avx2(in0, in1);
+      highbd_fadst16_avx2(in0, in1);
+      break;
+  }
+
+  for (i = 0; i < 16; ++i) {
+    _mm256_storeu_si256((__m256i *)(output + i * 16), in0[i]);
+    _mm256_storeu_si256((__m256i *)(output + i * 16 + 8), in1[i]);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
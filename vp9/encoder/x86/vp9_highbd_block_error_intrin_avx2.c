@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+
+// Add the squares of the 8 signed 32-bit values in a to the 4 64-bit sums in
+// acc. The products of the even and the odd lanes are formed separately, so
+// no range check is needed, unlike in the SSE2 version.
+static INLINE __m256i add_squares(const __m256i acc, const __m256i a) {
+  const __m256i a_odd = _mm256_srli_epi64(a, 32);
+  return _mm256_add_epi64(_mm256_add_epi64(acc, _mm256_mul_epi32(a, a)),
+                          _mm256_mul_epi32(a_odd, a_odd));
+}
+
+int64_t vp9_highbd_block_error_avx2(const tran_low_t *coeff,
+                                    const tran_low_t *dqcoeff,
+                                    intptr_t block_size, int64_t *ssz, int bd) {
+  const int shift = 2 * (bd - 8);
+  const int rounding = shift > 0 ? 1 << (shift - 1) : 0;
+  __m256i error_256 = _mm256_setzero_si256();
+  __m256i sqcoeff_256 = _mm256_setzero_si256();
+  __m128i error_128, sqcoeff_128;
+  int64_t error, sqcoeff;
+  intptr_t i;
+
+  assert(block_size % 16 == 0);
+
+  for (i = 0; i < block_size; i += 16) {
+    const __m256i coeff_0 = _mm256_loadu_si256((const __m256i *)(coeff + i));
+    const __m256i coeff_1 =
+        _mm256_loadu_si256((const __m256i *)(coeff + i + 8));
+    const __m256i dqcoeff_0 =
+        _mm256_loadu_si256((const __m256i *)(dqcoeff + i));
+    const __m256i dqcoeff_1 =
+        _mm256_loadu_si256((const __m256i *)(dqcoeff + i + 8));
+    error_256 = add_squares(error_256, _mm256_sub_epi32(coeff_0, dqcoeff_0));
+    error_256 = add_squares(error_256, _mm256_sub_epi32(coeff_1, dqcoeff_1));
+    sqcoeff_256 = add_squares(sqcoeff_256, coeff_0);
+    sqcoeff_256 = add_squares(sqcoeff_256, coeff_1);
+  }
+
+  error_128 = _mm_add_epi64(_mm256_castsi256_si128(error_256),
+                            _mm256_extracti128_si256(error_256, 1));
+  error_128 = _mm_add_epi64(error_128, _mm_srli_si128(error_128, 8));
+  sqcoeff_128 = _mm_add_epi64(_mm256_castsi256_si128(sqcoeff_256),
+                              _mm256_extracti128_si256(sqcoeff_256, 1));
+  sqcoeff_128 = _mm_add_epi64(sqcoeff_128, _mm_srli_si128(sqcoeff_128, 8));
+#if VPX_ARCH_X86_64
+  error = _mm_cvtsi128_si64(error_128);
+  sqcoeff = _mm_cvtsi128_si64(sqcoeff_128);
+#else
+  _mm_storel_epi64((__m128i *)&error, error_128);
+  _mm_storel_epi64((__m128i *)&sqcoeff, sqcoeff_128);
+#endif
+
+  assert(error >= 0 && sqcoeff >= 0);
+  error = (error + rounding) >> shift;
+  sqcoeff = (sqcoeff + rounding) >> shift;
+
+  *ssz = sqcoeff;
+  return error;
+}
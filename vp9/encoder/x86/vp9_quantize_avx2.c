@@ -15,6 +15,7 @@
 #include "vpx/vpx_integer.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx_dsp/x86/bitdepth_conversion_avx2.h"
+#include "vpx_dsp/x86/highbd_quantize_avx2.h"
 #include "vpx_dsp/x86/quantize_sse2.h"
 
 // Zero fill 8 positions in the output buffer.
@@ -137,3 +138,195 @@ void vp9_quantize_fp_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
 
   *eob_ptr = accumulate_eob(eob);
 }
+
+// Quantize 16 coefficients for a 32x32 transform. Coefficients below
+// dequant / 4 are zeroed, as in vp9_quantize_fp_32x32_c(), and the whole row
+// is skipped when all of them are.
+static INLINE void quantize_fp_32x32_16(
+    const tran_low_t *coeff_ptr, const int16_t *iscan_ptr,
+    const __m256i round256, const __m256i quant256, const __m256i dequant256,
+    const __m256i thr256, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    __m256i *eob256) {
+  const __m256i coeff256 = load_tran_low(coeff_ptr);
+  const __m256i abs_coeff256 = _mm256_abs_epi16(coeff256);
+  const __m256i skip256 = _mm256_cmpgt_epi16(thr256, abs_coeff256);
+  const __m256i sign256 = _mm256_srai_epi16(coeff256, 15);
+  __m256i qcoeff256, dqcoeff256, lo256, hi256;
+
+  if (_mm256_movemask_epi8(skip256) == -1) {
+    store_zero_tran_low(qcoeff_ptr);
+    store_zero_tran_low(dqcoeff_ptr);
+    return;
+  }
+
+  // quant256 is doubled, so this is (tmp * quant) >> 15.
+  qcoeff256 = _mm256_adds_epi16(abs_coeff256, round256);
+  qcoeff256 = _mm256_mulhi_epu16(qcoeff256, quant256);
+  qcoeff256 = _mm256_andnot_si256(skip256, qcoeff256);
+
+  // (qcoeff * dequant) / 2 from the low 17 bits of the 32 bit product.
+  lo256 = _mm256_mullo_epi16(qcoeff256, dequant256);
+  hi256 = _mm256_mulhi_epu16(qcoeff256, dequant256);
+  dqcoeff256 =
+      _mm256_or_si256(_mm256_srli_epi16(lo256, 1), _mm256_slli_epi16(hi256, 15));
+
+  qcoeff256 = _mm256_sub_epi16(_mm256_xor_si256(qcoeff256, sign256), sign256);
+  dqcoeff256 =
+      _mm256_sub_epi16(_mm256_xor_si256(dqcoeff256, sign256), sign256);
+  store_tran_low(qcoeff256, qcoeff_ptr);
+  store_tran_low(dqcoeff256, dqcoeff_ptr);
+
+  *eob256 = _mm256_max_epi16(
+      *eob256, scan_eob_256((const __m256i *)iscan_ptr, &qcoeff256));
+}
+
+void vp9_quantize_fp_32x32_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan, const int16_t *iscan) {
+  __m128i eob;
+  __m256i round256, quant256, dequant256, thr256;
+  __m256i eob256 = _mm256_setzero_si256();
+  intptr_t i;
+
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  // Setup global values
+  {
+    const __m128i round = _mm_load_si128((const __m128i *)round_ptr);
+    const __m128i quant = _mm_load_si128((const __m128i *)quant_ptr);
+    const __m128i dequant = _mm_load_si128((const __m128i *)dequant_ptr);
+    // ROUND_POWER_OF_TWO(round, 1)
+    round256 = _mm256_castsi128_si256(
+        _mm_srai_epi16(_mm_add_epi16(round, _mm_set1_epi16(1)), 1));
+    round256 = _mm256_permute4x64_epi64(round256, 0x54);
+
+    quant256 = _mm256_castsi128_si256(_mm_slli_epi16(quant, 1));
+    quant256 = _mm256_permute4x64_epi64(quant256, 0x54);
+
+    dequant256 = _mm256_castsi128_si256(dequant);
+    dequant256 = _mm256_permute4x64_epi64(dequant256, 0x54);
+  }
+  thr256 = _mm256_srai_epi16(dequant256, 2);
+
+  quantize_fp_32x32_16(coeff_ptr, iscan, round256, quant256, dequant256, thr256,
+                       qcoeff_ptr, dqcoeff_ptr, &eob256);
+
+  // remove dc constants
+  dequant256 = _mm256_permute2x128_si256(dequant256, dequant256, 0x31);
+  quant256 = _mm256_permute2x128_si256(quant256, quant256, 0x31);
+  round256 = _mm256_permute2x128_si256(round256, round256, 0x31);
+  thr256 = _mm256_permute2x128_si256(thr256, thr256, 0x31);
+
+  for (i = 16; i < n_coeffs; i += 16) {
+    quantize_fp_32x32_16(coeff_ptr + i, iscan + i, round256, quant256,
+                         dequant256, thr256, qcoeff_ptr + i, dqcoeff_ptr + i,
+                         &eob256);
+  }
+
+  eob = _mm_max_epi16(_mm256_castsi256_si128(eob256),
+                      _mm256_extracti128_si256(eob256, 1));
+
+  *eob_ptr = accumulate_eob(eob);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// Quantize 8 coefficients. log_scale is 1 for 32x32 transforms, where
+// coefficients below dequant / 4 are zeroed, the result is scaled up by 2 and
+// the dequantized value halved.
+static INLINE void highbd_quantize_fp_8(
+    const tran_low_t *coeff_ptr, const int16_t *iscan_ptr, const __m256i round,
+    const __m256i quant, const __m256i dequant, const int log_scale,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, __m256i *eob) {
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i abs_coeff = _mm256_abs_epi32(coeff);
+  __m256i qcoeff, dqcoeff;
+
+  qcoeff = _mm256_add_epi32(abs_coeff, round);
+  qcoeff = highbd_mul_shift_epi32_avx2(qcoeff, quant, 16 - log_scale);
+  if (log_scale) {
+    const __m256i skip =
+        _mm256_cmpgt_epi32(_mm256_srai_epi32(dequant, 2), abs_coeff);
+    if (_mm256_movemask_epi8(skip) == -1) {
+      highbd_store_zero_avx2(qcoeff_ptr, dqcoeff_ptr);
+      return;
+    }
+    qcoeff = _mm256_andnot_si256(skip, qcoeff);
+  }
+  qcoeff = highbd_invert_sign_avx2(qcoeff, coeff);
+  dqcoeff = _mm256_mullo_epi32(qcoeff, dequant);
+  if (log_scale) dqcoeff = highbd_half_epi32_avx2(dqcoeff);
+
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, qcoeff);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dqcoeff);
+  *eob = _mm256_max_epi32(*eob, highbd_scan_eob_avx2(qcoeff, iscan_ptr));
+}
+
+static INLINE void highbd_quantize_fp_avx2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *round_ptr,
+    const int16_t *quant_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *iscan,
+    const int log_scale) {
+  __m256i round = highbd_load_values_avx2(round_ptr);
+  __m256i quant = highbd_load_values_avx2(quant_ptr);
+  __m256i dequant = highbd_load_values_avx2(dequant_ptr);
+  __m256i eob = _mm256_setzero_si256();
+  intptr_t i;
+
+  assert(n_coeffs >= 16 && !(n_coeffs & 7));
+
+  if (log_scale) {
+    // ROUND_POWER_OF_TWO(round, 1)
+    const __m256i one = _mm256_set1_epi32(1);
+    round = _mm256_srai_epi32(_mm256_add_epi32(round, one), 1);
+  }
+
+  highbd_quantize_fp_8(coeff_ptr, iscan, round, quant, dequant, log_scale,
+                       qcoeff_ptr, dqcoeff_ptr, &eob);
+
+  round = highbd_ac_values_avx2(round);
+  quant = highbd_ac_values_avx2(quant);
+  dequant = highbd_ac_values_avx2(dequant);
+
+  for (i = 8; i < n_coeffs; i += 8) {
+    highbd_quantize_fp_8(coeff_ptr + i, iscan + i, round, quant, dequant,
+                         log_scale, qcoeff_ptr + i, dqcoeff_ptr + i, &eob);
+  }
+
+  *eob_ptr = highbd_accumulate_eob_avx2(eob);
+}
+
+void vp9_highbd_quantize_fp_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                 int skip_block, const int16_t *round_ptr,
+                                 const int16_t *quant_ptr,
+                                 tran_low_t *qcoeff_ptr,
+                                 tran_low_t *dqcoeff_ptr,
+                                 const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                 const int16_t *scan, const int16_t *iscan) {
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  highbd_quantize_fp_avx2(coeff_ptr, n_coeffs, round_ptr, quant_ptr,
+                          qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan,
+                          0);
+}
+
+void vp9_highbd_quantize_fp_32x32_avx2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *round_ptr, const int16_t *quant_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  highbd_quantize_fp_avx2(coeff_ptr, n_coeffs, round_ptr, quant_ptr,
+                          qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan,
+                          1);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX512
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/x86/bitdepth_conversion_avx512.h"
+#include "vpx_dsp/x86/quantize_sse2.h"
+
+// Set the first element to the DC value and the rest to the AC value.
+static INLINE __m512i load_dc_ac_avx512(const int16_t *ptr) {
+  return _mm512_mask_set1_epi16(_mm512_set1_epi16(ptr[1]), 1, ptr[0]);
+}
+
+// Quantize the coefficients selected by keep and return the running eob.
+static INLINE __m512i quantize_fp_32(const __m512i coeff, const __m512i round,
+                                     const __m512i quant,
+                                     const __m512i dequant,
+                                     const __mmask32 keep,
+                                     const int16_t *iscan,
+                                     tran_low_t *qcoeff_ptr,
+                                     tran_low_t *dqcoeff_ptr,
+                                     const __m512i eob) {
+  const __m512i zero = _mm512_setzero_si512();
+  __m512i qcoeff = _mm512_adds_epi16(_mm512_abs_epi16(coeff), round);
+  __m512i dqcoeff;
+  __mmask32 nonzero;
+  qcoeff = _mm512_mulhi_epi16(qcoeff, quant);
+  // Restore the sign and clear zero or skipped coefficients.
+  qcoeff = _mm512_mask_sub_epi16(qcoeff, _mm512_movepi16_mask(coeff), zero,
+                                 qcoeff);
+  qcoeff = _mm512_maskz_mov_epi16(keep & _mm512_test_epi16_mask(coeff, coeff),
+                                  qcoeff);
+  dqcoeff = _mm512_mullo_epi16(qcoeff, dequant);
+  store_tran_low(qcoeff, qcoeff_ptr);
+  store_tran_low(dqcoeff, dqcoeff_ptr);
+
+  // Add one to convert from indices to counts.
+  nonzero = _mm512_test_epi16_mask(qcoeff, qcoeff);
+  return _mm512_mask_max_epi16(
+      eob, nonzero, eob,
+      _mm512_add_epi16(_mm512_loadu_si512((const __m512i *)iscan),
+                       _mm512_set1_epi16(1)));
+}
+
+// Like the AVX2 version, a row of 16 AC coefficients is quantized to zero if
+// all of them are at most half the quantization step.
+static INLINE __mmask32 rows_to_keep(const __m512i coeff, const __m512i thr) {
+  const __mmask32 nz = _mm512_cmpgt_epi16_mask(_mm512_abs_epi16(coeff), thr);
+  return ((nz & 0xffff) ? 0xffff : 0) | ((nz >> 16) ? 0xffff0000 : 0);
+}
+
+void vp9_quantize_fp_avx512(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                            int skip_block, const int16_t *round_ptr,
+                            const int16_t *quant_ptr, tran_low_t *qcoeff_ptr,
+                            tran_low_t *dqcoeff_ptr,
+                            const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                            const int16_t *scan, const int16_t *iscan) {
+  __m512i round, quant, dequant, thr, coeff;
+  __m512i eob512;
+  __m256i eob256;
+  intptr_t i;
+
+  (void)skip_block;
+  assert(!skip_block);
+
+  // A 4x4 block only fills half a register.
+  if (n_coeffs < 32) {
+    vp9_quantize_fp_avx2(coeff_ptr, n_coeffs, skip_block, round_ptr,
+                         quant_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                         eob_ptr, scan, iscan);
+    return;
+  }
+
+  // The first row holds the DC coefficient and is always quantized.
+  coeff = load_tran_low(coeff_ptr);
+  thr = _mm512_srai_epi16(_mm512_set1_epi16(dequant_ptr[1]), 1);
+  eob512 = quantize_fp_32(
+      coeff, load_dc_ac_avx512(round_ptr), load_dc_ac_avx512(quant_ptr),
+      load_dc_ac_avx512(dequant_ptr), 0xffff | rows_to_keep(coeff, thr), iscan,
+      qcoeff_ptr, dqcoeff_ptr, _mm512_setzero_si512());
+
+  // AC only loop
+  round = _mm512_set1_epi16(round_ptr[1]);
+  quant = _mm512_set1_epi16(quant_ptr[1]);
+  dequant = _mm512_set1_epi16(dequant_ptr[1]);
+  for (i = 32; i < n_coeffs; i += 32) {
+    const __m512i coeff_ac = load_tran_low(coeff_ptr + i);
+    const __mmask32 keep = rows_to_keep(coeff_ac, thr);
+    if (keep) {
+      eob512 = quantize_fp_32(coeff_ac, round, quant, dequant, keep, iscan + i,
+                              qcoeff_ptr + i, dqcoeff_ptr + i, eob512);
+    } else {
+      store_zero_tran_low(qcoeff_ptr + i);
+      store_zero_tran_low(dqcoeff_ptr + i);
+    }
+  }
+
+  eob256 = _mm256_max_epi16(_mm512_castsi512_si256(eob512),
+                            _mm512_extracti64x4_epi64(eob512, 1));
+  *eob_ptr = accumulate_eob(_mm_max_epi16(_mm256_castsi256_si128(eob256),
+                                          _mm256_extracti128_si256(eob256, 1)));
+}
@@ -17,6 +17,7 @@
 #include "vpx_ports/vpx_once.h"
 #include "vpx_ports/static_assert.h"
 #include "vpx_ports/system_state.h"
+#include "vpx_util/vpx_thread.h"
 #include "vpx_util/vpx_timestamp.h"
 #include "vpx/internal/vpx_codec_internal.h"
 #include "./vpx_version.h"
@@ -62,6 +63,7 @@ typedef struct vp9_extracfg {
   unsigned int row_mt;
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
+  unsigned int lpf_opt;
 } vp9_extracfg;
 
 static struct vp9_extracfg default_extra_cfg = {
@@ -97,8 +99,27 @@ static struct vp9_extracfg default_extra_cfg = {
   0,                     // row_mt
   0,                     // motion_vector_unit_test
   0,                     // delta_q_uv
+  0,                     // lpf_opt
 };
 
+// A frame submitted in pipelined mode, encoded on the pipeline worker.
+typedef struct EncodeJob {
+  vpx_image_t img;  // Copy of the source frame.
+  int flush;
+  vpx_codec_pts_t pts;
+  unsigned long duration;
+  vpx_enc_frame_flags_t flags;
+  unsigned long deadline;
+  vpx_codec_err_t res;
+} EncodeJob;
+
+// Packets owning a copy of their data.
+typedef struct PacketQueue {
+  vpx_codec_cx_pkt_t *pkts;
+  int size;
+  int count;
+} PacketQueue;
+
 struct vpx_codec_alg_priv {
   vpx_codec_priv_t base;
   vpx_codec_enc_cfg_t cfg;
@@ -123,6 +144,18 @@ struct vpx_codec_alg_priv {
   vpx_codec_priv_output_cx_pkt_cb_pair_t output_cx_pkt_cb;
   // BufferPool that holds all reference frames.
   BufferPool *buffer_pool;
+  // Pipelined encode: each frame is encoded on pipeline_worker while the
+  // application submits the next one.
+  int pipelined;
+  VPxWorker pipeline_worker;
+  int pipeline_busy;
+  vpx_codec_err_t pipeline_res;
+  EncodeJob pipeline_jobs[2];
+  int pipeline_job;  // Job of the next frame.
+  // Packets of the job on the worker, and packets for get_cx_data().
+  PacketQueue pipeline_done;
+  PacketQueue pipeline_pkts;
+  int pipeline_next_pkt;
 };
 
 static vpx_codec_err_t update_error_state(
@@ -135,6 +168,95 @@ static vpx_codec_err_t update_error_state(
   return res;
 }
 
+// Returns the data the packet points to, or NULL if it has none.
+static void **get_pkt_buf(vpx_codec_cx_pkt_t *pkt, size_t *sz) {
+  switch (pkt->kind) {
+    case VPX_CODEC_CX_FRAME_PKT:
+      *sz = pkt->data.frame.sz;
+      return &pkt->data.frame.buf;
+    case VPX_CODEC_STATS_PKT:
+      *sz = pkt->data.twopass_stats.sz;
+      return &pkt->data.twopass_stats.buf;
+    case VPX_CODEC_FPMB_STATS_PKT:
+      *sz = pkt->data.firstpass_mb_stats.sz;
+      return &pkt->data.firstpass_mb_stats.buf;
+    default: return NULL;
+  }
+}
+
+static int pkt_queue_reserve(PacketQueue *queue, int count) {
+  if (queue->count + count > queue->size) {
+    int size = queue->size ? queue->size : 16;
+    vpx_codec_cx_pkt_t *pkts;
+    while (size < queue->count + count) size *= 2;
+    pkts = (vpx_codec_cx_pkt_t *)realloc(queue->pkts, size * sizeof(*pkts));
+    if (pkts == NULL) return 0;
+    queue->pkts = pkts;
+    queue->size = size;
+  }
+  return 1;
+}
+
+// Appends a copy of pkt and its data to the queue.
+static int pkt_queue_push(PacketQueue *queue, const vpx_codec_cx_pkt_t *pkt) {
+  vpx_codec_cx_pkt_t *copy;
+  void **buf;
+  size_t sz = 0;
+
+  if (!pkt_queue_reserve(queue, 1)) return 0;
+  copy = &queue->pkts[queue->count];
+  *copy = *pkt;
+  buf = get_pkt_buf(copy, &sz);
+  if (buf != NULL) {
+    void *const data = sz ? malloc(sz) : NULL;
+    if (sz && data == NULL) return 0;
+    if (sz) memcpy(data, *buf, sz);
+    *buf = data;
+  }
+  ++queue->count;
+  return 1;
+}
+
+// Frees the first count packets of the queue.
+static void pkt_queue_pop(PacketQueue *queue, int count) {
+  int i;
+  if (count == 0) return;
+  for (i = 0; i < count; ++i) {
+    size_t sz;
+    void **const buf = get_pkt_buf(&queue->pkts[i], &sz);
+    if (buf != NULL) free(*buf);
+  }
+  queue->count -= count;
+  memmove(queue->pkts, queue->pkts + count,
+          queue->count * sizeof(*queue->pkts));
+}
+
+// Waits for the frame on the pipeline worker and queues its packets for
+// get_cx_data(). An error is kept in pipeline_res until encode() reports it.
+static void pipeline_wait(vpx_codec_alg_priv_t *ctx) {
+  const EncodeJob *const job = &ctx->pipeline_jobs[ctx->pipeline_job ^ 1];
+  PacketQueue *const done = &ctx->pipeline_done;
+  PacketQueue *const pkts = &ctx->pipeline_pkts;
+  vpx_codec_err_t res;
+
+  if (!ctx->pipeline_busy) return;
+  vpx_get_worker_interface()->sync(&ctx->pipeline_worker);
+  ctx->pipeline_busy = 0;
+  res = job->res;
+
+  // The packets keep their data.
+  if (pkt_queue_reserve(pkts, done->count)) {
+    memcpy(pkts->pkts + pkts->count, done->pkts,
+           done->count * sizeof(*pkts->pkts));
+    pkts->count += done->count;
+    done->count = 0;
+  } else {
+    pkt_queue_pop(done, done->count);
+    res = VPX_CODEC_MEM_ERROR;
+  }
+  if (ctx->pipeline_res == VPX_CODEC_OK) ctx->pipeline_res = res;
+}
+
 #undef ERROR
 #define ERROR(str)                  \
   do {                              \
@@ -260,6 +382,7 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
         "or kf_max_dist instead.");
 
   RANGE_CHECK(extra_cfg, row_mt, 0, 1);
+  RANGE_CHECK(extra_cfg, lpf_opt, 0, 1);
   RANGE_CHECK(extra_cfg, motion_vector_unit_test, 0, 2);
   RANGE_CHECK(extra_cfg, enable_auto_alt_ref, 0, MAX_ARF_LAYERS);
   RANGE_CHECK(extra_cfg, cpu_used, -9, 9);
@@ -601,6 +724,7 @@ static vpx_codec_err_t set_encoder_config(
   oxcf->target_level = extra_cfg->target_level;
 
   oxcf->row_mt = extra_cfg->row_mt;
+  oxcf->lpf_opt = extra_cfg->lpf_opt;
   oxcf->motion_vector_unit_test = extra_cfg->motion_vector_unit_test;
 
   oxcf->delta_q_uv = extra_cfg->delta_q_uv;
@@ -633,6 +757,7 @@ static vpx_codec_err_t encoder_set_config(vpx_codec_alg_priv_t *ctx,
   vpx_codec_err_t res;
   int force_key = 0;
 
+  pipeline_wait(ctx);
   if (cfg->g_w != ctx->cfg.g_w || cfg->g_h != ctx->cfg.g_h) {
     if (cfg->g_lag_in_frames > 1 || cfg->g_pass != VPX_RC_ONE_PASS)
       ERROR("Cannot change width or height after initialization");
@@ -667,6 +792,7 @@ static vpx_codec_err_t encoder_set_config(vpx_codec_alg_priv_t *ctx,
 static vpx_codec_err_t ctrl_get_quantizer(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   int *const arg = va_arg(args, int *);
+  pipeline_wait(ctx);
   if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
   *arg = vp9_get_quantizer(ctx->cpi);
   return VPX_CODEC_OK;
@@ -675,6 +801,7 @@ static vpx_codec_err_t ctrl_get_quantizer(vpx_codec_alg_priv_t *ctx,
 static vpx_codec_err_t ctrl_get_quantizer64(vpx_codec_alg_priv_t *ctx,
                                             va_list args) {
   int *const arg = va_arg(args, int *);
+  pipeline_wait(ctx);
   if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
   *arg = vp9_qindex_to_quantizer(vp9_get_quantizer(ctx->cpi));
   return VPX_CODEC_OK;
@@ -682,7 +809,10 @@ static vpx_codec_err_t ctrl_get_quantizer64(vpx_codec_alg_priv_t *ctx,
 
 static vpx_codec_err_t update_extra_cfg(vpx_codec_alg_priv_t *ctx,
                                         const struct vp9_extracfg *extra_cfg) {
-  const vpx_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
+  vpx_codec_err_t res;
+
+  pipeline_wait(ctx);
+  res = validate_config(ctx, &ctx->cfg, extra_cfg);
   if (res == VPX_CODEC_OK) {
     ctx->extra_cfg = *extra_cfg;
     set_encoder_config(&ctx->oxcf, &ctx->cfg, &ctx->extra_cfg);
@@ -872,6 +1002,47 @@ static vpx_codec_err_t ctrl_set_row_mt(vpx_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t ctrl_set_loop_filter_opt(vpx_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.lpf_opt = CAST(VP9E_SET_LOOP_FILTER_OPT, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_pipelined_encode(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  const int pipelined = CAST(VP9E_SET_PIPELINED_ENCODE, args) != 0;
+  vpx_codec_err_t res;
+
+  pipeline_wait(ctx);
+  res = ctx->pipeline_res;
+  ctx->pipeline_res = VPX_CODEC_OK;
+  if (pipelined && !ctx->pipelined &&
+      !vpx_get_worker_interface()->reset(&ctx->pipeline_worker)) {
+    return VPX_CODEC_MEM_ERROR;
+  }
+  // The packets of the last pipelined frame were moved to pipeline_pkts.
+  if (!pipelined) vpx_codec_pkt_list_init(&ctx->pkt_list);
+  ctx->pipelined = pipelined;
+  return res;
+}
+
+static vpx_codec_err_t ctrl_set_source_release_cb(vpx_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  const vpx_codec_release_source_cb_t *const cb =
+      va_arg(args, vpx_codec_release_source_cb_t *);
+  VP9_COMP *const cpi = ctx->cpi;
+
+  pipeline_wait(ctx);
+  // Frames already held keep the callback they were pushed with.
+  if (cb != NULL) {
+    cpi->release_source_cb = *cb;
+  } else {
+    cpi->release_source_cb.release_source = NULL;
+  }
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_enable_motion_vector_unit_test(
     vpx_codec_alg_priv_t *ctx, va_list args) {
   struct vp9_extracfg extra_cfg = ctx->extra_cfg;
@@ -882,11 +1053,31 @@ static vpx_codec_err_t ctrl_enable_motion_vector_unit_test(
 
 static vpx_codec_err_t ctrl_get_level(vpx_codec_alg_priv_t *ctx, va_list args) {
   int *const arg = va_arg(args, int *);
+  pipeline_wait(ctx);
   if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
   *arg = (int)vp9_get_level(&ctx->cpi->level_info.level_spec);
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_get_row_mt_thread_stats(vpx_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+  vpx_row_mt_thread_stats_t *const stats =
+      va_arg(args, vpx_row_mt_thread_stats_t *);
+  const MultiThreadHandle *const multi_thread_ctxt =
+      &ctx->cpi->multi_thread_ctxt;
+  int i;
+
+  pipeline_wait(ctx);
+  if (stats == NULL) return VPX_CODEC_INVALID_PARAM;
+  memset(stats, 0, sizeof(*stats));
+  stats->num_threads = VPXMIN(ctx->cpi->num_workers, VPX_ROW_MT_MAX_THREADS);
+  for (i = 0; i < stats->num_threads; ++i) {
+    stats->busy_us[i] = multi_thread_ctxt->thread_busy_time[i];
+    stats->idle_us[i] = multi_thread_ctxt->thread_idle_time[i];
+  }
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
                                     vpx_codec_priv_enc_mr_cfg_t *data) {
   vpx_codec_err_t res = VPX_CODEC_OK;
@@ -901,6 +1092,7 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
     ctx->priv->enc.total_encoders = 1;
     priv->buffer_pool = (BufferPool *)vpx_calloc(1, sizeof(BufferPool));
     if (priv->buffer_pool == NULL) return VPX_CODEC_MEM_ERROR;
+    vpx_get_worker_interface()->init(&priv->pipeline_worker);
 
     if (ctx->config.enc) {
       // Update the reference to the config structure to an internal copy.
@@ -933,6 +1125,13 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
 }
 
 static vpx_codec_err_t encoder_destroy(vpx_codec_alg_priv_t *ctx) {
+  pipeline_wait(ctx);
+  vpx_get_worker_interface()->end(&ctx->pipeline_worker);
+  vpx_img_free(&ctx->pipeline_jobs[0].img);
+  vpx_img_free(&ctx->pipeline_jobs[1].img);
+  pkt_queue_pop(&ctx->pipeline_pkts, ctx->pipeline_pkts.count);
+  free(ctx->pipeline_pkts.pkts);
+  free(ctx->pipeline_done.pkts);
   free(ctx->cx_data);
   vp9_remove_compressor(ctx->cpi);
   vpx_free(ctx->buffer_pool);
@@ -1082,12 +1281,12 @@ get_first_pass_stats_pkt(FIRSTPASS_STATS *stats) {
 #endif
 
 const size_t kMinCompressedSize = 8192;
-static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
-                                      const vpx_image_t *img,
-                                      vpx_codec_pts_t pts_val,
-                                      unsigned long duration,
-                                      vpx_enc_frame_flags_t enc_flags,
-                                      unsigned long deadline) {
+static vpx_codec_err_t encode_frame(vpx_codec_alg_priv_t *ctx,
+                                    const vpx_image_t *img,
+                                    vpx_codec_pts_t pts_val,
+                                    unsigned long duration,
+                                    vpx_enc_frame_flags_t enc_flags,
+                                    unsigned long deadline) {
   volatile vpx_codec_err_t res = VPX_CODEC_OK;
   volatile vpx_enc_frame_flags_t flags = enc_flags;
   volatile vpx_codec_pts_t pts = pts_val;
@@ -1340,8 +1539,131 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
   return res;
 }
 
+static int pipeline_hook(void *arg1, void *arg2) {
+  vpx_codec_alg_priv_t *const ctx = (vpx_codec_alg_priv_t *)arg1;
+  EncodeJob *const job = (EncodeJob *)arg2;
+  const vpx_codec_cx_pkt_t *pkt;
+  vpx_codec_iter_t iter = NULL;
+
+  // encode_frame() may fail before resetting the list.
+  vpx_codec_pkt_list_init(&ctx->pkt_list);
+  job->res = encode_frame(ctx, job->flush ? NULL : &job->img, job->pts,
+                          job->duration, job->flags, job->deadline);
+  while ((pkt = vpx_codec_pkt_list_get(&ctx->pkt_list.head, &iter)) != NULL) {
+    if (!pkt_queue_push(&ctx->pipeline_done, pkt)) {
+      job->res = VPX_CODEC_MEM_ERROR;
+      break;
+    }
+  }
+  return job->res == VPX_CODEC_OK;
+}
+
+// Copies img to dst, reallocating dst if its format or size differ.
+static int copy_image(vpx_image_t *dst, const vpx_image_t *img) {
+  const int bytes_per_sample = (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  int plane;
+
+  if (dst->img_data == NULL || dst->fmt != img->fmt || dst->d_w != img->d_w ||
+      dst->d_h != img->d_h) {
+    vpx_img_free(dst);
+    if (vpx_img_alloc(dst, img->fmt, img->d_w, img->d_h, 32) == NULL) return 0;
+  }
+  dst->bit_depth = img->bit_depth;
+  dst->cs = img->cs;
+  dst->range = img->range;
+  dst->r_w = img->r_w;
+  dst->r_h = img->r_h;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int x_shift = plane ? img->x_chroma_shift : 0;
+    const int y_shift = plane ? img->y_chroma_shift : 0;
+    const int w = ((img->d_w + x_shift) >> x_shift) * bytes_per_sample;
+    const int h = (img->d_h + y_shift) >> y_shift;
+    const uint8_t *src_row = img->planes[plane];
+    uint8_t *dst_row = dst->planes[plane];
+    int y;
+    for (y = 0; y < h; ++y) {
+      memcpy(dst_row, src_row, w);
+      src_row += img->stride[plane];
+      dst_row += dst->stride[plane];
+    }
+  }
+  return 1;
+}
+
+static void release_source(const VP9_COMP *cpi, const vpx_image_t *img) {
+  cpi->release_source_cb.release_source(cpi->release_source_cb.user_priv,
+                                        img);
+}
+
+static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
+                                      const vpx_image_t *img,
+                                      vpx_codec_pts_t pts,
+                                      unsigned long duration,
+                                      vpx_enc_frame_flags_t flags,
+                                      unsigned long deadline) {
+  EncodeJob *const job = &ctx->pipeline_jobs[ctx->pipeline_job];
+  VP9_COMP *const cpi = ctx->cpi;
+  vpx_codec_err_t res;
+
+  // Release the packets returned since the last call.
+  pkt_queue_pop(&ctx->pipeline_pkts, ctx->pipeline_next_pkt);
+  ctx->pipeline_next_pkt = 0;
+
+  if (!ctx->pipelined) {
+    if (img != NULL && cpi->release_source_cb.release_source != NULL)
+      cpi->source_ref = img;
+    res = encode_frame(ctx, img, pts, duration, flags, deadline);
+    // The lookahead did not take the frame.
+    if (cpi->source_ref != NULL) {
+      release_source(cpi, cpi->source_ref);
+      cpi->source_ref = NULL;
+    }
+    return res;
+  }
+
+  // Copy the frame while the previous one is being encoded.
+  if (img != NULL) {
+    res = validate_img(ctx, img);
+    if (res == VPX_CODEC_OK && !copy_image(&job->img, img))
+      res = VPX_CODEC_MEM_ERROR;
+    if (cpi->release_source_cb.release_source != NULL)
+      release_source(cpi, img);
+    if (res != VPX_CODEC_OK) return res;
+  }
+  job->flush = img == NULL;
+  job->pts = pts;
+  job->duration = duration;
+  job->flags = flags;
+  job->deadline = deadline;
+
+  pipeline_wait(ctx);
+  res = ctx->pipeline_res;
+  ctx->pipeline_res = VPX_CODEC_OK;
+  if (res != VPX_CODEC_OK) return res;
+
+  ctx->pipeline_worker.hook = pipeline_hook;
+  ctx->pipeline_worker.data1 = ctx;
+  ctx->pipeline_worker.data2 = job;
+  vpx_get_worker_interface()->launch(&ctx->pipeline_worker);
+  ctx->pipeline_busy = 1;
+  ctx->pipeline_job ^= 1;
+
+  // Flushing returns the packets of the frames left in the encoder.
+  if (img == NULL) {
+    pipeline_wait(ctx);
+    res = ctx->pipeline_res;
+    ctx->pipeline_res = VPX_CODEC_OK;
+  }
+  return res;
+}
+
 static const vpx_codec_cx_pkt_t *encoder_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                     vpx_codec_iter_t *iter) {
+  // Packets of pipelined frames come first and are returned once.
+  if (ctx->pipeline_next_pkt < ctx->pipeline_pkts.count)
+    return &ctx->pipeline_pkts.pkts[ctx->pipeline_next_pkt++];
+  if (ctx->pipelined) return NULL;
   return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
 }
 
@@ -1349,6 +1671,7 @@ static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vpx_ref_frame_t *const frame = va_arg(args, vpx_ref_frame_t *);
 
+  pipeline_wait(ctx);
   if (frame != NULL) {
     YV12_BUFFER_CONFIG sd;
 
@@ -1364,6 +1687,7 @@ static vpx_codec_err_t ctrl_copy_reference(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_ref_frame_t *const frame = va_arg(args, vpx_ref_frame_t *);
 
+  pipeline_wait(ctx);
   if (frame != NULL) {
     YV12_BUFFER_CONFIG sd;
 
@@ -1379,6 +1703,7 @@ static vpx_codec_err_t ctrl_get_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vp9_ref_frame_t *const frame = va_arg(args, vp9_ref_frame_t *);
 
+  pipeline_wait(ctx);
   if (frame != NULL) {
     const int fb_idx = ctx->cpi->common.cur_show_frame_fb_idx;
     YV12_BUFFER_CONFIG *fb = get_buf_frame(&ctx->cpi->common, fb_idx);
@@ -1408,6 +1733,7 @@ static vpx_codec_err_t ctrl_set_previewpp(vpx_codec_alg_priv_t *ctx,
 static vpx_image_t *encoder_get_preview(vpx_codec_alg_priv_t *ctx) {
   YV12_BUFFER_CONFIG sd;
   vp9_ppflags_t flags;
+  pipeline_wait(ctx);
   vp9_zero(flags);
 
   if (ctx->preview_ppcfg.post_proc_flag) {
@@ -1427,6 +1753,7 @@ static vpx_codec_err_t ctrl_set_roi_map(vpx_codec_alg_priv_t *ctx,
                                         va_list args) {
   vpx_roi_map_t *data = va_arg(args, vpx_roi_map_t *);
 
+  pipeline_wait(ctx);
   if (data) {
     vpx_roi_map_t *roi = (vpx_roi_map_t *)data;
 
@@ -1444,6 +1771,7 @@ static vpx_codec_err_t ctrl_set_active_map(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_active_map_t *const map = va_arg(args, vpx_active_map_t *);
 
+  pipeline_wait(ctx);
   if (map) {
     if (!vp9_set_active_map(ctx->cpi, map->active_map, (int)map->rows,
                             (int)map->cols))
@@ -1458,6 +1786,7 @@ static vpx_codec_err_t ctrl_get_active_map(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_active_map_t *const map = va_arg(args, vpx_active_map_t *);
 
+  pipeline_wait(ctx);
   if (map) {
     if (!vp9_get_active_map(ctx->cpi, map->active_map, (int)map->rows,
                             (int)map->cols))
@@ -1472,6 +1801,7 @@ static vpx_codec_err_t ctrl_set_scale_mode(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_scaling_mode_t *const mode = va_arg(args, vpx_scaling_mode_t *);
 
+  pipeline_wait(ctx);
   if (mode) {
     const int res =
         vp9_set_internal_size(ctx->cpi, (VPX_SCALING)mode->h_scaling_mode,
@@ -1484,6 +1814,7 @@ static vpx_codec_err_t ctrl_set_scale_mode(vpx_codec_alg_priv_t *ctx,
 static vpx_codec_err_t ctrl_set_svc(vpx_codec_alg_priv_t *ctx, va_list args) {
   int data = va_arg(args, int);
   const vpx_codec_enc_cfg_t *cfg = &ctx->cfg;
+  pipeline_wait(ctx);
   // Both one-pass and two-pass RC are supported now.
   // User setting this has to make sure of the following.
   // In two-pass setting: either (but not both)
@@ -1511,6 +1842,7 @@ static vpx_codec_err_t ctrl_set_svc_layer_id(vpx_codec_alg_priv_t *ctx,
   SVC *const svc = &cpi->svc;
   int sl;
 
+  pipeline_wait(ctx);
   svc->spatial_layer_to_encode = data->spatial_layer_id;
   svc->first_spatial_layer_to_encode = data->spatial_layer_id;
   // TODO(jianj): Deprecated to be removed.
@@ -1535,6 +1867,7 @@ static vpx_codec_err_t ctrl_get_svc_layer_id(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = (VP9_COMP *)ctx->cpi;
   SVC *const svc = &cpi->svc;
 
+  pipeline_wait(ctx);
   data->spatial_layer_id = svc->spatial_layer_id;
   data->temporal_layer_id = svc->temporal_layer_id;
 
@@ -1547,6 +1880,7 @@ static vpx_codec_err_t ctrl_set_svc_parameters(vpx_codec_alg_priv_t *ctx,
   vpx_svc_extra_cfg_t *const params = va_arg(args, vpx_svc_extra_cfg_t *);
   int sl, tl;
 
+  pipeline_wait(ctx);
   // Number of temporal layers and number of spatial layers have to be set
   // properly before calling this control function.
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
@@ -1570,6 +1904,7 @@ static vpx_codec_err_t ctrl_get_svc_ref_frame_config(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = ctx->cpi;
   vpx_svc_ref_frame_config_t *data = va_arg(args, vpx_svc_ref_frame_config_t *);
   int sl;
+  pipeline_wait(ctx);
   for (sl = 0; sl <= cpi->svc.spatial_layer_id; sl++) {
     data->update_buffer_slot[sl] = cpi->svc.update_buffer_slot[sl];
     data->reference_last[sl] = cpi->svc.reference_last[sl];
@@ -1591,6 +1926,7 @@ static vpx_codec_err_t ctrl_set_svc_ref_frame_config(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = ctx->cpi;
   vpx_svc_ref_frame_config_t *data = va_arg(args, vpx_svc_ref_frame_config_t *);
   int sl;
+  pipeline_wait(ctx);
   cpi->svc.use_set_ref_frame_config = 1;
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
     cpi->svc.update_buffer_slot[sl] = data->update_buffer_slot[sl];
@@ -1609,6 +1945,7 @@ static vpx_codec_err_t ctrl_set_svc_inter_layer_pred(vpx_codec_alg_priv_t *ctx,
                                                      va_list args) {
   const int data = va_arg(args, int);
   VP9_COMP *const cpi = ctx->cpi;
+  pipeline_wait(ctx);
   cpi->svc.disable_inter_layer_pred = data;
   return VPX_CODEC_OK;
 }
@@ -1618,6 +1955,7 @@ static vpx_codec_err_t ctrl_set_svc_frame_drop_layer(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = ctx->cpi;
   vpx_svc_frame_drop_t *data = va_arg(args, vpx_svc_frame_drop_t *);
   int sl;
+  pipeline_wait(ctx);
   cpi->svc.framedrop_mode = data->framedrop_mode;
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl)
     cpi->svc.framedrop_thresh[sl] = data->framedrop_thresh[sl];
@@ -1630,6 +1968,7 @@ static vpx_codec_err_t ctrl_set_svc_gf_temporal_ref(vpx_codec_alg_priv_t *ctx,
                                                     va_list args) {
   VP9_COMP *const cpi = ctx->cpi;
   const unsigned int data = va_arg(args, unsigned int);
+  pipeline_wait(ctx);
   cpi->svc.use_gf_temporal_ref = data;
   return VPX_CODEC_OK;
 }
@@ -1640,6 +1979,7 @@ static vpx_codec_err_t ctrl_set_svc_spatial_layer_sync(
   vpx_svc_spatial_layer_sync_t *data =
       va_arg(args, vpx_svc_spatial_layer_sync_t *);
   int sl;
+  pipeline_wait(ctx);
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl)
     cpi->svc.spatial_layer_sync[sl] = data->spatial_layer_sync[sl];
   cpi->svc.set_intra_only_frame = data->base_layer_intra_only;
@@ -1699,6 +2039,7 @@ static vpx_codec_err_t ctrl_set_postencode_drop(vpx_codec_alg_priv_t *ctx,
                                                 va_list args) {
   VP9_COMP *const cpi = ctx->cpi;
   const unsigned int data = va_arg(args, unsigned int);
+  pipeline_wait(ctx);
   cpi->rc.ext_use_post_encode_drop = data;
   return VPX_CODEC_OK;
 }
@@ -1753,6 +2094,9 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_SET_SVC_GF_TEMPORAL_REF, ctrl_set_svc_gf_temporal_ref },
   { VP9E_SET_SVC_SPATIAL_LAYER_SYNC, ctrl_set_svc_spatial_layer_sync },
   { VP9E_SET_DELTA_Q_UV, ctrl_set_delta_q_uv },
+  { VP9E_SET_LOOP_FILTER_OPT, ctrl_set_loop_filter_opt },
+  { VP9E_SET_PIPELINED_ENCODE, ctrl_set_pipelined_encode },
+  { VP9E_SET_SOURCE_RELEASE_CB, ctrl_set_source_release_cb },
 
   // Getters
   { VP8E_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -1762,6 +2106,7 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_GET_ACTIVEMAP, ctrl_get_active_map },
   { VP9E_GET_LEVEL, ctrl_get_level },
   { VP9E_GET_SVC_REF_FRAME_CONFIG, ctrl_get_svc_ref_frame_config },
+  { VP9E_GET_ROW_MT_THREAD_STATS, ctrl_get_row_mt_thread_stats },
 
   { -1, NULL },
 };
@@ -1849,7 +2194,8 @@ CODEC_INTERFACE(vpx_codec_vp9_cx) = {
       NULL,  // vpx_codec_get_si_fn_t
       NULL,  // vpx_codec_decode_fn_t
       NULL,  // vpx_codec_frame_get_fn_t
-      NULL   // vpx_codec_set_fb_fn_t
+      NULL,  // vpx_codec_set_fb_fn_t
+      NULL   // vpx_codec_decode_async_fn_t
   },
   {
       // NOLINT
@@ -2059,6 +2405,7 @@ void vp9_dump_encoder_config(const VP9EncoderConfig *oxcf) {
   DUMP_STRUCT_VALUE(oxcf, temporal_layering_mode);
 
   DUMP_STRUCT_VALUE(oxcf, row_mt);
+  DUMP_STRUCT_VALUE(oxcf, lpf_opt);
   DUMP_STRUCT_VALUE(oxcf, motion_vector_unit_test);
 }
 
@@ -2082,3 +2429,8 @@ void vp9_set_first_pass_stats(VP9EncoderConfig *oxcf,
                               const vpx_fixed_buf_t *stats) {
   oxcf->two_pass_stats_in = *stats;
 }
+
+VP9_COMP *vp9_get_compressor(vpx_codec_ctx_t *ctx) {
+  vpx_codec_alg_priv_t *const priv = (vpx_codec_alg_priv_t *)ctx->priv;
+  return priv != NULL ? priv->cpi : NULL;
+}
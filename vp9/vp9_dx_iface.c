@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -56,14 +57,48 @@ static vpx_codec_err_t decoder_init(vpx_codec_ctx_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static void sync_frame_workers(vpx_codec_alg_priv_t *ctx);
+static void release_output_frames(vpx_codec_alg_priv_t *ctx);
+
 static vpx_codec_err_t decoder_destroy(vpx_codec_alg_priv_t *ctx) {
-  if (ctx->pbi != NULL) {
+  if (ctx->frame_workers != NULL) {
+    int i;
+    sync_frame_workers(ctx);
+    while (ctx->num_cache_frames > 0) {
+      ctx->output_fb_idx[ctx->num_output_frames++] =
+          ctx->frame_cache[ctx->frame_cache_read].fb_idx;
+      ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+      --ctx->num_cache_frames;
+    }
+    release_output_frames(ctx);
+
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      VPxWorker *const worker = &ctx->frame_workers[i];
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)worker->data1;
+      vpx_get_worker_interface()->end(worker);
+      if (frame_worker_data == NULL) continue;
+      if (frame_worker_data->pbi != NULL)
+        vp9_decoder_remove(frame_worker_data->pbi);
+      vpx_free(frame_worker_data->scratch_buffer);
+#if CONFIG_MULTITHREAD
+      pthread_mutex_destroy(&frame_worker_data->stats_mutex);
+      pthread_cond_destroy(&frame_worker_data->stats_cond);
+#endif
+      vpx_free(frame_worker_data);
+    }
+    vpx_free(ctx->frame_workers);
+  } else if (ctx->pbi != NULL) {
     vp9_decoder_remove(ctx->pbi);
   }
 
   if (ctx->buffer_pool) {
     vp9_free_ref_frame_buffers(ctx->buffer_pool);
     vp9_free_internal_frame_buffers(&ctx->buffer_pool->int_frame_buffers);
+#if CONFIG_MULTITHREAD
+    pthread_mutex_destroy(&ctx->buffer_pool->pool_mutex);
+    pthread_cond_destroy(&ctx->buffer_pool->progress_cond);
+#endif
   }
 
   vpx_free(ctx->buffer_pool);
@@ -201,14 +236,18 @@ static vpx_codec_err_t update_error_state(
   return error->error_code;
 }
 
-static void init_buffer_callbacks(vpx_codec_alg_priv_t *ctx) {
-  VP9_COMMON *const cm = &ctx->pbi->common;
+static void init_buffer_callbacks(vpx_codec_alg_priv_t *ctx, VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
   BufferPool *const pool = cm->buffer_pool;
 
   cm->new_fb_idx = INVALID_IDX;
   cm->byte_alignment = ctx->byte_alignment;
+  cm->stride_alignment = ctx->zero_copy_stride_alignment;
   cm->skip_loop_filter = ctx->skip_loop_filter;
 
+  // The frame workers' decoders share the pool.
+  if (pool->get_fb_cb != NULL) return;
+
   if (ctx->get_ext_fb_cb != NULL && ctx->release_ext_fb_cb != NULL) {
     pool->get_fb_cb = ctx->get_ext_fb_cb;
     pool->release_fb_cb = ctx->release_ext_fb_cb;
@@ -231,6 +270,13 @@ static void set_default_ppflags(vp8_postproc_cfg_t *cfg) {
   cfg->noise_level = 0;
 }
 
+// Postprocessing writes the output to another buffer, so it is off when the
+// output must not be copied.
+static int use_postproc(const vpx_codec_alg_priv_t *ctx) {
+  return (ctx->base.init_flags & VPX_CODEC_USE_POSTPROC) &&
+         !ctx->zero_copy_stride_alignment;
+}
+
 static void set_ppflags(const vpx_codec_alg_priv_t *ctx, vp9_ppflags_t *flags) {
   flags->post_proc_flag = ctx->postproc_cfg.post_proc_flag;
 
@@ -251,6 +297,91 @@ static void set_ppflags(const vpx_codec_alg_priv_t *ctx, vp9_ppflags_t *flags) {
       ERROR(#memb " out of range [" #lo ".." #hi "]");                   \
   } while (0)
 
+static int frame_worker_hook(void *arg1, void *arg2) {
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)arg1;
+  const uint8_t *data = frame_worker_data->data;
+  (void)arg2;
+
+  frame_worker_data->result = vp9_receive_compressed_data(
+      frame_worker_data->pbi, frame_worker_data->data_size, &data);
+  frame_worker_data->data_end = data;
+  vp9_frameworker_signal_decoded(frame_worker_data);
+  if (frame_worker_data->decode_cb != NULL) {
+    const vpx_codec_err_t error_code =
+        frame_worker_data->pbi->common.error.error_code;
+    frame_worker_data->decode_cb(
+        frame_worker_data->decode_cb_priv, frame_worker_data->user_priv,
+        !frame_worker_data->result
+            ? VPX_CODEC_OK
+            : error_code != VPX_CODEC_OK ? error_code : VPX_CODEC_ERROR);
+  }
+  return !frame_worker_data->result;
+}
+
+static vpx_codec_err_t init_frame_workers(vpx_codec_alg_priv_t *ctx) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  const int num_workers =
+      VPXMAX(1, VPXMIN((int)ctx->cfg.threads, MAX_FRAME_WORKERS));
+  int i;
+
+  ctx->frame_workers = (VPxWorker *)vpx_calloc(num_workers, sizeof(VPxWorker));
+  if (ctx->frame_workers == NULL) {
+    set_error_detail(ctx, "Failed to allocate frame workers");
+    return VPX_CODEC_MEM_ERROR;
+  }
+
+  for (i = 0; i < num_workers; ++i) {
+    VPxWorker *const worker = &ctx->frame_workers[i];
+    FrameWorkerData *frame_worker_data;
+    VP9Decoder *pbi;
+
+    winterface->init(worker);
+    frame_worker_data =
+        (FrameWorkerData *)vpx_calloc(1, sizeof(*frame_worker_data));
+    if (frame_worker_data == NULL) {
+      set_error_detail(ctx, "Failed to allocate frame worker data");
+      return VPX_CODEC_MEM_ERROR;
+    }
+    worker->data1 = frame_worker_data;
+    ++ctx->num_frame_workers;
+    ++ctx->available_threads;
+
+#if CONFIG_MULTITHREAD
+    if (pthread_mutex_init(&frame_worker_data->stats_mutex, NULL) ||
+        pthread_cond_init(&frame_worker_data->stats_cond, NULL)) {
+      set_error_detail(ctx, "Failed to initialize frame worker");
+      return VPX_CODEC_MEM_ERROR;
+    }
+#endif
+    // Nothing to wait for before the first frame.
+    frame_worker_data->frame_context_ready = 1;
+
+    pbi = vp9_decoder_create(ctx->buffer_pool);
+    frame_worker_data->pbi = pbi;
+    if (pbi == NULL) {
+      set_error_detail(ctx, "Failed to allocate decoder");
+      return VPX_CODEC_MEM_ERROR;
+    }
+    pbi->frame_worker_owner = worker;
+    pbi->common.frame_parallel_decode = 1;
+    // Each frame worker decodes its frame on its own thread.
+    pbi->max_threads = 1;
+    pbi->inv_tile_order = ctx->invert_tile_order;
+    pbi->frame_timing = ctx->frame_timing;
+    init_buffer_callbacks(ctx, pbi);
+
+    worker->hook = frame_worker_hook;
+    if (!winterface->reset(worker)) {
+      set_error_detail(ctx, "Frame worker thread creation failed");
+      return VPX_CODEC_MEM_ERROR;
+    }
+  }
+
+  ctx->last_submit_worker_id = -1;
+  ctx->pbi = ((FrameWorkerData *)ctx->frame_workers[0].data1)->pbi;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->last_show_frame = -1;
   ctx->need_resync = 1;
@@ -259,6 +390,23 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->buffer_pool = (BufferPool *)vpx_calloc(1, sizeof(BufferPool));
   if (ctx->buffer_pool == NULL) return VPX_CODEC_MEM_ERROR;
 
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&ctx->buffer_pool->pool_mutex, NULL) ||
+      pthread_cond_init(&ctx->buffer_pool->progress_cond, NULL)) {
+    vpx_free(ctx->buffer_pool);
+    ctx->buffer_pool = NULL;
+    set_error_detail(ctx, "Failed to allocate buffer pool mutex");
+    return VPX_CODEC_MEM_ERROR;
+  }
+#endif
+
+  RANGE_CHECK(ctx, frame_parallel_decode, 0, 1);
+  // Postprocessing is applied on output by the decoder of the frame, which
+  // frame parallel decode no longer keeps around.
+  if (use_postproc(ctx)) ctx->frame_parallel_decode = 0;
+
+  if (ctx->frame_parallel_decode) return init_frame_workers(ctx);
+
   ctx->pbi = vp9_decoder_create(ctx->buffer_pool);
   if (ctx->pbi == NULL) {
     set_error_detail(ctx, "Failed to allocate decoder");
@@ -266,19 +414,22 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   }
   ctx->pbi->max_threads = ctx->cfg.threads;
   ctx->pbi->inv_tile_order = ctx->invert_tile_order;
+  ctx->pbi->frame_timing = ctx->frame_timing;
 
   RANGE_CHECK(ctx, row_mt, 0, 1);
   ctx->pbi->row_mt = ctx->row_mt;
 
   RANGE_CHECK(ctx, lpf_opt, 0, 1);
-  ctx->pbi->lpf_mt_opt = ctx->lpf_opt;
+  // The optimized loop filter has tile workers wait on rows decoded by all
+  // the others, which a shared pool running work on the caller cannot serve.
+  ctx->pbi->lpf_mt_opt = ctx->lpf_opt && !vpx_thread_pool_active();
 
   // If postprocessing was enabled by the application and a
   // configuration has not been provided, default it.
-  if (!ctx->postproc_cfg_set && (ctx->base.init_flags & VPX_CODEC_USE_POSTPROC))
+  if (!ctx->postproc_cfg_set && use_postproc(ctx))
     set_default_ppflags(&ctx->postproc_cfg);
 
-  init_buffer_callbacks(ctx);
+  init_buffer_callbacks(ctx, ctx->pbi);
 
   return VPX_CODEC_OK;
 }
@@ -291,23 +442,30 @@ static INLINE void check_resync(vpx_codec_alg_priv_t *const ctx,
     ctx->need_resync = 0;
 }
 
-static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
-                                  const uint8_t **data, unsigned int data_sz,
-                                  void *user_priv, int64_t deadline) {
-  (void)deadline;
-
+static vpx_codec_err_t peek_stream_info(vpx_codec_alg_priv_t *ctx,
+                                        const uint8_t *data,
+                                        unsigned int data_sz) {
   // Determine the stream parameters. Note that we rely on peek_si to
   // validate that we have a buffer that does not wrap around the top
   // of the heap.
   if (!ctx->si.h) {
     int is_intra_only = 0;
     const vpx_codec_err_t res =
-        decoder_peek_si_internal(*data, data_sz, &ctx->si, &is_intra_only,
+        decoder_peek_si_internal(data, data_sz, &ctx->si, &is_intra_only,
                                  ctx->decrypt_cb, ctx->decrypt_state);
     if (res != VPX_CODEC_OK) return res;
 
     if (!ctx->si.is_kf && !is_intra_only) return VPX_CODEC_ERROR;
   }
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
+                                  const uint8_t **data, unsigned int data_sz,
+                                  void *user_priv, int64_t deadline) {
+  const vpx_codec_err_t res = peek_stream_info(ctx, *data, data_sz);
+  (void)deadline;
+  if (res != VPX_CODEC_OK) return res;
 
   ctx->user_priv = user_priv;
 
@@ -328,6 +486,153 @@ static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static void release_output_frames(vpx_codec_alg_priv_t *ctx) {
+  BufferPool *const pool = ctx->buffer_pool;
+  int i;
+
+  if (ctx->num_output_frames == 0) return;
+  lock_buffer_pool(pool);
+  for (i = 0; i < ctx->num_output_frames; ++i)
+    decrease_ref_count(ctx->output_fb_idx[i], pool->frame_bufs, pool);
+  unlock_buffer_pool(pool);
+  ctx->num_output_frames = 0;
+}
+
+// Wait for the oldest frame in flight. Its frame buffer, still held by the
+// frame worker's decoder, is moved to the frame cache if it is to be output
+// and released otherwise.
+static vpx_codec_err_t sync_output_worker(vpx_codec_alg_priv_t *ctx) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker *const worker = &ctx->frame_workers[ctx->next_output_worker_id];
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+  VP9Decoder *const pbi = frame_worker_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  YV12_BUFFER_CONFIG sd;
+  vp9_ppflags_t flags = { 0, 0, 0 };
+
+  assert(ctx->available_threads < ctx->num_frame_workers);
+  ctx->next_output_worker_id =
+      (ctx->next_output_worker_id + 1) % ctx->num_frame_workers;
+  ++ctx->available_threads;
+
+  if (!winterface->sync(worker)) {
+    // The frame worker has already released the frame. Keep the error detail
+    // around: the frame worker may be relaunched before it is read.
+    ctx->need_resync = 1;
+    if (cm->error.has_detail) {
+      memcpy(ctx->error_detail, cm->error.detail, sizeof(ctx->error_detail));
+      set_error_detail(ctx, ctx->error_detail);
+    } else {
+      set_error_detail(ctx, NULL);
+    }
+    return cm->error.error_code;
+  }
+
+  check_resync(ctx, pbi);
+
+  if (frame_worker_data->output_candidate && !ctx->need_resync &&
+      vp9_get_raw_frame(pbi, &sd, &flags) == 0) {
+    cache_frame *frame;
+    if (ctx->num_cache_frames == FRAME_CACHE_SIZE) {
+      // The application is not retrieving the frames; drop the oldest.
+      lock_buffer_pool(pool);
+      decrease_ref_count(ctx->frame_cache[ctx->frame_cache_read].fb_idx,
+                         pool->frame_bufs, pool);
+      unlock_buffer_pool(pool);
+      ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+      --ctx->num_cache_frames;
+    }
+    frame = &ctx->frame_cache[ctx->frame_cache_write];
+    frame->fb_idx = cm->new_fb_idx;
+    frame->corrupted = pool->frame_bufs[cm->new_fb_idx].buf.corrupted;
+    yuvconfig2image(&frame->img, &sd, frame_worker_data->user_priv);
+    frame->img.fb_priv =
+        pool->frame_bufs[cm->new_fb_idx].raw_frame_buffer.priv;
+    ctx->frame_cache_write = (ctx->frame_cache_write + 1) % FRAME_CACHE_SIZE;
+    ++ctx->num_cache_frames;
+  } else {
+    lock_buffer_pool(pool);
+    decrease_ref_count(cm->new_fb_idx, pool->frame_bufs, pool);
+    unlock_buffer_pool(pool);
+  }
+
+  return VPX_CODEC_OK;
+}
+
+static void sync_frame_workers(vpx_codec_alg_priv_t *ctx) {
+  while (ctx->available_threads < ctx->num_frame_workers)
+    sync_output_worker(ctx);
+}
+
+// Start decoding a frame on the next frame worker, once the previous frame has
+// produced the state this one starts from. output_candidate is set for the
+// last frame of a packet, the only one that may be returned.
+static vpx_codec_err_t submit_frame(vpx_codec_alg_priv_t *ctx,
+                                    const uint8_t *data, unsigned int data_sz,
+                                    void *user_priv, int output_candidate) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker *const worker = &ctx->frame_workers[ctx->next_submit_worker_id];
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+  VP9Decoder *const pbi = frame_worker_data->pbi;
+  vpx_codec_err_t res = peek_stream_info(ctx, data, data_sz);
+  if (res != VPX_CODEC_OK) return res;
+
+  // All frame workers are busy: wait for the oldest frame. An error is
+  // reported once this frame has been submitted, unless it goes to the
+  // completion callback of the oldest frame's packet.
+  if (ctx->available_threads == 0) {
+    res = sync_output_worker(ctx);
+    if (ctx->async_decode) res = VPX_CODEC_OK;
+  }
+
+  if (frame_worker_data->scratch_buffer_size < data_sz) {
+    vpx_free(frame_worker_data->scratch_buffer);
+    frame_worker_data->scratch_buffer_size = 0;
+    frame_worker_data->scratch_buffer = (uint8_t *)vpx_malloc(data_sz);
+    if (frame_worker_data->scratch_buffer == NULL) {
+      set_error_detail(ctx, "Failed to reallocate scratch buffer");
+      return VPX_CODEC_MEM_ERROR;
+    }
+    frame_worker_data->scratch_buffer_size = data_sz;
+  }
+  // The frame is decrypted here as a whole: the decrypt callback expects
+  // pointers into the application's buffer.
+  if (ctx->decrypt_cb != NULL) {
+    ctx->decrypt_cb(ctx->decrypt_state, data, frame_worker_data->scratch_buffer,
+                    data_sz);
+  } else {
+    memcpy(frame_worker_data->scratch_buffer, data, data_sz);
+  }
+  frame_worker_data->data = frame_worker_data->scratch_buffer;
+  frame_worker_data->data_size = data_sz;
+  frame_worker_data->user_priv = user_priv;
+  frame_worker_data->output_candidate = output_candidate;
+  frame_worker_data->decode_cb = output_candidate ? ctx->decode_cb : NULL;
+  frame_worker_data->decode_cb_priv = ctx->decode_cb_priv;
+  frame_worker_data->frame_decoded = 0;
+  pbi->decrypt_cb = NULL;
+  pbi->decrypt_state = NULL;
+
+  if (ctx->last_submit_worker_id >= 0) {
+    FrameWorkerData *const prev_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[ctx->last_submit_worker_id].data1;
+    vp9_frameworker_wait_context_ready(prev_worker_data);
+    vp9_frameworker_copy_context(pbi, prev_worker_data->pbi);
+  }
+  frame_worker_data->frame_context_ready = 0;
+
+  ctx->pbi = pbi;
+  ctx->last_submit_worker_id = ctx->next_submit_worker_id;
+  ctx->next_submit_worker_id =
+      (ctx->next_submit_worker_id + 1) % ctx->num_frame_workers;
+  --ctx->available_threads;
+  worker->had_error = 0;
+  winterface->launch(worker);
+
+  return res;
+}
+
 static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
                                       const uint8_t *data, unsigned int data_sz,
                                       void *user_priv, long deadline) {
@@ -337,6 +642,9 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
   uint32_t frame_sizes[8];
   int frame_count;
 
+  // Frames returned by the last call are no longer in use.
+  if (ctx->frame_parallel_decode) release_output_frames(ctx);
+
   if (data == NULL && data_sz == 0) {
     ctx->flushed = 1;
     return VPX_CODEC_OK;
@@ -371,11 +679,21 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
         return VPX_CODEC_CORRUPT_FRAME;
       }
 
-      res = decode_one(ctx, &data_start_copy, frame_size, user_priv, deadline);
+      if (ctx->frame_parallel_decode) {
+        res = submit_frame(ctx, data_start, frame_size, user_priv,
+                           i == frame_count - 1);
+      } else {
+        res = decode_one(ctx, &data_start_copy, frame_size, user_priv,
+                         deadline);
+      }
       if (res != VPX_CODEC_OK) return res;
 
       data_start += frame_size;
     }
+  } else if (ctx->frame_parallel_decode) {
+    // Without an index the frame boundaries are only known once the frame is
+    // decoded, so the whole buffer is decoded as one frame.
+    res = submit_frame(ctx, data_start, data_sz, user_priv, 1);
   } else {
     while (data_start < data_end) {
       const uint32_t frame_size = (uint32_t)(data_end - data_start);
@@ -396,6 +714,30 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
   return res;
 }
 
+static vpx_codec_err_t decoder_decode_async(vpx_codec_alg_priv_t *ctx,
+                                            const uint8_t *data,
+                                            unsigned int data_sz,
+                                            void *user_priv,
+                                            vpx_codec_decode_cb_fn_t cb,
+                                            void *cb_priv) {
+  vpx_codec_err_t res;
+
+  if (!ctx->async_decode) {
+    // Only takes effect when the decoder is initialized on the first frame.
+    if (ctx->pbi != NULL) return VPX_CODEC_ERROR;
+    if (use_postproc(ctx)) return VPX_CODEC_INCAPABLE;
+    ctx->async_decode = 1;
+    ctx->frame_parallel_decode = 1;
+  }
+
+  ctx->decode_cb = cb;
+  ctx->decode_cb_priv = cb_priv;
+  res = decoder_decode(ctx, data, data_sz, user_priv, 0);
+  ctx->decode_cb = NULL;
+  ctx->decode_cb_priv = NULL;
+  return res;
+}
+
 static vpx_image_t *decoder_get_frame(vpx_codec_alg_priv_t *ctx,
                                       vpx_codec_iter_t *iter) {
   vpx_image_t *img = NULL;
@@ -404,10 +746,37 @@ static vpx_image_t *decoder_get_frame(vpx_codec_alg_priv_t *ctx,
   // always return only 1 frame per decode call.
   (void)iter;
 
+  if (ctx->frame_parallel_decode) {
+    // Once flushed, wait for the frames still in flight. Asynchronous decode
+    // only takes the frames that are already decoded.
+    while (ctx->num_cache_frames == 0 &&
+           ctx->available_threads < ctx->num_frame_workers &&
+           (ctx->async_decode
+                ? vp9_frameworker_is_decoded(
+                      (FrameWorkerData *)ctx->frame_workers
+                          [ctx->next_output_worker_id]
+                              .data1)
+                : ctx->flushed))
+      sync_output_worker(ctx);
+
+    if (ctx->num_cache_frames > 0) {
+      const cache_frame *const frame =
+          &ctx->frame_cache[ctx->frame_cache_read];
+      ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+      --ctx->num_cache_frames;
+      ctx->output_fb_idx[ctx->num_output_frames++] = frame->fb_idx;
+      ctx->last_show_frame = frame->fb_idx;
+      ctx->last_show_frame_corrupted = frame->corrupted;
+      ctx->img = frame->img;
+      img = &ctx->img;
+    }
+    return img;
+  }
+
   if (ctx->pbi != NULL) {
     YV12_BUFFER_CONFIG sd;
     vp9_ppflags_t flags = { 0, 0, 0 };
-    if (ctx->base.init_flags & VPX_CODEC_USE_POSTPROC) set_ppflags(ctx, &flags);
+    if (use_postproc(ctx)) set_ppflags(ctx, &flags);
     if (vp9_get_raw_frame(ctx->pbi, &sd, &flags) == 0) {
       VP9_COMMON *const cm = &ctx->pbi->common;
       RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
@@ -443,6 +812,7 @@ static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vpx_ref_frame_t *const data = va_arg(args, vpx_ref_frame_t *);
 
+  sync_frame_workers(ctx);
   if (data) {
     vpx_ref_frame_t *const frame = (vpx_ref_frame_t *)data;
     YV12_BUFFER_CONFIG sd;
@@ -458,6 +828,7 @@ static vpx_codec_err_t ctrl_copy_reference(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_ref_frame_t *data = va_arg(args, vpx_ref_frame_t *);
 
+  sync_frame_workers(ctx);
   if (data) {
     vpx_ref_frame_t *frame = (vpx_ref_frame_t *)data;
     YV12_BUFFER_CONFIG sd;
@@ -473,6 +844,7 @@ static vpx_codec_err_t ctrl_get_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vp9_ref_frame_t *data = va_arg(args, vp9_ref_frame_t *);
 
+  sync_frame_workers(ctx);
   if (data) {
     if (ctx->pbi) {
       const int fb_idx = ctx->pbi->common.cur_show_frame_fb_idx;
@@ -511,6 +883,7 @@ static vpx_codec_err_t ctrl_get_quantizer(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   int *const arg = va_arg(args, int *);
   if (arg == NULL || ctx->pbi == NULL) return VPX_CODEC_INVALID_PARAM;
+  sync_frame_workers(ctx);
   *arg = ctx->pbi->common.base_qindex;
   return VPX_CODEC_OK;
 }
@@ -521,6 +894,7 @@ static vpx_codec_err_t ctrl_get_last_ref_updates(vpx_codec_alg_priv_t *ctx,
 
   if (update_info) {
     if (ctx->pbi != NULL) {
+      sync_frame_workers(ctx);
       *update_info = ctx->pbi->refresh_frame_flags;
       return VPX_CODEC_OK;
     } else {
@@ -538,8 +912,14 @@ static vpx_codec_err_t ctrl_get_frame_corrupted(vpx_codec_alg_priv_t *ctx,
   if (corrupted) {
     if (ctx->pbi != NULL) {
       RefCntBuffer *const frame_bufs = ctx->pbi->common.buffer_pool->frame_bufs;
-      if (ctx->pbi->common.frame_to_show == NULL) return VPX_CODEC_ERROR;
-      if (ctx->last_show_frame >= 0)
+      // In frame parallel decode ctx->pbi may still be decoding its frame.
+      if (ctx->frame_parallel_decode ? ctx->last_submit_worker_id < 0
+                                     : ctx->pbi->common.frame_to_show == NULL)
+        return VPX_CODEC_ERROR;
+      // The frame buffer may already be reused by a frame worker.
+      if (ctx->frame_parallel_decode && ctx->last_show_frame >= 0)
+        *corrupted = ctx->last_show_frame_corrupted;
+      else if (ctx->last_show_frame >= 0)
         *corrupted = frame_bufs[ctx->last_show_frame].buf.corrupted;
       return VPX_CODEC_OK;
     } else {
@@ -557,6 +937,7 @@ static vpx_codec_err_t ctrl_get_frame_size(vpx_codec_alg_priv_t *ctx,
   if (frame_size) {
     if (ctx->pbi != NULL) {
       const VP9_COMMON *const cm = &ctx->pbi->common;
+      sync_frame_workers(ctx);
       frame_size[0] = cm->width;
       frame_size[1] = cm->height;
       return VPX_CODEC_OK;
@@ -575,6 +956,7 @@ static vpx_codec_err_t ctrl_get_render_size(vpx_codec_alg_priv_t *ctx,
   if (render_size) {
     if (ctx->pbi != NULL) {
       const VP9_COMMON *const cm = &ctx->pbi->common;
+      sync_frame_workers(ctx);
       render_size[0] = cm->render_width;
       render_size[1] = cm->render_height;
       return VPX_CODEC_OK;
@@ -593,6 +975,7 @@ static vpx_codec_err_t ctrl_get_bit_depth(vpx_codec_alg_priv_t *ctx,
   if (bit_depth) {
     if (ctx->pbi != NULL) {
       const VP9_COMMON *const cm = &ctx->pbi->common;
+      sync_frame_workers(ctx);
       *bit_depth = cm->bit_depth;
       return VPX_CODEC_OK;
     } else {
@@ -631,7 +1014,15 @@ static vpx_codec_err_t ctrl_set_byte_alignment(vpx_codec_alg_priv_t *ctx,
     return VPX_CODEC_INVALID_PARAM;
 
   ctx->byte_alignment = byte_alignment;
-  if (ctx->pbi != NULL) {
+  if (ctx->frame_parallel_decode) {
+    int i;
+    sync_frame_workers(ctx);
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[i].data1;
+      frame_worker_data->pbi->common.byte_alignment = byte_alignment;
+    }
+  } else if (ctx->pbi != NULL) {
     ctx->pbi->common.byte_alignment = byte_alignment;
   }
   return VPX_CODEC_OK;
@@ -641,7 +1032,15 @@ static vpx_codec_err_t ctrl_set_skip_loop_filter(vpx_codec_alg_priv_t *ctx,
                                                  va_list args) {
   ctx->skip_loop_filter = va_arg(args, int);
 
-  if (ctx->pbi != NULL) {
+  if (ctx->frame_parallel_decode) {
+    int i;
+    sync_frame_workers(ctx);
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[i].data1;
+      frame_worker_data->pbi->common.skip_loop_filter = ctx->skip_loop_filter;
+    }
+  } else if (ctx->pbi != NULL) {
     ctx->pbi->common.skip_loop_filter = ctx->skip_loop_filter;
   }
 
@@ -672,6 +1071,75 @@ static vpx_codec_err_t ctrl_enable_lpf_opt(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_frame_parallel(vpx_codec_alg_priv_t *ctx,
+                                               va_list args) {
+  // Only takes effect when the decoder is initialized on the first frame.
+  if (ctx->pbi != NULL) return VPX_CODEC_ERROR;
+  ctx->frame_parallel_decode = va_arg(args, int);
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_zero_copy_output(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  const int stride_alignment = va_arg(args, int);
+
+  // Only takes effect when the decoder is initialized on the first frame.
+  if (ctx->pbi != NULL) return VPX_CODEC_ERROR;
+  if (stride_alignment != 0 &&
+      (stride_alignment < 32 || stride_alignment > 1024 ||
+       (stride_alignment & (stride_alignment - 1)) != 0))
+    return VPX_CODEC_INVALID_PARAM;
+  ctx->zero_copy_stride_alignment = stride_alignment;
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_frame_timing(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  ctx->frame_timing = !!va_arg(args, int);
+
+  if (ctx->frame_parallel_decode) {
+    int i;
+    sync_frame_workers(ctx);
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[i].data1;
+      frame_worker_data->pbi->frame_timing = ctx->frame_timing;
+    }
+  } else if (ctx->pbi != NULL) {
+    ctx->pbi->frame_timing = ctx->frame_timing;
+  }
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_get_frame_timing(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  vpx_frame_timing_t *const timing = va_arg(args, vpx_frame_timing_t *);
+
+  if (timing) {
+    if (ctx->pbi != NULL && ctx->frame_timing) {
+      const VP9StageTimes *times;
+      sync_frame_workers(ctx);
+      times = &ctx->pbi->frame_times;
+      timing->total = times->total / 1000;
+      timing->header = times->header / 1000;
+      timing->parse = times->parse / 1000;
+      timing->recon = times->recon / 1000;
+      timing->inverse_transform = times->inverse_transform / 1000;
+      timing->inter_pred = times->inter_pred / 1000;
+      timing->loop_filter = times->loop_filter / 1000;
+      timing->thread_wait = times->thread_wait / 1000;
+      return VPX_CODEC_OK;
+    } else {
+      return VPX_CODEC_ERROR;
+    }
+  }
+
+  return VPX_CODEC_INVALID_PARAM;
+}
+
 static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP8_COPY_REFERENCE, ctrl_copy_reference },
 
@@ -685,6 +1153,9 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP9_DECODE_SVC_SPATIAL_LAYER, ctrl_set_spatial_layer_svc },
   { VP9D_SET_ROW_MT, ctrl_set_row_mt },
   { VP9D_SET_LOOP_FILTER_OPT, ctrl_enable_lpf_opt },
+  { VP9D_SET_FRAME_PARALLEL, ctrl_set_frame_parallel },
+  { VP9D_SET_ZERO_COPY_OUTPUT, ctrl_set_zero_copy_output },
+  { VP9D_SET_FRAME_TIMING, ctrl_set_frame_timing },
 
   // Getters
   { VPXD_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -694,6 +1165,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP9D_GET_DISPLAY_SIZE, ctrl_get_render_size },
   { VP9D_GET_BIT_DEPTH, ctrl_get_bit_depth },
   { VP9D_GET_FRAME_SIZE, ctrl_get_frame_size },
+  { VP9D_GET_FRAME_TIMING, ctrl_get_frame_timing },
 
   { -1, NULL },
 };
@@ -708,17 +1180,19 @@ CODEC_INTERFACE(vpx_codec_vp9_dx) = {
   VPX_CODEC_CAP_HIGHBITDEPTH |
 #endif
       VPX_CODEC_CAP_DECODER | VP9_CAP_POSTPROC |
-      VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER,  // vpx_codec_caps_t
-  decoder_init,                             // vpx_codec_init_fn_t
-  decoder_destroy,                          // vpx_codec_destroy_fn_t
-  decoder_ctrl_maps,                        // vpx_codec_ctrl_fn_map_t
+      VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER |
+      VPX_CODEC_CAP_ASYNC_DECODE,  // vpx_codec_caps_t
+  decoder_init,                    // vpx_codec_init_fn_t
+  decoder_destroy,                 // vpx_codec_destroy_fn_t
+  decoder_ctrl_maps,               // vpx_codec_ctrl_fn_map_t
   {
       // NOLINT
-      decoder_peek_si,    // vpx_codec_peek_si_fn_t
-      decoder_get_si,     // vpx_codec_get_si_fn_t
-      decoder_decode,     // vpx_codec_decode_fn_t
-      decoder_get_frame,  // vpx_codec_frame_get_fn_t
-      decoder_set_fb_fn,  // vpx_codec_set_fb_fn_t
+      decoder_peek_si,       // vpx_codec_peek_si_fn_t
+      decoder_get_si,        // vpx_codec_get_si_fn_t
+      decoder_decode,        // vpx_codec_decode_fn_t
+      decoder_get_frame,     // vpx_codec_frame_get_fn_t
+      decoder_set_fb_fn,     // vpx_codec_set_fb_fn_t
+      decoder_decode_async,  // vpx_codec_decode_async_fn_t
   },
   {
       // NOLINT
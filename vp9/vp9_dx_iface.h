@@ -12,9 +12,19 @@
 #define VPX_VP9_VP9_DX_IFACE_H_
 
 #include "vp9/decoder/vp9_decoder.h"
+#include "vp9/decoder/vp9_dthread.h"
 
 typedef vpx_codec_stream_info_t vp9_stream_info_t;
 
+// Decoded frames waiting to be returned in frame parallel decode.
+#define FRAME_CACHE_SIZE MAX_FRAME_WORKERS
+
+typedef struct cache_frame {
+  int fb_idx;
+  int corrupted;
+  vpx_image_t img;
+} cache_frame;
+
 struct vpx_codec_alg_priv {
   vpx_codec_priv_t base;
   vpx_codec_dec_cfg_t cfg;
@@ -31,6 +41,8 @@ struct vpx_codec_alg_priv {
   int invert_tile_order;
   int last_show_frame;  // Index of last output frame.
   int byte_alignment;
+  // Set by VP9D_SET_ZERO_COPY_OUTPUT, 0 when off.
+  int zero_copy_stride_alignment;
   int skip_loop_filter;
 
   int need_resync;  // wait for key/intra-only frame
@@ -47,6 +59,31 @@ struct vpx_codec_alg_priv {
   int svc_spatial_layer;
   int row_mt;
   int lpf_opt;
+  int frame_timing;
+
+  // Frame parallel decode. pbi is the decoder of the last submitted frame.
+  int frame_parallel_decode;
+  // Set by the first vpx_codec_decode_async() call: frames are output once
+  // decoded, without waiting for them.
+  int async_decode;
+  // Completion callback of the packet being submitted.
+  vpx_codec_decode_cb_fn_t decode_cb;
+  void *decode_cb_priv;
+  VPxWorker *frame_workers;
+  int num_frame_workers;
+  int next_submit_worker_id;
+  int last_submit_worker_id;
+  int next_output_worker_id;
+  int available_threads;
+  cache_frame frame_cache[FRAME_CACHE_SIZE];
+  int frame_cache_write;
+  int frame_cache_read;
+  int num_cache_frames;
+  // Frames returned by decoder_get_frame(), held until the next decode call.
+  int output_fb_idx[FRAME_CACHE_SIZE + MAX_FRAME_WORKERS];
+  int num_output_frames;
+  int last_show_frame_corrupted;
+  char error_detail[80];  // of the last frame that failed to decode.
 };
 
 #endif  // VPX_VP9_VP9_DX_IFACE_H_
@@ -58,7 +58,7 @@ extern "C" {
  * types, removing or reassigning enums, adding/removing/rearranging
  * fields to structures
  */
-#define VPX_CODEC_INTERNAL_ABI_VERSION (5) /**<\hideinitializer*/
+#define VPX_CODEC_INTERNAL_ABI_VERSION (6) /**<\hideinitializer*/
 
 typedef struct vpx_codec_alg_priv vpx_codec_alg_priv_t;
 typedef struct vpx_codec_priv_enc_mr_cfg vpx_codec_priv_enc_mr_cfg_t;
@@ -198,6 +198,25 @@ typedef vpx_codec_err_t (*vpx_codec_decode_fn_t)(vpx_codec_alg_priv_t *ctx,
                                                  void *user_priv,
                                                  long deadline);
 
+/*!\brief Decode data without waiting for it to be decoded.
+ *
+ * Queues data to be decoded on the decoder's threads. This function is
+ * called by the generic vpx_codec_decode_async() wrapper function, so
+ * plugins implementing this interface may trust the input parameters to be
+ * properly initialized.
+ *
+ * \param[in] ctx          Pointer to this instance's context
+ * \param[in] data         Pointer to this block of new coded data. NULL
+ *                         flushes the decoder.
+ * \param[in] data_sz      Size of the coded data, in bytes.
+ * \param[in] user_priv    Passed back to cb.
+ * \param[in] cb           Called once the data has been decoded. May be NULL.
+ * \param[in] cb_priv      Callback's private data
+ */
+typedef vpx_codec_err_t (*vpx_codec_decode_async_fn_t)(
+    vpx_codec_alg_priv_t *ctx, const uint8_t *data, unsigned int data_sz,
+    void *user_priv, vpx_codec_decode_cb_fn_t cb, void *cb_priv);
+
 /*!\brief Decoded frames iterator
  *
  * Iterates over a list of the frames available for display. The iterator
@@ -300,6 +319,8 @@ struct vpx_codec_iface {
     vpx_codec_get_frame_fn_t
         get_frame;                   /**< \copydoc ::vpx_codec_get_frame_fn_t */
     vpx_codec_set_fb_fn_t set_fb_fn; /**< \copydoc ::vpx_codec_set_fb_fn_t */
+    vpx_codec_decode_async_fn_t
+        decode_async; /**< \copydoc ::vpx_codec_decode_async_fn_t */
   } dec;
   struct vpx_codec_enc_iface {
     int cfg_map_count;
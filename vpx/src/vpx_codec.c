@@ -12,10 +12,13 @@
  * \brief Provides the high level interface to wrap decoder algorithms.
  *
  */
+#include <limits.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include "./vpx_config.h"
 #include "vpx/vpx_integer.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_util/vpx_thread.h"
 #include "vpx_version.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
@@ -85,6 +88,20 @@ vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface) {
   return (iface) ? iface->caps : 0;
 }
 
+vpx_codec_err_t vpx_codec_thread_pool_init(unsigned int num_threads) {
+#if CONFIG_MULTITHREAD
+  if (num_threads == 0 || num_threads > INT_MAX || vpx_thread_pool_active())
+    return VPX_CODEC_INVALID_PARAM;
+  return vpx_thread_pool_init((int)num_threads) ? VPX_CODEC_OK
+                                                 : VPX_CODEC_MEM_ERROR;
+#else
+  (void)num_threads;
+  return VPX_CODEC_INCAPABLE;
+#endif
+}
+
+void vpx_codec_thread_pool_destroy(void) { vpx_thread_pool_destroy(); }
+
 vpx_codec_err_t vpx_codec_control_(vpx_codec_ctx_t *ctx, int ctrl_id, ...) {
   vpx_codec_err_t res;
 
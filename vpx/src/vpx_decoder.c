@@ -120,6 +120,28 @@ vpx_codec_err_t vpx_codec_decode(vpx_codec_ctx_t *ctx, const uint8_t *data,
   return SAVE_STATUS(ctx, res);
 }
 
+vpx_codec_err_t vpx_codec_decode_async(vpx_codec_ctx_t *ctx,
+                                       const uint8_t *data,
+                                       unsigned int data_sz, void *user_priv,
+                                       vpx_codec_decode_cb_fn_t cb,
+                                       void *cb_priv) {
+  vpx_codec_err_t res;
+
+  /* NULL data ptr allowed if data_sz is 0 too */
+  if (!ctx || (!data && data_sz) || (data && !data_sz))
+    res = VPX_CODEC_INVALID_PARAM;
+  else if (!ctx->iface || !ctx->priv)
+    res = VPX_CODEC_ERROR;
+  else if (!(ctx->iface->caps & VPX_CODEC_CAP_ASYNC_DECODE))
+    res = VPX_CODEC_INCAPABLE;
+  else {
+    res = ctx->iface->dec.decode_async(get_alg_priv(ctx), data, data_sz,
+                                       user_priv, cb, cb_priv);
+  }
+
+  return SAVE_STATUS(ctx, res);
+}
+
 vpx_image_t *vpx_codec_get_frame(vpx_codec_ctx_t *ctx, vpx_codec_iter_t *iter) {
   vpx_image_t *img;
 
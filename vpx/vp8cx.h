@@ -684,6 +684,71 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP9
    */
   VP9E_SET_DELTA_Q_UV,
+
+  /*!\brief Codec control function to get the time each thread of the row
+   * based multi-threaded encoder spent running jobs and waiting for them.
+   *
+   * Times are accumulated over all frames encoded so far. They cover the
+   * first pass, temporal filter, TPL model and encoding stages when run with
+   * VP9E_SET_ROW_MT enabled, and are zero otherwise.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_ROW_MT_THREAD_STATS,
+
+  /*!\brief Codec control function to loop filter superblock rows while the
+   * row based multi-threaded encoder is still encoding the rows below them.
+   *
+   * Only used with VP9E_SET_ROW_MT enabled at realtime speeds where the loop
+   * filter level is picked from q. The output is unchanged.
+   *
+   * 0 : off, 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_LOOP_FILTER_OPT,
+
+  /*!\brief Codec control function to encode each frame on an internal thread
+   * while the application submits the next one.
+   *
+   * vpx_codec_encode() copies the frame and returns once the previous frame is
+   * encoded. vpx_codec_get_cx_data() returns each packet once, so packets come
+   * out one call later than without this control, and all of them once
+   * vpx_codec_encode() is called with a NULL image. An error encoding a frame
+   * is returned by the next vpx_codec_encode() call, which then does not take
+   * its frame. Other controls wait for the frame being encoded. The output is
+   * unchanged.
+   *
+   * 0 : off, 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_PIPELINED_ENCODE,
+
+  /*!\brief Codec control function to let the encoder hold source images by
+   * reference instead of copying them.
+   *
+   * When a release callback is set, vpx_codec_encode() keeps a pointer to the
+   * image and its planes until the encoder no longer reads them, then passes
+   * the image to the callback. The callback is called once for every image
+   * given to vpx_codec_encode(), from within a libvpx call, and may be called
+   * before vpx_codec_encode() returns. The application must not modify or free
+   * the image until then. The last frames are released by
+   * vpx_codec_destroy().
+   *
+   * Only images laid out like the encoder's own frame buffers can be held:
+   * allocate them with vpx_img_alloc(img, fmt, w + 2 * b, h + 2 * b, 32),
+   * where b is VPX_SOURCE_BORDER_IN_PIXELS, and crop them with
+   * vpx_img_set_rect(img, b, b, w, h). The encoder extends the borders of the
+   * frame in place. Images with other strides are copied as usual. The encoder
+   * may also write to the pixels of the image, e.g. when denoising.
+   *
+   * Images given to the encoder in VP9E_SET_PIPELINED_ENCODE mode are always
+   * copied. Pass NULL or a NULL callback to copy all images (default).
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_SOURCE_RELEASE_CB,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -875,6 +940,41 @@ typedef struct vpx_svc_spatial_layer_sync {
   int base_layer_intra_only; /**< Flag for setting Intra-only frame on base */
 } vpx_svc_spatial_layer_sync_t;
 
+/*!\brief Maximum number of threads reported by VP9E_GET_ROW_MT_THREAD_STATS.
+ */
+#define VPX_ROW_MT_MAX_THREADS 64
+
+/*!\brief vp9 row based multi-threading statistics.
+ *
+ * Busy time includes the time a row waits for the row above it to be far
+ * enough ahead. Idle time is the rest of the time spent in row based
+ * multi-threaded stages, mostly waiting for other threads to finish the
+ * frame. All times are in microseconds.
+ */
+typedef struct vpx_row_mt_thread_stats {
+  int num_threads;                         /**< Number of threads reported */
+  int64_t busy_us[VPX_ROW_MT_MAX_THREADS]; /**< Time spent running jobs */
+  int64_t idle_us[VPX_ROW_MT_MAX_THREADS]; /**< Time spent without a job */
+} vpx_row_mt_thread_stats_t;
+
+/*!\brief Border around source images the VP9 encoder can hold by reference,
+ * see VP9E_SET_SOURCE_RELEASE_CB.
+ */
+#define VPX_SOURCE_BORDER_IN_PIXELS 160
+
+/*!\brief Callback function pointer for releasing a source image, see
+ * VP9E_SET_SOURCE_RELEASE_CB.
+ */
+typedef void (*vpx_codec_release_source_fn_t)(void *user_priv,
+                                              const vpx_image_t *img);
+
+/*!\brief vp9 source image release callback and its private data.
+ */
+typedef struct vpx_codec_release_source_cb {
+  vpx_codec_release_source_fn_t release_source; /**< Callback function */
+  void *user_priv; /**< Pointer to private data passed to the callback */
+} vpx_codec_release_source_cb_t;
+
 /*!\cond */
 /*!\brief VP8 encoder control function parameter type
  *
@@ -1034,6 +1134,18 @@ VPX_CTRL_USE_TYPE(VP9E_SET_POSTENCODE_DROP, unsigned int)
 VPX_CTRL_USE_TYPE(VP9E_SET_DELTA_Q_UV, int)
 #define VPX_CTRL_VP9E_SET_DELTA_Q_UV
 
+VPX_CTRL_USE_TYPE(VP9E_GET_ROW_MT_THREAD_STATS, vpx_row_mt_thread_stats_t *)
+#define VPX_CTRL_VP9E_GET_ROW_MT_THREAD_STATS
+
+VPX_CTRL_USE_TYPE(VP9E_SET_LOOP_FILTER_OPT, unsigned int)
+#define VPX_CTRL_VP9E_SET_LOOP_FILTER_OPT
+
+VPX_CTRL_USE_TYPE(VP9E_SET_PIPELINED_ENCODE, unsigned int)
+#define VPX_CTRL_VP9E_SET_PIPELINED_ENCODE
+
+VPX_CTRL_USE_TYPE(VP9E_SET_SOURCE_RELEASE_CB, vpx_codec_release_source_cb_t *)
+#define VPX_CTRL_VP9E_SET_SOURCE_RELEASE_CB
+
 /*!\endcond */
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
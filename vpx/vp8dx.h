@@ -142,6 +142,62 @@ enum vp8_dec_control_id {
    */
   VP9D_SET_LOOP_FILTER_OPT,
 
+  /*!\brief Codec control function to enable frame parallel decoding.
+   *
+   * 0 : off, 1 : on
+   *
+   * When on, up to min(threads, 4) consecutive frames are decoded
+   * concurrently, each waiting on the rows of its reference frames it needs.
+   * Decoded frames are returned with up to that many frames of delay, so the
+   * decoder must be flushed at the end of the stream, and decode errors are
+   * reported by the call that waits for the failing frame. Each frame is
+   * decoded by a single thread: tile and row based multi-threading are
+   * disabled. Superframes must carry an index. Must be set before the first
+   * call to vpx_codec_decode(); ignored when postprocessing is enabled.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_FRAME_PARALLEL,
+
+  /*!\brief Codec control function to output frames without copying them.
+   *
+   * 0 : off. Otherwise a power of 2, from 32 to 1024, that the strides of all
+   * planes of the output frames are a multiple of.
+   *
+   * When on, the image returned by vpx_codec_get_frame() always points into
+   * the frame buffer the frame was decoded to. With external frame buffers
+   * (see vpx_codec_set_frame_buffer_functions()) that is the buffer from the
+   * get callback, and fb_priv of the image is its priv. The buffer is not
+   * released before the next call to vpx_codec_decode(), and then only once
+   * no reference frame uses it. Postprocessing is disabled. Use
+   * VP9_SET_BYTE_ALIGNMENT to align the start of the planes. Must be set
+   * before the first call to vpx_codec_decode().
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_ZERO_COPY_OUTPUT,
+
+  /*!\brief Codec control function to time the stages of decoding frames.
+   *
+   * 0 : off, 1 : on
+   *
+   * When off, VP9D_GET_FRAME_TIMING fails and the decoder takes no time
+   * stamps.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_FRAME_TIMING,
+
+  /*!\brief Codec control function to get the time taken by each stage of
+   * decoding the last frame, see vpx_frame_timing_t.
+   *
+   * Requires VP9D_SET_FRAME_TIMING. With frame parallel decoding, waits for
+   * the frames being decoded and reports the last one.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_GET_FRAME_TIMING,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -163,6 +219,31 @@ typedef struct vpx_decrypt_init {
   void *decrypt_state;
 } vpx_decrypt_init;
 
+/*!\brief Time taken by each stage of decoding a frame
+ *
+ * All times are in microseconds. The stages run on several threads are
+ * summed over them, so with multi-threading they may add up to more than
+ * total.
+ */
+typedef struct vpx_frame_timing {
+  /*! Wall time of the whole frame. */
+  int64_t total;
+  /*! Reading the uncompressed and compressed headers. */
+  int64_t header;
+  /*! Reading the modes and coefficients of the tiles. */
+  int64_t parse;
+  /*! Prediction and reconstruction of the blocks. */
+  int64_t recon;
+  /*! Inverse transforms, part of recon. */
+  int64_t inverse_transform;
+  /*! Inter prediction, part of recon. */
+  int64_t inter_pred;
+  /*! Loop filtering. */
+  int64_t loop_filter;
+  /*! Waiting for other threads, outside of the stages above. */
+  int64_t thread_wait;
+} vpx_frame_timing_t;
+
 /*!\cond */
 /*!\brief VP8 decoder control function parameter type
  *
@@ -199,6 +280,14 @@ VPX_CTRL_USE_TYPE(VP9_SET_SKIP_LOOP_FILTER, int)
 VPX_CTRL_USE_TYPE(VP9D_SET_ROW_MT, int)
 #define VPX_CTRL_VP9_SET_LOOP_FILTER_OPT
 VPX_CTRL_USE_TYPE(VP9D_SET_LOOP_FILTER_OPT, int)
+#define VPX_CTRL_VP9D_SET_FRAME_PARALLEL
+VPX_CTRL_USE_TYPE(VP9D_SET_FRAME_PARALLEL, int)
+#define VPX_CTRL_VP9D_SET_ZERO_COPY_OUTPUT
+VPX_CTRL_USE_TYPE(VP9D_SET_ZERO_COPY_OUTPUT, int)
+#define VPX_CTRL_VP9D_SET_FRAME_TIMING
+VPX_CTRL_USE_TYPE(VP9D_SET_FRAME_TIMING, int)
+#define VPX_CTRL_VP9D_GET_FRAME_TIMING
+VPX_CTRL_USE_TYPE(VP9D_GET_FRAME_TIMING, vpx_frame_timing_t *)
 
 /*!\endcond */
 /*! @} - end defgroup vp8_decoder */
@@ -357,6 +357,42 @@ vpx_codec_err_t vpx_codec_destroy(vpx_codec_ctx_t *ctx);
  */
 vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface);
 
+/*!\brief Set up a worker thread pool shared by all codec instances
+ *
+ * By default every VP9 encoder and decoder instance starts its own worker
+ * threads, according to its configured thread count. Once a shared pool is
+ * set up, their tile, row and loop filter work is run by the pool's threads
+ * instead, and no instance starts threads of its own. Work submitted while
+ * every pool thread is busy runs on the thread calling into the codec, so
+ * the process never uses more than num_threads worker threads however many
+ * instances exist. VP8 instances are not affected and keep their own
+ * threads.
+ *
+ * This function must be called before any codec instance is initialized,
+ * or after all of them have been destroyed. It is not thread-safe.
+ *
+ * \param[in] num_threads   Number of threads in the pool, at least 1
+ *
+ * \retval #VPX_CODEC_OK
+ *     The pool was set up.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     num_threads is 0 or a pool is already set up.
+ * \retval #VPX_CODEC_INCAPABLE
+ *     The library was built without multithreading support.
+ * \retval #VPX_CODEC_MEM_ERROR
+ *     The pool threads could not be created.
+ */
+vpx_codec_err_t vpx_codec_thread_pool_init(unsigned int num_threads);
+
+/*!\brief Stop the shared worker thread pool
+ *
+ * Joins the threads started by vpx_codec_thread_pool_init(). All codec
+ * instances must have been destroyed beforehand. Instances initialized
+ * afterwards start their own threads again. Does nothing if no pool is set
+ * up.
+ */
+void vpx_codec_thread_pool_destroy(void);
+
 /*!\brief Control algorithm
  *
  * This function is used to exchange algorithm specific data with the codec
@@ -70,6 +70,8 @@ extern "C" {
 #define VPX_CODEC_CAP_FRAME_THREADING 0x200000
 /*!brief Can support external frame buffers */
 #define VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER 0x400000
+/*!\brief Can decode asynchronously, see vpx_codec_decode_async() */
+#define VPX_CODEC_CAP_ASYNC_DECODE 0x800000
 
 #define VPX_CODEC_USE_POSTPROC 0x10000 /**< Postprocess decoded frame */
 /*!\brief Conceal errors in decoded frames */
@@ -358,6 +360,77 @@ vpx_codec_err_t vpx_codec_set_frame_buffer_functions(
 
 /*!@} - end defgroup cap_external_frame_buffer */
 
+/*!\defgroup cap_async_decode Asynchronous Decoding Functions
+ *
+ * The following section is required to be implemented for all decoders
+ * that advertise the VPX_CODEC_CAP_ASYNC_DECODE capability. Calling this
+ * function for codecs that don't advertise this capability will result in
+ * an error code being returned, usually VPX_CODEC_INCAPABLE.
+ *
+ * \note
+ * Currently this only works with VP9.
+ * @{
+ */
+
+/*!\brief Decode completion callback prototype
+ *
+ * This callback is invoked from one of the decoder's threads, or from the
+ * calling thread before vpx_codec_decode_async() returns, once the data
+ * passed to vpx_codec_decode_async() has been decoded. The frame it produced
+ * can then be retrieved with vpx_codec_get_frame() as soon as the frames
+ * before it are retrieved. The callback must not call into the decoder.
+ *
+ * \param[in] cb_priv      Callback's private data
+ * \param[in] user_priv    user_priv of the vpx_codec_decode_async() call
+ * \param[in] res          Result of decoding the data
+ */
+typedef void (*vpx_codec_decode_cb_fn_t)(void *cb_priv, void *user_priv,
+                                         vpx_codec_err_t res);
+
+/*!\brief Decode data without waiting for it to be decoded
+ *
+ * Like vpx_codec_decode(), but the data is decoded by the decoder's threads,
+ * so one thread can feed many decoders. Up to as many packets as the decoder
+ * has threads, at most 4, are decoded concurrently; once that many are in
+ * flight the call waits for the oldest one. The data is copied and may be
+ * freed once the call returns.
+ *
+ * The first call makes the decoder asynchronous and must come before any
+ * call to vpx_codec_decode(). From then on vpx_codec_get_frame() does not
+ * wait: it returns the decoded frames in decode order and NULL while the next
+ * one is still being decoded. Frames not retrieved before 4 more are decoded
+ * are dropped. At the end of the stream call this function with NULL data and
+ * 0 data_sz, then retrieve the remaining frames once they are decoded.
+ *
+ * Each frame is decoded by a single thread, and postprocessing is not
+ * supported.
+ *
+ * \param[in] ctx          Pointer to this instance's context
+ * \param[in] data         Pointer to this block of new coded data
+ * \param[in] data_sz      Size of the coded data, in bytes.
+ * \param[in] user_priv    Application specific data to associate with
+ *                         this frame, passed back to cb.
+ * \param[in] cb           Called once the data has been decoded. May be NULL.
+ * \param[in] cb_priv      Callback's private data
+ *
+ * \retval #VPX_CODEC_OK
+ *     The data was queued to be decoded.
+ * \retval #VPX_CODEC_INCAPABLE
+ *     The decoder can not decode asynchronously, or postprocessing is
+ *     enabled.
+ * \retval #VPX_CODEC_ERROR
+ *     The decoder already decoded data with vpx_codec_decode().
+ * Otherwise the data could not be queued and cb is not called. Errors
+ * decoding queued data are only passed to its callback.
+ */
+vpx_codec_err_t vpx_codec_decode_async(vpx_codec_ctx_t *ctx,
+                                       const uint8_t *data,
+                                       unsigned int data_sz, void *user_priv,
+                                       vpx_codec_decode_cb_fn_t cb,
+                                       void *cb_priv);
+
+/*!@} - end defgroup cap_async_decode */
+
 /*!@} - end defgroup decoder*/
 #ifdef __cplusplus
 }
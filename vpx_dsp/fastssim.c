@@ -44,7 +44,7 @@ struct fs_level {
 struct fs_ctx {
   fs_level *level;
   int nlevels;
-  unsigned *col_buf;
+  uint32_t *col_buf;
 };
 
 static void fs_ctx_init(fs_ctx *_ctx, int _w, int _h, int _nlevels) {
@@ -94,7 +94,7 @@ static void fs_ctx_init(fs_ctx *_ctx, int _w, int _h, int _nlevels) {
     lw = (lw + 1) >> 1;
     lh = (lh + 1) >> 1;
   }
-  _ctx->col_buf = (unsigned *)data;
+  _ctx->col_buf = (uint32_t *)data;
 }
 
 static void fs_ctx_clear(fs_ctx *_ctx) { free(_ctx->level); }
@@ -310,40 +310,23 @@ static void fs_apply_luminance(fs_ctx *_ctx, int _l, int bit_depth) {
     col_sums_gxgy[(_col1)] = col_sums_gxgy[(_col2)] * 2; \
   } while (0)
 
-static void fs_calc_structure(fs_ctx *_ctx, int _l, int bit_depth) {
-  uint32_t *im1;
-  uint32_t *im2;
-  unsigned *gx_buf;
-  unsigned *gy_buf;
-  double *ssim;
+// Computes the structure term of every pixel of a w x h level from the 8x8
+// weighted sums of its gradients. buf must have room for 16 * (w + 8) values.
+void vpx_fastssim_structure_c(const uint32_t *im1, const uint32_t *im2, int w,
+                              int h, double c2, double *ssim, uint32_t *buf) {
+  uint32_t *gx_buf;
+  uint32_t *gy_buf;
   double col_sums_gx2[8];
   double col_sums_gy2[8];
   double col_sums_gxgy[8];
-  double c2;
   int stride;
-  int w;
-  int h;
   int i;
   int j;
-  double ssim_c2 = SSIM_C2;
-#if CONFIG_VP9_HIGHBITDEPTH
-  if (bit_depth == 10) ssim_c2 = SSIM_C2_10;
-  if (bit_depth == 12) ssim_c2 = SSIM_C2_12;
-#else
-  assert(bit_depth == 8);
-  (void)bit_depth;
-#endif
 
-  w = _ctx->level[_l].w;
-  h = _ctx->level[_l].h;
-  im1 = _ctx->level[_l].im1;
-  im2 = _ctx->level[_l].im2;
-  ssim = _ctx->level[_l].ssim;
-  gx_buf = _ctx->col_buf;
+  gx_buf = buf;
   stride = w + 8;
   gy_buf = gx_buf + 8 * stride;
   memset(gx_buf, 0, 2 * 8 * stride * sizeof(*gx_buf));
-  c2 = ssim_c2 * (1 << 4 * _l) * 16 * 104;
   for (j = 0; j < h + 4; j++) {
     if (j < h - 1) {
       for (i = 0; i < w - 1; i++) {
@@ -417,6 +400,21 @@ static void fs_calc_structure(fs_ctx *_ctx, int _l, int bit_depth) {
   }
 }
 
+static void fs_calc_structure(fs_ctx *_ctx, int _l, int bit_depth) {
+  double ssim_c2 = SSIM_C2;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (bit_depth == 10) ssim_c2 = SSIM_C2_10;
+  if (bit_depth == 12) ssim_c2 = SSIM_C2_12;
+#else
+  assert(bit_depth == 8);
+  (void)bit_depth;
+#endif
+  vpx_fastssim_structure(_ctx->level[_l].im1, _ctx->level[_l].im2,
+                         _ctx->level[_l].w, _ctx->level[_l].h,
+                         ssim_c2 * (1 << 4 * _l) * 16 * 104,
+                         _ctx->level[_l].ssim, _ctx->col_buf);
+}
+
 #define FS_NLEVELS (4)
 
 /*These weights were derived from the default weights found in Wang's original
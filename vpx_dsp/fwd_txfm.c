@@ -766,6 +766,26 @@ void vpx_fdct32x32_1_c(const int16_t *input, tran_low_t *output, int stride) {
   output[0] = (tran_low_t)(sum >> 3);
 }
 
+#if !CONFIG_VP9_HIGHBITDEPTH
+void vpx_subtract_fdct32x32_c(int16_t *diff_ptr, ptrdiff_t diff_stride,
+                              const uint8_t *src_ptr, ptrdiff_t src_stride,
+                              const uint8_t *pred_ptr, ptrdiff_t pred_stride,
+                              tran_low_t *output) {
+  vpx_subtract_block_c(32, 32, diff_ptr, diff_stride, src_ptr, src_stride,
+                       pred_ptr, pred_stride);
+  vpx_fdct32x32_c(diff_ptr, output, (int)diff_stride);
+}
+
+void vpx_subtract_fdct32x32_rd_c(int16_t *diff_ptr, ptrdiff_t diff_stride,
+                                 const uint8_t *src_ptr, ptrdiff_t src_stride,
+                                 const uint8_t *pred_ptr,
+                                 ptrdiff_t pred_stride, tran_low_t *output) {
+  vpx_subtract_block_c(32, 32, diff_ptr, diff_stride, src_ptr, src_stride,
+                       pred_ptr, pred_stride);
+  vpx_fdct32x32_rd_c(diff_ptr, output, (int)diff_stride);
+}
+#endif  // !CONFIG_VP9_HIGHBITDEPTH
+
 #if CONFIG_VP9_HIGHBITDEPTH
 void vpx_highbd_fdct4x4_c(const int16_t *input, tran_low_t *output,
                           int stride) {
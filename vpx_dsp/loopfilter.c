@@ -159,6 +159,14 @@ void vpx_lpf_vertical_4_dual_c(uint8_t *s, int pitch, const uint8_t *blimit0,
   vpx_lpf_vertical_4_c(s + 8 * pitch, pitch, blimit1, limit1, thresh1);
 }
 
+void vpx_lpf_vertical_4_quad_c(uint8_t *s, int pitch, const uint8_t *blimit,
+                               const uint8_t *limit, const uint8_t *thresh) {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    vpx_lpf_vertical_4_c(s + i * 8 * pitch, pitch, blimit, limit, thresh);
+  }
+}
+
 static INLINE void filter8(int8_t mask, uint8_t thresh, uint8_t flat,
                            uint8_t *op3, uint8_t *op2, uint8_t *op1,
                            uint8_t *op0, uint8_t *oq0, uint8_t *oq1,
@@ -232,6 +240,14 @@ void vpx_lpf_vertical_8_dual_c(uint8_t *s, int pitch, const uint8_t *blimit0,
   vpx_lpf_vertical_8_c(s + 8 * pitch, pitch, blimit1, limit1, thresh1);
 }
 
+void vpx_lpf_vertical_8_quad_c(uint8_t *s, int pitch, const uint8_t *blimit,
+                               const uint8_t *limit, const uint8_t *thresh) {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    vpx_lpf_vertical_8_c(s + i * 8 * pitch, pitch, blimit, limit, thresh);
+  }
+}
+
 static INLINE void filter16(int8_t mask, uint8_t thresh, uint8_t flat,
                             uint8_t flat2, uint8_t *op7, uint8_t *op6,
                             uint8_t *op5, uint8_t *op4, uint8_t *op3,
@@ -356,6 +372,11 @@ void vpx_lpf_vertical_16_dual_c(uint8_t *s, int pitch, const uint8_t *blimit,
   mb_lpf_vertical_edge_w(s, pitch, blimit, limit, thresh, 16);
 }
 
+void vpx_lpf_vertical_16_quad_c(uint8_t *s, int pitch, const uint8_t *blimit,
+                                const uint8_t *limit, const uint8_t *thresh) {
+  mb_lpf_vertical_edge_w(s, pitch, blimit, limit, thresh, 32);
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 // Should we apply any filter at all: 11111111 yes, 00000000 no ?
 static INLINE int8_t highbd_filter_mask(uint8_t limit, uint8_t blimit,
@@ -252,12 +252,47 @@ static double calc_psnrhvs(const unsigned char *src, int _systride,
   return ret;
 }
 
+double vpx_psnrhvs_plane_c(const uint8_t *src, int src_stride,
+                           const uint8_t *dst, int dst_stride, int w, int h,
+                           int step, const double csf[8][8]) {
+  return calc_psnrhvs(src, src_stride, dst, dst_stride, 1.0, w, h, step, csf, 8,
+                      0);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+double vpx_highbd_psnrhvs_plane_c(const uint16_t *src, int src_stride,
+                                  const uint16_t *dst, int dst_stride, int w,
+                                  int h, int step, const double csf[8][8],
+                                  uint32_t bd, uint32_t shift) {
+  return calc_psnrhvs(CONVERT_TO_BYTEPTR(src), src_stride,
+                      CONVERT_TO_BYTEPTR(dst), dst_stride, 1.0, w, h, step, csf,
+                      bd, shift);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+static double psnrhvs_plane(const uint8_t *src, int src_stride,
+                            const uint8_t *dst, int dst_stride, int w, int h,
+                            int step, const double csf[8][8], uint32_t bd,
+                            uint32_t shift) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (bd == 10 || bd == 12) {
+    return vpx_highbd_psnrhvs_plane(CONVERT_TO_SHORTPTR(src), src_stride,
+                                    CONVERT_TO_SHORTPTR(dst), dst_stride, w, h,
+                                    step, csf, bd, shift);
+  }
+#else
+  (void)bd;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  assert(shift == 0);
+  (void)shift;
+  return vpx_psnrhvs_plane(src, src_stride, dst, dst_stride, w, h, step, csf);
+}
+
 double vpx_psnrhvs(const YV12_BUFFER_CONFIG *src,
                    const YV12_BUFFER_CONFIG *dest, double *y_psnrhvs,
                    double *u_psnrhvs, double *v_psnrhvs, uint32_t bd,
                    uint32_t in_bd) {
   double psnrhvs;
-  const double par = 1.0;
   const int step = 7;
   uint32_t bd_shift = 0;
   vpx_clear_system_state();
@@ -267,15 +302,17 @@ double vpx_psnrhvs(const YV12_BUFFER_CONFIG *src,
 
   bd_shift = bd - in_bd;
 
-  *y_psnrhvs = calc_psnrhvs(src->y_buffer, src->y_stride, dest->y_buffer,
-                            dest->y_stride, par, src->y_crop_width,
-                            src->y_crop_height, step, csf_y, bd, bd_shift);
-  *u_psnrhvs = calc_psnrhvs(src->u_buffer, src->uv_stride, dest->u_buffer,
-                            dest->uv_stride, par, src->uv_crop_width,
-                            src->uv_crop_height, step, csf_cb420, bd, bd_shift);
-  *v_psnrhvs = calc_psnrhvs(src->v_buffer, src->uv_stride, dest->v_buffer,
-                            dest->uv_stride, par, src->uv_crop_width,
-                            src->uv_crop_height, step, csf_cr420, bd, bd_shift);
+  *y_psnrhvs = psnrhvs_plane(src->y_buffer, src->y_stride, dest->y_buffer,
+                             dest->y_stride, src->y_crop_width,
+                             src->y_crop_height, step, csf_y, bd, bd_shift);
+  *u_psnrhvs = psnrhvs_plane(src->u_buffer, src->uv_stride, dest->u_buffer,
+                             dest->uv_stride, src->uv_crop_width,
+                             src->uv_crop_height, step, csf_cb420, bd,
+                             bd_shift);
+  *v_psnrhvs = psnrhvs_plane(src->v_buffer, src->uv_stride, dest->v_buffer,
+                             dest->uv_stride, src->uv_crop_width,
+                             src->uv_crop_height, step, csf_cr420, bd,
+                             bd_shift);
   psnrhvs = (*y_psnrhvs) * .8 + .1 * ((*u_psnrhvs) + (*v_psnrhvs));
   return convert_score_db(psnrhvs, 1.0, in_bd);
 }
@@ -121,8 +121,8 @@ static double highbd_ssim_8x8(const uint16_t *s, int sp, const uint16_t *r,
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
-static double vpx_ssim2(const uint8_t *img1, const uint8_t *img2,
-                        int stride_img1, int stride_img2, int width,
+double vpx_ssim_plane_c(const uint8_t *img1, int stride_img1,
+                        const uint8_t *img2, int stride_img2, int width,
                         int height) {
   int i, j;
   int samples = 0;
@@ -142,9 +142,10 @@ static double vpx_ssim2(const uint8_t *img1, const uint8_t *img2,
 }
 
 #if CONFIG_VP9_HIGHBITDEPTH
-static double vpx_highbd_ssim2(const uint8_t *img1, const uint8_t *img2,
-                               int stride_img1, int stride_img2, int width,
-                               int height, uint32_t bd, uint32_t shift) {
+double vpx_highbd_ssim_plane_c(const uint16_t *img1, int stride_img1,
+                               const uint16_t *img2, int stride_img2,
+                               int width, int height, uint32_t bd,
+                               uint32_t shift) {
   int i, j;
   int samples = 0;
   double ssim_total = 0;
@@ -153,9 +154,8 @@ static double vpx_highbd_ssim2(const uint8_t *img1, const uint8_t *img2,
   for (i = 0; i <= height - 8;
        i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
     for (j = 0; j <= width - 8; j += 4) {
-      double v = highbd_ssim_8x8(CONVERT_TO_SHORTPTR(img1 + j), stride_img1,
-                                 CONVERT_TO_SHORTPTR(img2 + j), stride_img2, bd,
-                                 shift);
+      double v = highbd_ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2,
+                                 bd, shift);
       ssim_total += v;
       samples++;
     }
@@ -170,14 +170,17 @@ double vpx_calc_ssim(const YV12_BUFFER_CONFIG *source,
   double a, b, c;
   double ssimv;
 
-  a = vpx_ssim2(source->y_buffer, dest->y_buffer, source->y_stride,
-                dest->y_stride, source->y_crop_width, source->y_crop_height);
+  a = vpx_ssim_plane(source->y_buffer, source->y_stride, dest->y_buffer,
+                     dest->y_stride, source->y_crop_width,
+                     source->y_crop_height);
 
-  b = vpx_ssim2(source->u_buffer, dest->u_buffer, source->uv_stride,
-                dest->uv_stride, source->uv_crop_width, source->uv_crop_height);
+  b = vpx_ssim_plane(source->u_buffer, source->uv_stride, dest->u_buffer,
+                     dest->uv_stride, source->uv_crop_width,
+                     source->uv_crop_height);
 
-  c = vpx_ssim2(source->v_buffer, dest->v_buffer, source->uv_stride,
-                dest->uv_stride, source->uv_crop_width, source->uv_crop_height);
+  c = vpx_ssim_plane(source->v_buffer, source->uv_stride, dest->v_buffer,
+                     dest->uv_stride, source->uv_crop_width,
+                     source->uv_crop_height);
 
   ssimv = a * .8 + .1 * (b + c);
 
@@ -439,17 +442,23 @@ double vpx_highbd_calc_ssim(const YV12_BUFFER_CONFIG *source,
   assert(bd >= in_bd);
   shift = bd - in_bd;
 
-  a = vpx_highbd_ssim2(source->y_buffer, dest->y_buffer, source->y_stride,
-                       dest->y_stride, source->y_crop_width,
-                       source->y_crop_height, in_bd, shift);
-
-  b = vpx_highbd_ssim2(source->u_buffer, dest->u_buffer, source->uv_stride,
-                       dest->uv_stride, source->uv_crop_width,
-                       source->uv_crop_height, in_bd, shift);
-
-  c = vpx_highbd_ssim2(source->v_buffer, dest->v_buffer, source->uv_stride,
-                       dest->uv_stride, source->uv_crop_width,
-                       source->uv_crop_height, in_bd, shift);
+  a = vpx_highbd_ssim_plane(CONVERT_TO_SHORTPTR(source->y_buffer),
+                            source->y_stride,
+                            CONVERT_TO_SHORTPTR(dest->y_buffer),
+                            dest->y_stride, source->y_crop_width,
+                            source->y_crop_height, in_bd, shift);
+
+  b = vpx_highbd_ssim_plane(CONVERT_TO_SHORTPTR(source->u_buffer),
+                            source->uv_stride,
+                            CONVERT_TO_SHORTPTR(dest->u_buffer),
+                            dest->uv_stride, source->uv_crop_width,
+                            source->uv_crop_height, in_bd, shift);
+
+  c = vpx_highbd_ssim_plane(CONVERT_TO_SHORTPTR(source->v_buffer),
+                            source->uv_stride,
+                            CONVERT_TO_SHORTPTR(dest->v_buffer),
+                            dest->uv_stride, source->uv_crop_width,
+                            source->uv_crop_height, in_bd, shift);
 
   ssimv = a * .8 + .1 * (b + c);
 
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef VPX_VPX_DSP_X86_BITDEPTH_CONVERSION_AVX512_H_
+#define VPX_VPX_DSP_X86_BITDEPTH_CONVERSION_AVX512_H_
+
+#include <immintrin.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+
+// Load 32 16 bit values. If the source is 32 bits then pack down with
+// saturation. Unlike the AVX2 version the values stay in order.
+static INLINE __m512i load_tran_low(const tran_low_t *a) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const __m256i a_low =
+      _mm512_cvtsepi32_epi16(_mm512_loadu_si512((const __m512i *)a));
+  const __m256i a_high =
+      _mm512_cvtsepi32_epi16(_mm512_loadu_si512((const __m512i *)(a + 16)));
+  return _mm512_inserti64x4(_mm512_castsi256_si512(a_low), a_high, 1);
+#else
+  return _mm512_loadu_si512((const __m512i *)a);
+#endif
+}
+
+static INLINE void store_tran_low(__m512i a, tran_low_t *b) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  _mm512_storeu_si512((__m512i *)b,
+                      _mm512_cvtepi16_epi32(_mm512_castsi512_si256(a)));
+  _mm512_storeu_si512((__m512i *)(b + 16),
+                      _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(a, 1)));
+#else
+  _mm512_storeu_si512((__m512i *)b, a);
+#endif
+}
+
+// Zero fill 32 positions in the output buffer.
+static INLINE void store_zero_tran_low(tran_low_t *a) {
+  const __m512i zero = _mm512_setzero_si512();
+#if CONFIG_VP9_HIGHBITDEPTH
+  _mm512_storeu_si512((__m512i *)a, zero);
+  _mm512_storeu_si512((__m512i *)(a + 16), zero);
+#else
+  _mm512_storeu_si512((__m512i *)a, zero);
+#endif
+}
+#endif  // VPX_VPX_DSP_X86_BITDEPTH_CONVERSION_AVX512_H_
@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+
+// vpx_fastssim_structure_c() slides a weighted 8x8 window of gradient squares
+// and products over the level. Unrolled, the weight of a gradient pair of rows
+// at level L (rows o + 3 and o + 4 for L = 3, o + 2 and o - 3 for L = 2,
+// o + 1 and o - 2 for L = 1, o and o - 1 for L = 0) in the pair of columns d
+// away from the center (i - 1 - d and i + d) is 2^(L - d), or 0 when d > L.
+// All the sums involved are integers below 2^53, so they are exact in double
+// precision in any order and the result matches the C code.
+//
+// The level is processed in tiles of TILE_W columns. Each tile walks down the
+// rows keeping the gradient terms of the last 8 rows in a ring buffer.
+
+#define TILE_W 32
+#define TILE_COLS (TILE_W + 8)
+
+enum { GX2, GY2, GXGY, NUM_TERMS };
+
+static INLINE __m256i gradient_8(const uint32_t *above, const uint32_t *below) {
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i a1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i b0 = _mm256_loadu_si256((const __m256i *)below);
+  const __m256i b1 = _mm256_loadu_si256((const __m256i *)(below + 1));
+  const __m256i g1 = _mm256_abs_epi32(_mm256_sub_epi32(b1, a0));
+  const __m256i g2 = _mm256_abs_epi32(_mm256_sub_epi32(b0, a1));
+  return _mm256_add_epi32(_mm256_slli_epi32(_mm256_max_epi32(g1, g2), 2),
+                          _mm256_min_epi32(g1, g2));
+}
+
+static INLINE uint32_t gradient(const uint32_t *above, const uint32_t *below) {
+  const int g1 = abs((int)below[1] - (int)above[0]);
+  const int g2 = abs((int)below[0] - (int)above[1]);
+  return 4 * VPXMAX(g1, g2) + VPXMIN(g1, g2);
+}
+
+// Computes the squares and the products of the gradients of row r for the
+// TILE_COLS columns starting at x0. Gradients outside the level are zero.
+static void gradient_terms(const uint32_t *im1, const uint32_t *im2, int w,
+                           int h, int r, int x0, double (*term)[TILE_COLS]) {
+  int c;
+
+  if (r < 0 || r >= h - 1) {
+    memset(term, 0, NUM_TERMS * TILE_COLS * sizeof(term[0][0]));
+    return;
+  }
+
+  im1 += r * w;
+  im2 += r * w;
+  for (c = 0; c < TILE_COLS; c += 8) {
+    const int x = x0 + c;
+    __m256i gx, gy;
+    __m256d gx_lo, gx_hi, gy_lo, gy_hi;
+
+    if (x >= 0 && x + 8 <= w - 1) {
+      gx = gradient_8(im1 + x, im1 + w + x);
+      gy = gradient_8(im2 + x, im2 + w + x);
+    } else {
+      DECLARE_ALIGNED(32, uint32_t, gx_buf[8]);
+      DECLARE_ALIGNED(32, uint32_t, gy_buf[8]);
+      int k;
+      for (k = 0; k < 8; ++k) {
+        if (x + k >= 0 && x + k < w - 1) {
+          gx_buf[k] = gradient(im1 + x + k, im1 + w + x + k);
+          gy_buf[k] = gradient(im2 + x + k, im2 + w + x + k);
+        } else {
+          gx_buf[k] = gy_buf[k] = 0;
+        }
+      }
+      gx = _mm256_load_si256((const __m256i *)gx_buf);
+      gy = _mm256_load_si256((const __m256i *)gy_buf);
+    }
+
+    gx_lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(gx));
+    gx_hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(gx, 1));
+    gy_lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(gy));
+    gy_hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(gy, 1));
+    _mm256_store_pd(term[GX2] + c, _mm256_mul_pd(gx_lo, gx_lo));
+    _mm256_store_pd(term[GX2] + c + 4, _mm256_mul_pd(gx_hi, gx_hi));
+    _mm256_store_pd(term[GY2] + c, _mm256_mul_pd(gy_lo, gy_lo));
+    _mm256_store_pd(term[GY2] + c + 4, _mm256_mul_pd(gy_hi, gy_hi));
+    _mm256_store_pd(term[GXGY] + c, _mm256_mul_pd(gx_lo, gy_lo));
+    _mm256_store_pd(term[GXGY] + c + 4, _mm256_mul_pd(gx_hi, gy_hi));
+  }
+}
+
+static INLINE __m256d add_rows(const double *a, const double *b) {
+  return _mm256_add_pd(_mm256_load_pd(a), _mm256_load_pd(b));
+}
+
+void vpx_fastssim_structure_avx2(const uint32_t *im1, const uint32_t *im2,
+                                 int w, int h, double c2, double *ssim,
+                                 uint32_t *buf) {
+  // Gradient terms of rows o - 3 .. o + 4, row r in slot r & 7.
+  DECLARE_ALIGNED(32, double, term[8][NUM_TERMS][TILE_COLS]);
+  // Vertical sums of the terms for the column pairs d = 0 .. 3 away from the
+  // center.
+  DECLARE_ALIGNED(32, double, col_sum[NUM_TERMS][4][TILE_COLS]);
+  const __m256d c2_4 = _mm256_set1_pd(c2);
+  int x0, o, r, c, t, d, k;
+  (void)buf;
+
+  for (x0 = 0; x0 < w; x0 += TILE_W) {
+    const int tile_w = VPXMIN(TILE_W, w - x0);
+
+    for (r = -3; r < 4; ++r) {
+      gradient_terms(im1, im2, w, h, r, x0 - 4, term[(r + 8) & 7]);
+    }
+
+    for (o = 0; o < h; ++o) {
+      gradient_terms(im1, im2, w, h, o + 4, x0 - 4, term[(o + 4) & 7]);
+
+      for (k = 0; k < NUM_TERMS; ++k) {
+        const double *const row0 = term[o & 7][k];
+        const double *const row1 = term[(o + 1) & 7][k];
+        const double *const row2 = term[(o + 2) & 7][k];
+        const double *const row3 = term[(o + 3) & 7][k];
+        const double *const row4 = term[(o + 4) & 7][k];
+        const double *const row5 = term[(o + 5) & 7][k];
+        const double *const row6 = term[(o + 6) & 7][k];
+        const double *const row7 = term[(o + 7) & 7][k];
+        for (c = 0; c < TILE_COLS; c += 4) {
+          // Rows o - 3, o - 2 and o - 1 are in slots o + 5, o + 6 and o + 7.
+          __m256d sum = add_rows(row3 + c, row4 + c);
+          _mm256_store_pd(col_sum[k][3] + c, sum);
+          sum = _mm256_add_pd(_mm256_add_pd(sum, sum),
+                              add_rows(row2 + c, row5 + c));
+          _mm256_store_pd(col_sum[k][2] + c, sum);
+          sum = _mm256_add_pd(_mm256_add_pd(sum, sum),
+                              add_rows(row1 + c, row6 + c));
+          _mm256_store_pd(col_sum[k][1] + c, sum);
+          sum = _mm256_add_pd(_mm256_add_pd(sum, sum),
+                              add_rows(row0 + c, row7 + c));
+          _mm256_store_pd(col_sum[k][0] + c, sum);
+        }
+      }
+
+      for (t = 0; t < tile_w; t += 4) {
+        __m256d mu[NUM_TERMS], v;
+        for (k = 0; k < NUM_TERMS; ++k) {
+          // Output column x0 + t is at index t + 4 of the tile.
+          mu[k] = _mm256_add_pd(_mm256_loadu_pd(col_sum[k][0] + t + 3),
+                                _mm256_loadu_pd(col_sum[k][0] + t + 4));
+          for (d = 1; d < 4; ++d) {
+            const __m256d left = _mm256_loadu_pd(col_sum[k][d] + t + 3 - d);
+            const __m256d right = _mm256_loadu_pd(col_sum[k][d] + t + 4 + d);
+            mu[k] = _mm256_add_pd(mu[k], _mm256_add_pd(left, right));
+          }
+        }
+        v = _mm256_div_pd(
+            _mm256_add_pd(_mm256_add_pd(mu[GXGY], mu[GXGY]), c2_4),
+            _mm256_add_pd(_mm256_add_pd(mu[GX2], mu[GY2]), c2_4));
+        if (t + 4 <= tile_w) {
+          _mm256_storeu_pd(ssim + o * w + x0 + t, v);
+        } else {
+          DECLARE_ALIGNED(32, double, tail[4]);
+          _mm256_store_pd(tail, v);
+          memcpy(ssim + o * w + x0 + t, tail, (tile_w - t) * sizeof(*tail));
+        }
+      }
+    }
+  }
+}
@@ -23,7 +23,9 @@
   _mm256_set_epi32((int)(b), (int)(a), (int)(b), (int)(a), (int)(b), (int)(a), \
                    (int)(b), (int)(a))
 
-#if FDCT32x32_HIGH_PRECISION
+// These are shared by every high precision variant included in a file.
+#if FDCT32x32_HIGH_PRECISION && !defined(FDCT32x32_HIGH_PRECISION_HELPERS)
+#define FDCT32x32_HIGH_PRECISION_HELPERS
 static INLINE __m256i k_madd_epi32_avx2(__m256i a, __m256i b) {
   __m256i buf0, buf1;
   buf0 = _mm256_mul_epu32(a, b);
@@ -40,11 +42,24 @@ static INLINE __m256i k_packs_epi64_avx2(__m256i a, __m256i b) {
 }
 #endif
 
+#if FDCT32x32_SUBTRACT
+// The input of the first pass is formed as the difference of src_ptr and
+// pred_ptr as it is loaded. It is also stored to diff_ptr for callers that
+// need the residual itself.
+void FDCT32x32_2D_AVX2(int16_t *diff_ptr, ptrdiff_t diff_stride,
+                       const uint8_t *src_ptr, ptrdiff_t src_stride,
+                       const uint8_t *pred_ptr, ptrdiff_t pred_stride,
+                       int16_t *output_org) {
+#define LOAD_INPUT_ROW(row)                                              \
+  subtract_row_16_avx2(src + (row)*src_stride, pred + (row)*pred_stride, \
+                       diff + (row)*diff_stride)
+#else
 void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
   // Calculate pre-multiplied strides
   const int str1 = stride;
-  const int str2 = 2 * stride;
-  const int str3 = 2 * stride + str1;
+#define LOAD_INPUT_ROW(row) \
+  _mm256_loadu_si256((const __m256i *)(in + (row)*str1))
+#endif
   // We need an intermediate buffer between passes.
   DECLARE_ALIGNED(32, int16_t, intermediate[32 * 32]);
   // Constants
@@ -105,29 +120,27 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
       // Note: even though all the loads below are aligned, using the aligned
       //       intrinsic make the code slightly slower.
       if (0 == pass) {
+#if FDCT32x32_SUBTRACT
+        const uint8_t *src = &src_ptr[column_start];
+        const uint8_t *pred = &pred_ptr[column_start];
+        int16_t *diff = &diff_ptr[column_start];
+#else
         const int16_t *in = &input[column_start];
+#endif
         // step1[i] =  (in[ 0 * stride] + in[(32 -  1) * stride]) << 2;
         // Note: the next four blocks could be in a loop. That would help the
         //       instruction cache but is actually slower.
         {
-          const int16_t *ina = in + 0 * str1;
-          const int16_t *inb = in + 31 * str1;
           __m256i *step1a = &step1[0];
           __m256i *step1b = &step1[31];
-          const __m256i ina0 = _mm256_loadu_si256((const __m256i *)(ina));
-          const __m256i ina1 =
-              _mm256_loadu_si256((const __m256i *)(ina + str1));
-          const __m256i ina2 =
-              _mm256_loadu_si256((const __m256i *)(ina + str2));
-          const __m256i ina3 =
-              _mm256_loadu_si256((const __m256i *)(ina + str3));
-          const __m256i inb3 =
-              _mm256_loadu_si256((const __m256i *)(inb - str3));
-          const __m256i inb2 =
-              _mm256_loadu_si256((const __m256i *)(inb - str2));
-          const __m256i inb1 =
-              _mm256_loadu_si256((const __m256i *)(inb - str1));
-          const __m256i inb0 = _mm256_loadu_si256((const __m256i *)(inb));
+          const __m256i ina0 = LOAD_INPUT_ROW(0);
+          const __m256i ina1 = LOAD_INPUT_ROW(1);
+          const __m256i ina2 = LOAD_INPUT_ROW(2);
+          const __m256i ina3 = LOAD_INPUT_ROW(3);
+          const __m256i inb3 = LOAD_INPUT_ROW(28);
+          const __m256i inb2 = LOAD_INPUT_ROW(29);
+          const __m256i inb1 = LOAD_INPUT_ROW(30);
+          const __m256i inb0 = LOAD_INPUT_ROW(31);
           step1a[0] = _mm256_add_epi16(ina0, inb0);
           step1a[1] = _mm256_add_epi16(ina1, inb1);
           step1a[2] = _mm256_add_epi16(ina2, inb2);
@@ -146,24 +159,16 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
           step1b[-0] = _mm256_slli_epi16(step1b[-0], 2);
         }
         {
-          const int16_t *ina = in + 4 * str1;
-          const int16_t *inb = in + 27 * str1;
           __m256i *step1a = &step1[4];
           __m256i *step1b = &step1[27];
-          const __m256i ina0 = _mm256_loadu_si256((const __m256i *)(ina));
-          const __m256i ina1 =
-              _mm256_loadu_si256((const __m256i *)(ina + str1));
-          const __m256i ina2 =
-              _mm256_loadu_si256((const __m256i *)(ina + str2));
-          const __m256i ina3 =
-              _mm256_loadu_si256((const __m256i *)(ina + str3));
-          const __m256i inb3 =
-              _mm256_loadu_si256((const __m256i *)(inb - str3));
-          const __m256i inb2 =
-              _mm256_loadu_si256((const __m256i *)(inb - str2));
-          const __m256i inb1 =
-              _mm256_loadu_si256((const __m256i *)(inb - str1));
-          const __m256i inb0 = _mm256_loadu_si256((const __m256i *)(inb));
+          const __m256i ina0 = LOAD_INPUT_ROW(4);
+          const __m256i ina1 = LOAD_INPUT_ROW(5);
+          const __m256i ina2 = LOAD_INPUT_ROW(6);
+          const __m256i ina3 = LOAD_INPUT_ROW(7);
+          const __m256i inb3 = LOAD_INPUT_ROW(24);
+          const __m256i inb2 = LOAD_INPUT_ROW(25);
+          const __m256i inb1 = LOAD_INPUT_ROW(26);
+          const __m256i inb0 = LOAD_INPUT_ROW(27);
           step1a[0] = _mm256_add_epi16(ina0, inb0);
           step1a[1] = _mm256_add_epi16(ina1, inb1);
           step1a[2] = _mm256_add_epi16(ina2, inb2);
@@ -182,24 +187,16 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
           step1b[-0] = _mm256_slli_epi16(step1b[-0], 2);
         }
         {
-          const int16_t *ina = in + 8 * str1;
-          const int16_t *inb = in + 23 * str1;
           __m256i *step1a = &step1[8];
           __m256i *step1b = &step1[23];
-          const __m256i ina0 = _mm256_loadu_si256((const __m256i *)(ina));
-          const __m256i ina1 =
-              _mm256_loadu_si256((const __m256i *)(ina + str1));
-          const __m256i ina2 =
-              _mm256_loadu_si256((const __m256i *)(ina + str2));
-          const __m256i ina3 =
-              _mm256_loadu_si256((const __m256i *)(ina + str3));
-          const __m256i inb3 =
-              _mm256_loadu_si256((const __m256i *)(inb - str3));
-          const __m256i inb2 =
-              _mm256_loadu_si256((const __m256i *)(inb - str2));
-          const __m256i inb1 =
-              _mm256_loadu_si256((const __m256i *)(inb - str1));
-          const __m256i inb0 = _mm256_loadu_si256((const __m256i *)(inb));
+          const __m256i ina0 = LOAD_INPUT_ROW(8);
+          const __m256i ina1 = LOAD_INPUT_ROW(9);
+          const __m256i ina2 = LOAD_INPUT_ROW(10);
+          const __m256i ina3 = LOAD_INPUT_ROW(11);
+          const __m256i inb3 = LOAD_INPUT_ROW(20);
+          const __m256i inb2 = LOAD_INPUT_ROW(21);
+          const __m256i inb1 = LOAD_INPUT_ROW(22);
+          const __m256i inb0 = LOAD_INPUT_ROW(23);
           step1a[0] = _mm256_add_epi16(ina0, inb0);
           step1a[1] = _mm256_add_epi16(ina1, inb1);
           step1a[2] = _mm256_add_epi16(ina2, inb2);
@@ -218,24 +215,16 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
           step1b[-0] = _mm256_slli_epi16(step1b[-0], 2);
         }
         {
-          const int16_t *ina = in + 12 * str1;
-          const int16_t *inb = in + 19 * str1;
           __m256i *step1a = &step1[12];
           __m256i *step1b = &step1[19];
-          const __m256i ina0 = _mm256_loadu_si256((const __m256i *)(ina));
-          const __m256i ina1 =
-              _mm256_loadu_si256((const __m256i *)(ina + str1));
-          const __m256i ina2 =
-              _mm256_loadu_si256((const __m256i *)(ina + str2));
-          const __m256i ina3 =
-              _mm256_loadu_si256((const __m256i *)(ina + str3));
-          const __m256i inb3 =
-              _mm256_loadu_si256((const __m256i *)(inb - str3));
-          const __m256i inb2 =
-              _mm256_loadu_si256((const __m256i *)(inb - str2));
-          const __m256i inb1 =
-              _mm256_loadu_si256((const __m256i *)(inb - str1));
-          const __m256i inb0 = _mm256_loadu_si256((const __m256i *)(inb));
+          const __m256i ina0 = LOAD_INPUT_ROW(12);
+          const __m256i ina1 = LOAD_INPUT_ROW(13);
+          const __m256i ina2 = LOAD_INPUT_ROW(14);
+          const __m256i ina3 = LOAD_INPUT_ROW(15);
+          const __m256i inb3 = LOAD_INPUT_ROW(16);
+          const __m256i inb2 = LOAD_INPUT_ROW(17);
+          const __m256i inb1 = LOAD_INPUT_ROW(18);
+          const __m256i inb0 = LOAD_INPUT_ROW(19);
           step1a[0] = _mm256_add_epi16(ina0, inb0);
           step1a[1] = _mm256_add_epi16(ina1, inb1);
           step1a[2] = _mm256_add_epi16(ina2, inb2);
@@ -2928,3 +2917,5 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
     }
   }
 }  // NOLINT
+
+#undef LOAD_INPUT_ROW
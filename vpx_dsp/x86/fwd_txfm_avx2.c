@@ -8,12 +8,15 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <immintrin.h>  // AVX2
+
 #include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
 
 #if !CONFIG_VP9_HIGHBITDEPTH
 #define FDCT32x32_2D_AVX2 vpx_fdct32x32_rd_avx2
 #define FDCT32x32_HIGH_PRECISION 0
+#define FDCT32x32_SUBTRACT 0
 #include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"
 #undef FDCT32x32_2D_AVX2
 #undef FDCT32x32_HIGH_PRECISION
@@ -23,4 +26,31 @@
 #include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"  // NOLINT
 #undef FDCT32x32_2D_AVX2
 #undef FDCT32x32_HIGH_PRECISION
+#undef FDCT32x32_SUBTRACT
+
+// Return the difference of 16 pixels of src and pred, and store it to diff.
+static INLINE __m256i subtract_row_16_avx2(const uint8_t *src,
+                                           const uint8_t *pred,
+                                           int16_t *diff) {
+  const __m256i s = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)src));
+  const __m256i p =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)pred));
+  const __m256i d = _mm256_sub_epi16(s, p);
+  _mm256_storeu_si256((__m256i *)diff, d);
+  return d;
+}
+
+#define FDCT32x32_2D_AVX2 vpx_subtract_fdct32x32_rd_avx2
+#define FDCT32x32_HIGH_PRECISION 0
+#define FDCT32x32_SUBTRACT 1
+#include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"  // NOLINT
+#undef FDCT32x32_2D_AVX2
+#undef FDCT32x32_HIGH_PRECISION
+
+#define FDCT32x32_2D_AVX2 vpx_subtract_fdct32x32_avx2
+#define FDCT32x32_HIGH_PRECISION 1
+#include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"  // NOLINT
+#undef FDCT32x32_2D_AVX2
+#undef FDCT32x32_HIGH_PRECISION
+#undef FDCT32x32_SUBTRACT
 #endif  // !CONFIG_VP9_HIGHBITDEPTH
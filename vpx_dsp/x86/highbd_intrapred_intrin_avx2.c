@@ -0,0 +1,553 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// As in intrapred_avx2.c, the directional predictors keep the outer border of
+// the block in registers and build every row with a byte shift of it. A row
+// of 16 pixels is one register, so the 16x16 and 32x32 versions share the code
+// below with bs in {16, 32}.
+
+// (x + 2 * y + z + 2) >> 2, computed as avg(avg(x, z) - ((x ^ z) & 1), y).
+static INLINE __m256i avg3_epu16_avx2(const __m256i x, const __m256i y,
+                                      const __m256i z) {
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i a = _mm256_avg_epu16(x, z);
+  const __m256i b =
+      _mm256_sub_epi16(a, _mm256_and_si256(_mm256_xor_si256(x, z), one));
+  return _mm256_avg_epu16(b, y);
+}
+
+// Elements [1, 17) and [2, 18) of the 32 element sequence lo:hi.
+static INLINE __m256i next_1_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21), lo, 2);
+}
+
+static INLINE __m256i next_2_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21), lo, 4);
+}
+
+// Elements [15, 31), [14, 30) and [13, 29) of the 32 element sequence lo:hi.
+static INLINE __m256i prev_1_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(hi, _mm256_permute2x128_si256(lo, hi, 0x21), 14);
+}
+
+static INLINE __m256i prev_2_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(hi, _mm256_permute2x128_si256(lo, hi, 0x21), 12);
+}
+
+static INLINE __m256i prev_3_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(hi, _mm256_permute2x128_si256(lo, hi, 0x21), 10);
+}
+
+// Return a vector holding x and y in its last two elements, for use as the lo
+// argument of prev_*_avx2().
+static INLINE __m256i last_two(const uint16_t x, const uint16_t y) {
+  return _mm256_setr_epi16(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, (int16_t)x,
+                           (int16_t)y);
+}
+
+static INLINE __m256i load_row(const uint16_t *src) {
+  return _mm256_loadu_si256((const __m256i *)src);
+}
+
+static INLINE void store_row(uint16_t *dst, const __m256i row) {
+  _mm256_storeu_si256((__m256i *)dst, row);
+}
+
+// Store 8 rows, row i holding pixels [i, i + 16) of the sequence that a starts
+// and b continues 8 pixels further on.
+static INLINE void store_8_rows(uint16_t *dst, ptrdiff_t stride,
+                                const __m256i a, const __m256i b) {
+  store_row(dst, a);
+  store_row(dst + 1 * stride, _mm256_alignr_epi8(b, a, 2));
+  store_row(dst + 2 * stride, _mm256_alignr_epi8(b, a, 4));
+  store_row(dst + 3 * stride, _mm256_alignr_epi8(b, a, 6));
+  store_row(dst + 4 * stride, _mm256_alignr_epi8(b, a, 8));
+  store_row(dst + 5 * stride, _mm256_alignr_epi8(b, a, 10));
+  store_row(dst + 6 * stride, _mm256_alignr_epi8(b, a, 12));
+  store_row(dst + 7 * stride, _mm256_alignr_epi8(b, a, 14));
+}
+
+// As store_8_rows() with 4 rows, row i starting 2 * i pixels in.
+static INLINE void store_4_rows_step_2(uint16_t *dst, ptrdiff_t stride,
+                                       const __m256i a, const __m256i b) {
+  store_row(dst, a);
+  store_row(dst + 1 * stride, _mm256_alignr_epi8(b, a, 4));
+  store_row(dst + 2 * stride, _mm256_alignr_epi8(b, a, 8));
+  store_row(dst + 3 * stride, _mm256_alignr_epi8(b, a, 12));
+}
+
+// Store 8 rows, row i holding the 16 pixels starting i pixels before b, where
+// a starts 8 pixels before b.
+static INLINE void store_8_rows_back(uint16_t *dst, ptrdiff_t stride,
+                                     const __m256i a, const __m256i b) {
+  store_row(dst, b);
+  store_row(dst + 1 * stride, _mm256_alignr_epi8(b, a, 14));
+  store_row(dst + 2 * stride, _mm256_alignr_epi8(b, a, 12));
+  store_row(dst + 3 * stride, _mm256_alignr_epi8(b, a, 10));
+  store_row(dst + 4 * stride, _mm256_alignr_epi8(b, a, 8));
+  store_row(dst + 5 * stride, _mm256_alignr_epi8(b, a, 6));
+  store_row(dst + 6 * stride, _mm256_alignr_epi8(b, a, 4));
+  store_row(dst + 7 * stride, _mm256_alignr_epi8(b, a, 2));
+}
+
+// Expand the n vectors of v into the 2 * n - 1 vectors w, w[i] holding pixels
+// [8 * i, 8 * i + 16) of the sequence.
+static INLINE void split_sequence(const __m256i *v, int n, __m256i *w) {
+  int i;
+  for (i = 0; i < n - 1; ++i) {
+    w[2 * i] = v[i];
+    w[2 * i + 1] = _mm256_permute2x128_si256(v[i], v[i + 1], 0x21);
+  }
+  w[2 * i] = v[i];
+}
+
+// Fill rows of width pixels from the sequence of n vectors v, row r starting
+// step * r pixels in, with step 1 or 2. The predictors whose rows move left
+// along the border go from the bottom row up with a negative stride.
+static INLINE void store_from_sequence(uint16_t *dst, ptrdiff_t stride,
+                                       int rows, int width, const __m256i *v,
+                                       int n, int step) {
+  __m256i w[11];
+  int r, c;
+  split_sequence(v, n, w);
+  for (r = 0; r < rows; r += 8 / step) {
+    for (c = 0; c < width; c += 16) {
+      const int i = (step * r + c) / 8;
+      if (step == 1) {
+        store_8_rows(dst + r * stride + c, stride, w[i], w[i + 1]);
+      } else {
+        store_4_rows_step_2(dst + r * stride + c, stride, w[i], w[i + 1]);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// DC_PRED
+
+// Sum the 16 bit lanes of a. Each lane must hold at most 32767.
+static INLINE int highbd_horizontal_add_avx2(const __m256i a) {
+  const __m256i sum = _mm256_madd_epi16(a, _mm256_set1_epi16(1));
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                            _mm256_extracti128_si256(sum, 1));
+  s = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+  s = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+  return _mm_cvtsi128_si32(s);
+}
+
+// Sum bs pixels of at most 12 bits into 16 bit lanes.
+static INLINE __m256i highbd_sum_avx2(const uint16_t *ref, int bs) {
+  __m256i sum = load_row(ref);
+  int i;
+  for (i = 16; i < bs; i += 16) sum = _mm256_add_epi16(sum, load_row(ref + i));
+  return sum;
+}
+
+static INLINE void highbd_dc_store(uint16_t *dst, ptrdiff_t stride, int bs,
+                                   int dc) {
+  const __m256i row = _mm256_set1_epi16((int16_t)dc);
+  int r, c;
+  for (r = 0; r < bs; ++r) {
+    for (c = 0; c < bs; c += 16) store_row(dst + c, row);
+    dst += stride;
+  }
+}
+
+static INLINE void highbd_dc_predictor(uint16_t *dst, ptrdiff_t stride, int bs,
+                                       const uint16_t *above,
+                                       const uint16_t *left) {
+  const __m256i sum =
+      _mm256_add_epi16(highbd_sum_avx2(above, bs), highbd_sum_avx2(left, bs));
+  highbd_dc_store(dst, stride, bs,
+                  (highbd_horizontal_add_avx2(sum) + bs) / (2 * bs));
+}
+
+static INLINE void highbd_dc_edge_predictor(uint16_t *dst, ptrdiff_t stride,
+                                            int bs, const uint16_t *edge) {
+  const __m256i sum = highbd_sum_avx2(edge, bs);
+  highbd_dc_store(dst, stride, bs,
+                  (highbd_horizontal_add_avx2(sum) + (bs >> 1)) / bs);
+}
+
+void vpx_highbd_dc_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                        const uint16_t *above,
+                                        const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_dc_predictor(dst, stride, 16, above, left);
+}
+
+void vpx_highbd_dc_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                        const uint16_t *above,
+                                        const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_dc_predictor(dst, stride, 32, above, left);
+}
+
+void vpx_highbd_dc_top_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                            const uint16_t *above,
+                                            const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_dc_edge_predictor(dst, stride, 16, above);
+}
+
+void vpx_highbd_dc_top_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                            const uint16_t *above,
+                                            const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_dc_edge_predictor(dst, stride, 32, above);
+}
+
+void vpx_highbd_dc_left_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                             const uint16_t *above,
+                                             const uint16_t *left, int bd) {
+  (void)above;
+  (void)bd;
+  highbd_dc_edge_predictor(dst, stride, 16, left);
+}
+
+void vpx_highbd_dc_left_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                             const uint16_t *above,
+                                             const uint16_t *left, int bd) {
+  (void)above;
+  (void)bd;
+  highbd_dc_edge_predictor(dst, stride, 32, left);
+}
+
+void vpx_highbd_dc_128_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                            const uint16_t *above,
+                                            const uint16_t *left, int bd) {
+  (void)above;
+  (void)left;
+  highbd_dc_store(dst, stride, 16, 1 << (bd - 1));
+}
+
+void vpx_highbd_dc_128_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                            const uint16_t *above,
+                                            const uint16_t *left, int bd) {
+  (void)above;
+  (void)left;
+  highbd_dc_store(dst, stride, 32, 1 << (bd - 1));
+}
+
+// -----------------------------------------------------------------------------
+// D45_PRED
+
+static INLINE void highbd_d45_predictor(uint16_t *dst, ptrdiff_t stride,
+                                        int bs, const uint16_t *above) {
+  const __m256i above_right = _mm256_set1_epi16((int16_t)above[bs - 1]);
+  __m256i v[4];
+  int i;
+
+  for (i = 0; i < bs / 16; ++i) {
+    v[i] = avg3_epu16_avx2(load_row(above + 16 * i),
+                           load_row(above + 16 * i + 1),
+                           load_row(above + 16 * i + 2));
+  }
+  // The last pixel of the first row is above[bs - 1] itself, as is everything
+  // after it.
+  v[i - 1] = _mm256_insert_epi16(v[i - 1], (short)above[bs - 1], 15);
+  for (; i < bs / 8; ++i) v[i] = above_right;
+
+  store_from_sequence(dst, stride, bs, bs, v, bs / 8, 1);
+}
+
+void vpx_highbd_d45_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_d45_predictor(dst, stride, 16, above);
+}
+
+void vpx_highbd_d45_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_d45_predictor(dst, stride, 32, above);
+}
+
+// -----------------------------------------------------------------------------
+// D63_PRED
+
+static INLINE void highbd_d63_predictor(uint16_t *dst, ptrdiff_t stride,
+                                        int bs, const uint16_t *above) {
+  const __m256i above_right = _mm256_set1_epi16((int16_t)above[bs - 1]);
+  __m256i avg2[3], avg3[3], last_avg2, last_avg3;
+  int i;
+
+  for (i = 0; i < bs / 16; ++i) {
+    const __m256i a0 = load_row(above + 16 * i);
+    const __m256i a1 = load_row(above + 16 * i + 1);
+    const __m256i a2 = load_row(above + 16 * i + 2);
+    avg2[i] = _mm256_avg_epu16(a0, a1);
+    avg3[i] = avg3_epu16_avx2(a0, a1, a2);
+  }
+  // The shifted copies of the first two rows are padded with above[bs - 1]
+  // from their last pixel on, but the first two rows keep that pixel.
+  last_avg2 = avg2[i - 1];
+  last_avg3 = avg3[i - 1];
+  avg2[i - 1] = _mm256_insert_epi16(last_avg2, (short)above[bs - 1], 15);
+  avg3[i - 1] = _mm256_insert_epi16(last_avg3, (short)above[bs - 1], 15);
+  avg2[i] = above_right;
+  avg3[i] = above_right;
+
+  store_from_sequence(dst, 2 * stride, bs / 2, bs, avg2, bs / 16 + 1, 1);
+  store_from_sequence(dst + stride, 2 * stride, bs / 2, bs, avg3, bs / 16 + 1,
+                      1);
+  store_row(dst + bs - 16, last_avg2);
+  store_row(dst + stride + bs - 16, last_avg3);
+}
+
+void vpx_highbd_d63_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_d63_predictor(dst, stride, 16, above);
+}
+
+void vpx_highbd_d63_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  (void)left;
+  (void)bd;
+  highbd_d63_predictor(dst, stride, 32, above);
+}
+
+// -----------------------------------------------------------------------------
+// D117_PRED
+
+static INLINE void highbd_d117_predictor(uint16_t *dst, ptrdiff_t stride,
+                                         int bs, const uint16_t *above,
+                                         const uint16_t *left) {
+  // The even and odd rows each shift right by one pixel every two rows,
+  // pulling in the even and odd entries of the first column respectively.
+  const __m256i deinterleave =
+      _mm256_setr_epi8(12, 13, 8, 9, 4, 5, 0, 1, 14, 15, 10, 11, 6, 7, 2, 3,
+                       12, 13, 8, 9, 4, 5, 0, 1, 14, 15, 10, 11, 6, 7, 2, 3);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i col_desc[2];
+  __m256i prev = last_two(0, above[-1]);
+  __m256i even[3], odd[3], even_w[5], odd_w[5];
+  int i, c;
+
+  // col[r] = AVG3(left[r - 3], left[r - 2], left[r - 1]), left[-1] being the
+  // top left pixel. Only r >= 2 is used.
+  col_desc[1] = zero;
+  for (i = 0; i < bs / 16; ++i) {
+    const __m256i l0 = load_row(left + 16 * i);
+    const __m256i col = avg3_epu16_avx2(
+        prev_3_avx2(prev, l0), prev_2_avx2(prev, l0), prev_1_avx2(prev, l0));
+    col_desc[i] =
+        _mm256_permute4x64_epi64(_mm256_shuffle_epi8(col, deinterleave), 0x72);
+    prev = l0;
+  }
+  // The even entries in descending order, shifted up by one so that the
+  // vector ends with col[2] and can lead the first row; likewise the odd ones.
+  even[0] = prev_1_avx2(
+      zero, _mm256_permute2x128_si256(col_desc[1], col_desc[0], 0x20));
+  odd[0] = prev_1_avx2(
+      zero, _mm256_permute2x128_si256(col_desc[1], col_desc[0], 0x31));
+
+  for (i = 0; i < bs / 16; ++i) {
+    const __m256i am1 = load_row(above + 16 * i - 1);
+    const __m256i a0 = load_row(above + 16 * i);
+    // above[-2] is taken to be left[0] for the first pixel of the second row.
+    const __m256i am2 = i ? load_row(above + 16 * i - 2)
+                          : prev_1_avx2(last_two(0, left[0]), am1);
+    even[i + 1] = _mm256_avg_epu16(am1, a0);
+    odd[i + 1] = avg3_epu16_avx2(am2, am1, a0);
+  }
+  split_sequence(even, bs / 16 + 1, even_w);
+  split_sequence(odd, bs / 16 + 1, odd_w);
+
+  // Rows 2 * i and 2 * i + 1 start i pixels before the first two rows, which
+  // are even_w[2] and odd_w[2] onwards.
+  for (i = 0; i < bs / 2; i += 8) {
+    for (c = 0; c < bs; c += 16) {
+      const int j = 2 + (c - i) / 8;
+      store_8_rows_back(dst + 2 * i * stride + c, 2 * stride, even_w[j - 1],
+                        even_w[j]);
+      store_8_rows_back(dst + (2 * i + 1) * stride + c, 2 * stride,
+                        odd_w[j - 1], odd_w[j]);
+    }
+  }
+}
+
+void vpx_highbd_d117_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d117_predictor(dst, stride, 16, above, left);
+}
+
+void vpx_highbd_d117_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d117_predictor(dst, stride, 32, above, left);
+}
+
+// -----------------------------------------------------------------------------
+// D135_PRED
+
+// The border runs from the bottom left pixel up the left column, through the
+// top left pixel and along the top row: each entry is the AVG3 of three
+// neighbours of that sequence. Row r starts bs - 1 - r pixels in.
+static INLINE void highbd_d135_predictor(uint16_t *dst, ptrdiff_t stride,
+                                         int bs, const uint16_t *above,
+                                         const uint16_t *left) {
+  const __m256i rev =
+      _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                       14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  __m256i l_desc = _mm256_permute4x64_epi64(
+      _mm256_shuffle_epi8(load_row(left + bs - 16), rev), 0x4e);
+  __m256i v[4];
+  int i;
+
+  for (i = 0; i < bs; i += 16) {
+    const __m256i next =
+        (i + 16 < bs)
+            ? _mm256_permute4x64_epi64(
+                  _mm256_shuffle_epi8(load_row(left + bs - 32 - i), rev), 0x4e)
+            : load_row(above - 1);
+    v[i / 16] = avg3_epu16_avx2(l_desc, next_1_avx2(l_desc, next),
+                                next_2_avx2(l_desc, next));
+    l_desc = next;
+  }
+  for (i = 0; i < bs; i += 16) {
+    v[(bs + i) / 16] =
+        avg3_epu16_avx2(load_row(above + i - 1), load_row(above + i),
+                        load_row(above + i + 1));
+  }
+
+  store_from_sequence(dst + (bs - 1) * stride, -stride, bs, bs, v, bs / 8, 1);
+}
+
+void vpx_highbd_d135_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d135_predictor(dst, stride, 16, above, left);
+}
+
+void vpx_highbd_d135_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d135_predictor(dst, stride, 32, above, left);
+}
+
+// -----------------------------------------------------------------------------
+// D153_PRED
+
+static INLINE void highbd_d153_predictor(uint16_t *dst, ptrdiff_t stride,
+                                         int bs, const uint16_t *above,
+                                         const uint16_t *left) {
+  // The border holds the (AVG2, AVG3) pairs of the first two columns from the
+  // bottom row up, followed by the rest of the first row. Row r starts two
+  // pixels further right than row r + 1.
+  const __m256i rev_pairs = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  // left[-1] is the top left pixel and left[-2] above[0], which gives the
+  // AVG3 of the first row.
+  __m256i prev = last_two(above[0], above[-1]);
+  __m256i v[6];
+  int i;
+
+  for (i = 0; i < bs; i += 16) {
+    const __m256i l0 = load_row(left + i);
+    const __m256i lm1 = prev_1_avx2(prev, l0);
+    const __m256i lm2 = prev_2_avx2(prev, l0);
+    const __m256i avg2 = _mm256_avg_epu16(lm1, l0);
+    const __m256i avg3 = avg3_epu16_avx2(lm2, lm1, l0);
+    const __m256i lo = _mm256_unpacklo_epi16(avg2, avg3);
+    const __m256i hi = _mm256_unpackhi_epi16(avg2, avg3);
+    v[(bs - 16 - i) / 8] = _mm256_permutevar8x32_epi32(
+        _mm256_permute2x128_si256(lo, hi, 0x31), rev_pairs);
+    v[(bs - 16 - i) / 8 + 1] = _mm256_permutevar8x32_epi32(
+        _mm256_permute2x128_si256(lo, hi, 0x20), rev_pairs);
+    prev = l0;
+  }
+  for (i = 0; i < bs; i += 16) {
+    v[(2 * bs + i) / 16] =
+        avg3_epu16_avx2(load_row(above + i - 1), load_row(above + i),
+                        load_row(above + i + 1));
+  }
+
+  store_from_sequence(dst + (bs - 1) * stride, -stride, bs, bs, v,
+                      3 * bs / 16, 2);
+}
+
+void vpx_highbd_d153_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d153_predictor(dst, stride, 16, above, left);
+}
+
+void vpx_highbd_d153_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)bd;
+  highbd_d153_predictor(dst, stride, 32, above, left);
+}
+
+// -----------------------------------------------------------------------------
+// D207_PRED
+
+static INLINE void highbd_d207_predictor(uint16_t *dst, ptrdiff_t stride,
+                                         int bs, const uint16_t *left) {
+  // The border interleaves the AVG2 and AVG3 columns and is padded with
+  // left[bs - 1]. Row r starts 2 * r pixels in.
+  const __m256i bottom = _mm256_set1_epi16((int16_t)left[bs - 1]);
+  __m256i v[6];
+  int i;
+
+  for (i = 0; i < bs; i += 16) {
+    const __m256i l0 = load_row(left + i);
+    const __m256i next = (i + 16 < bs) ? load_row(left + i + 16) : bottom;
+    const __m256i l1 = next_1_avx2(l0, next);
+    const __m256i l2 = next_2_avx2(l0, next);
+    const __m256i avg2 = _mm256_avg_epu16(l0, l1);
+    const __m256i avg3 = avg3_epu16_avx2(l0, l1, l2);
+    const __m256i lo = _mm256_unpacklo_epi16(avg2, avg3);
+    const __m256i hi = _mm256_unpackhi_epi16(avg2, avg3);
+    v[i / 8] = _mm256_permute2x128_si256(lo, hi, 0x20);
+    v[i / 8 + 1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+  }
+  for (i = bs / 8; i < 3 * bs / 16; ++i) v[i] = bottom;
+
+  store_from_sequence(dst, stride, bs, bs, v, 3 * bs / 16, 2);
+}
+
+void vpx_highbd_d207_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)above;
+  (void)bd;
+  highbd_d207_predictor(dst, stride, 16, left);
+}
+
+void vpx_highbd_d207_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
+                                          const uint16_t *above,
+                                          const uint16_t *left, int bd) {
+  (void)above;
+  (void)bd;
+  highbd_d207_predictor(dst, stride, 32, left);
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_HIGHBD_QUANTIZE_AVX2_H_
+#define VPX_VPX_DSP_X86_HIGHBD_QUANTIZE_AVX2_H_
+
+#include <immintrin.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+
+#if CONFIG_VP9_HIGHBITDEPTH
+
+// Load the 8 dc/ac values of a quantizer table into 32 bit lanes. Lane 0
+// holds the dc value and lanes 1-7 the ac value.
+static INLINE __m256i highbd_load_values_avx2(const int16_t *ptr) {
+  return _mm256_cvtepi16_epi32(_mm_load_si128((const __m128i *)ptr));
+}
+
+// Replace the dc value in lane 0 with the ac value.
+static INLINE __m256i highbd_ac_values_avx2(const __m256i a) {
+  return _mm256_shuffle_epi32(a, 0x55);
+}
+
+// Multiply the 32 bit lanes of a and b with 64 bit intermediate precision and
+// return bits [shift, shift + 32) of each product. This matches
+// (int)(((int64_t)a * b) >> shift) when the result fits in 32 bits.
+static INLINE __m256i highbd_mul_shift_epi32_avx2(const __m256i a,
+                                                  const __m256i b,
+                                                  const int shift) {
+  const __m256i prod_even = _mm256_mul_epi32(a, b);
+  const __m256i prod_odd =
+      _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  return _mm256_blend_epi32(_mm256_srli_epi64(prod_even, shift),
+                            _mm256_slli_epi64(prod_odd, 32 - shift), 0xaa);
+}
+
+// Apply the sign of coeff the way the C code does, (a ^ sign) - sign, so a
+// value quantized from a zero coefficient keeps its sign.
+static INLINE __m256i highbd_invert_sign_avx2(const __m256i a,
+                                              const __m256i coeff) {
+  const __m256i sign = _mm256_srai_epi32(coeff, 31);
+  return _mm256_sub_epi32(_mm256_xor_si256(a, sign), sign);
+}
+
+// Divide by 2, rounding toward zero like the C '/ 2'.
+static INLINE __m256i highbd_half_epi32_avx2(const __m256i a) {
+  return _mm256_srai_epi32(_mm256_add_epi32(a, _mm256_srli_epi32(a, 31)), 1);
+}
+
+// Return the 1-based scan position of each nonzero qcoeff, 0 otherwise.
+static INLINE __m256i highbd_scan_eob_avx2(const __m256i qcoeff,
+                                           const int16_t *iscan) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i iscan32 =
+      _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)iscan));
+  const __m256i zero_coeff = _mm256_cmpeq_epi32(qcoeff, zero);
+  const __m256i nzero_coeff = _mm256_cmpeq_epi32(zero_coeff, zero);
+  // Add one to convert from indices to counts
+  const __m256i iscan_plus_one = _mm256_sub_epi32(iscan32, nzero_coeff);
+  return _mm256_and_si256(iscan_plus_one, nzero_coeff);
+}
+
+static INLINE uint16_t highbd_accumulate_eob_avx2(const __m256i eob) {
+  __m128i eob_s = _mm_max_epi32(_mm256_castsi256_si128(eob),
+                                _mm256_extracti128_si256(eob, 1));
+  eob_s = _mm_max_epi32(eob_s, _mm_shuffle_epi32(eob_s, 0xe));
+  eob_s = _mm_max_epi32(eob_s, _mm_shuffle_epi32(eob_s, 1));
+  return (uint16_t)_mm_cvtsi128_si32(eob_s);
+}
+
+static INLINE void highbd_store_zero_avx2(tran_low_t *qcoeff_ptr,
+                                          tran_low_t *dqcoeff_ptr) {
+  const __m256i zero = _mm256_setzero_si256();
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, zero);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, zero);
+}
+
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#endif  // VPX_VPX_DSP_X86_HIGHBD_QUANTIZE_AVX2_H_
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/x86/highbd_quantize_avx2.h"
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// Quantize 8 coefficients. Only coefficients at or above zbin are quantized,
+// which makes the scan order pre-pass of the C code unnecessary: everything it
+// trims is below zbin. log_scale is 1 for 32x32 blocks, where the result is
+// scaled up by 2 and the dequantized value halved.
+static INLINE void highbd_quantize_b_8(
+    const tran_low_t *coeff_ptr, const int16_t *iscan_ptr, const __m256i zbin,
+    const __m256i round, const __m256i quant, const __m256i quant_shift,
+    const __m256i dequant, const int log_scale, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, __m256i *eob) {
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i abs_coeff = _mm256_abs_epi32(coeff);
+  const __m256i skip = _mm256_cmpgt_epi32(zbin, abs_coeff);
+  __m256i tmp1, tmp2, qcoeff, dqcoeff;
+
+  if (_mm256_movemask_epi8(skip) == -1) {
+    highbd_store_zero_avx2(qcoeff_ptr, dqcoeff_ptr);
+    return;
+  }
+
+  tmp1 = _mm256_add_epi32(abs_coeff, round);
+  tmp2 = _mm256_add_epi32(highbd_mul_shift_epi32_avx2(tmp1, quant, 16), tmp1);
+  qcoeff = highbd_mul_shift_epi32_avx2(tmp2, quant_shift, 16 - log_scale);
+  qcoeff = highbd_invert_sign_avx2(_mm256_andnot_si256(skip, qcoeff), coeff);
+  dqcoeff = _mm256_mullo_epi32(qcoeff, dequant);
+  if (log_scale) dqcoeff = highbd_half_epi32_avx2(dqcoeff);
+
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, qcoeff);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dqcoeff);
+  *eob = _mm256_max_epi32(*eob, highbd_scan_eob_avx2(qcoeff, iscan_ptr));
+}
+
+static INLINE void highbd_quantize_b_avx2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, const int16_t *zbin_ptr,
+    const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *iscan, const int log_scale) {
+  const __m256i one = _mm256_set1_epi32(1);
+  __m256i zbin = highbd_load_values_avx2(zbin_ptr);
+  __m256i round = highbd_load_values_avx2(round_ptr);
+  __m256i quant = highbd_load_values_avx2(quant_ptr);
+  __m256i quant_shift = highbd_load_values_avx2(quant_shift_ptr);
+  __m256i dequant = highbd_load_values_avx2(dequant_ptr);
+  __m256i eob = _mm256_setzero_si256();
+  intptr_t i;
+
+  assert(n_coeffs >= 16 && !(n_coeffs & 7));
+
+  if (log_scale) {
+    // ROUND_POWER_OF_TWO(x, 1)
+    zbin = _mm256_srai_epi32(_mm256_add_epi32(zbin, one), 1);
+    round = _mm256_srai_epi32(_mm256_add_epi32(round, one), 1);
+  }
+
+  highbd_quantize_b_8(coeff_ptr, iscan, zbin, round, quant, quant_shift,
+                      dequant, log_scale, qcoeff_ptr, dqcoeff_ptr, &eob);
+
+  zbin = highbd_ac_values_avx2(zbin);
+  round = highbd_ac_values_avx2(round);
+  quant = highbd_ac_values_avx2(quant);
+  quant_shift = highbd_ac_values_avx2(quant_shift);
+  dequant = highbd_ac_values_avx2(dequant);
+
+  for (i = 8; i < n_coeffs; i += 8) {
+    highbd_quantize_b_8(coeff_ptr + i, iscan + i, zbin, round, quant,
+                        quant_shift, dequant, log_scale, qcoeff_ptr + i,
+                        dqcoeff_ptr + i, &eob);
+  }
+
+  *eob_ptr = highbd_accumulate_eob_avx2(eob);
+}
+
+void vpx_highbd_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *zbin_ptr,
+                                const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                const int16_t *quant_shift_ptr,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan, const int16_t *iscan) {
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  highbd_quantize_b_avx2(coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr,
+                         quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                         eob_ptr, iscan, 0);
+}
+
+void vpx_highbd_quantize_b_32x32_avx2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  highbd_quantize_b_avx2(coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr,
+                         quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr,
+                         eob_ptr, iscan, 1);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// A 64-pixel row of 16-bit pixels takes two registers. The absolute
+// differences of 12-bit pixels are summed in 16 bits over 4 rows, 8 additions
+// per lane, before they are widened to 32 bits.
+static INLINE void highbd_sad64xhx4d_avx512(const uint8_t *src_ptr,
+                                            int src_stride,
+                                            const uint8_t *const ref_array[],
+                                            int ref_stride, int height,
+                                            uint32_t *res) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src_ptr);
+  const uint16_t *ref[4];
+  const __m512i one = _mm512_set1_epi16(1);
+  __m512i sum_ref[4];
+  int i, j, r;
+
+  for (r = 0; r < 4; ++r) {
+    ref[r] = CONVERT_TO_SHORTPTR(ref_array[r]);
+    sum_ref[r] = _mm512_setzero_si512();
+  }
+
+  for (i = 0; i < height; i += 4) {
+    __m512i sums_16[4];
+    for (r = 0; r < 4; ++r) sums_16[r] = _mm512_setzero_si512();
+    for (j = 0; j < 4; ++j) {
+      const __m512i src0 = _mm512_loadu_si512((const __m512i *)src);
+      const __m512i src1 = _mm512_loadu_si512((const __m512i *)(src + 32));
+      for (r = 0; r < 4; ++r) {
+        const __m512i ref0 = _mm512_loadu_si512((const __m512i *)ref[r]);
+        const __m512i ref1 = _mm512_loadu_si512((const __m512i *)(ref[r] + 32));
+        const __m512i sad0 = _mm512_abs_epi16(_mm512_sub_epi16(src0, ref0));
+        const __m512i sad1 = _mm512_abs_epi16(_mm512_sub_epi16(src1, ref1));
+        sums_16[r] =
+            _mm512_add_epi16(sums_16[r], _mm512_add_epi16(sad0, sad1));
+        ref[r] += ref_stride;
+      }
+      src += src_stride;
+    }
+    for (r = 0; r < 4; ++r) {
+      sum_ref[r] =
+          _mm512_add_epi32(sum_ref[r], _mm512_madd_epi16(sums_16[r], one));
+    }
+  }
+
+  for (r = 0; r < 4; ++r) res[r] = _mm512_reduce_add_epi32(sum_ref[r]);
+}
+
+void vpx_highbd_sad64x64x4d_avx512(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *const ref_array[],
+                                   int ref_stride, uint32_t *res) {
+  highbd_sad64xhx4d_avx512(src_ptr, src_stride, ref_array, ref_stride, 64,
+                           res);
+}
+
+void vpx_highbd_sad64x32x4d_avx512(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *const ref_array[],
+                                   int ref_stride, uint32_t *res) {
+  highbd_sad64xhx4d_avx512(src_ptr, src_stride, ref_array, ref_stride, 32,
+                           res);
+}
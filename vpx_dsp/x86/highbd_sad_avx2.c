@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Absolute differences of 16 pixels of up to 12 bits.
+static INLINE __m256i highbd_sad16_avx2(const __m256i src, const __m256i ref) {
+  return _mm256_abs_epi16(_mm256_sub_epi16(src, ref));
+}
+
+// Widen 16-bit sums of at most 8 absolute differences to 32 bits.
+static INLINE __m256i highbd_widen_sums_avx2(const __m256i sums_16) {
+  return _mm256_madd_epi16(sums_16, _mm256_set1_epi16(1));
+}
+
+static INLINE unsigned int highbd_hadd_epi32_avx2(const __m256i sums) {
+  const __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sums),
+                                  _mm256_extracti128_si256(sums, 1));
+  const __m128i t = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+  const __m128i u = _mm_add_epi32(t, _mm_srli_si128(t, 4));
+  return (unsigned int)_mm_cvtsi128_si32(u);
+}
+
+static INLINE unsigned int highbd_sad_avx2(const uint16_t *src, int src_stride,
+                                           const uint16_t *ref, int ref_stride,
+                                           const uint16_t *second_pred,
+                                           int width, int height) {
+  // Each 16-bit lane can hold the sum of 8 absolute differences of 12-bit
+  // pixels before it has to be widened.
+  const int rows = 128 / width;
+  __m256i sums_32 = _mm256_setzero_si256();
+  int i, j, k;
+
+  for (i = 0; i < height; i += rows) {
+    __m256i sums_16 = _mm256_setzero_si256();
+    for (j = 0; j < rows; ++j) {
+      for (k = 0; k < width; k += 16) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + k));
+        __m256i r = _mm256_loadu_si256((const __m256i *)(ref + k));
+        if (second_pred != NULL) {
+          const __m256i p =
+              _mm256_loadu_si256((const __m256i *)(second_pred + k));
+          r = _mm256_avg_epu16(r, p);
+        }
+        sums_16 = _mm256_add_epi16(sums_16, highbd_sad16_avx2(s, r));
+      }
+      src += src_stride;
+      ref += ref_stride;
+      if (second_pred != NULL) second_pred += width;
+    }
+    sums_32 = _mm256_add_epi32(sums_32, highbd_widen_sums_avx2(sums_16));
+  }
+  return highbd_hadd_epi32_avx2(sums_32);
+}
+
+static INLINE void highbd_sad_x4d_avx2(const uint16_t *src, int src_stride,
+                                       const uint8_t *const ref_array[4],
+                                       int ref_stride, int width, int height,
+                                       uint32_t sad_array[4]) {
+  const uint16_t *ref0 = CONVERT_TO_SHORTPTR(ref_array[0]);
+  const uint16_t *ref1 = CONVERT_TO_SHORTPTR(ref_array[1]);
+  const uint16_t *ref2 = CONVERT_TO_SHORTPTR(ref_array[2]);
+  const uint16_t *ref3 = CONVERT_TO_SHORTPTR(ref_array[3]);
+  const int rows = 128 / width;
+  __m256i sum_ref0 = _mm256_setzero_si256();
+  __m256i sum_ref1 = _mm256_setzero_si256();
+  __m256i sum_ref2 = _mm256_setzero_si256();
+  __m256i sum_ref3 = _mm256_setzero_si256();
+  int i, j, k;
+
+  for (i = 0; i < height; i += rows) {
+    __m256i sums0 = _mm256_setzero_si256();
+    __m256i sums1 = _mm256_setzero_si256();
+    __m256i sums2 = _mm256_setzero_si256();
+    __m256i sums3 = _mm256_setzero_si256();
+    for (j = 0; j < rows; ++j) {
+      for (k = 0; k < width; k += 16) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + k));
+        const __m256i r0 = _mm256_loadu_si256((const __m256i *)(ref0 + k));
+        const __m256i r1 = _mm256_loadu_si256((const __m256i *)(ref1 + k));
+        const __m256i r2 = _mm256_loadu_si256((const __m256i *)(ref2 + k));
+        const __m256i r3 = _mm256_loadu_si256((const __m256i *)(ref3 + k));
+        sums0 = _mm256_add_epi16(sums0, highbd_sad16_avx2(s, r0));
+        sums1 = _mm256_add_epi16(sums1, highbd_sad16_avx2(s, r1));
+        sums2 = _mm256_add_epi16(sums2, highbd_sad16_avx2(s, r2));
+        sums3 = _mm256_add_epi16(sums3, highbd_sad16_avx2(s, r3));
+      }
+      src += src_stride;
+      ref0 += ref_stride;
+      ref1 += ref_stride;
+      ref2 += ref_stride;
+      ref3 += ref_stride;
+    }
+    sum_ref0 = _mm256_add_epi32(sum_ref0, highbd_widen_sums_avx2(sums0));
+    sum_ref1 = _mm256_add_epi32(sum_ref1, highbd_widen_sums_avx2(sums1));
+    sum_ref2 = _mm256_add_epi32(sum_ref2, highbd_widen_sums_avx2(sums2));
+    sum_ref3 = _mm256_add_epi32(sum_ref3, highbd_widen_sums_avx2(sums3));
+  }
+
+  sad_array[0] = highbd_hadd_epi32_avx2(sum_ref0);
+  sad_array[1] = highbd_hadd_epi32_avx2(sum_ref1);
+  sad_array[2] = highbd_hadd_epi32_avx2(sum_ref2);
+  sad_array[3] = highbd_hadd_epi32_avx2(sum_ref3);
+}
+
+#define HIGHBD_SADMXN(m, n)                                                   \
+  unsigned int vpx_highbd_sad##m##x##n##_avx2(                                \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride) {                                                       \
+    return highbd_sad_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,          \
+                           CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, NULL, m, \
+                           n);                                                \
+  }                                                                           \
+                                                                              \
+  unsigned int vpx_highbd_sad##m##x##n##_avg_avx2(                            \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, const uint8_t *second_pred) {                           \
+    return highbd_sad_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,          \
+                           CONVERT_TO_SHORTPTR(ref_ptr), ref_stride,          \
+                           CONVERT_TO_SHORTPTR(second_pred), m, n);           \
+  }                                                                           \
+                                                                              \
+  void vpx_highbd_sad##m##x##n##x4d_avx2(                                     \
+      const uint8_t *src_ptr, int src_stride,                                 \
+      const uint8_t *const ref_array[], int ref_stride,                       \
+      uint32_t *sad_array) {                                                  \
+    highbd_sad_x4d_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride, ref_array,  \
+                        ref_stride, m, n, sad_array);                         \
+  }
+
+HIGHBD_SADMXN(64, 64)
+HIGHBD_SADMXN(64, 32)
+HIGHBD_SADMXN(32, 64)
+HIGHBD_SADMXN(32, 32)
+HIGHBD_SADMXN(32, 16)
+HIGHBD_SADMXN(16, 32)
+HIGHBD_SADMXN(16, 16)
+HIGHBD_SADMXN(16, 8)
+
+#undef HIGHBD_SADMXN
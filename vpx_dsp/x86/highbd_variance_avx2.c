@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_filter.h"
+#include "vpx_ports/mem.h"
+
+// The 2-tap filters used by the sub-pixel variances, one pair per eighth of a
+// pixel, as in variance.c.
+static const uint8_t bilinear_filters[8][2] = {
+  { 128, 0 }, { 112, 16 }, { 96, 32 }, { 80, 48 },
+  { 64, 64 }, { 48, 80 },  { 32, 96 }, { 16, 112 },
+};
+
+// Accumulate the sum and the sum of squares of 16 differences. The
+// differences of 12-bit pixels fit in 16 bits and each 32-bit lane of sse
+// collects 2 squares per row, so a 64-row column of a block cannot overflow
+// it.
+static INLINE void highbd_variance_kernel_avx2(const __m256i src,
+                                               const __m256i ref,
+                                               __m256i *const sse,
+                                               __m256i *const sum) {
+  const __m256i diff = _mm256_sub_epi16(src, ref);
+  *sse = _mm256_add_epi32(*sse, _mm256_madd_epi16(diff, diff));
+  *sum = _mm256_add_epi32(*sum, _mm256_madd_epi16(diff, _mm256_set1_epi16(1)));
+}
+
+// Add the unsigned 32-bit lanes of in to the 64-bit lanes of *acc.
+static INLINE void highbd_accumulate_epu32_avx2(const __m256i in,
+                                                __m256i *const acc) {
+  const __m256i zero = _mm256_setzero_si256();
+  *acc = _mm256_add_epi64(*acc, _mm256_unpacklo_epi32(in, zero));
+  *acc = _mm256_add_epi64(*acc, _mm256_unpackhi_epi32(in, zero));
+}
+
+static INLINE void highbd_variance_finish_avx2(const __m256i sse_64,
+                                               const __m256i sum_32,
+                                               uint64_t *const sse,
+                                               int64_t *const sum) {
+  __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sse_64),
+                            _mm256_extracti128_si256(sse_64, 1));
+  __m128i t = _mm_add_epi32(_mm256_castsi256_si128(sum_32),
+                            _mm256_extracti128_si256(sum_32, 1));
+  s = _mm_add_epi64(s, _mm_srli_si128(s, 8));
+  t = _mm_add_epi32(t, _mm_srli_si128(t, 8));
+  t = _mm_add_epi32(t, _mm_srli_si128(t, 4));
+  _mm_storel_epi64((__m128i *)sse, s);
+  *sum = _mm_cvtsi128_si32(t);
+}
+
+// Compute the sum and the sum of squares of the differences of a block whose
+// width is a multiple of 16, working down one 16-wide column at a time.
+static void highbd_variance_avx2(const uint16_t *src, int src_stride,
+                                 const uint16_t *ref, int ref_stride, int w,
+                                 int h, uint64_t *sse, int64_t *sum) {
+  __m256i sse_64 = _mm256_setzero_si256();
+  __m256i sum_32 = _mm256_setzero_si256();
+  int i, j;
+
+  for (j = 0; j < w; j += 16) {
+    __m256i sse_32 = _mm256_setzero_si256();
+    for (i = 0; i < h; ++i) {
+      const __m256i s =
+          _mm256_loadu_si256((const __m256i *)(src + i * src_stride + j));
+      const __m256i r =
+          _mm256_loadu_si256((const __m256i *)(ref + i * ref_stride + j));
+      highbd_variance_kernel_avx2(s, r, &sse_32, &sum_32);
+    }
+    highbd_accumulate_epu32_avx2(sse_32, &sse_64);
+  }
+  highbd_variance_finish_avx2(sse_64, sum_32, sse, sum);
+}
+
+// Filter 16 pixels with a 2-tap bilinear filter. An offset of 0 is a copy and
+// an offset of 4 is a rounded average, which both avoid the widening.
+static INLINE __m256i highbd_filter16_avx2(const __m256i a, const __m256i b,
+                                           const int offset) {
+  if (offset == 0) {
+    return a;
+  } else if (offset == 4) {
+    return _mm256_avg_epu16(a, b);
+  } else {
+    const __m256i f = _mm256_set1_epi32((bilinear_filters[offset][1] << 16) |
+                                        bilinear_filters[offset][0]);
+    const __m256i round = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), f);
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), f);
+    lo = _mm256_srli_epi32(_mm256_add_epi32(lo, round), FILTER_BITS);
+    hi = _mm256_srli_epi32(_mm256_add_epi32(hi, round), FILTER_BITS);
+    return _mm256_packus_epi32(lo, hi);
+  }
+}
+
+// Load and horizontally filter 16 pixels.
+static INLINE __m256i highbd_filter_row16_avx2(const uint16_t *src,
+                                               const int x_offset) {
+  const __m256i a = _mm256_loadu_si256((const __m256i *)src);
+  if (x_offset == 0) return a;
+  return highbd_filter16_avx2(
+      a, _mm256_loadu_si256((const __m256i *)(src + 1)), x_offset);
+}
+
+// The sub-pixel variance of a block whose width is a multiple of 16. The two
+// filter passes of variance.c are applied a row at a time in registers, and
+// the result is averaged with second_pred if it is not NULL.
+static void highbd_subpel_variance_avx2(const uint16_t *src, int src_stride,
+                                        int x_offset, int y_offset,
+                                        const uint16_t *ref, int ref_stride,
+                                        const uint16_t *second_pred, int w,
+                                        int h, uint64_t *sse, int64_t *sum) {
+  __m256i sse_64 = _mm256_setzero_si256();
+  __m256i sum_32 = _mm256_setzero_si256();
+  int i, j;
+
+  for (j = 0; j < w; j += 16) {
+    const uint16_t *s = src + j;
+    __m256i sse_32 = _mm256_setzero_si256();
+    __m256i prev = _mm256_setzero_si256();
+    if (y_offset != 0) prev = highbd_filter_row16_avx2(s, x_offset);
+    for (i = 0; i < h; ++i) {
+      __m256i p, r;
+      if (y_offset == 0) {
+        p = highbd_filter_row16_avx2(s, x_offset);
+      } else {
+        const __m256i next =
+            highbd_filter_row16_avx2(s + src_stride, x_offset);
+        p = highbd_filter16_avx2(prev, next, y_offset);
+        prev = next;
+      }
+      if (second_pred != NULL) {
+        p = _mm256_avg_epu16(
+            p, _mm256_loadu_si256((const __m256i *)(second_pred + i * w + j)));
+      }
+      r = _mm256_loadu_si256((const __m256i *)(ref + i * ref_stride + j));
+      highbd_variance_kernel_avx2(p, r, &sse_32, &sum_32);
+      s += src_stride;
+    }
+    highbd_accumulate_epu32_avx2(sse_32, &sse_64);
+  }
+  highbd_variance_finish_avx2(sse_64, sum_32, sse, sum);
+}
+
+// Scale the sums of 10 and 12-bit blocks down to 8 bits, as variance.c does,
+// and return the variance.
+static INLINE uint32_t highbd_variance_result(uint64_t sse_long,
+                                              int64_t sum_long, int bd,
+                                              int shift, uint32_t *sse) {
+  int sum;
+  int64_t var;
+  if (bd == 8) {
+    *sse = (uint32_t)sse_long;
+    sum = (int)sum_long;
+    return *sse - (uint32_t)(((int64_t)sum * sum) >> shift);
+  }
+  *sse = (uint32_t)ROUND_POWER_OF_TWO(sse_long, 2 * (bd - 8));
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, bd - 8);
+  var = (int64_t)(*sse) - (((int64_t)sum * sum) >> shift);
+  return (var >= 0) ? (uint32_t)var : 0;
+}
+
+#define HIGHBD_VAR_FN(bd, w, h, shift)                                        \
+  uint32_t vpx_highbd_##bd##_variance##w##x##h##_avx2(                        \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    uint64_t sse_long;                                                        \
+    int64_t sum_long;                                                         \
+    highbd_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,            \
+                         CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, w, h,      \
+                         &sse_long, &sum_long);                               \
+    return highbd_variance_result(sse_long, sum_long, bd, shift, sse);        \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_##bd##_sub_pixel_variance##w##x##h##_avx2(              \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse) {                \
+    uint64_t sse_long;                                                        \
+    int64_t sum_long;                                                         \
+    highbd_subpel_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,     \
+                                x_offset, y_offset,                           \
+                                CONVERT_TO_SHORTPTR(ref_ptr), ref_stride,     \
+                                NULL, w, h, &sse_long, &sum_long);            \
+    return highbd_variance_result(sse_long, sum_long, bd, shift, sse);        \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_##bd##_sub_pixel_avg_variance##w##x##h##_avx2(          \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,                  \
+      const uint8_t *second_pred) {                                           \
+    uint64_t sse_long;                                                        \
+    int64_t sum_long;                                                         \
+    highbd_subpel_variance_avx2(                                              \
+        CONVERT_TO_SHORTPTR(src_ptr), src_stride, x_offset, y_offset,         \
+        CONVERT_TO_SHORTPTR(ref_ptr), ref_stride,                             \
+        CONVERT_TO_SHORTPTR(second_pred), w, h, &sse_long, &sum_long);        \
+    return highbd_variance_result(sse_long, sum_long, bd, shift, sse);        \
+  }
+
+#define HIGHBD_VAR_FNS(w, h, shift) \
+  HIGHBD_VAR_FN(8, w, h, shift)     \
+  HIGHBD_VAR_FN(10, w, h, shift)    \
+  HIGHBD_VAR_FN(12, w, h, shift)
+
+HIGHBD_VAR_FNS(64, 64, 12)
+HIGHBD_VAR_FNS(64, 32, 11)
+HIGHBD_VAR_FNS(32, 64, 11)
+HIGHBD_VAR_FNS(32, 32, 10)
+HIGHBD_VAR_FNS(32, 16, 9)
+HIGHBD_VAR_FNS(16, 32, 9)
+HIGHBD_VAR_FNS(16, 16, 8)
+HIGHBD_VAR_FNS(16, 8, 7)
+
+#undef HIGHBD_VAR_FNS
+#undef HIGHBD_VAR_FN
@@ -0,0 +1,469 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// The directional predictors below keep the outer border of the block in
+// registers and build every row with a byte shift of it: in the C code each
+// row is the previous one moved along the border by one or two pixels.
+// Reloading the rows from a copy of the border in memory would stall on store
+// forwarding instead.
+
+// (x + 2 * y + z + 2) >> 2, computed as avg(avg(x, z) - ((x ^ z) & 1), y).
+static INLINE __m256i avg3_epu8_avx2(const __m256i x, const __m256i y,
+                                     const __m256i z) {
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i a = _mm256_avg_epu8(x, z);
+  const __m256i b =
+      _mm256_sub_epi8(a, _mm256_and_si256(_mm256_xor_si256(x, z), one));
+  return _mm256_avg_epu8(b, y);
+}
+
+static INLINE __m128i avg3_epu8(const __m128i x, const __m128i y,
+                                const __m128i z) {
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i a = _mm_avg_epu8(x, z);
+  const __m128i b = _mm_sub_epi8(a, _mm_and_si128(_mm_xor_si128(x, z), one));
+  return _mm_avg_epu8(b, y);
+}
+
+// Bytes [1, 33) and [2, 34) of the 64 byte sequence lo:hi.
+static INLINE __m256i next_1_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21), lo, 1);
+}
+
+static INLINE __m256i next_2_avx2(const __m256i lo, const __m256i hi) {
+  return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21), lo, 2);
+}
+
+// Return a 16 byte vector holding x in its last byte.
+static INLINE __m128i last_byte(const uint8_t x) {
+  return _mm_slli_si128(_mm_cvtsi32_si128(x), 15);
+}
+
+// Return the low lanes of lo and hi.
+static INLINE __m256i combine_lo(const __m128i lo, const __m256i hi) {
+  return _mm256_permute2x128_si256(_mm256_castsi128_si256(lo), hi, 0x20);
+}
+
+// Return a with its 32 bytes in reverse order.
+static INLINE __m256i reverse_epi8_avx2(const __m256i a) {
+  const __m256i rev =
+      _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                       15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, rev), 0x4e);
+}
+
+// Store 16 rows, row i holding bytes [i, i + 32) of the sequence that a starts
+// and b continues 16 bytes further on.
+static INLINE void store_16_rows(uint8_t *dst, ptrdiff_t stride,
+                                 const __m256i a, const __m256i b) {
+  _mm256_storeu_si256((__m256i *)dst, a);
+  _mm256_storeu_si256((__m256i *)(dst + 1 * stride),
+                      _mm256_alignr_epi8(b, a, 1));
+  _mm256_storeu_si256((__m256i *)(dst + 2 * stride),
+                      _mm256_alignr_epi8(b, a, 2));
+  _mm256_storeu_si256((__m256i *)(dst + 3 * stride),
+                      _mm256_alignr_epi8(b, a, 3));
+  _mm256_storeu_si256((__m256i *)(dst + 4 * stride),
+                      _mm256_alignr_epi8(b, a, 4));
+  _mm256_storeu_si256((__m256i *)(dst + 5 * stride),
+                      _mm256_alignr_epi8(b, a, 5));
+  _mm256_storeu_si256((__m256i *)(dst + 6 * stride),
+                      _mm256_alignr_epi8(b, a, 6));
+  _mm256_storeu_si256((__m256i *)(dst + 7 * stride),
+                      _mm256_alignr_epi8(b, a, 7));
+  _mm256_storeu_si256((__m256i *)(dst + 8 * stride),
+                      _mm256_alignr_epi8(b, a, 8));
+  _mm256_storeu_si256((__m256i *)(dst + 9 * stride),
+                      _mm256_alignr_epi8(b, a, 9));
+  _mm256_storeu_si256((__m256i *)(dst + 10 * stride),
+                      _mm256_alignr_epi8(b, a, 10));
+  _mm256_storeu_si256((__m256i *)(dst + 11 * stride),
+                      _mm256_alignr_epi8(b, a, 11));
+  _mm256_storeu_si256((__m256i *)(dst + 12 * stride),
+                      _mm256_alignr_epi8(b, a, 12));
+  _mm256_storeu_si256((__m256i *)(dst + 13 * stride),
+                      _mm256_alignr_epi8(b, a, 13));
+  _mm256_storeu_si256((__m256i *)(dst + 14 * stride),
+                      _mm256_alignr_epi8(b, a, 14));
+  _mm256_storeu_si256((__m256i *)(dst + 15 * stride),
+                      _mm256_alignr_epi8(b, a, 15));
+}
+
+// As store_16_rows() with 8 rows, row i starting 2 * i bytes in.
+static INLINE void store_8_rows_step_2(uint8_t *dst, ptrdiff_t stride,
+                                       const __m256i a, const __m256i b) {
+  _mm256_storeu_si256((__m256i *)dst, a);
+  _mm256_storeu_si256((__m256i *)(dst + 1 * stride),
+                      _mm256_alignr_epi8(b, a, 2));
+  _mm256_storeu_si256((__m256i *)(dst + 2 * stride),
+                      _mm256_alignr_epi8(b, a, 4));
+  _mm256_storeu_si256((__m256i *)(dst + 3 * stride),
+                      _mm256_alignr_epi8(b, a, 6));
+  _mm256_storeu_si256((__m256i *)(dst + 4 * stride),
+                      _mm256_alignr_epi8(b, a, 8));
+  _mm256_storeu_si256((__m256i *)(dst + 5 * stride),
+                      _mm256_alignr_epi8(b, a, 10));
+  _mm256_storeu_si256((__m256i *)(dst + 6 * stride),
+                      _mm256_alignr_epi8(b, a, 12));
+  _mm256_storeu_si256((__m256i *)(dst + 7 * stride),
+                      _mm256_alignr_epi8(b, a, 14));
+}
+
+// Store 16 rows, row i holding the 32 bytes starting i bytes before b, where
+// a starts 16 bytes before b.
+static INLINE void store_16_rows_back(uint8_t *dst, ptrdiff_t stride,
+                                      const __m256i a, const __m256i b) {
+  _mm256_storeu_si256((__m256i *)dst, b);
+  _mm256_storeu_si256((__m256i *)(dst + 1 * stride),
+                      _mm256_alignr_epi8(b, a, 15));
+  _mm256_storeu_si256((__m256i *)(dst + 2 * stride),
+                      _mm256_alignr_epi8(b, a, 14));
+  _mm256_storeu_si256((__m256i *)(dst + 3 * stride),
+                      _mm256_alignr_epi8(b, a, 13));
+  _mm256_storeu_si256((__m256i *)(dst + 4 * stride),
+                      _mm256_alignr_epi8(b, a, 12));
+  _mm256_storeu_si256((__m256i *)(dst + 5 * stride),
+                      _mm256_alignr_epi8(b, a, 11));
+  _mm256_storeu_si256((__m256i *)(dst + 6 * stride),
+                      _mm256_alignr_epi8(b, a, 10));
+  _mm256_storeu_si256((__m256i *)(dst + 7 * stride),
+                      _mm256_alignr_epi8(b, a, 9));
+  _mm256_storeu_si256((__m256i *)(dst + 8 * stride),
+                      _mm256_alignr_epi8(b, a, 8));
+  _mm256_storeu_si256((__m256i *)(dst + 9 * stride),
+                      _mm256_alignr_epi8(b, a, 7));
+  _mm256_storeu_si256((__m256i *)(dst + 10 * stride),
+                      _mm256_alignr_epi8(b, a, 6));
+  _mm256_storeu_si256((__m256i *)(dst + 11 * stride),
+                      _mm256_alignr_epi8(b, a, 5));
+  _mm256_storeu_si256((__m256i *)(dst + 12 * stride),
+                      _mm256_alignr_epi8(b, a, 4));
+  _mm256_storeu_si256((__m256i *)(dst + 13 * stride),
+                      _mm256_alignr_epi8(b, a, 3));
+  _mm256_storeu_si256((__m256i *)(dst + 14 * stride),
+                      _mm256_alignr_epi8(b, a, 2));
+  _mm256_storeu_si256((__m256i *)(dst + 15 * stride),
+                      _mm256_alignr_epi8(b, a, 1));
+}
+
+// Store 16 rows of 16 pixels, row i holding bytes [i, i + 16) of lo:hi.
+static INLINE void store_16_rows_128(uint8_t *dst, ptrdiff_t stride,
+                                     const __m128i lo, const __m128i hi) {
+  _mm_storeu_si128((__m128i *)dst, lo);
+  _mm_storeu_si128((__m128i *)(dst + 1 * stride), _mm_alignr_epi8(hi, lo, 1));
+  _mm_storeu_si128((__m128i *)(dst + 2 * stride), _mm_alignr_epi8(hi, lo, 2));
+  _mm_storeu_si128((__m128i *)(dst + 3 * stride), _mm_alignr_epi8(hi, lo, 3));
+  _mm_storeu_si128((__m128i *)(dst + 4 * stride), _mm_alignr_epi8(hi, lo, 4));
+  _mm_storeu_si128((__m128i *)(dst + 5 * stride), _mm_alignr_epi8(hi, lo, 5));
+  _mm_storeu_si128((__m128i *)(dst + 6 * stride), _mm_alignr_epi8(hi, lo, 6));
+  _mm_storeu_si128((__m128i *)(dst + 7 * stride), _mm_alignr_epi8(hi, lo, 7));
+  _mm_storeu_si128((__m128i *)(dst + 8 * stride), _mm_alignr_epi8(hi, lo, 8));
+  _mm_storeu_si128((__m128i *)(dst + 9 * stride), _mm_alignr_epi8(hi, lo, 9));
+  _mm_storeu_si128((__m128i *)(dst + 10 * stride), _mm_alignr_epi8(hi, lo, 10));
+  _mm_storeu_si128((__m128i *)(dst + 11 * stride), _mm_alignr_epi8(hi, lo, 11));
+  _mm_storeu_si128((__m128i *)(dst + 12 * stride), _mm_alignr_epi8(hi, lo, 12));
+  _mm_storeu_si128((__m128i *)(dst + 13 * stride), _mm_alignr_epi8(hi, lo, 13));
+  _mm_storeu_si128((__m128i *)(dst + 14 * stride), _mm_alignr_epi8(hi, lo, 14));
+  _mm_storeu_si128((__m128i *)(dst + 15 * stride), _mm_alignr_epi8(hi, lo, 15));
+}
+
+// Store 8 rows of 16 pixels, row i holding the last i bytes of a followed by
+// the first 16 - i bytes of b.
+static INLINE void store_8_rows_back_128(uint8_t *dst, ptrdiff_t stride,
+                                         const __m128i a, const __m128i b) {
+  _mm_storeu_si128((__m128i *)dst, b);
+  _mm_storeu_si128((__m128i *)(dst + 1 * stride), _mm_alignr_epi8(b, a, 15));
+  _mm_storeu_si128((__m128i *)(dst + 2 * stride), _mm_alignr_epi8(b, a, 14));
+  _mm_storeu_si128((__m128i *)(dst + 3 * stride), _mm_alignr_epi8(b, a, 13));
+  _mm_storeu_si128((__m128i *)(dst + 4 * stride), _mm_alignr_epi8(b, a, 12));
+  _mm_storeu_si128((__m128i *)(dst + 5 * stride), _mm_alignr_epi8(b, a, 11));
+  _mm_storeu_si128((__m128i *)(dst + 6 * stride), _mm_alignr_epi8(b, a, 10));
+  _mm_storeu_si128((__m128i *)(dst + 7 * stride), _mm_alignr_epi8(b, a, 9));
+}
+
+// -----------------------------------------------------------------------------
+// DC_PRED
+
+static INLINE __m256i sum_32_avx2(const uint8_t *ref) {
+  const __m256i x = _mm256_loadu_si256((const __m256i *)ref);
+  return _mm256_sad_epu8(x, _mm256_setzero_si256());
+}
+
+static INLINE int horizontal_add_avx2(const __m256i sum) {
+  __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                            _mm256_extracti128_si256(sum, 1));
+  s = _mm_add_epi64(s, _mm_srli_si128(s, 8));
+  return _mm_cvtsi128_si32(s);
+}
+
+static INLINE void dc_store_32x32(uint8_t *dst, ptrdiff_t stride, int dc) {
+  const __m256i row = _mm256_set1_epi8((int8_t)dc);
+  int i;
+  for (i = 0; i < 32; ++i) {
+    _mm256_storeu_si256((__m256i *)dst, row);
+    dst += stride;
+  }
+}
+
+void vpx_dc_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                 const uint8_t *above, const uint8_t *left) {
+  const __m256i sum = _mm256_add_epi64(sum_32_avx2(above), sum_32_avx2(left));
+  dc_store_32x32(dst, stride, (horizontal_add_avx2(sum) + 32) >> 6);
+}
+
+void vpx_dc_top_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                     const uint8_t *above,
+                                     const uint8_t *left) {
+  (void)left;
+  dc_store_32x32(dst, stride,
+                 (horizontal_add_avx2(sum_32_avx2(above)) + 16) >> 5);
+}
+
+void vpx_dc_left_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                      const uint8_t *above,
+                                      const uint8_t *left) {
+  (void)above;
+  dc_store_32x32(dst, stride,
+                 (horizontal_add_avx2(sum_32_avx2(left)) + 16) >> 5);
+}
+
+void vpx_dc_128_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                     const uint8_t *above,
+                                     const uint8_t *left) {
+  (void)above;
+  (void)left;
+  dc_store_32x32(dst, stride, 128);
+}
+
+// -----------------------------------------------------------------------------
+// D45_PRED
+
+void vpx_d45_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i a1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i a2 = _mm256_loadu_si256((const __m256i *)(above + 2));
+  const __m256i above_right = _mm256_set1_epi8((int8_t)above[31]);
+  // The last pixel of the first row is above[31] itself, as is everything
+  // after it.
+  const __m256i border =
+      _mm256_insert_epi8(avg3_epu8_avx2(a0, a1, a2), (char)above[31], 31);
+  const __m256i mid = _mm256_permute2x128_si256(border, above_right, 0x21);
+  (void)left;
+
+  store_16_rows(dst, stride, border, mid);
+  store_16_rows(dst + 16 * stride, stride, mid, above_right);
+}
+
+// -----------------------------------------------------------------------------
+// D63_PRED
+
+void vpx_d63_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i a1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i a2 = _mm256_loadu_si256((const __m256i *)(above + 2));
+  const __m256i above_right = _mm256_set1_epi8((int8_t)above[31]);
+  const __m256i avg2 = _mm256_avg_epu8(a0, a1);
+  const __m256i avg3 = avg3_epu8_avx2(a0, a1, a2);
+  // The shifted copies of the first two rows are padded with above[31] from
+  // their last pixel on.
+  const __m256i avg2_border = _mm256_insert_epi8(avg2, (char)above[31], 31);
+  const __m256i avg3_border = _mm256_insert_epi8(avg3, (char)above[31], 31);
+  (void)left;
+
+  store_16_rows(dst, 2 * stride, avg2_border,
+                _mm256_permute2x128_si256(avg2_border, above_right, 0x21));
+  store_16_rows(dst + stride, 2 * stride, avg3_border,
+                _mm256_permute2x128_si256(avg3_border, above_right, 0x21));
+  // The first two rows keep their last pixel.
+  _mm256_storeu_si256((__m256i *)dst, avg2);
+  _mm256_storeu_si256((__m256i *)(dst + stride), avg3);
+}
+
+// -----------------------------------------------------------------------------
+// D117_PRED
+
+// The even and odd rows each shift right by one pixel every two rows, pulling
+// in the even and odd entries of the first column respectively.
+
+void vpx_d117_predictor_16x16_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m128i deinterleave =
+      _mm_setr_epi8(14, 12, 10, 8, 6, 4, 2, 0, 15, 13, 11, 9, 7, 5, 3, 1);
+  const __m128i am1 = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i a0 = _mm_loadu_si128((const __m128i *)above);
+  // above[-2] is taken to be left[0] for the first pixel of the second row.
+  const __m128i am2 = _mm_alignr_epi8(am1, last_byte(left[0]), 15);
+  const __m128i l0 = _mm_loadu_si128((const __m128i *)left);
+  const __m128i tl = last_byte(above[-1]);
+  // col[r] = AVG3(left[r - 3], left[r - 2], left[r - 1]), left[-1] being the
+  // top left pixel. Only r >= 2 is used.
+  const __m128i col = avg3_epu8(_mm_alignr_epi8(l0, tl, 13),
+                                _mm_alignr_epi8(l0, tl, 14),
+                                _mm_alignr_epi8(l0, tl, 15));
+  // The even entries in descending order, then the odd ones.
+  const __m128i col_desc = _mm_shuffle_epi8(col, deinterleave);
+
+  store_8_rows_back_128(dst, 2 * stride, _mm_slli_si128(col_desc, 9),
+                        _mm_avg_epu8(am1, a0));
+  store_8_rows_back_128(dst + stride, 2 * stride, _mm_slli_si128(col_desc, 1),
+                        avg3_epu8(am2, am1, a0));
+}
+
+void vpx_d117_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m256i deinterleave =
+      _mm256_setr_epi8(14, 12, 10, 8, 6, 4, 2, 0, 15, 13, 11, 9, 7, 5, 3, 1,
+                       14, 12, 10, 8, 6, 4, 2, 0, 15, 13, 11, 9, 7, 5, 3, 1);
+  const __m256i am1 = _mm256_loadu_si256((const __m256i *)(above - 1));
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i am2 =
+      _mm256_alignr_epi8(am1, combine_lo(last_byte(left[0]), am1), 15);
+  const __m256i l0 = _mm256_loadu_si256((const __m256i *)left);
+  const __m256i tl = combine_lo(last_byte(above[-1]), l0);
+  const __m256i col = avg3_epu8_avx2(_mm256_alignr_epi8(l0, tl, 13),
+                                     _mm256_alignr_epi8(l0, tl, 14),
+                                     _mm256_alignr_epi8(l0, tl, 15));
+  // Even entries in descending order in the low lane, odd ones in the high.
+  const __m256i col_desc =
+      _mm256_permute4x64_epi64(_mm256_shuffle_epi8(col, deinterleave), 0x72);
+  const __m256i even = _mm256_avg_epu8(am1, a0);
+  const __m256i odd = avg3_epu8_avx2(am2, am1, a0);
+
+  store_16_rows_back(
+      dst, 2 * stride,
+      combine_lo(_mm_slli_si128(_mm256_castsi256_si128(col_desc), 1), even),
+      even);
+  store_16_rows_back(
+      dst + stride, 2 * stride,
+      combine_lo(_mm_slli_si128(_mm256_extracti128_si256(col_desc, 1), 1), odd),
+      odd);
+}
+
+// -----------------------------------------------------------------------------
+// D135_PRED
+
+// The border runs from the bottom left pixel up the left column, through the
+// top left pixel and along the top row: each entry is the AVG3 of three
+// neighbours of that sequence. Row r starts bs - 1 - r pixels in, so the rows
+// are stored from the bottom up.
+
+void vpx_d135_predictor_16x16_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+                                    3, 2, 1, 0);
+  const __m128i l_desc =
+      _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)left), rev);
+  const __m128i am1 = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i a0 = _mm_loadu_si128((const __m128i *)above);
+  const __m128i a1 = _mm_loadu_si128((const __m128i *)(above + 1));
+  const __m256i x0 =
+      _mm256_inserti128_si256(_mm256_castsi128_si256(l_desc), am1, 1);
+  const __m256i x1 = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_alignr_epi8(am1, l_desc, 1)), a0, 1);
+  const __m256i x2 = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_alignr_epi8(am1, l_desc, 2)), a1, 1);
+  const __m256i border = avg3_epu8_avx2(x0, x1, x2);
+
+  store_16_rows_128(dst + 15 * stride, -stride, _mm256_castsi256_si128(border),
+                    _mm256_extracti128_si256(border, 1));
+}
+
+void vpx_d135_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m256i l_desc =
+      reverse_epi8_avx2(_mm256_loadu_si256((const __m256i *)left));
+  const __m256i am1 = _mm256_loadu_si256((const __m256i *)(above - 1));
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i a1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i b0 = avg3_epu8_avx2(l_desc, next_1_avx2(l_desc, am1),
+                                    next_2_avx2(l_desc, am1));
+  const __m256i b1 = avg3_epu8_avx2(am1, a0, a1);
+  const __m256i mid = _mm256_permute2x128_si256(b0, b1, 0x21);
+
+  dst += 31 * stride;
+  store_16_rows(dst, -stride, b0, mid);
+  store_16_rows(dst - 16 * stride, -stride, mid, b1);
+}
+
+// -----------------------------------------------------------------------------
+// D153_PRED
+
+void vpx_d153_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  // The border holds the (AVG2, AVG3) pairs of the first two columns from the
+  // bottom row up, followed by the rest of the first row. Row r starts two
+  // pixels further right than row r + 1.
+  const __m256i rev_pairs =
+      _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                       14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  const __m256i l0 = _mm256_loadu_si256((const __m256i *)left);
+  // left[-1] is the top left pixel and left[-2] above[0], which gives the
+  // AVG3 of the first row.
+  const __m256i edge = combine_lo(
+      _mm_slli_si128(_mm_cvtsi32_si128(above[0] | (above[-1] << 8)), 14), l0);
+  const __m256i lm1 = _mm256_alignr_epi8(l0, edge, 15);
+  const __m256i lm2 = _mm256_alignr_epi8(l0, edge, 14);
+  const __m256i avg2 = _mm256_avg_epu8(lm1, l0);
+  const __m256i avg3 = avg3_epu8_avx2(lm2, lm1, l0);
+  const __m256i lo = _mm256_unpacklo_epi8(avg2, avg3);
+  const __m256i hi = _mm256_unpackhi_epi8(avg2, avg3);
+  const __m256i am1 = _mm256_loadu_si256((const __m256i *)(above - 1));
+  const __m256i a0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i a1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i b0 = _mm256_permute4x64_epi64(
+      _mm256_shuffle_epi8(_mm256_permute2x128_si256(lo, hi, 0x31), rev_pairs),
+      0x4e);
+  const __m256i b1 = _mm256_permute4x64_epi64(
+      _mm256_shuffle_epi8(_mm256_permute2x128_si256(lo, hi, 0x20), rev_pairs),
+      0x4e);
+  const __m256i b2 = avg3_epu8_avx2(am1, a0, a1);
+  const __m256i mid0 = _mm256_permute2x128_si256(b0, b1, 0x21);
+  const __m256i mid1 = _mm256_permute2x128_si256(b1, b2, 0x21);
+
+  dst += 31 * stride;
+  store_8_rows_step_2(dst, -stride, b0, mid0);
+  store_8_rows_step_2(dst - 8 * stride, -stride, mid0, b1);
+  store_8_rows_step_2(dst - 16 * stride, -stride, b1, mid1);
+  store_8_rows_step_2(dst - 24 * stride, -stride, mid1, b2);
+}
+
+// -----------------------------------------------------------------------------
+// D207_PRED
+
+void vpx_d207_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  // The border interleaves the AVG2 and AVG3 columns and is padded with
+  // left[31]. Row r starts 2 * r pixels in.
+  const __m256i l0 = _mm256_loadu_si256((const __m256i *)left);
+  const __m256i bottom = _mm256_set1_epi8((int8_t)left[31]);
+  const __m256i l1 = next_1_avx2(l0, bottom);
+  const __m256i l2 = next_2_avx2(l0, bottom);
+  const __m256i avg2 = _mm256_avg_epu8(l0, l1);
+  const __m256i avg3 = avg3_epu8_avx2(l0, l1, l2);
+  const __m256i lo = _mm256_unpacklo_epi8(avg2, avg3);
+  const __m256i hi = _mm256_unpackhi_epi8(avg2, avg3);
+  const __m256i b0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+  const __m256i b1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+  const __m256i mid0 = _mm256_permute2x128_si256(b0, b1, 0x21);
+  const __m256i mid1 = _mm256_permute2x128_si256(b1, bottom, 0x21);
+  (void)above;
+
+  store_8_rows_step_2(dst, stride, b0, mid0);
+  store_8_rows_step_2(dst + 8 * stride, stride, mid0, b1);
+  store_8_rows_step_2(dst + 16 * stride, stride, b1, mid1);
+  store_8_rows_step_2(dst + 24 * stride, stride, mid1, bottom);
+}
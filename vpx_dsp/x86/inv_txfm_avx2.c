@@ -0,0 +1,869 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+#include "vpx_dsp/x86/inv_txfm_sse2.h"
+#include "vpx_dsp/x86/transpose_sse2.h"
+
+static INLINE void idct16_16col_avx2(const __m256i *const in /*in[16]*/,
+                                     __m256i *const out /*out[16]*/) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[1], in[15], cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(in[9], in[7], cospi_14_64, cospi_18_64, &step2[9], &step2[14]);
+  butterfly_avx2(in[5], in[11], cospi_22_64, cospi_10_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(in[13], in[3], cospi_6_64, cospi_26_64, &step2[11],
+                 &step2[12]);
+
+  // stage 3
+  butterfly_avx2(in[2], in[14], cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+  butterfly_avx2(in[10], in[6], cospi_12_64, cospi_20_64, &step1[5], &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[10], step2[11]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[14], step2[15]);
+
+  // stage 4
+  butterfly_avx2(in[0], in[8], cospi_16_64, cospi_16_64, &step2[1], &step2[0]);
+  butterfly_avx2(in[4], in[12], cospi_24_64, cospi_8_64, &step2[2], &step2[3]);
+  butterfly_avx2(step1[14], step1[9], cospi_24_64, cospi_8_64, &step2[9],
+            &step2[14]);
+  butterfly_avx2(step1[10], step1[13], -cospi_8_64, -cospi_24_64, &step2[13],
+            &step2[10]);
+  step2[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step1[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step1[7] = _mm256_add_epi16(step1[6], step1[7]);
+  step2[8] = step1[8];
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+  step2[15] = step1[15];
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi16(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi16(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi16(step2[0], step2[3]);
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[12]);
+
+  // stage 6
+  step2[0] = _mm256_add_epi16(step1[0], step1[7]);
+  step2[1] = _mm256_add_epi16(step1[1], step1[6]);
+  step2[2] = _mm256_add_epi16(step1[2], step1[5]);
+  step2[3] = _mm256_add_epi16(step1[3], step1[4]);
+  step2[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  step2[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  step2[7] = _mm256_sub_epi16(step1[0], step1[7]);
+  butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64, &step2[10],
+            &step2[13]);
+  butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64, &step2[11],
+            &step2[12]);
+
+  // stage 7
+  out[0] = _mm256_add_epi16(step2[0], step1[15]);
+  out[1] = _mm256_add_epi16(step2[1], step1[14]);
+  out[2] = _mm256_add_epi16(step2[2], step2[13]);
+  out[3] = _mm256_add_epi16(step2[3], step2[12]);
+  out[4] = _mm256_add_epi16(step2[4], step2[11]);
+  out[5] = _mm256_add_epi16(step2[5], step2[10]);
+  out[6] = _mm256_add_epi16(step2[6], step1[9]);
+  out[7] = _mm256_add_epi16(step2[7], step1[8]);
+  out[8] = _mm256_sub_epi16(step2[7], step1[8]);
+  out[9] = _mm256_sub_epi16(step2[6], step1[9]);
+  out[10] = _mm256_sub_epi16(step2[5], step2[10]);
+  out[11] = _mm256_sub_epi16(step2[4], step2[11]);
+  out[12] = _mm256_sub_epi16(step2[3], step2[12]);
+  out[13] = _mm256_sub_epi16(step2[2], step2[13]);
+  out[14] = _mm256_sub_epi16(step2[1], step1[14]);
+  out[15] = _mm256_sub_epi16(step2[0], step1[15]);
+}
+
+// 16-point 1-D IDCT of 16 columns when only in[0] to in[3] are non-zero.
+static INLINE void idct16_10_16col_avx2(const __m256i *const in /*in[4]*/,
+                                        __m256i *const out /*out[16]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[1], zero, cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(zero, in[3], cospi_6_64, cospi_26_64, &step2[11], &step2[12]);
+
+  // stage 3
+  butterfly_avx2(in[2], zero, cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+
+  // stage 4
+  step1[0] = butterfly_cospi16_avx2(in[0]);
+  butterfly_avx2(step2[15], step2[8], cospi_24_64, cospi_8_64, &step2[9],
+                 &step2[14]);
+  butterfly_avx2(step2[11], step2[12], -cospi_8_64, -cospi_24_64, &step2[13],
+                 &step2[10]);
+
+  // stage 5
+  butterfly_avx2(step1[7], step1[4], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[12]);
+
+  // stage 6
+  step2[0] = _mm256_add_epi16(step1[0], step1[7]);
+  step2[1] = _mm256_add_epi16(step1[0], step1[6]);
+  step2[2] = _mm256_add_epi16(step1[0], step1[5]);
+  step2[3] = _mm256_add_epi16(step1[0], step1[4]);
+  step2[4] = _mm256_sub_epi16(step1[0], step1[4]);
+  step2[5] = _mm256_sub_epi16(step1[0], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[0], step1[6]);
+  step2[7] = _mm256_sub_epi16(step1[0], step1[7]);
+  butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64, &step2[11],
+                 &step2[12]);
+
+  // stage 7
+  out[0] = _mm256_add_epi16(step2[0], step1[15]);
+  out[1] = _mm256_add_epi16(step2[1], step1[14]);
+  out[2] = _mm256_add_epi16(step2[2], step2[13]);
+  out[3] = _mm256_add_epi16(step2[3], step2[12]);
+  out[4] = _mm256_add_epi16(step2[4], step2[11]);
+  out[5] = _mm256_add_epi16(step2[5], step2[10]);
+  out[6] = _mm256_add_epi16(step2[6], step1[9]);
+  out[7] = _mm256_add_epi16(step2[7], step1[8]);
+  out[8] = _mm256_sub_epi16(step2[7], step1[8]);
+  out[9] = _mm256_sub_epi16(step2[6], step1[9]);
+  out[10] = _mm256_sub_epi16(step2[5], step2[10]);
+  out[11] = _mm256_sub_epi16(step2[4], step2[11]);
+  out[12] = _mm256_sub_epi16(step2[3], step2[12]);
+  out[13] = _mm256_sub_epi16(step2[2], step2[13]);
+  out[14] = _mm256_sub_epi16(step2[1], step1[14]);
+  out[15] = _mm256_sub_epi16(step2[0], step1[15]);
+}
+
+void idct16_avx2(__m256i *const in /*in[16]*/) {
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_16col_avx2(in, in);
+}
+
+static INLINE void load_buffer_16x16_avx2(const tran_low_t *const input,
+                                          const int rows, __m256i *const in) {
+  int i;
+  for (i = 0; i < rows; ++i) in[i] = load_input_data16_avx2(input + i * 16);
+  for (; i < 16; ++i) in[i] = _mm256_setzero_si256();
+}
+
+static INLINE void write_buffer_16x16_avx2(const __m256i *const in,
+                                           uint8_t *const dest,
+                                           const int stride) {
+  int i;
+  for (i = 0; i < 16; ++i) write_buffer_16x1_avx2(dest + i * stride, in[i]);
+}
+
+void vpx_idct16x16_256_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride) {
+  __m256i in[16];
+
+  load_buffer_16x16_avx2(input, 16, in);
+  idct16_avx2(in);
+  idct16_avx2(in);
+  write_buffer_16x16_avx2(in, dest, stride);
+}
+
+// Only the upper-left 8x8 coefficients are non-zero, so skip loading the
+// bottom half. The lanes cost the same whether they are zero or not.
+void vpx_idct16x16_38_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride) {
+  __m256i in[16];
+
+  load_buffer_16x16_avx2(input, 8, in);
+  idct16_avx2(in);
+  idct16_avx2(in);
+  write_buffer_16x16_avx2(in, dest, stride);
+}
+
+// Only the upper-left 4x4 coefficients are non-zero, so only 4 of the rows
+// need transposing on the way into each pass.
+void vpx_idct16x16_10_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i io[4], l[8], r[8];
+  __m256i in[16];
+  int i;
+
+  // First 1-D inverse DCT
+  io[0] = load_input_data4(input + 0 * 16);
+  io[1] = load_input_data4(input + 1 * 16);
+  io[2] = load_input_data4(input + 2 * 16);
+  io[3] = load_input_data4(input + 3 * 16);
+  transpose_16bit_4x4(io, io);
+  // io[0]: 00 10 20 30  01 11 21 31
+  // io[1]: 02 12 22 32  03 13 23 33
+  in[0] = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                                  _mm_unpacklo_epi64(io[0], zero), 0);
+  in[1] = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                                  _mm_unpackhi_epi64(io[0], zero), 0);
+  in[2] = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                                  _mm_unpacklo_epi64(io[1], zero), 0);
+  in[3] = _mm256_inserti128_si256(_mm256_setzero_si256(),
+                                  _mm_unpackhi_epi64(io[1], zero), 0);
+  idct16_10_16col_avx2(in, in);
+
+  // Second 1-D inverse DCT. Only the first 4 lanes of each output are
+  // non-zero.
+  for (i = 0; i < 8; ++i) {
+    l[i] = _mm256_castsi256_si128(in[i]);
+    r[i] = _mm256_castsi256_si128(in[i + 8]);
+  }
+  transpose_16bit_4x8(l, l);
+  transpose_16bit_4x8(r, r);
+  for (i = 0; i < 4; ++i) {
+    in[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(l[i]), r[i], 1);
+  }
+  idct16_10_16col_avx2(in, in);
+
+  write_buffer_16x16_avx2(in, dest, stride);
+}
+
+// Multiply the interleaved elements of in0 and in1 by (c0, c1) and add them
+// together, leaving 32-bit sums.
+static INLINE void madd_avx2(const __m256i in0, const __m256i in1,
+                             const int c0, const int c1,
+                             __m256i *const out /*out[2]*/) {
+  const __m256i cst = pair256_set_epi16(c0, c1);
+  out[0] = _mm256_madd_epi16(_mm256_unpacklo_epi16(in0, in1), cst);
+  out[1] = _mm256_madd_epi16(_mm256_unpackhi_epi16(in0, in1), cst);
+}
+
+static INLINE __m256i add_round_shift_pack_avx2(const __m256i *const a,
+                                                const __m256i *const b) {
+  const __m256i t0 = dct_const_round_shift_avx2(_mm256_add_epi32(a[0], b[0]));
+  const __m256i t1 = dct_const_round_shift_avx2(_mm256_add_epi32(a[1], b[1]));
+  return _mm256_packs_epi32(t0, t1);
+}
+
+static INLINE __m256i sub_round_shift_pack_avx2(const __m256i *const a,
+                                                const __m256i *const b) {
+  const __m256i t0 = dct_const_round_shift_avx2(_mm256_sub_epi32(a[0], b[0]));
+  const __m256i t1 = dct_const_round_shift_avx2(_mm256_sub_epi32(a[1], b[1]));
+  return _mm256_packs_epi32(t0, t1);
+}
+
+// 16-point 1-D ADST of 16 columns, following vpx_iadst16_8col_sse2(). The
+// forward ADST has the same flow graph, so the encoder uses this as well.
+void adst16_16col_avx2(__m256i *const in /*in[16]*/) {
+  __m256i s[16], x[16], a[8][2], b[8][2];
+  int i;
+
+  // stage 1
+  madd_avx2(in[15], in[0], cospi_1_64, cospi_31_64, a[0]);
+  madd_avx2(in[15], in[0], cospi_31_64, -cospi_1_64, b[0]);
+  madd_avx2(in[13], in[2], cospi_5_64, cospi_27_64, a[1]);
+  madd_avx2(in[13], in[2], cospi_27_64, -cospi_5_64, b[1]);
+  madd_avx2(in[11], in[4], cospi_9_64, cospi_23_64, a[2]);
+  madd_avx2(in[11], in[4], cospi_23_64, -cospi_9_64, b[2]);
+  madd_avx2(in[9], in[6], cospi_13_64, cospi_19_64, a[3]);
+  madd_avx2(in[9], in[6], cospi_19_64, -cospi_13_64, b[3]);
+  madd_avx2(in[7], in[8], cospi_17_64, cospi_15_64, a[4]);
+  madd_avx2(in[7], in[8], cospi_15_64, -cospi_17_64, b[4]);
+  madd_avx2(in[5], in[10], cospi_21_64, cospi_11_64, a[5]);
+  madd_avx2(in[5], in[10], cospi_11_64, -cospi_21_64, b[5]);
+  madd_avx2(in[3], in[12], cospi_25_64, cospi_7_64, a[6]);
+  madd_avx2(in[3], in[12], cospi_7_64, -cospi_25_64, b[6]);
+  madd_avx2(in[1], in[14], cospi_29_64, cospi_3_64, a[7]);
+  madd_avx2(in[1], in[14], cospi_3_64, -cospi_29_64, b[7]);
+
+  for (i = 0; i < 4; ++i) {
+    s[2 * i] = add_round_shift_pack_avx2(a[i], a[i + 4]);
+    s[2 * i + 1] = add_round_shift_pack_avx2(b[i], b[i + 4]);
+    s[2 * i + 8] = sub_round_shift_pack_avx2(a[i], a[i + 4]);
+    s[2 * i + 9] = sub_round_shift_pack_avx2(b[i], b[i + 4]);
+  }
+
+  // stage 2
+  madd_avx2(s[8], s[9], cospi_4_64, cospi_28_64, a[0]);
+  madd_avx2(s[8], s[9], cospi_28_64, -cospi_4_64, b[0]);
+  madd_avx2(s[10], s[11], cospi_20_64, cospi_12_64, a[1]);
+  madd_avx2(s[10], s[11], cospi_12_64, -cospi_20_64, b[1]);
+  madd_avx2(s[12], s[13], -cospi_28_64, cospi_4_64, a[2]);
+  madd_avx2(s[12], s[13], cospi_4_64, cospi_28_64, b[2]);
+  madd_avx2(s[14], s[15], -cospi_12_64, cospi_20_64, a[3]);
+  madd_avx2(s[14], s[15], cospi_20_64, cospi_12_64, b[3]);
+
+  for (i = 0; i < 4; ++i) {
+    x[i] = _mm256_add_epi16(s[i], s[i + 4]);
+    x[i + 4] = _mm256_sub_epi16(s[i], s[i + 4]);
+  }
+  x[8] = add_round_shift_pack_avx2(a[0], a[2]);
+  x[9] = add_round_shift_pack_avx2(b[0], b[2]);
+  x[10] = add_round_shift_pack_avx2(a[1], a[3]);
+  x[11] = add_round_shift_pack_avx2(b[1], b[3]);
+  x[12] = sub_round_shift_pack_avx2(a[0], a[2]);
+  x[13] = sub_round_shift_pack_avx2(b[0], b[2]);
+  x[14] = sub_round_shift_pack_avx2(a[1], a[3]);
+  x[15] = sub_round_shift_pack_avx2(b[1], b[3]);
+
+  // stage 3
+  madd_avx2(x[4], x[5], cospi_8_64, cospi_24_64, a[0]);
+  madd_avx2(x[4], x[5], cospi_24_64, -cospi_8_64, b[0]);
+  madd_avx2(x[6], x[7], -cospi_24_64, cospi_8_64, a[1]);
+  madd_avx2(x[6], x[7], cospi_8_64, cospi_24_64, b[1]);
+  madd_avx2(x[12], x[13], cospi_8_64, cospi_24_64, a[2]);
+  madd_avx2(x[12], x[13], cospi_24_64, -cospi_8_64, b[2]);
+  madd_avx2(x[14], x[15], -cospi_24_64, cospi_8_64, a[3]);
+  madd_avx2(x[14], x[15], cospi_8_64, cospi_24_64, b[3]);
+
+  s[0] = _mm256_add_epi16(x[0], x[2]);
+  s[1] = _mm256_add_epi16(x[1], x[3]);
+  s[2] = _mm256_sub_epi16(x[0], x[2]);
+  s[3] = _mm256_sub_epi16(x[1], x[3]);
+  s[4] = add_round_shift_pack_avx2(a[0], a[1]);
+  s[5] = add_round_shift_pack_avx2(b[0], b[1]);
+  s[6] = sub_round_shift_pack_avx2(a[0], a[1]);
+  s[7] = sub_round_shift_pack_avx2(b[0], b[1]);
+  s[8] = _mm256_add_epi16(x[8], x[10]);
+  s[9] = _mm256_add_epi16(x[9], x[11]);
+  s[10] = _mm256_sub_epi16(x[8], x[10]);
+  s[11] = _mm256_sub_epi16(x[9], x[11]);
+  s[12] = add_round_shift_pack_avx2(a[2], a[3]);
+  s[13] = add_round_shift_pack_avx2(b[2], b[3]);
+  s[14] = sub_round_shift_pack_avx2(a[2], a[3]);
+  s[15] = sub_round_shift_pack_avx2(b[2], b[3]);
+
+  // stage 4
+  in[7] = madd_round_shift_pack_avx2(s[2], s[3], -cospi_16_64, -cospi_16_64);
+  in[8] = madd_round_shift_pack_avx2(s[2], s[3], cospi_16_64, -cospi_16_64);
+  in[4] = madd_round_shift_pack_avx2(s[6], s[7], cospi_16_64, cospi_16_64);
+  in[11] = madd_round_shift_pack_avx2(s[6], s[7], -cospi_16_64, cospi_16_64);
+  in[6] = madd_round_shift_pack_avx2(s[10], s[11], cospi_16_64, cospi_16_64);
+  in[9] = madd_round_shift_pack_avx2(s[10], s[11], -cospi_16_64, cospi_16_64);
+  in[5] = madd_round_shift_pack_avx2(s[14], s[15], -cospi_16_64, -cospi_16_64);
+  in[10] = madd_round_shift_pack_avx2(s[14], s[15], cospi_16_64, -cospi_16_64);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi16(_mm256_setzero_si256(), s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi16(_mm256_setzero_si256(), s[4]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi16(_mm256_setzero_si256(), s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi16(_mm256_setzero_si256(), s[1]);
+}
+
+void iadst16_avx2(__m256i *const in /*in[16]*/) {
+  transpose_16bit_16x16_avx2(in, in);
+  adst16_16col_avx2(in);
+}
+
+// Only do addition and subtraction butterfly, size = 16, 32
+static INLINE void add_sub_butterfly_avx2(const __m256i *in, __m256i *out,
+                                          int size) {
+  int i = 0;
+  const int num = size >> 1;
+  const int bound = size - 1;
+  while (i < num) {
+    out[i] = _mm256_add_epi16(in[i], in[bound - i]);
+    out[bound - i] = _mm256_sub_epi16(in[i], in[bound - i]);
+    i++;
+  }
+}
+
+// Group the coefficient calculation into smaller functions to prevent stack
+// spillover in 32x32 idct optimizations:
+// quarter_1: 0-7
+// quarter_2: 8-15
+// quarter_3_4: 16-23, 24-31
+
+static INLINE void idct32_16x32_quarter_2_stage_4_to_6_avx2(
+    __m256i *const step1 /*step1[16]*/, __m256i *const out /*out[16]*/) {
+  __m256i step2[32];
+
+  // stage 4
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  butterfly_avx2(step1[14], step1[9], cospi_24_64, cospi_8_64, &step2[9],
+            &step2[14]);
+  butterfly_avx2(step1[13], step1[10], -cospi_8_64, cospi_24_64, &step2[10],
+            &step2[13]);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+
+  // stage 5
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[12]);
+
+  // stage 6
+  out[8] = step1[8];
+  out[9] = step1[9];
+  butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64, &out[10],
+                 &out[13]);
+  butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64, &out[11],
+                 &out[12]);
+  out[14] = step1[14];
+  out[15] = step1[15];
+}
+
+static INLINE void idct32_16x32_quarter_3_4_stage_4_to_7_avx2(
+    __m256i *const step1 /*step1[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i step2[32];
+
+  // stage 4
+  step2[16] = _mm256_add_epi16(step1[16], step1[19]);
+  step2[17] = _mm256_add_epi16(step1[17], step1[18]);
+  step2[18] = _mm256_sub_epi16(step1[17], step1[18]);
+  step2[19] = _mm256_sub_epi16(step1[16], step1[19]);
+  step2[20] = _mm256_sub_epi16(step1[23], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[22], step1[21]);
+  step2[22] = _mm256_add_epi16(step1[22], step1[21]);
+  step2[23] = _mm256_add_epi16(step1[23], step1[20]);
+
+  step2[24] = _mm256_add_epi16(step1[24], step1[27]);
+  step2[25] = _mm256_add_epi16(step1[25], step1[26]);
+  step2[26] = _mm256_sub_epi16(step1[25], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[24], step1[27]);
+  step2[28] = _mm256_sub_epi16(step1[31], step1[28]);
+  step2[29] = _mm256_sub_epi16(step1[30], step1[29]);
+  step2[30] = _mm256_add_epi16(step1[29], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[28], step1[31]);
+
+  // stage 5
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  butterfly_avx2(step2[29], step2[18], cospi_24_64, cospi_8_64, &step1[18],
+            &step1[29]);
+  butterfly_avx2(step2[28], step2[19], cospi_24_64, cospi_8_64, &step1[19],
+            &step1[28]);
+  butterfly_avx2(step2[27], step2[20], -cospi_8_64, cospi_24_64, &step1[20],
+            &step1[27]);
+  butterfly_avx2(step2[26], step2[21], -cospi_8_64, cospi_24_64, &step1[21],
+            &step1[26]);
+  step1[22] = step2[22];
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[25] = step2[25];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // stage 6
+  out[16] = _mm256_add_epi16(step1[16], step1[23]);
+  out[17] = _mm256_add_epi16(step1[17], step1[22]);
+  out[18] = _mm256_add_epi16(step1[18], step1[21]);
+  out[19] = _mm256_add_epi16(step1[19], step1[20]);
+  step2[20] = _mm256_sub_epi16(step1[19], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[18], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[17], step1[22]);
+  step2[23] = _mm256_sub_epi16(step1[16], step1[23]);
+
+  step2[24] = _mm256_sub_epi16(step1[31], step1[24]);
+  step2[25] = _mm256_sub_epi16(step1[30], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[29], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[28], step1[27]);
+  out[28] = _mm256_add_epi16(step1[27], step1[28]);
+  out[29] = _mm256_add_epi16(step1[26], step1[29]);
+  out[30] = _mm256_add_epi16(step1[25], step1[30]);
+  out[31] = _mm256_add_epi16(step1[24], step1[31]);
+
+  // stage 7
+  butterfly_avx2(step2[27], step2[20], cospi_16_64, cospi_16_64, &out[20],
+                 &out[27]);
+  butterfly_avx2(step2[26], step2[21], cospi_16_64, cospi_16_64, &out[21],
+                 &out[26]);
+  butterfly_avx2(step2[25], step2[22], cospi_16_64, cospi_16_64, &out[22],
+                 &out[25]);
+  butterfly_avx2(step2[24], step2[23], cospi_16_64, cospi_16_64, &out[23],
+                 &out[24]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 0, 4, 8, 12, 16, 20, 24, 28
+// output pixels: 0-7 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_1_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[8]*/) {
+  __m256i step1[8], step2[8];
+
+  // stage 3
+  butterfly_avx2(in[4], in[28], cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+  butterfly_avx2(in[20], in[12], cospi_12_64, cospi_20_64, &step1[5],
+                 &step1[6]);
+
+  // stage 4
+  butterfly_avx2(in[0], in[16], cospi_16_64, cospi_16_64, &step2[1], &step2[0]);
+  butterfly_avx2(in[8], in[24], cospi_24_64, cospi_8_64, &step2[2], &step2[3]);
+  step2[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step2[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step2[7] = _mm256_add_epi16(step1[7], step1[6]);
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi16(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi16(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi16(step2[0], step2[3]);
+  step1[4] = step2[4];
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[7] = step2[7];
+
+  // stage 6
+  out[0] = _mm256_add_epi16(step1[0], step1[7]);
+  out[1] = _mm256_add_epi16(step1[1], step1[6]);
+  out[2] = _mm256_add_epi16(step1[2], step1[5]);
+  out[3] = _mm256_add_epi16(step1[3], step1[4]);
+  out[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  out[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  out[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  out[7] = _mm256_sub_epi16(step1[0], step1[7]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 2, 6, 10, 14, 18, 22, 26, 30
+// output pixels: 8-15 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_2_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[16]*/) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[2], in[30], cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(in[18], in[14], cospi_14_64, cospi_18_64, &step2[9],
+                 &step2[14]);
+  butterfly_avx2(in[10], in[22], cospi_22_64, cospi_10_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(in[26], in[6], cospi_6_64, cospi_26_64, &step2[11],
+                 &step2[12]);
+
+  // stage 3
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[11], step2[10]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[14]);
+
+  idct32_16x32_quarter_2_stage_4_to_6_avx2(step1, out);
+}
+
+static INLINE void idct32_1024_16x32_quarter_1_2_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i temp[16];
+  idct32_1024_16x32_quarter_1_avx2(in, temp);
+  idct32_1024_16x32_quarter_2_avx2(in, temp);
+  // stage 7
+  add_sub_butterfly_avx2(temp, out, 16);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with odd index,
+// 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31
+// output pixels: 16-23, 24-31 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_3_4_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i step1[32], step2[32];
+
+  // stage 1
+  butterfly_avx2(in[1], in[31], cospi_31_64, cospi_1_64, &step1[16],
+                 &step1[31]);
+  butterfly_avx2(in[17], in[15], cospi_15_64, cospi_17_64, &step1[17],
+                 &step1[30]);
+  butterfly_avx2(in[9], in[23], cospi_23_64, cospi_9_64, &step1[18],
+                 &step1[29]);
+  butterfly_avx2(in[25], in[7], cospi_7_64, cospi_25_64, &step1[19],
+                 &step1[28]);
+
+  butterfly_avx2(in[5], in[27], cospi_27_64, cospi_5_64, &step1[20],
+                 &step1[27]);
+  butterfly_avx2(in[21], in[11], cospi_11_64, cospi_21_64, &step1[21],
+                 &step1[26]);
+
+  butterfly_avx2(in[13], in[19], cospi_19_64, cospi_13_64, &step1[22],
+                 &step1[25]);
+  butterfly_avx2(in[29], in[3], cospi_3_64, cospi_29_64, &step1[23],
+                 &step1[24]);
+
+  // stage 2
+  step2[16] = _mm256_add_epi16(step1[16], step1[17]);
+  step2[17] = _mm256_sub_epi16(step1[16], step1[17]);
+  step2[18] = _mm256_sub_epi16(step1[19], step1[18]);
+  step2[19] = _mm256_add_epi16(step1[19], step1[18]);
+  step2[20] = _mm256_add_epi16(step1[20], step1[21]);
+  step2[21] = _mm256_sub_epi16(step1[20], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[23], step1[22]);
+  step2[23] = _mm256_add_epi16(step1[23], step1[22]);
+
+  step2[24] = _mm256_add_epi16(step1[24], step1[25]);
+  step2[25] = _mm256_sub_epi16(step1[24], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[27], step1[26]);
+  step2[27] = _mm256_add_epi16(step1[27], step1[26]);
+  step2[28] = _mm256_add_epi16(step1[28], step1[29]);
+  step2[29] = _mm256_sub_epi16(step1[28], step1[29]);
+  step2[30] = _mm256_sub_epi16(step1[31], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[31], step1[30]);
+
+  // stage 3
+  step1[16] = step2[16];
+  step1[31] = step2[31];
+  butterfly_avx2(step2[30], step2[17], cospi_28_64, cospi_4_64, &step1[17],
+            &step1[30]);
+  butterfly_avx2(step2[29], step2[18], -cospi_4_64, cospi_28_64, &step1[18],
+            &step1[29]);
+  step1[19] = step2[19];
+  step1[20] = step2[20];
+  butterfly_avx2(step2[26], step2[21], cospi_12_64, cospi_20_64, &step1[21],
+            &step1[26]);
+  butterfly_avx2(step2[25], step2[22], -cospi_20_64, cospi_12_64, &step1[22],
+            &step1[25]);
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[27] = step2[27];
+  step1[28] = step2[28];
+
+  idct32_16x32_quarter_3_4_stage_4_to_7_avx2(step1, out);
+}
+
+static void idct32_1024_16x32_avx2(const __m256i *const in /*in[32]*/,
+                                   __m256i *const out /*out[32]*/) {
+  __m256i temp[32];
+
+  idct32_1024_16x32_quarter_1_2_avx2(in, temp);
+  idct32_1024_16x32_quarter_3_4_avx2(in, temp);
+  // final stage
+  add_sub_butterfly_avx2(temp, out, 32);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 0, 4
+// output pixels: 0-7 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_1_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[8]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[8], step2[8];
+
+  // stage 3
+  butterfly_avx2(in[4], zero, cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+
+  // stage 4
+  step2[0] = butterfly_cospi16_avx2(in[0]);
+  step2[4] = step1[4];
+  step2[5] = step1[4];
+  step2[6] = step1[7];
+  step2[7] = step1[7];
+
+  // stage 5
+  step1[0] = step2[0];
+  step1[1] = step2[0];
+  step1[2] = step2[0];
+  step1[3] = step2[0];
+  step1[4] = step2[4];
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[7] = step2[7];
+
+  // stage 6
+  out[0] = _mm256_add_epi16(step1[0], step1[7]);
+  out[1] = _mm256_add_epi16(step1[1], step1[6]);
+  out[2] = _mm256_add_epi16(step1[2], step1[5]);
+  out[3] = _mm256_add_epi16(step1[3], step1[4]);
+  out[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  out[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  out[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  out[7] = _mm256_sub_epi16(step1[0], step1[7]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 2, 6
+// output pixels: 8-15 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_2_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[16]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[2], zero, cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(zero, in[6], cospi_6_64, cospi_26_64, &step2[11], &step2[12]);
+
+  // stage 3
+  step1[8] = step2[8];
+  step1[9] = step2[8];
+  step1[14] = step2[15];
+  step1[15] = step2[15];
+  step1[10] = step2[11];
+  step1[11] = step2[11];
+  step1[12] = step2[12];
+  step1[13] = step2[12];
+
+  idct32_16x32_quarter_2_stage_4_to_6_avx2(step1, out);
+}
+
+static INLINE void idct32_34_16x32_quarter_1_2_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i temp[16];
+  idct32_34_16x32_quarter_1_avx2(in, temp);
+  idct32_34_16x32_quarter_2_avx2(in, temp);
+  // stage 7
+  add_sub_butterfly_avx2(temp, out, 16);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with odd index, 1, 3, 5, 7
+// output pixels: 16-23, 24-31 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_3_4_avx2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[32];
+
+  // stage 1
+  butterfly_avx2(in[1], zero, cospi_31_64, cospi_1_64, &step1[16], &step1[31]);
+  butterfly_avx2(zero, in[7], cospi_7_64, cospi_25_64, &step1[19], &step1[28]);
+  butterfly_avx2(in[5], zero, cospi_27_64, cospi_5_64, &step1[20], &step1[27]);
+  butterfly_avx2(zero, in[3], cospi_3_64, cospi_29_64, &step1[23], &step1[24]);
+
+  // stage 3
+  butterfly_avx2(step1[31], step1[16], cospi_28_64, cospi_4_64, &step1[17],
+                 &step1[30]);
+  butterfly_avx2(step1[28], step1[19], -cospi_4_64, cospi_28_64, &step1[18],
+                 &step1[29]);
+  butterfly_avx2(step1[27], step1[20], cospi_12_64, cospi_20_64, &step1[21],
+                 &step1[26]);
+  butterfly_avx2(step1[24], step1[23], -cospi_20_64, cospi_12_64, &step1[22],
+                 &step1[25]);
+
+  idct32_16x32_quarter_3_4_stage_4_to_7_avx2(step1, out);
+}
+
+static void idct32_34_16x32_avx2(const __m256i *const in /*in[32]*/,
+                                 __m256i *const out /*out[32]*/) {
+  __m256i temp[32];
+
+  idct32_34_16x32_quarter_1_2_avx2(in, temp);
+  idct32_34_16x32_quarter_3_4_avx2(in, temp);
+  // final stage
+  add_sub_butterfly_avx2(temp, out, 32);
+}
+
+// Load 16 rows of 32 coefficients, transposed so that in[k] holds coefficient
+// k of every row. Only the first rows rows and cols columns are loaded, the
+// rest are known to be zero.
+static INLINE void load_transpose_16x32_avx2(const tran_low_t *input,
+                                             const int rows, const int cols,
+                                             __m256i *const in /*in[32]*/) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    in[i] = i < rows ? load_input_data16_avx2(input + i * 32)
+                     : _mm256_setzero_si256();
+    in[i + 16] = (i < rows && cols > 16)
+                     ? load_input_data16_avx2(input + i * 32 + 16)
+                     : _mm256_setzero_si256();
+  }
+  transpose_16bit_16x16_avx2(in, in);
+  transpose_16bit_16x16_avx2(in + 16, in + 16);
+}
+
+// Columns of the 32x32 transform. Rows 16-31 of the intermediate result are
+// zero when row_blocks is 1.
+static INLINE void idct32_columns_avx2(__m256i (*const col)[32],
+                                       const int row_blocks, uint8_t *dest,
+                                       const int stride) {
+  __m256i io[32];
+  int i, j;
+
+  for (i = 0; i < 32; i += 16) {
+    transpose_16bit_16x16_avx2(col[0] + i, io);
+    if (row_blocks > 1) {
+      transpose_16bit_16x16_avx2(col[1] + i, io + 16);
+    } else {
+      for (j = 16; j < 32; ++j) io[j] = _mm256_setzero_si256();
+    }
+    idct32_1024_16x32_avx2(io, io);
+
+    for (j = 0; j < 32; ++j) {
+      write_buffer_16x1_avx2(dest + j * stride, io[j]);
+    }
+
+    dest += 16;
+  }
+}
+
+void vpx_idct32x32_1024_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                 int stride) {
+  __m256i col[2][32], io[32];
+  int i;
+
+  // rows
+  for (i = 0; i < 2; i++) {
+    load_transpose_16x32_avx2(input, 16, 32, io);
+    idct32_1024_16x32_avx2(io, col[i]);
+    input += 32 << 4;
+  }
+
+  // columns
+  idct32_columns_avx2(col, 2, dest, stride);
+}
+
+// Only the upper-left 16x16 coefficients are non-zero, so the rows need a
+// single pass and the bottom half of the intermediate result is zero.
+void vpx_idct32x32_135_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride) {
+  __m256i col[1][32], io[32];
+
+  load_transpose_16x32_avx2(input, 16, 16, io);
+  idct32_1024_16x32_avx2(io, col[0]);
+  idct32_columns_avx2(col, 1, dest, stride);
+}
+
+// Only the upper-left 8x8 coefficients are non-zero.
+void vpx_idct32x32_34_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride) {
+  __m256i col[32], io[32];
+  int i, j;
+
+  // rows
+  load_transpose_16x32_avx2(input, 8, 16, io);
+  idct32_34_16x32_avx2(io, col);
+
+  // columns
+  for (i = 0; i < 32; i += 16) {
+    transpose_16bit_16x16_avx2(col + i, io);
+    idct32_34_16x32_avx2(io, io);
+
+    for (j = 0; j < 32; ++j) {
+      write_buffer_16x1_avx2(dest + j * stride, io[j]);
+    }
+
+    dest += 16;
+  }
+}
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
+#define VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/inv_txfm.h"
+#include "vpx_dsp/txfm_common.h"
+
+// The AVX2 inverse transforms mirror the SSE2 ones in inv_txfm_sse2.h, with
+// each register holding 16 columns instead of 8. The unpack, madd and pack
+// instructions all work within 128-bit lanes, so the arithmetic, and with it
+// the output, is identical to the SSE2 and C versions.
+
+#define pair256_set_epi16(a, b)                                            \
+  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
+
+static INLINE __m256i dct_const_round_shift_avx2(const __m256i in) {
+  const __m256i t =
+      _mm256_add_epi32(in, _mm256_set1_epi32(DCT_CONST_ROUNDING));
+  return _mm256_srai_epi32(t, DCT_CONST_BITS);
+}
+
+static INLINE __m256i idct_madd_round_shift_avx2(const __m256i in,
+                                                 const __m256i cospi) {
+  const __m256i t = _mm256_madd_epi16(in, cospi);
+  return dct_const_round_shift_avx2(t);
+}
+
+// Calculate the dot product between in0/1 and x and wrap to short.
+static INLINE __m256i idct_calc_wraplow_avx2(const __m256i in0,
+                                             const __m256i in1,
+                                             const __m256i x) {
+  const __m256i t0 = idct_madd_round_shift_avx2(in0, x);
+  const __m256i t1 = idct_madd_round_shift_avx2(in1, x);
+  return _mm256_packs_epi32(t0, t1);
+}
+
+// Multiply elements by constants and add them together.
+static INLINE void butterfly_avx2(const __m256i in0, const __m256i in1,
+                                  const int c0, const int c1,
+                                  __m256i *const out0, __m256i *const out1) {
+  const __m256i cst0 = pair256_set_epi16(c0, -c1);
+  const __m256i cst1 = pair256_set_epi16(c1, c0);
+  const __m256i lo = _mm256_unpacklo_epi16(in0, in1);
+  const __m256i hi = _mm256_unpackhi_epi16(in0, in1);
+  *out0 = idct_calc_wraplow_avx2(lo, hi, cst0);
+  *out1 = idct_calc_wraplow_avx2(lo, hi, cst1);
+}
+
+// Return the rounded and packed in0 * c0 + in1 * c1.
+static INLINE __m256i madd_round_shift_pack_avx2(const __m256i in0,
+                                                 const __m256i in1,
+                                                 const int c0, const int c1) {
+  const __m256i cst = pair256_set_epi16(c0, c1);
+  const __m256i lo = _mm256_unpacklo_epi16(in0, in1);
+  const __m256i hi = _mm256_unpackhi_epi16(in0, in1);
+  return idct_calc_wraplow_avx2(lo, hi, cst);
+}
+
+static INLINE __m256i butterfly_cospi16_avx2(const __m256i in) {
+  const __m256i cst = pair256_set_epi16(cospi_16_64, cospi_16_64);
+  const __m256i lo = _mm256_unpacklo_epi16(in, _mm256_setzero_si256());
+  const __m256i hi = _mm256_unpackhi_epi16(in, _mm256_setzero_si256());
+  return idct_calc_wraplow_avx2(lo, hi, cst);
+}
+
+// Load 16 coefficients, packing them to 16 bits when tran_low_t is 32 bits.
+static INLINE __m256i load_input_data16_avx2(const tran_low_t *data) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const __m256i in0 = _mm256_loadu_si256((const __m256i *)data);
+  const __m256i in1 = _mm256_loadu_si256((const __m256i *)(data + 8));
+  // The pack interleaves the 128-bit lanes of in0 and in1; restore the order.
+  return _mm256_permute4x64_epi64(_mm256_packs_epi32(in0, in1), 0xd8);
+#else
+  return _mm256_loadu_si256((const __m256i *)data);
+#endif
+}
+
+static INLINE void transpose_16bit_16x16_avx2(const __m256i *const in,
+                                              __m256i *const out) {
+  __m256i t[16];
+  int i;
+
+  // Transpose the 8x8 blocks within each 128-bit lane, as in
+  // transpose_16bit_8x8(). For rows 0-7 this gives:
+  // t[0]: 00 10 20 30 40 50 60 70  08 18 28 38 48 58 68 78
+  // t[1]: 01 11 21 31 41 51 61 71  09 19 29 39 49 59 69 79
+  // ...
+  // and likewise for rows 8-15 in t[8] to t[15].
+  for (i = 0; i < 16; i += 8) {
+    const __m256i a0 = _mm256_unpacklo_epi16(in[i + 0], in[i + 1]);
+    const __m256i a1 = _mm256_unpacklo_epi16(in[i + 2], in[i + 3]);
+    const __m256i a2 = _mm256_unpacklo_epi16(in[i + 4], in[i + 5]);
+    const __m256i a3 = _mm256_unpacklo_epi16(in[i + 6], in[i + 7]);
+    const __m256i a4 = _mm256_unpackhi_epi16(in[i + 0], in[i + 1]);
+    const __m256i a5 = _mm256_unpackhi_epi16(in[i + 2], in[i + 3]);
+    const __m256i a6 = _mm256_unpackhi_epi16(in[i + 4], in[i + 5]);
+    const __m256i a7 = _mm256_unpackhi_epi16(in[i + 6], in[i + 7]);
+
+    const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+    const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+    const __m256i b2 = _mm256_unpacklo_epi32(a4, a5);
+    const __m256i b3 = _mm256_unpacklo_epi32(a6, a7);
+    const __m256i b4 = _mm256_unpackhi_epi32(a0, a1);
+    const __m256i b5 = _mm256_unpackhi_epi32(a2, a3);
+    const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+    const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+    t[i + 0] = _mm256_unpacklo_epi64(b0, b1);
+    t[i + 1] = _mm256_unpackhi_epi64(b0, b1);
+    t[i + 2] = _mm256_unpacklo_epi64(b4, b5);
+    t[i + 3] = _mm256_unpackhi_epi64(b4, b5);
+    t[i + 4] = _mm256_unpacklo_epi64(b2, b3);
+    t[i + 5] = _mm256_unpackhi_epi64(b2, b3);
+    t[i + 6] = _mm256_unpacklo_epi64(b6, b7);
+    t[i + 7] = _mm256_unpackhi_epi64(b6, b7);
+  }
+
+  // Join the low lanes for columns 0-7 and the high lanes for columns 8-15:
+  // out[0]: 00 10 20 30 40 50 60 70  80 90 a0 b0 c0 d0 e0 f0
+  // out[8]: 08 18 28 38 48 58 68 78  88 98 a8 b8 c8 d8 e8 f8
+  for (i = 0; i < 8; ++i) {
+    out[i] = _mm256_permute2x128_si256(t[i], t[i + 8], 0x20);
+    out[i + 8] = _mm256_permute2x128_si256(t[i], t[i + 8], 0x31);
+  }
+}
+
+// Round, shift and add 16 residuals to dest, saturating as the SSE2 version.
+static INLINE void write_buffer_16x1_avx2(uint8_t *const dest,
+                                          const __m256i in) {
+  const __m256i final_rounding = _mm256_set1_epi16(1 << 5);
+  const __m128i d = _mm_loadu_si128((const __m128i *)dest);
+  __m256i out = _mm256_adds_epi16(in, final_rounding);
+  __m128i d0;
+  out = _mm256_srai_epi16(out, 6);
+  out = _mm256_add_epi16(out, _mm256_cvtepu8_epi16(d));
+  d0 = _mm_packus_epi16(_mm256_castsi256_si128(out),
+                        _mm256_extracti128_si256(out, 1));
+  _mm_storeu_si128((__m128i *)dest, d0);
+}
+
+void idct16_avx2(__m256i *const in);
+void iadst16_avx2(__m256i *const in);
+void adst16_16col_avx2(__m256i *const in);
+
+#endif  // VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
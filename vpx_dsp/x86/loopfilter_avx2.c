@@ -911,3 +911,374 @@ void vpx_lpf_horizontal_16_dual_avx2(unsigned char *s, int pitch,
     _mm_storeu_si128((__m128i *)(s + 6 * pitch), q6);
   }
 }
+
+// Store the 8-byte halves of the low lane of a to rows 0 and 1 of out, and
+// those of the high lane to rows 0 and 1 of out + lane_p.
+static INLINE void store_4x8_avx2(uint8_t *out, int out_p, int lane_p,
+                                  const __m256i a) {
+  const __m128i lo = _mm256_castsi256_si128(a);
+  const __m128i hi = _mm256_extracti128_si256(a, 1);
+  _mm_storel_epi64((__m128i *)out, lo);
+  _mm_storeh_pi((__m64 *)(out + out_p), _mm_castsi128_ps(lo));
+  _mm_storel_epi64((__m128i *)(out + lane_p), hi);
+  _mm_storeh_pi((__m64 *)(out + lane_p + out_p), _mm_castsi128_ps(hi));
+}
+
+// The _quad filters work on 32 rows, one per byte of a register. p[i] holds
+// the pixels i + 1 to the left of the edge and q[i] those i to the right, as
+// in the C filters of loopfilter.c.
+
+static INLINE __m256i abs_diff_avx2(const __m256i a, const __m256i b) {
+  return _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+}
+
+// Arithmetic right shift of signed bytes.
+static INLINE __m256i srai_epi8_avx2(const __m256i a, const int bits) {
+  const __m256i lo = _mm256_srai_epi16(_mm256_unpacklo_epi8(a, a), 8 + bits);
+  const __m256i hi = _mm256_srai_epi16(_mm256_unpackhi_epi8(a, a), 8 + bits);
+  return _mm256_packs_epi16(lo, hi);
+}
+
+// All ones where max(abs(a[i] - ref)) <= 1 for i < n.
+static INLINE __m256i flat_mask_avx2(const __m256i *a, const __m256i ref,
+                                     int n) {
+  __m256i max = _mm256_setzero_si256();
+  int i;
+  for (i = 0; i < n; ++i) max = _mm256_max_epu8(max, abs_diff_avx2(a[i], ref));
+  return _mm256_cmpeq_epi8(_mm256_subs_epu8(max, _mm256_set1_epi8(1)),
+                           _mm256_setzero_si256());
+}
+
+// All ones where the edge is to be filtered, as filter_mask().
+static INLINE __m256i filter_mask_avx2(const __m256i *p, const __m256i *q,
+                                       const __m256i blimit,
+                                       const __m256i limit) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i abs_p0q0 = abs_diff_avx2(p[0], q[0]);
+  const __m256i abs_p1q1 = abs_diff_avx2(p[1], q[1]);
+  __m256i max, edge;
+  int i;
+
+  // abs(p0 - q0) * 2 + abs(p1 - q1) / 2 > blimit
+  edge = _mm256_adds_epu8(
+      _mm256_adds_epu8(abs_p0q0, abs_p0q0),
+      _mm256_srli_epi16(
+          _mm256_and_si256(abs_p1q1, _mm256_set1_epi8((int8_t)0xfe)), 1));
+  edge = _mm256_subs_epu8(edge, blimit);
+
+  max = zero;
+  for (i = 0; i < 3; ++i) {
+    max = _mm256_max_epu8(max, abs_diff_avx2(p[i + 1], p[i]));
+    max = _mm256_max_epu8(max, abs_diff_avx2(q[i + 1], q[i]));
+  }
+  max = _mm256_subs_epu8(max, limit);
+  return _mm256_cmpeq_epi8(_mm256_or_si256(edge, max), zero);
+}
+
+// Apply filter4() to p[1], p[0], q[0] and q[1] where mask is set.
+static INLINE void filter4_avx2(const __m256i mask, const __m256i thresh,
+                                __m256i *p, __m256i *q) {
+  const __m256i t80 = _mm256_set1_epi8((int8_t)0x80);
+  const __m256i ps1 = _mm256_xor_si256(p[1], t80);
+  const __m256i ps0 = _mm256_xor_si256(p[0], t80);
+  const __m256i qs0 = _mm256_xor_si256(q[0], t80);
+  const __m256i qs1 = _mm256_xor_si256(q[1], t80);
+  // All ones where there is no high edge variance.
+  const __m256i not_hev = _mm256_cmpeq_epi8(
+      _mm256_subs_epu8(_mm256_max_epu8(abs_diff_avx2(p[1], p[0]),
+                                       abs_diff_avx2(q[1], q[0])),
+                       thresh),
+      _mm256_setzero_si256());
+  const __m256i work = _mm256_subs_epi8(qs0, ps0);
+  __m256i filter, filter1, filter2;
+
+  filter = _mm256_andnot_si256(not_hev, _mm256_subs_epi8(ps1, qs1));
+  filter = _mm256_adds_epi8(filter, work);
+  filter = _mm256_adds_epi8(filter, work);
+  filter = _mm256_adds_epi8(filter, work);
+  filter = _mm256_and_si256(filter, mask);
+
+  filter1 = srai_epi8_avx2(_mm256_adds_epi8(filter, _mm256_set1_epi8(4)), 3);
+  filter2 = srai_epi8_avx2(_mm256_adds_epi8(filter, _mm256_set1_epi8(3)), 3);
+  q[0] = _mm256_xor_si256(_mm256_subs_epi8(qs0, filter1), t80);
+  p[0] = _mm256_xor_si256(_mm256_adds_epi8(ps0, filter2), t80);
+
+  filter = srai_epi8_avx2(_mm256_adds_epi8(filter1, _mm256_set1_epi8(1)), 1);
+  filter = _mm256_and_si256(filter, not_hev);
+  q[1] = _mm256_xor_si256(_mm256_subs_epi8(qs1, filter), t80);
+  p[1] = _mm256_xor_si256(_mm256_adds_epi8(ps1, filter), t80);
+}
+
+// sum += a0 + a1 - s0 - s1 and return sum >> bits.
+static INLINE __m256i filter_add2_sub2_avx2(__m256i *sum, const __m256i a0,
+                                            const __m256i a1, const __m256i s0,
+                                            const __m256i s1, const int bits) {
+  *sum = _mm256_add_epi16(*sum, _mm256_add_epi16(a0, a1));
+  *sum = _mm256_sub_epi16(*sum, _mm256_add_epi16(s0, s1));
+  return _mm256_srli_epi16(*sum, bits);
+}
+
+// The 7-tap filter of filter8() on 16-bit pixels, as running sums.
+static INLINE void filter8_flat_avx2(const __m256i *p, const __m256i *q,
+                                     __m256i *op, __m256i *oq) {
+  __m256i sum = _mm256_set1_epi16(4);
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p[3], p[3]));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p[3], p[2]));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p[2], p[1]));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p[0], q[0]));
+  op[2] = _mm256_srli_epi16(sum, 3);
+  op[1] = filter_add2_sub2_avx2(&sum, p[1], q[1], p[3], p[2], 3);
+  op[0] = filter_add2_sub2_avx2(&sum, p[0], q[2], p[3], p[1], 3);
+  oq[0] = filter_add2_sub2_avx2(&sum, q[0], q[3], p[3], p[0], 3);
+  oq[1] = filter_add2_sub2_avx2(&sum, q[1], q[3], p[2], q[0], 3);
+  oq[2] = filter_add2_sub2_avx2(&sum, q[2], q[3], p[1], q[1], 3);
+}
+
+// The 15-tap filter of filter16() on 16-bit pixels, as running sums.
+static INLINE void filter16_flat_avx2(const __m256i *p, const __m256i *q,
+                                      __m256i *op, __m256i *oq) {
+  __m256i sum = _mm256_set1_epi16(8);
+  int i;
+
+  // p7 * 7 + p6 * 2 + p5 + p4 + p3 + p2 + p1 + p0 + q0
+  sum = _mm256_add_epi16(sum, _mm256_sub_epi16(_mm256_slli_epi16(p[7], 3),
+                                               p[7]));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p[6], q[0]));
+  for (i = 0; i < 7; ++i) sum = _mm256_add_epi16(sum, p[i]);
+  op[6] = _mm256_srli_epi16(sum, 4);
+  for (i = 5; i >= 0; --i) {
+    op[i] = filter_add2_sub2_avx2(&sum, p[i], q[6 - i], p[7], p[i + 1], 4);
+  }
+  oq[0] = filter_add2_sub2_avx2(&sum, q[0], q[7], p[7], p[0], 4);
+  for (i = 1; i < 7; ++i) {
+    oq[i] = filter_add2_sub2_avx2(&sum, q[i], q[7], p[7 - i], q[i - 1], 4);
+  }
+}
+
+// Run the flat filter f over the low and high halves of p and q, n pixels
+// each side of the edge, and blend its output into p and q where flat is set.
+static INLINE void filter_flat_avx2(void (*f)(const __m256i *, const __m256i *,
+                                              __m256i *, __m256i *),
+                                    const __m256i flat, const __m256i *p_in,
+                                    const __m256i *q_in, int n, __m256i *p,
+                                    __m256i *q) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i p_lo[8], q_lo[8], p_hi[8], q_hi[8];
+  __m256i op_lo[7], oq_lo[7], op_hi[7], oq_hi[7];
+  int i;
+
+  for (i = 0; i <= n; ++i) {
+    p_lo[i] = _mm256_unpacklo_epi8(p_in[i], zero);
+    q_lo[i] = _mm256_unpacklo_epi8(q_in[i], zero);
+    p_hi[i] = _mm256_unpackhi_epi8(p_in[i], zero);
+    q_hi[i] = _mm256_unpackhi_epi8(q_in[i], zero);
+  }
+  f(p_lo, q_lo, op_lo, oq_lo);
+  f(p_hi, q_hi, op_hi, oq_hi);
+  for (i = 0; i < n; ++i) {
+    p[i] = _mm256_blendv_epi8(p[i], _mm256_packus_epi16(op_lo[i], op_hi[i]),
+                              flat);
+    q[i] = _mm256_blendv_epi8(q[i], _mm256_packus_epi16(oq_lo[i], oq_hi[i]),
+                              flat);
+  }
+}
+
+// Filter 32 rows across an edge with the filters of vpx_lpf_*_4, _8 or _16,
+// according to taps. Returns 0 if nothing is filtered.
+static INLINE int lpf_32_avx2(__m256i *p, __m256i *q, const uint8_t *blimit,
+                              const uint8_t *limit, const uint8_t *thresh,
+                              int taps) {
+  const __m256i blimit_v = _mm256_set1_epi8((int8_t)blimit[0]);
+  const __m256i limit_v = _mm256_set1_epi8((int8_t)limit[0]);
+  const __m256i thresh_v = _mm256_set1_epi8((int8_t)thresh[0]);
+  const __m256i mask = filter_mask_avx2(p, q, blimit_v, limit_v);
+  __m256i p_in[8], q_in[8], flat, flat2;
+  int i;
+
+  if (_mm256_testz_si256(mask, mask)) return 0;
+
+  if (taps == 4) {
+    filter4_avx2(mask, thresh_v, p, q);
+    return 1;
+  }
+
+  for (i = 0; i < taps / 2; ++i) {
+    p_in[i] = p[i];
+    q_in[i] = q[i];
+  }
+  filter4_avx2(mask, thresh_v, p, q);
+
+  // The flat filters see the pixels before filter4().
+  flat = _mm256_and_si256(
+      mask, _mm256_and_si256(flat_mask_avx2(p_in + 1, p_in[0], 3),
+                             flat_mask_avx2(q_in + 1, q_in[0], 3)));
+  if (_mm256_testz_si256(flat, flat)) return 1;
+
+  if (taps == 16) {
+    flat2 = _mm256_and_si256(
+        flat, _mm256_and_si256(flat_mask_avx2(p_in + 4, p_in[0], 4),
+                               flat_mask_avx2(q_in + 4, q_in[0], 4)));
+    // The 15-tap output replaces the 7-tap output where flat2 is set.
+    if (!_mm256_testc_si256(flat2, flat)) {
+      filter_flat_avx2(filter8_flat_avx2, flat, p_in, q_in, 3, p, q);
+    }
+    if (!_mm256_testz_si256(flat2, flat2)) {
+      filter_flat_avx2(filter16_flat_avx2, flat2, p_in, q_in, 7, p, q);
+    }
+  } else {
+    filter_flat_avx2(filter8_flat_avx2, flat, p_in, q_in, 3, p, q);
+  }
+  return 1;
+}
+
+// Transpose the 16 pixels across the edge in each of 32 rows, or back.
+// Register i holds rows i and i + 16 in its two lanes, and each lane is
+// transposed as a 16x16 block.
+static INLINE void transpose_32x16_avx2(const __m256i *in, __m256i *out) {
+  __m256i a[16], b[16];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    a[i] = _mm256_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+    a[i + 8] = _mm256_unpackhi_epi8(in[2 * i], in[2 * i + 1]);
+  }
+  for (i = 0; i < 4; ++i) {
+    b[i] = _mm256_unpacklo_epi16(a[2 * i], a[2 * i + 1]);
+    b[i + 4] = _mm256_unpackhi_epi16(a[2 * i], a[2 * i + 1]);
+    b[i + 8] = _mm256_unpacklo_epi16(a[2 * i + 8], a[2 * i + 9]);
+    b[i + 12] = _mm256_unpackhi_epi16(a[2 * i + 8], a[2 * i + 9]);
+  }
+  for (i = 0; i < 16; i += 4) {
+    const __m256i c0 = _mm256_unpacklo_epi32(b[i + 0], b[i + 1]);
+    const __m256i c1 = _mm256_unpackhi_epi32(b[i + 0], b[i + 1]);
+    const __m256i d0 = _mm256_unpacklo_epi32(b[i + 2], b[i + 3]);
+    const __m256i d1 = _mm256_unpackhi_epi32(b[i + 2], b[i + 3]);
+    out[i + 0] = _mm256_unpacklo_epi64(c0, d0);
+    out[i + 1] = _mm256_unpackhi_epi64(c0, d0);
+    out[i + 2] = _mm256_unpacklo_epi64(c1, d1);
+    out[i + 3] = _mm256_unpackhi_epi64(c1, d1);
+  }
+}
+
+void vpx_lpf_vertical_16_quad_avx2(uint8_t *s, int pitch,
+                                   const uint8_t *blimit, const uint8_t *limit,
+                                   const uint8_t *thresh) {
+  __m256i x[16], y[16], p[8], q[8];
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    const uint8_t *const row = s - 8 + i * pitch;
+    x[i] = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)row)),
+        _mm_loadu_si128((const __m128i *)(row + 16 * pitch)), 1);
+  }
+  transpose_32x16_avx2(x, y);
+  for (i = 0; i < 8; ++i) {
+    p[i] = y[7 - i];
+    q[i] = y[8 + i];
+  }
+
+  if (!lpf_32_avx2(p, q, blimit, limit, thresh, 16)) return;
+
+  for (i = 0; i < 8; ++i) {
+    y[7 - i] = p[i];
+    y[8 + i] = q[i];
+  }
+  transpose_32x16_avx2(y, x);
+  for (i = 0; i < 16; ++i) {
+    uint8_t *const row = s - 8 + i * pitch;
+    _mm_storeu_si128((__m128i *)row, _mm256_castsi256_si128(x[i]));
+    _mm_storeu_si128((__m128i *)(row + 16 * pitch),
+                     _mm256_extracti128_si256(x[i], 1));
+  }
+}
+
+// Filter the 8 pixels across the edge in each of 32 rows with the 4 or 8-tap
+// filters. The rows are loaded 8 and 16 apart so that, as in
+// transpose_32x16_avx2(), each lane of the transposed registers holds 16 rows.
+static INLINE void lpf_vertical_32x8_avx2(uint8_t *s, int pitch,
+                                          const uint8_t *blimit,
+                                          const uint8_t *limit,
+                                          const uint8_t *thresh, int taps) {
+  __m256i x[8], a[8], b[8], c[8], p[4], q[4];
+  int i;
+
+  s -= 4;
+  for (i = 0; i < 8; ++i) {
+    const uint8_t *const row = s + i * pitch;
+    const __m128i lo = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)row),
+        _mm_loadl_epi64((const __m128i *)(row + 8 * pitch)));
+    const __m128i hi = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(row + 16 * pitch)),
+        _mm_loadl_epi64((const __m128i *)(row + 24 * pitch)));
+    x[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+  }
+
+  // a[i]: rows 2i and 2i + 1, a[i + 4]: rows 2i + 8 and 2i + 9.
+  for (i = 0; i < 4; ++i) {
+    a[i] = _mm256_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+    a[i + 4] = _mm256_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+  }
+  for (i = 0; i < 8; i += 4) {
+    b[i + 0] = _mm256_unpacklo_epi16(a[i + 0], a[i + 1]);
+    b[i + 1] = _mm256_unpacklo_epi16(a[i + 2], a[i + 3]);
+    b[i + 2] = _mm256_unpackhi_epi16(a[i + 0], a[i + 1]);
+    b[i + 3] = _mm256_unpackhi_epi16(a[i + 2], a[i + 3]);
+  }
+  for (i = 0; i < 8; i += 4) {
+    c[i + 0] = _mm256_unpacklo_epi32(b[i + 0], b[i + 1]);
+    c[i + 1] = _mm256_unpackhi_epi32(b[i + 0], b[i + 1]);
+    c[i + 2] = _mm256_unpacklo_epi32(b[i + 2], b[i + 3]);
+    c[i + 3] = _mm256_unpackhi_epi32(b[i + 2], b[i + 3]);
+  }
+  for (i = 0; i < 4; ++i) {
+    x[2 * i] = _mm256_unpacklo_epi64(c[i], c[i + 4]);
+    x[2 * i + 1] = _mm256_unpackhi_epi64(c[i], c[i + 4]);
+  }
+  for (i = 0; i < 4; ++i) {
+    p[i] = x[3 - i];
+    q[i] = x[4 + i];
+  }
+
+  if (!lpf_32_avx2(p, q, blimit, limit, thresh, taps)) return;
+
+  for (i = 0; i < 4; ++i) {
+    x[3 - i] = p[i];
+    x[4 + i] = q[i];
+  }
+  // a[i]: rows 0-7 of columns 2i and 2i + 1, a[i + 4]: rows 8-15.
+  for (i = 0; i < 4; ++i) {
+    a[i] = _mm256_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+    a[i + 4] = _mm256_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+  }
+  for (i = 0; i < 8; i += 4) {
+    b[i + 0] = _mm256_unpacklo_epi16(a[i + 0], a[i + 1]);
+    b[i + 1] = _mm256_unpacklo_epi16(a[i + 2], a[i + 3]);
+    b[i + 2] = _mm256_unpackhi_epi16(a[i + 0], a[i + 1]);
+    b[i + 3] = _mm256_unpackhi_epi16(a[i + 2], a[i + 3]);
+  }
+  for (i = 0; i < 8; i += 4) {
+    uint8_t *const row = s + 2 * i * pitch;
+    store_4x8_avx2(row, pitch, 16 * pitch,
+                   _mm256_unpacklo_epi32(b[i + 0], b[i + 1]));
+    store_4x8_avx2(row + 2 * pitch, pitch, 16 * pitch,
+                   _mm256_unpackhi_epi32(b[i + 0], b[i + 1]));
+    store_4x8_avx2(row + 4 * pitch, pitch, 16 * pitch,
+                   _mm256_unpacklo_epi32(b[i + 2], b[i + 3]));
+    store_4x8_avx2(row + 6 * pitch, pitch, 16 * pitch,
+                   _mm256_unpackhi_epi32(b[i + 2], b[i + 3]));
+  }
+}
+
+void vpx_lpf_vertical_8_quad_avx2(uint8_t *s, int pitch, const uint8_t *blimit,
+                                  const uint8_t *limit,
+                                  const uint8_t *thresh) {
+  lpf_vertical_32x8_avx2(s, pitch, blimit, limit, thresh, 8);
+}
+
+void vpx_lpf_vertical_4_quad_avx2(uint8_t *s, int pitch, const uint8_t *blimit,
+                                  const uint8_t *limit,
+                                  const uint8_t *thresh) {
+  lpf_vertical_32x8_avx2(s, pitch, blimit, limit, thresh, 4);
+}
@@ -1777,3 +1777,28 @@ void vpx_lpf_vertical_16_dual_sse2(unsigned char *s, int pitch,
   transpose8x16(t_dst, t_dst + 8 * 16, 16, s - 8, pitch);
   transpose8x16(t_dst + 8, t_dst + 8 + 8 * 16, 16, s - 8 + 8 * pitch, pitch);
 }
+
+void vpx_lpf_vertical_16_quad_sse2(unsigned char *s, int pitch,
+                                   const uint8_t *blimit, const uint8_t *limit,
+                                   const uint8_t *thresh) {
+  vpx_lpf_vertical_16_dual_sse2(s, pitch, blimit, limit, thresh);
+  vpx_lpf_vertical_16_dual_sse2(s + 16 * pitch, pitch, blimit, limit, thresh);
+}
+
+void vpx_lpf_vertical_8_quad_sse2(uint8_t *s, int pitch, const uint8_t *blimit,
+                                  const uint8_t *limit,
+                                  const uint8_t *thresh) {
+  vpx_lpf_vertical_8_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit,
+                               thresh);
+  vpx_lpf_vertical_8_dual_sse2(s + 16 * pitch, pitch, blimit, limit, thresh,
+                               blimit, limit, thresh);
+}
+
+void vpx_lpf_vertical_4_quad_sse2(uint8_t *s, int pitch, const uint8_t *blimit,
+                                  const uint8_t *limit,
+                                  const uint8_t *thresh) {
+  vpx_lpf_vertical_4_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit,
+                               thresh);
+  vpx_lpf_vertical_4_dual_sse2(s + 16 * pitch, pitch, blimit, limit, thresh,
+                               blimit, limit, thresh);
+}
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_MEM_AVX512_H_
+#define VPX_VPX_DSP_X86_MEM_AVX512_H_
+
+#include <immintrin.h>  // AVX512
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+
+// Load 32 bytes from lo and from hi into the low and high halves of a
+// register, typically two rows of a 32-pixel wide block.
+static INLINE __m512i mm512_loadu2_si256(const void *lo, const void *hi) {
+  const __m512i tmp =
+      _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *)lo));
+  return _mm512_inserti64x4(tmp, _mm256_loadu_si256((const __m256i *)hi), 1);
+}
+
+static INLINE void mm512_storeu2_si256(void *lo, void *hi, const __m512i a) {
+  _mm256_storeu_si256((__m256i *)lo, _mm512_castsi512_si256(a));
+  _mm256_storeu_si256((__m256i *)hi, _mm512_extracti64x4_epi64(a, 1));
+}
+
+// Load a 64-pixel row, or two rows of a 32-pixel wide block, into one
+// register.
+static INLINE __m512i load_row_avx512(const uint8_t *p, int stride,
+                                      int width) {
+  if (width == 64) return _mm512_loadu_si512((const __m512i *)p);
+  return mm512_loadu2_si256(p, p + stride);
+}
+
+#endif  // VPX_VPX_DSP_X86_MEM_AVX512_H_
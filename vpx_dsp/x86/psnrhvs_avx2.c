@@ -0,0 +1,214 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+#include <math.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+
+// Follows calc_psnrhvs() in psnrhvs.c. The per coefficient terms are formed 4
+// at a time, but the floating point sums are accumulated in the same order as
+// the C code, so the result matches it exactly. The block variances are
+// formed from integer sums: the C code computes them exactly as well.
+
+static void init_mask(const double *csf, double *mask) {
+  int k;
+  for (k = 0; k < 64; ++k) mask[k] = (csf[k] / csf[8]) * (csf[k] / csf[8]);
+}
+
+static INLINE __m128i load_coeff_4(const tran_low_t *coeff) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  return _mm_load_si128((const __m128i *)coeff);
+#else
+  return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)coeff));
+#endif
+}
+
+// Returns the summed variances of the four 4x4 quadrants of the block
+// relative to the variance of the whole block.
+static double variance_ratio(const int16_t *block) {
+  const __m128i one = _mm_set1_epi16(1);
+  DECLARE_ALIGNED(16, int32_t, sum[4]);
+  DECLARE_ALIGNED(16, int32_t, sum_sq[4]);
+  __m128i sum_top = _mm_setzero_si128(), sum_bottom = _mm_setzero_si128();
+  __m128i sq_top = _mm_setzero_si128(), sq_bottom = _mm_setzero_si128();
+  double gvar, vars[4];
+  int64_t total = 0, total_sq = 0;
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    const __m128i top = _mm_load_si128((const __m128i *)(block + i * 8));
+    const __m128i bottom =
+        _mm_load_si128((const __m128i *)(block + (i + 4) * 8));
+    sum_top = _mm_add_epi16(sum_top, top);
+    sum_bottom = _mm_add_epi16(sum_bottom, bottom);
+    sq_top = _mm_add_epi32(sq_top, _mm_madd_epi16(top, top));
+    sq_bottom = _mm_add_epi32(sq_bottom, _mm_madd_epi16(bottom, bottom));
+  }
+  // Top left, top right, bottom left and bottom right quadrants.
+  _mm_store_si128((__m128i *)sum,
+                  _mm_hadd_epi32(_mm_madd_epi16(sum_top, one),
+                                 _mm_madd_epi16(sum_bottom, one)));
+  _mm_store_si128((__m128i *)sum_sq, _mm_hadd_epi32(sq_top, sq_bottom));
+
+  for (i = 0; i < 4; ++i) {
+    // The C code numbers the quadrants in column major order.
+    const int sub = (i >> 1) + ((i & 1) << 1);
+    vars[sub] = (double)(16 * (int64_t)sum_sq[i] - (int64_t)sum[i] * sum[i]) /
+                16;
+    total += sum[i];
+    total_sq += sum_sq[i];
+  }
+  gvar = (double)(64 * total_sq - total * total) / 64;
+
+  gvar *= 1 / 63.f * 64;
+  for (i = 0; i < 4; i++) vars[i] *= 1 / 15.f * 16;
+  if (gvar > 0) gvar = (vars[0] + vars[1] + vars[2] + vars[3]) / gvar;
+  return gvar;
+}
+
+// Adds the masked error of a pair of transformed blocks to ret.
+static double block_error(const int16_t *dct_s, const int16_t *dct_d,
+                          const tran_low_t *dct_s_coef,
+                          const tran_low_t *dct_d_coef, const double *csf,
+                          const double *mask, double ret) {
+  DECLARE_ALIGNED(16, int32_t, diff[64]);
+  DECLARE_ALIGNED(32, double, s_term[64]);
+  DECLARE_ALIGNED(32, double, d_term[64]);
+  DECLARE_ALIGNED(32, double, err_term[64]);
+  const __m128i four = _mm_set1_epi32(4);
+  const double s_gvar = variance_ratio(dct_s);
+  const double d_gvar = variance_ratio(dct_d);
+  double s_mask = 0;
+  double d_mask = 0;
+  __m256d s_mask_4;
+  int k;
+
+  for (k = 0; k < 64; k += 4) {
+    const __m128i s =
+        _mm_srai_epi32(_mm_add_epi32(load_coeff_4(dct_s_coef + k), four), 3);
+    const __m128i d =
+        _mm_srai_epi32(_mm_add_epi32(load_coeff_4(dct_d_coef + k), four), 3);
+    const __m256d s_sq = _mm256_cvtepi32_pd(_mm_mullo_epi32(s, s));
+    const __m256d d_sq = _mm256_cvtepi32_pd(_mm_mullo_epi32(d, d));
+    const __m256d m = _mm256_loadu_pd(mask + k);
+    _mm256_store_pd(s_term + k, _mm256_mul_pd(s_sq, m));
+    _mm256_store_pd(d_term + k, _mm256_mul_pd(d_sq, m));
+    _mm_store_si128((__m128i *)(diff + k), _mm_sub_epi32(s, d));
+  }
+
+  // The DC coefficient is not masked.
+  for (k = 1; k < 64; ++k) {
+    s_mask += s_term[k];
+    d_mask += d_term[k];
+  }
+  s_mask = sqrt(s_mask * s_gvar) / 32.f;
+  d_mask = sqrt(d_mask * d_gvar) / 32.f;
+  if (d_mask > s_mask) s_mask = d_mask;
+
+  s_mask_4 = _mm256_set1_pd(s_mask);
+  for (k = 0; k < 64; k += 4) {
+    const __m256d err = _mm256_cvtepi32_pd(
+        _mm_abs_epi32(_mm_load_si128((const __m128i *)(diff + k))));
+    __m256d threshold = _mm256_div_pd(s_mask_4, _mm256_loadu_pd(mask + k));
+    __m256d masked_err;
+    if (k == 0) threshold = _mm256_blend_pd(threshold, _mm256_setzero_pd(), 1);
+    masked_err =
+        _mm256_andnot_pd(_mm256_cmp_pd(err, threshold, _CMP_LT_OQ),
+                         _mm256_sub_pd(err, threshold));
+    masked_err = _mm256_mul_pd(masked_err, _mm256_loadu_pd(csf + k));
+    _mm256_store_pd(err_term + k, _mm256_mul_pd(masked_err, masked_err));
+  }
+  for (k = 0; k < 64; ++k) ret += err_term[k];
+  return ret;
+}
+
+double vpx_psnrhvs_plane_avx2(const uint8_t *src, int src_stride,
+                              const uint8_t *dst, int dst_stride, int w, int h,
+                              int step, const double csf[8][8]) {
+  DECLARE_ALIGNED(16, int16_t, dct_s[8 * 8]);
+  DECLARE_ALIGNED(16, int16_t, dct_d[8 * 8]);
+  DECLARE_ALIGNED(16, tran_low_t, dct_s_coef[8 * 8]);
+  DECLARE_ALIGNED(16, tran_low_t, dct_d_coef[8 * 8]);
+  double mask[8 * 8];
+  double ret = 0;
+  int pixels = 0;
+  int x, y, i;
+
+  init_mask(&csf[0][0], mask);
+  for (y = 0; y < h - 7; y += step) {
+    for (x = 0; x < w - 7; x += step) {
+      for (i = 0; i < 8; ++i) {
+        const __m128i s = _mm_loadl_epi64(
+            (const __m128i *)(src + (y + i) * src_stride + x));
+        const __m128i d = _mm_loadl_epi64(
+            (const __m128i *)(dst + (y + i) * dst_stride + x));
+        _mm_store_si128((__m128i *)(dct_s + i * 8), _mm_cvtepu8_epi16(s));
+        _mm_store_si128((__m128i *)(dct_d + i * 8), _mm_cvtepu8_epi16(d));
+      }
+      vpx_fdct8x8(dct_s, dct_s_coef, 8);
+      vpx_fdct8x8(dct_d, dct_d_coef, 8);
+      ret = block_error(dct_s, dct_d, dct_s_coef, dct_d_coef, &csf[0][0], mask,
+                        ret);
+      pixels += 64;
+    }
+  }
+  if (pixels <= 0) return 0;
+  ret /= pixels;
+  return ret;
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+double vpx_highbd_psnrhvs_plane_avx2(const uint16_t *src, int src_stride,
+                                     const uint16_t *dst, int dst_stride, int w,
+                                     int h, int step, const double csf[8][8],
+                                     uint32_t bd, uint32_t shift) {
+  DECLARE_ALIGNED(16, int16_t, dct_s[8 * 8]);
+  DECLARE_ALIGNED(16, int16_t, dct_d[8 * 8]);
+  DECLARE_ALIGNED(16, tran_low_t, dct_s_coef[8 * 8]);
+  DECLARE_ALIGNED(16, tran_low_t, dct_d_coef[8 * 8]);
+  const __m128i shift_count = _mm_cvtsi32_si128((int)shift);
+  double mask[8 * 8];
+  double ret = 0;
+  int pixels = 0;
+  int x, y, i;
+
+  assert(bd == 10 || bd == 12);
+  (void)bd;
+
+  init_mask(&csf[0][0], mask);
+  for (y = 0; y < h - 7; y += step) {
+    for (x = 0; x < w - 7; x += step) {
+      for (i = 0; i < 8; ++i) {
+        const __m128i s = _mm_loadu_si128(
+            (const __m128i *)(src + (y + i) * src_stride + x));
+        const __m128i d = _mm_loadu_si128(
+            (const __m128i *)(dst + (y + i) * dst_stride + x));
+        _mm_store_si128((__m128i *)(dct_s + i * 8),
+                        _mm_srl_epi16(s, shift_count));
+        _mm_store_si128((__m128i *)(dct_d + i * 8),
+                        _mm_srl_epi16(d, shift_count));
+      }
+      vpx_highbd_fdct8x8(dct_s, dct_s_coef, 8);
+      vpx_highbd_fdct8x8(dct_d, dct_d_coef, 8);
+      ret = block_error(dct_s, dct_d, dct_s_coef, dct_d_coef, &csf[0][0], mask,
+                        ret);
+      pixels += 64;
+    }
+  }
+  if (pixels <= 0) return 0;
+  ret /= pixels;
+  return ret;
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -10,13 +10,47 @@
 #include <immintrin.h>  // AVX512
 #include "./vpx_dsp_rtcd.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_avx512.h"
+
+// Add up the sums of absolute differences of each reference and store them
+// to res[0] to res[3].
+static INLINE void calc_final_4_avx512(__m512i sum_ref0, __m512i sum_ref1,
+                                       __m512i sum_ref2, __m512i sum_ref3,
+                                       uint32_t res[4]) {
+  __m512i sum_mlow, sum_mhigh;
+  __m256i sum256;
+  __m128i sum128;
+  // in sum_ref[] the result is saved in the first 4 bytes
+  // the other 4 bytes are zeroed.
+  // sum_ref1 and sum_ref3 are shifted left by 4 bytes
+  sum_ref1 = _mm512_bslli_epi128(sum_ref1, 4);
+  sum_ref3 = _mm512_bslli_epi128(sum_ref3, 4);
+
+  // merge sum_ref0 and sum_ref1 also sum_ref2 and sum_ref3
+  sum_ref0 = _mm512_or_si512(sum_ref0, sum_ref1);
+  sum_ref2 = _mm512_or_si512(sum_ref2, sum_ref3);
+
+  // merge every 64 bit from each sum_ref[]
+  sum_mlow = _mm512_unpacklo_epi64(sum_ref0, sum_ref2);
+  sum_mhigh = _mm512_unpackhi_epi64(sum_ref0, sum_ref2);
+
+  // add the low 64 bit to the high 64 bit
+  sum_mlow = _mm512_add_epi32(sum_mlow, sum_mhigh);
+
+  // add the low 128 bit to the high 128 bit
+  sum256 = _mm256_add_epi32(_mm512_castsi512_si256(sum_mlow),
+                            _mm512_extracti32x8_epi32(sum_mlow, 1));
+  sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum256),
+                         _mm256_extractf128_si256(sum256, 1));
+
+  _mm_storeu_si128((__m128i *)(res), sum128);
+}
 
 void vpx_sad64x64x4d_avx512(const uint8_t *src_ptr, int src_stride,
                             const uint8_t *const ref_array[4], int ref_stride,
                             uint32_t res[4]) {
   __m512i src_reg, ref0_reg, ref1_reg, ref2_reg, ref3_reg;
   __m512i sum_ref0, sum_ref1, sum_ref2, sum_ref3;
-  __m512i sum_mlow, sum_mhigh;
   int i;
   const uint8_t *ref0, *ref1, *ref2, *ref3;
 
@@ -52,32 +86,45 @@ void vpx_sad64x64x4d_avx512(const uint8_t *src_ptr, int src_stride,
     ref2 += ref_stride;
     ref3 += ref_stride;
   }
-  {
-    __m256i sum256;
-    __m128i sum128;
-    // in sum_ref[] the result is saved in the first 4 bytes
-    // the other 4 bytes are zeroed.
-    // sum_ref1 and sum_ref3 are shifted left by 4 bytes
-    sum_ref1 = _mm512_bslli_epi128(sum_ref1, 4);
-    sum_ref3 = _mm512_bslli_epi128(sum_ref3, 4);
-
-    // merge sum_ref0 and sum_ref1 also sum_ref2 and sum_ref3
-    sum_ref0 = _mm512_or_si512(sum_ref0, sum_ref1);
-    sum_ref2 = _mm512_or_si512(sum_ref2, sum_ref3);
-
-    // merge every 64 bit from each sum_ref[]
-    sum_mlow = _mm512_unpacklo_epi64(sum_ref0, sum_ref2);
-    sum_mhigh = _mm512_unpackhi_epi64(sum_ref0, sum_ref2);
+  calc_final_4_avx512(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
+}
 
-    // add the low 64 bit to the high 64 bit
-    sum_mlow = _mm512_add_epi32(sum_mlow, sum_mhigh);
+static INLINE void sad_x4d_avx512(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *const ref_array[4],
+                                  int ref_stride, int width, int height,
+                                  uint32_t res[4]) {
+  const int rows = 64 / width;
+  const uint8_t *ref[4];
+  __m512i sum_ref[4];
+  int i, r;
 
-    // add the low 128 bit to the high 128 bit
-    sum256 = _mm256_add_epi32(_mm512_castsi512_si256(sum_mlow),
-                              _mm512_extracti32x8_epi32(sum_mlow, 1));
-    sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum256),
-                           _mm256_extractf128_si256(sum256, 1));
+  for (r = 0; r < 4; ++r) {
+    ref[r] = ref_array[r];
+    sum_ref[r] = _mm512_setzero_si512();
+  }
 
-    _mm_storeu_si128((__m128i *)(res), sum128);
+  for (i = 0; i < height; i += rows) {
+    const __m512i s = load_row_avx512(src_ptr, src_stride, width);
+    for (r = 0; r < 4; ++r) {
+      const __m512i ref_reg = load_row_avx512(ref[r], ref_stride, width);
+      sum_ref[r] = _mm512_add_epi32(sum_ref[r], _mm512_sad_epu8(ref_reg, s));
+      ref[r] += rows * ref_stride;
+    }
+    src_ptr += rows * src_stride;
   }
+  calc_final_4_avx512(sum_ref[0], sum_ref[1], sum_ref[2], sum_ref[3], res);
 }
+
+#define SAD_X4D_AVX512(w, h)                                                   \
+  void vpx_sad##w##x##h##x4d_avx512(const uint8_t *src_ptr, int src_stride,    \
+                                    const uint8_t *const ref_array[4],         \
+                                    int ref_stride, uint32_t res[4]) {         \
+    sad_x4d_avx512(src_ptr, src_stride, ref_array, ref_stride, w, h, res);     \
+  }
+
+SAD_X4D_AVX512(64, 32)
+SAD_X4D_AVX512(32, 64)
+SAD_X4D_AVX512(32, 32)
+SAD_X4D_AVX512(32, 16)
+
+#undef SAD_X4D_AVX512
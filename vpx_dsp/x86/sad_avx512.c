@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_avx512.h"
+#include "vpx_ports/mem.h"
+
+static INLINE unsigned int sad_avx512(const uint8_t *src_ptr, int src_stride,
+                                      const uint8_t *ref_ptr, int ref_stride,
+                                      const uint8_t *second_pred, int width,
+                                      int height) {
+  const int rows = 64 / width;
+  __m512i sum_sad = _mm512_setzero_si512();
+  int i;
+
+  for (i = 0; i < height; i += rows) {
+    const __m512i s = load_row_avx512(src_ptr, src_stride, width);
+    __m512i r = load_row_avx512(ref_ptr, ref_stride, width);
+    if (second_pred != NULL) {
+      // second_pred is packed, so its rows are always contiguous.
+      r = _mm512_avg_epu8(r, _mm512_loadu_si512((const __m512i *)second_pred));
+      second_pred += 64;
+    }
+    sum_sad = _mm512_add_epi64(sum_sad, _mm512_sad_epu8(s, r));
+    src_ptr += rows * src_stride;
+    ref_ptr += rows * ref_stride;
+  }
+  return (unsigned int)_mm512_reduce_add_epi64(sum_sad);
+}
+
+#define FSAD_AVX512(w, h)                                                      \
+  unsigned int vpx_sad##w##x##h##_avx512(                                      \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride) {                                                        \
+    return sad_avx512(src_ptr, src_stride, ref_ptr, ref_stride, NULL, w, h);   \
+  }                                                                            \
+                                                                               \
+  unsigned int vpx_sad##w##x##h##_avg_avx512(                                  \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride, const uint8_t *second_pred) {                            \
+    return sad_avx512(src_ptr, src_stride, ref_ptr, ref_stride, second_pred,   \
+                      w, h);                                                   \
+  }
+
+FSAD_AVX512(64, 64)
+FSAD_AVX512(64, 32)
+FSAD_AVX512(32, 64)
+FSAD_AVX512(32, 32)
+FSAD_AVX512(32, 16)
+
+#undef FSAD_AVX512
@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+
+// The 8x8 windows start on every 4th pixel, so each window is made of two
+// adjacent 4 pixel wide quads of an 8 row strip. The quad sums of 16 columns
+// are computed at a time and combined with those of the next 16 columns into
+// the sums of 4 windows, which are then scored 4 at a time in double precision
+// with the same operations as similarity() in ssim.c. The scores are added to
+// the total in raster order, so the result matches the C code exactly.
+
+// Number of columns of the zero padded copy used for the last windows of a row.
+#define TAIL_COLS 48
+
+// Constants of similarity() for a window of 64 pixels.
+#define SSIM_C1_8 26634.0
+#define SSIM_C2_8 239708.0
+#if CONFIG_VP9_HIGHBITDEPTH
+#define SSIM_C1_10 428658.0
+#define SSIM_C2_10 3857925.0
+#define SSIM_C1_12 6868593.0
+#define SSIM_C2_12 61817334.0
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+enum { SUM_S, SUM_R, SUM_SQ_S, SUM_SQ_R, SUM_SXR, NUM_SUMS };
+
+static INLINE void add_row(const __m256i s, const __m256i r, __m256i *sum) {
+  sum[SUM_S] = _mm256_add_epi16(sum[SUM_S], s);
+  sum[SUM_R] = _mm256_add_epi16(sum[SUM_R], r);
+  sum[SUM_SQ_S] = _mm256_add_epi32(sum[SUM_SQ_S], _mm256_madd_epi16(s, s));
+  sum[SUM_SQ_R] = _mm256_add_epi32(sum[SUM_SQ_R], _mm256_madd_epi16(r, r));
+  sum[SUM_SXR] = _mm256_add_epi32(sum[SUM_SXR], _mm256_madd_epi16(s, r));
+}
+
+// Adds the 8 pair sums of a and of b into 4 quad sums each, returned in the
+// low and the high half.
+static INLINE __m256i pairs_to_quads(const __m256i a, const __m256i b) {
+  return _mm256_permute4x64_epi64(_mm256_hadd_epi32(a, b), 0xd8);
+}
+
+static INLINE void sums_to_quads(const __m256i *sum, __m128i *quad) {
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i s_r = pairs_to_quads(_mm256_madd_epi16(sum[SUM_S], one),
+                                     _mm256_madd_epi16(sum[SUM_R], one));
+  const __m256i sq = pairs_to_quads(sum[SUM_SQ_S], sum[SUM_SQ_R]);
+  const __m256i sxr = pairs_to_quads(sum[SUM_SXR], sum[SUM_SXR]);
+  quad[SUM_S] = _mm256_castsi256_si128(s_r);
+  quad[SUM_R] = _mm256_extracti128_si256(s_r, 1);
+  quad[SUM_SQ_S] = _mm256_castsi256_si128(sq);
+  quad[SUM_SQ_R] = _mm256_extracti128_si256(sq, 1);
+  quad[SUM_SXR] = _mm256_castsi256_si128(sxr);
+}
+
+static INLINE void clear_sums(__m256i *sum) {
+  int k;
+  for (k = 0; k < NUM_SUMS; ++k) sum[k] = _mm256_setzero_si256();
+}
+
+static INLINE void strip_quads(const uint8_t *s, int sp, const uint8_t *r,
+                               int rp, __m128i *quad) {
+  __m256i sum[NUM_SUMS];
+  int i;
+  clear_sums(sum);
+  for (i = 0; i < 8; ++i) {
+    add_row(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)s)),
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)r)), sum);
+    s += sp;
+    r += rp;
+  }
+  sums_to_quads(sum, quad);
+}
+
+// Sums of the 4 windows that start on the quads of cur. The last one ends on
+// the first quad of next.
+static INLINE void window_sums(const __m128i *cur, const __m128i *next,
+                               __m128i *win) {
+  int k;
+  for (k = 0; k < NUM_SUMS; ++k) {
+    win[k] = _mm_add_epi32(cur[k], _mm_alignr_epi8(next[k], cur[k], 4));
+  }
+}
+
+static INLINE __m256d similarity_4(const __m128i *win, const __m256d c1,
+                                   const __m256d c2) {
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d count = _mm256_set1_pd(64.0);
+  const __m256d two_count = _mm256_set1_pd(128.0);
+  const __m256d sum_s = _mm256_cvtepi32_pd(win[SUM_S]);
+  const __m256d sum_r = _mm256_cvtepi32_pd(win[SUM_R]);
+  const __m256d sum_sq_s = _mm256_cvtepi32_pd(win[SUM_SQ_S]);
+  const __m256d sum_sq_r = _mm256_cvtepi32_pd(win[SUM_SQ_R]);
+  const __m256d sum_sxr = _mm256_cvtepi32_pd(win[SUM_SXR]);
+  const __m256d s_x_r = _mm256_mul_pd(_mm256_mul_pd(two, sum_s), sum_r);
+  const __m256d s_x_s = _mm256_mul_pd(sum_s, sum_s);
+  const __m256d r_x_r = _mm256_mul_pd(sum_r, sum_r);
+  const __m256d ssim_n = _mm256_mul_pd(
+      _mm256_add_pd(s_x_r, c1),
+      _mm256_add_pd(
+          _mm256_sub_pd(_mm256_mul_pd(two_count, sum_sxr), s_x_r), c2));
+  __m256d var = _mm256_sub_pd(_mm256_mul_pd(count, sum_sq_s), s_x_s);
+  __m256d ssim_d;
+  var = _mm256_add_pd(var, _mm256_mul_pd(count, sum_sq_r));
+  var = _mm256_add_pd(_mm256_sub_pd(var, r_x_r), c2);
+  ssim_d = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(s_x_s, r_x_r), c1), var);
+  return _mm256_div_pd(ssim_n, ssim_d);
+}
+
+static INLINE double add_scores(double total, const __m256d v, int n) {
+  DECLARE_ALIGNED(32, double, score[4]);
+  int k;
+  _mm256_store_pd(score, v);
+  for (k = 0; k < n; ++k) total += score[k];
+  return total;
+}
+
+// Number of groups of 4 windows of a row which can be scored without reading
+// past the width.
+static INLINE int full_groups(int width, int windows) {
+  const int groups = width >= 32 ? (width - 32) / 16 + 1 : 0;
+  return VPXMIN(groups, windows / 4);
+}
+
+static double ssim_row(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                       int width, int windows, const __m256d c1,
+                       const __m256d c2, double total) {
+  const int groups = full_groups(width, windows);
+  __m128i cur[NUM_SUMS], next[NUM_SUMS], win[NUM_SUMS];
+  int g;
+
+  if (groups > 0) {
+    strip_quads(s, sp, r, rp, cur);
+    for (g = 0; g < groups; ++g) {
+      strip_quads(s + 16 * (g + 1), sp, r + 16 * (g + 1), rp, next);
+      window_sums(cur, next, win);
+      total = add_scores(total, similarity_4(win, c1, c2), 4);
+      memcpy(cur, next, sizeof(cur));
+    }
+  }
+
+  if (windows > 4 * groups) {
+    DECLARE_ALIGNED(16, uint8_t, s_tail[8 * TAIL_COLS]);
+    DECLARE_ALIGNED(16, uint8_t, r_tail[8 * TAIL_COLS]);
+    const int offset = 16 * groups;
+    const int cols = VPXMIN(width - offset, TAIL_COLS);
+    int remaining = windows - 4 * groups;
+    int i;
+
+    memset(s_tail, 0, sizeof(s_tail));
+    memset(r_tail, 0, sizeof(r_tail));
+    for (i = 0; i < 8; ++i) {
+      memcpy(s_tail + i * TAIL_COLS, s + i * sp + offset, cols);
+      memcpy(r_tail + i * TAIL_COLS, r + i * rp + offset, cols);
+    }
+
+    strip_quads(s_tail, TAIL_COLS, r_tail, TAIL_COLS, cur);
+    for (g = 0; remaining > 0; ++g, remaining -= 4) {
+      strip_quads(s_tail + 16 * (g + 1), TAIL_COLS, r_tail + 16 * (g + 1),
+                  TAIL_COLS, next);
+      window_sums(cur, next, win);
+      total = add_scores(total, similarity_4(win, c1, c2),
+                         VPXMIN(remaining, 4));
+      memcpy(cur, next, sizeof(cur));
+    }
+  }
+  return total;
+}
+
+double vpx_ssim_plane_avx2(const uint8_t *img1, int stride_img1,
+                           const uint8_t *img2, int stride_img2, int width,
+                           int height) {
+  const __m256d c1 = _mm256_set1_pd(SSIM_C1_8);
+  const __m256d c2 = _mm256_set1_pd(SSIM_C2_8);
+  int i;
+  int samples = 0;
+  double ssim_total = 0;
+
+  if (width >= 8) {
+    const int windows = (width - 8) / 4 + 1;
+    for (i = 0; i <= height - 8;
+         i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
+      ssim_total = ssim_row(img1, stride_img1, img2, stride_img2, width,
+                            windows, c1, c2, ssim_total);
+      samples += windows;
+    }
+  }
+  ssim_total /= samples;
+  return ssim_total;
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static INLINE void highbd_strip_quads(const uint16_t *s, int sp,
+                                      const uint16_t *r, int rp,
+                                      __m128i *quad) {
+  __m256i sum[NUM_SUMS];
+  int i;
+  clear_sums(sum);
+  for (i = 0; i < 8; ++i) {
+    add_row(_mm256_loadu_si256((const __m256i *)s),
+            _mm256_loadu_si256((const __m256i *)r), sum);
+    s += sp;
+    r += rp;
+  }
+  sums_to_quads(sum, quad);
+}
+
+// Scales the window sums down to the input bit depth like highbd_ssim_8x8().
+static INLINE void highbd_shift_sums(__m128i *win, const __m128i shift,
+                                     const __m128i shift2) {
+  win[SUM_S] = _mm_srl_epi32(win[SUM_S], shift);
+  win[SUM_R] = _mm_srl_epi32(win[SUM_R], shift);
+  win[SUM_SQ_S] = _mm_srl_epi32(win[SUM_SQ_S], shift2);
+  win[SUM_SQ_R] = _mm_srl_epi32(win[SUM_SQ_R], shift2);
+  win[SUM_SXR] = _mm_srl_epi32(win[SUM_SXR], shift2);
+}
+
+static double highbd_ssim_row(const uint16_t *s, int sp, const uint16_t *r,
+                              int rp, int width, int windows,
+                              const __m128i shift, const __m256d c1,
+                              const __m256d c2, double total) {
+  const __m128i shift2 = _mm_add_epi64(shift, shift);
+  const int groups = full_groups(width, windows);
+  __m128i cur[NUM_SUMS], next[NUM_SUMS], win[NUM_SUMS];
+  int g;
+
+  if (groups > 0) {
+    highbd_strip_quads(s, sp, r, rp, cur);
+    for (g = 0; g < groups; ++g) {
+      highbd_strip_quads(s + 16 * (g + 1), sp, r + 16 * (g + 1), rp, next);
+      window_sums(cur, next, win);
+      highbd_shift_sums(win, shift, shift2);
+      total = add_scores(total, similarity_4(win, c1, c2), 4);
+      memcpy(cur, next, sizeof(cur));
+    }
+  }
+
+  if (windows > 4 * groups) {
+    DECLARE_ALIGNED(32, uint16_t, s_tail[8 * TAIL_COLS]);
+    DECLARE_ALIGNED(32, uint16_t, r_tail[8 * TAIL_COLS]);
+    const int offset = 16 * groups;
+    const int cols = VPXMIN(width - offset, TAIL_COLS);
+    int remaining = windows - 4 * groups;
+    int i;
+
+    memset(s_tail, 0, sizeof(s_tail));
+    memset(r_tail, 0, sizeof(r_tail));
+    for (i = 0; i < 8; ++i) {
+      memcpy(s_tail + i * TAIL_COLS, s + i * sp + offset,
+             cols * sizeof(*s_tail));
+      memcpy(r_tail + i * TAIL_COLS, r + i * rp + offset,
+             cols * sizeof(*r_tail));
+    }
+
+    highbd_strip_quads(s_tail, TAIL_COLS, r_tail, TAIL_COLS, cur);
+    for (g = 0; remaining > 0; ++g, remaining -= 4) {
+      highbd_strip_quads(s_tail + 16 * (g + 1), TAIL_COLS,
+                         r_tail + 16 * (g + 1), TAIL_COLS, next);
+      window_sums(cur, next, win);
+      highbd_shift_sums(win, shift, shift2);
+      total = add_scores(total, similarity_4(win, c1, c2),
+                         VPXMIN(remaining, 4));
+      memcpy(cur, next, sizeof(cur));
+    }
+  }
+  return total;
+}
+
+double vpx_highbd_ssim_plane_avx2(const uint16_t *img1, int stride_img1,
+                                  const uint16_t *img2, int stride_img2,
+                                  int width, int height, uint32_t bd,
+                                  uint32_t shift) {
+  const __m128i shift_count = _mm_cvtsi32_si128((int)shift);
+  __m256d c1, c2;
+  int i;
+  int samples = 0;
+  double ssim_total = 0;
+
+  if (bd == 12) {
+    c1 = _mm256_set1_pd(SSIM_C1_12);
+    c2 = _mm256_set1_pd(SSIM_C2_12);
+  } else if (bd == 10) {
+    c1 = _mm256_set1_pd(SSIM_C1_10);
+    c2 = _mm256_set1_pd(SSIM_C2_10);
+  } else {
+    assert(bd == 8);
+    c1 = _mm256_set1_pd(SSIM_C1_8);
+    c2 = _mm256_set1_pd(SSIM_C2_8);
+  }
+
+  if (width >= 8) {
+    const int windows = (width - 8) / 4 + 1;
+    for (i = 0; i <= height - 8;
+         i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
+      ssim_total =
+          highbd_ssim_row(img1, stride_img1, img2, stride_img2, width,
+                          windows, shift_count, c1, c2, ssim_total);
+      samples += windows;
+    }
+  }
+  ssim_total /= samples;
+  return ssim_total;
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
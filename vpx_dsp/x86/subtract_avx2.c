@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+static INLINE void subtract_16(int16_t *diff_ptr, const __m128i src,
+                               const __m128i pred) {
+  const __m256i d =
+      _mm256_sub_epi16(_mm256_cvtepu8_epi16(src), _mm256_cvtepu8_epi16(pred));
+  _mm256_storeu_si256((__m256i *)diff_ptr, d);
+}
+
+static INLINE void subtract_32(int16_t *diff_ptr, const uint8_t *src_ptr,
+                               const uint8_t *pred_ptr) {
+  const __m256i s = _mm256_loadu_si256((const __m256i *)src_ptr);
+  const __m256i p = _mm256_loadu_si256((const __m256i *)pred_ptr);
+  subtract_16(diff_ptr, _mm256_castsi256_si128(s), _mm256_castsi256_si128(p));
+  subtract_16(diff_ptr + 16, _mm256_extracti128_si256(s, 1),
+              _mm256_extracti128_si256(p, 1));
+}
+
+static void subtract_block_16xn(int rows, int16_t *diff_ptr,
+                                ptrdiff_t diff_stride, const uint8_t *src_ptr,
+                                ptrdiff_t src_stride, const uint8_t *pred_ptr,
+                                ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_16(diff_ptr, _mm_loadu_si128((const __m128i *)src_ptr),
+                _mm_loadu_si128((const __m128i *)pred_ptr));
+    diff_ptr += diff_stride;
+    src_ptr += src_stride;
+    pred_ptr += pred_stride;
+  }
+}
+
+static void subtract_block_32xn(int rows, int16_t *diff_ptr,
+                                ptrdiff_t diff_stride, const uint8_t *src_ptr,
+                                ptrdiff_t src_stride, const uint8_t *pred_ptr,
+                                ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_32(diff_ptr, src_ptr, pred_ptr);
+    diff_ptr += diff_stride;
+    src_ptr += src_stride;
+    pred_ptr += pred_stride;
+  }
+}
+
+static void subtract_block_64xn(int rows, int16_t *diff_ptr,
+                                ptrdiff_t diff_stride, const uint8_t *src_ptr,
+                                ptrdiff_t src_stride, const uint8_t *pred_ptr,
+                                ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_32(diff_ptr, src_ptr, pred_ptr);
+    subtract_32(diff_ptr + 32, src_ptr + 32, pred_ptr + 32);
+    diff_ptr += diff_stride;
+    src_ptr += src_stride;
+    pred_ptr += pred_stride;
+  }
+}
+
+void vpx_subtract_block_avx2(int rows, int cols, int16_t *diff_ptr,
+                             ptrdiff_t diff_stride, const uint8_t *src_ptr,
+                             ptrdiff_t src_stride, const uint8_t *pred_ptr,
+                             ptrdiff_t pred_stride) {
+  switch (cols) {
+    case 16:
+      subtract_block_16xn(rows, diff_ptr, diff_stride, src_ptr, src_stride,
+                          pred_ptr, pred_stride);
+      break;
+    case 32:
+      subtract_block_32xn(rows, diff_ptr, diff_stride, src_ptr, src_stride,
+                          pred_ptr, pred_stride);
+      break;
+    case 64:
+      subtract_block_64xn(rows, diff_ptr, diff_stride, src_ptr, src_stride,
+                          pred_ptr, pred_stride);
+      break;
+    default:
+      // Rows of 4 and 8 pixels do not fill a ymm register.
+      vpx_subtract_block_sse2(rows, cols, diff_ptr, diff_stride, src_ptr,
+                              src_stride, pred_ptr, pred_stride);
+      break;
+  }
+}
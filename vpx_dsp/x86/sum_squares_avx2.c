@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+
+static INLINE __m256i square_row_pair(const int16_t *src, int stride) {
+  const __m256i s = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)src)),
+      _mm_loadu_si128((const __m128i *)(src + stride)), 1);
+  return _mm256_madd_epi16(s, s);
+}
+
+static INLINE __m256i square_16(const int16_t *src) {
+  const __m256i s = _mm256_loadu_si256((const __m256i *)src);
+  return _mm256_madd_epi16(s, s);
+}
+
+uint64_t vpx_sum_squares_2d_i16_avx2(const int16_t *src, int stride, int size) {
+  // As in the SSE2 version, the squares of 8 rows are summed in 32 bits before
+  // they are widened.
+  const __m256i v_zext_mask_q = _mm256_set1_epi64x(0xffffffff);
+  __m256i v_acc_q = _mm256_setzero_si256();
+  __m128i v_acc_128;
+  int r;
+
+  if (size == 4) return vpx_sum_squares_2d_i16_sse2(src, stride, size);
+
+  assert(size % 8 == 0);
+
+  for (r = 0; r < size; r += 8) {
+    __m256i v_acc_d = _mm256_setzero_si256();
+    int c;
+
+    if (size == 8) {
+      v_acc_d = _mm256_add_epi32(square_row_pair(src, stride),
+                                 square_row_pair(src + 2 * stride, stride));
+      v_acc_d = _mm256_add_epi32(v_acc_d,
+                                 square_row_pair(src + 4 * stride, stride));
+      v_acc_d = _mm256_add_epi32(v_acc_d,
+                                 square_row_pair(src + 6 * stride, stride));
+    } else {
+      for (c = 0; c < size; c += 16) {
+        const int16_t *const b = src + c;
+        const __m256i v_sum_01_d = _mm256_add_epi32(
+            square_16(b + 0 * stride), square_16(b + 1 * stride));
+        const __m256i v_sum_23_d = _mm256_add_epi32(
+            square_16(b + 2 * stride), square_16(b + 3 * stride));
+        const __m256i v_sum_45_d = _mm256_add_epi32(
+            square_16(b + 4 * stride), square_16(b + 5 * stride));
+        const __m256i v_sum_67_d = _mm256_add_epi32(
+            square_16(b + 6 * stride), square_16(b + 7 * stride));
+        v_acc_d = _mm256_add_epi32(
+            v_acc_d, _mm256_add_epi32(v_sum_01_d, v_sum_23_d));
+        v_acc_d = _mm256_add_epi32(
+            v_acc_d, _mm256_add_epi32(v_sum_45_d, v_sum_67_d));
+      }
+    }
+
+    v_acc_q =
+        _mm256_add_epi64(v_acc_q, _mm256_and_si256(v_acc_d, v_zext_mask_q));
+    v_acc_q = _mm256_add_epi64(v_acc_q, _mm256_srli_epi64(v_acc_d, 32));
+    src += 8 * stride;
+  }
+
+  v_acc_128 = _mm_add_epi64(_mm256_castsi256_si128(v_acc_q),
+                            _mm256_extracti128_si256(v_acc_q, 1));
+  v_acc_128 = _mm_add_epi64(v_acc_128, _mm_srli_si128(v_acc_128, 8));
+
+#if VPX_ARCH_X86_64
+  return (uint64_t)_mm_cvtsi128_si64(v_acc_128);
+#else
+  {
+    uint64_t tmp;
+    _mm_storel_epi64((__m128i *)&tmp, v_acc_128);
+    return tmp;
+  }
+#endif
+}
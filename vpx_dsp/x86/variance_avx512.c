@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX512
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_avx512.h"
+
+static INLINE void variance_kernel_avx512(const __m512i src,
+                                          const __m512i ref,
+                                          __m512i *const sse,
+                                          __m512i *const sum) {
+  const __m512i adj_sub = _mm512_set1_epi16(0xff01);
+
+  // unpack into pairs of source and reference values
+  const __m512i src_ref0 = _mm512_unpacklo_epi8(src, ref);
+  const __m512i src_ref1 = _mm512_unpackhi_epi8(src, ref);
+
+  // subtract adjacent elements using src*1 + ref*-1
+  const __m512i diff0 = _mm512_maddubs_epi16(src_ref0, adj_sub);
+  const __m512i diff1 = _mm512_maddubs_epi16(src_ref1, adj_sub);
+  const __m512i madd0 = _mm512_madd_epi16(diff0, diff0);
+  const __m512i madd1 = _mm512_madd_epi16(diff1, diff1);
+
+  // add to the running totals
+  *sum = _mm512_add_epi16(*sum, _mm512_add_epi16(diff0, diff1));
+  *sse = _mm512_add_epi32(*sse, _mm512_add_epi32(madd0, madd1));
+}
+
+// Each 16-bit lane of the sum collects 2 differences per register, so a
+// 64x64 block, 128 differences per lane, cannot overflow it.
+static INLINE void variance_avx512(const uint8_t *src, int src_stride,
+                                   const uint8_t *ref, int ref_stride,
+                                   int width, int height, unsigned int *sse,
+                                   int *sum) {
+  const int rows = 64 / width;
+  __m512i vsse = _mm512_setzero_si512();
+  __m512i vsum = _mm512_setzero_si512();
+  int i;
+
+  for (i = 0; i < height; i += rows) {
+    variance_kernel_avx512(load_row_avx512(src, src_stride, width),
+                           load_row_avx512(ref, ref_stride, width), &vsse,
+                           &vsum);
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  vsum = _mm512_madd_epi16(vsum, _mm512_set1_epi16(1));
+  *sse = (unsigned int)_mm512_reduce_add_epi32(vsse);
+  *sum = _mm512_reduce_add_epi32(vsum);
+}
+
+#define VAR_AVX512(w, h, shift)                                                \
+  unsigned int vpx_variance##w##x##h##_avx512(                                 \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride, unsigned int *sse) {                                     \
+    int sum;                                                                   \
+    variance_avx512(src_ptr, src_stride, ref_ptr, ref_stride, w, h, sse,       \
+                    &sum);                                                     \
+    return *sse - (unsigned int)(((int64_t)sum * sum) >> shift);               \
+  }
+
+VAR_AVX512(64, 64, 12)
+VAR_AVX512(64, 32, 11)
+VAR_AVX512(32, 64, 11)
+VAR_AVX512(32, 32, 10)
+VAR_AVX512(32, 16, 9)
+
+#undef VAR_AVX512
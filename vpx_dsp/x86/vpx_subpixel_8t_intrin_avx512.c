@@ -0,0 +1,299 @@
+/*
+ *  Copyright (c) 2020 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX512
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/x86/convolve.h"
+#include "vpx_dsp/x86/mem_avx512.h"
+#include "vpx_ports/mem.h"
+
+// The AVX-512 convolutions handle the 8-tap filters on blocks 32 and 64
+// pixels wide, 32 outputs per register. Everything else goes to the AVX2
+// versions. The arithmetic is that of convolve8_16_avx2(), so the results
+// are identical.
+
+// Pairs of adjacent pixels for taps 0 and 1, 2 and 3, 4 and 5, and 6 and 7,
+// within a 128-bit lane.
+DECLARE_ALIGNED(16, static const uint8_t, filt_avx512[4][16]) = {
+  { 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8 },
+  { 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10 },
+  { 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12 },
+  { 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14 },
+};
+
+static INLINE void shuffle_filter_avx512(const int16_t *const filter,
+                                         __m512i *const f) {
+  const __m512i f_values =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)filter));
+  // pack and duplicate the filter values
+  f[0] = _mm512_shuffle_epi8(f_values, _mm512_set1_epi16(0x0200u));
+  f[1] = _mm512_shuffle_epi8(f_values, _mm512_set1_epi16(0x0604u));
+  f[2] = _mm512_shuffle_epi8(f_values, _mm512_set1_epi16(0x0a08u));
+  f[3] = _mm512_shuffle_epi8(f_values, _mm512_set1_epi16(0x0e0cu));
+}
+
+static INLINE __m512i convolve8_32_avx512(const __m512i *const s,
+                                          const __m512i *const f) {
+  // multiply 2 adjacent elements with the filter and add the result
+  const __m512i k_64 = _mm512_set1_epi16(1 << 6);
+  const __m512i x0 = _mm512_maddubs_epi16(s[0], f[0]);
+  const __m512i x1 = _mm512_maddubs_epi16(s[1], f[1]);
+  const __m512i x2 = _mm512_maddubs_epi16(s[2], f[2]);
+  const __m512i x3 = _mm512_maddubs_epi16(s[3], f[3]);
+  __m512i sum1, sum2;
+
+  // sum the results together, saturating only on the final step
+  // adding x0 with x2 and x1 with x3 is the only order that prevents
+  // outranges for all filters
+  sum1 = _mm512_add_epi16(x0, x2);
+  sum2 = _mm512_add_epi16(x1, x3);
+  // add the rounding offset early to avoid another saturated add
+  sum1 = _mm512_add_epi16(sum1, k_64);
+  sum1 = _mm512_adds_epi16(sum1, sum2);
+  // round and shift by 7 bit each 16 bit
+  return _mm512_srai_epi16(sum1, 7);
+}
+
+// Filter 32 pixels of a row, src pointing 3 pixels to the left of the first.
+// Lane i of the source holds pixels 8 * i - 3 to 8 * i + 12, and gives the
+// outputs 8 * i to 8 * i + 7.
+static INLINE __m512i convolve8_h_32_avx512(const uint8_t *src,
+                                            const __m512i *const filt,
+                                            const __m512i *const f) {
+  const __m512i a = mm512_loadu2_si256(src, src + 8);
+  const __m512i b = _mm512_shuffle_i64x2(a, a, _MM_SHUFFLE(3, 1, 2, 0));
+  __m512i s[4];
+  s[0] = _mm512_shuffle_epi8(b, filt[0]);
+  s[1] = _mm512_shuffle_epi8(b, filt[1]);
+  s[2] = _mm512_shuffle_epi8(b, filt[2]);
+  s[3] = _mm512_shuffle_epi8(b, filt[3]);
+  return convolve8_32_avx512(s, f);
+}
+
+// Pack two sets of 32 16-bit outputs in order to the halves of a register.
+static INLINE __m512i pack_2x32_avx512(const __m512i a, const __m512i b) {
+  const __m512i idx = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+  return _mm512_permutexvar_epi64(idx, _mm512_packus_epi16(a, b));
+}
+
+static INLINE void filter_block1d_h8_avx512(const uint8_t *src_ptr,
+                                            ptrdiff_t src_pitch,
+                                            uint8_t *output_ptr,
+                                            ptrdiff_t out_pitch, int w,
+                                            int h, const int16_t *filter,
+                                            const int avg) {
+  __m512i f[4], filt[4];
+  int i;
+
+  shuffle_filter_avx512(filter, f);
+  for (i = 0; i < 4; ++i) {
+    filt[i] = _mm512_broadcast_i32x4(
+        _mm_load_si128((const __m128i *)filt_avx512[i]));
+  }
+  src_ptr -= 3;
+
+  if (w == 64) {
+    for (i = 0; i < h; ++i) {
+      __m512i res =
+          pack_2x32_avx512(convolve8_h_32_avx512(src_ptr, filt, f),
+                           convolve8_h_32_avx512(src_ptr + 32, filt, f));
+      if (avg) {
+        res = _mm512_avg_epu8(res,
+                              _mm512_loadu_si512((const __m512i *)output_ptr));
+      }
+      _mm512_storeu_si512((__m512i *)output_ptr, res);
+      src_ptr += src_pitch;
+      output_ptr += out_pitch;
+    }
+    return;
+  }
+
+  // Filter two 32-pixel rows at a time.
+  assert(w == 32);
+  for (i = h; i > 1; i -= 2) {
+    __m512i res =
+        pack_2x32_avx512(convolve8_h_32_avx512(src_ptr, filt, f),
+                         convolve8_h_32_avx512(src_ptr + src_pitch, filt, f));
+    if (avg) {
+      res = _mm512_avg_epu8(
+          res, mm512_loadu2_si256(output_ptr, output_ptr + out_pitch));
+    }
+    mm512_storeu2_si256(output_ptr, output_ptr + out_pitch, res);
+    src_ptr += 2 * src_pitch;
+    output_ptr += 2 * out_pitch;
+  }
+
+  if (i > 0) {
+    const __m512i sum = convolve8_h_32_avx512(src_ptr, filt, f);
+    __m256i res = _mm512_castsi512_si256(pack_2x32_avx512(sum, sum));
+    if (avg) {
+      res = _mm256_avg_epu8(res,
+                            _mm256_loadu_si256((const __m256i *)output_ptr));
+    }
+    _mm256_storeu_si256((__m256i *)output_ptr, res);
+  }
+}
+
+// Filter a column 32 pixels wide, src pointing 3 rows above the first
+// output. Each register holds two consecutive rows, so unpacking rows r and
+// r + 1 interleaves the pairs of taps of output rows r and r + 1 at once:
+//   s[k]: rows r + 2k and r + 2k + 1 | rows r + 2k + 1 and r + 2k + 2
+static INLINE void filter_block1d32_v8_avx512(const uint8_t *src_ptr,
+                                              ptrdiff_t src_pitch,
+                                              uint8_t *output_ptr,
+                                              ptrdiff_t out_pitch, int h,
+                                              const int16_t *filter,
+                                              const int avg) {
+  __m512i f[4], s_lo[4], s_hi[4], rows[8];
+  int i;
+
+  shuffle_filter_avx512(filter, f);
+
+  for (i = 0; i < 6; ++i) {
+    rows[i] = mm512_loadu2_si256(src_ptr + i * src_pitch,
+                                 src_ptr + (i + 1) * src_pitch);
+  }
+  for (i = 0; i < 3; ++i) {
+    s_lo[i] = _mm512_unpacklo_epi8(rows[2 * i], rows[2 * i + 1]);
+    s_hi[i] = _mm512_unpackhi_epi8(rows[2 * i], rows[2 * i + 1]);
+  }
+
+  for (i = h; i > 1; i -= 2) {
+    __m512i res;
+    rows[6] = mm512_loadu2_si256(src_ptr + 6 * src_pitch,
+                                 src_ptr + 7 * src_pitch);
+    rows[7] = mm512_loadu2_si256(src_ptr + 7 * src_pitch,
+                                 src_ptr + 8 * src_pitch);
+    s_lo[3] = _mm512_unpacklo_epi8(rows[6], rows[7]);
+    s_hi[3] = _mm512_unpackhi_epi8(rows[6], rows[7]);
+
+    // The unpacks and the pack both stay within 128-bit lanes, which keeps
+    // the pixels in order.
+    res = _mm512_packus_epi16(convolve8_32_avx512(s_lo, f),
+                              convolve8_32_avx512(s_hi, f));
+    if (avg) {
+      res = _mm512_avg_epu8(
+          res, mm512_loadu2_si256(output_ptr, output_ptr + out_pitch));
+    }
+    mm512_storeu2_si256(output_ptr, output_ptr + out_pitch, res);
+
+    s_lo[0] = s_lo[1];
+    s_hi[0] = s_hi[1];
+    s_lo[1] = s_lo[2];
+    s_hi[1] = s_hi[2];
+    s_lo[2] = s_lo[3];
+    s_hi[2] = s_hi[3];
+    src_ptr += 2 * src_pitch;
+    output_ptr += 2 * out_pitch;
+  }
+
+  if (i > 0) {
+    // The last row: the high halves are filled with a copy of row 7 rather
+    // than read past the end of the source, and their output is dropped.
+    __m256i res;
+    rows[6] = mm512_loadu2_si256(src_ptr + 6 * src_pitch,
+                                 src_ptr + 7 * src_pitch);
+    rows[7] = mm512_loadu2_si256(src_ptr + 7 * src_pitch,
+                                 src_ptr + 7 * src_pitch);
+    s_lo[3] = _mm512_unpacklo_epi8(rows[6], rows[7]);
+    s_hi[3] = _mm512_unpackhi_epi8(rows[6], rows[7]);
+    res = _mm512_castsi512_si256(_mm512_packus_epi16(
+        convolve8_32_avx512(s_lo, f), convolve8_32_avx512(s_hi, f)));
+    if (avg) {
+      res = _mm256_avg_epu8(res,
+                            _mm256_loadu_si256((const __m256i *)output_ptr));
+    }
+    _mm256_storeu_si256((__m256i *)output_ptr, res);
+  }
+}
+
+static INLINE int is_8tap(const int16_t *filter) {
+  return (filter[0] | filter[1] | filter[6] | filter[7]) != 0;
+}
+
+void vpx_convolve8_horiz_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const InterpKernel *filter, int x0_q4,
+                                int x_step_q4, int y0_q4, int y_step_q4, int w,
+                                int h) {
+  if (w >= 32 && is_8tap(filter[x0_q4])) {
+    assert(x_step_q4 == 16);
+    filter_block1d_h8_avx512(src, src_stride, dst, dst_stride, w, h,
+                             filter[x0_q4], 0);
+  } else {
+    vpx_convolve8_horiz_avx2(src, src_stride, dst, dst_stride, filter, x0_q4,
+                             x_step_q4, y0_q4, y_step_q4, w, h);
+  }
+}
+
+void vpx_convolve8_avg_horiz_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                                    uint8_t *dst, ptrdiff_t dst_stride,
+                                    const InterpKernel *filter, int x0_q4,
+                                    int x_step_q4, int y0_q4, int y_step_q4,
+                                    int w, int h) {
+  if (w >= 32 && is_8tap(filter[x0_q4])) {
+    assert(x_step_q4 == 16);
+    filter_block1d_h8_avx512(src, src_stride, dst, dst_stride, w, h,
+                             filter[x0_q4], 1);
+  } else {
+    vpx_convolve8_avg_horiz_avx2(src, src_stride, dst, dst_stride, filter,
+                                 x0_q4, x_step_q4, y0_q4, y_step_q4, w, h);
+  }
+}
+
+void vpx_convolve8_vert_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const InterpKernel *filter, int x0_q4,
+                               int x_step_q4, int y0_q4, int y_step_q4, int w,
+                               int h) {
+  if (w >= 32 && is_8tap(filter[y0_q4])) {
+    int x;
+    assert(y_step_q4 == 16);
+    for (x = 0; x < w; x += 32) {
+      filter_block1d32_v8_avx512(src - 3 * src_stride + x, src_stride, dst + x,
+                                 dst_stride, h, filter[y0_q4], 0);
+    }
+  } else {
+    vpx_convolve8_vert_avx2(src, src_stride, dst, dst_stride, filter, x0_q4,
+                            x_step_q4, y0_q4, y_step_q4, w, h);
+  }
+}
+
+void vpx_convolve8_avg_vert_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                                   uint8_t *dst, ptrdiff_t dst_stride,
+                                   const InterpKernel *filter, int x0_q4,
+                                   int x_step_q4, int y0_q4, int y_step_q4,
+                                   int w, int h) {
+  if (w >= 32 && is_8tap(filter[y0_q4])) {
+    int x;
+    assert(y_step_q4 == 16);
+    for (x = 0; x < w; x += 32) {
+      filter_block1d32_v8_avx512(src - 3 * src_stride + x, src_stride, dst + x,
+                                 dst_stride, h, filter[y0_q4], 1);
+    }
+  } else {
+    vpx_convolve8_avg_vert_avx2(src, src_stride, dst, dst_stride, filter,
+                                x0_q4, x_step_q4, y0_q4, y_step_q4, w, h);
+  }
+}
+
+// void vpx_convolve8_avx512(const uint8_t *src, ptrdiff_t src_stride,
+//                           uint8_t *dst, ptrdiff_t dst_stride,
+//                           const InterpKernel *filter, int x0_q4,
+//                           int32_t x_step_q4, int y0_q4, int y_step_q4,
+//                           int w, int h);
+// void vpx_convolve8_avg_avx512(const uint8_t *src, ptrdiff_t src_stride,
+//                               uint8_t *dst, ptrdiff_t dst_stride,
+//                               const InterpKernel *filter, int x0_q4,
+//                               int32_t x_step_q4, int y0_q4, int y_step_q4,
+//                               int w, int h);
+FUN_CONV_2D(, avx512, 0);
+FUN_CONV_2D(avg_, avx512, 1);
@@ -145,14 +145,16 @@ int vpx_free_frame_buffer(YV12_BUFFER_CONFIG *ybf) {
   return 0;
 }
 
-int vpx_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
-                             int ss_x, int ss_y,
+int vpx_realloc_frame_buffer_aligned(YV12_BUFFER_CONFIG *ybf, int width,
+                                     int height, int ss_x, int ss_y,
 #if CONFIG_VP9_HIGHBITDEPTH
-                             int use_highbitdepth,
+                                     int use_highbitdepth,
 #endif
-                             int border, int byte_alignment,
-                             vpx_codec_frame_buffer_t *fb,
-                             vpx_get_frame_buffer_cb_fn_t cb, void *cb_priv) {
+                                     int border, int byte_alignment,
+                                     int stride_alignment,
+                                     vpx_codec_frame_buffer_t *fb,
+                                     vpx_get_frame_buffer_cb_fn_t cb,
+                                     void *cb_priv) {
 #if CONFIG_SIZE_LIMIT
   if (width > DECODE_WIDTH_LIMIT || height > DECODE_HEIGHT_LIMIT) return -1;
 #endif
@@ -163,12 +165,15 @@ int vpx_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
    * between planes, which would break the semantics of things like
    * vpx_img_set_rect(). */
   if (border & 0x1f) return -3;
+  if (stride_alignment < 32 || (stride_alignment & (stride_alignment - 1)))
+    return -3;
 
   if (ybf) {
     const int vp9_byte_align = (byte_alignment == 0) ? 1 : byte_alignment;
     const int aligned_width = (width + 7) & ~7;
     const int aligned_height = (height + 7) & ~7;
-    const int y_stride = ((aligned_width + 2 * border) + 31) & ~31;
+    const int y_stride = ((aligned_width + 2 * border) + stride_alignment - 1) &
+                         ~(stride_alignment - 1);
     const uint64_t yplane_size =
         (aligned_height + 2 * border) * (uint64_t)y_stride + byte_alignment;
     const int uv_width = aligned_width >> ss_x;
@@ -285,6 +290,22 @@ int vpx_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
   return -2;
 }
 
+int vpx_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
+                             int ss_x, int ss_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                             int use_highbitdepth,
+#endif
+                             int border, int byte_alignment,
+                             vpx_codec_frame_buffer_t *fb,
+                             vpx_get_frame_buffer_cb_fn_t cb, void *cb_priv) {
+  return vpx_realloc_frame_buffer_aligned(ybf, width, height, ss_x, ss_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                          use_highbitdepth,
+#endif
+                                          border, byte_alignment, 32, fb, cb,
+                                          cb_priv);
+}
+
 int vpx_alloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
                            int ss_x, int ss_y,
 #if CONFIG_VP9_HIGHBITDEPTH
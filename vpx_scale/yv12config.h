@@ -94,6 +94,19 @@ int vpx_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf, int width, int height,
                              int border, int byte_alignment,
                              vpx_codec_frame_buffer_t *fb,
                              vpx_get_frame_buffer_cb_fn_t cb, void *cb_priv);
+
+// Same as vpx_realloc_frame_buffer() with the stride of the Y plane a multiple
+// of |stride_alignment|, a power of 2 of at least 32, instead of 32.
+int vpx_realloc_frame_buffer_aligned(YV12_BUFFER_CONFIG *ybf, int width,
+                                     int height, int ss_x, int ss_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                     int use_highbitdepth,
+#endif
+                                     int border, int byte_alignment,
+                                     int stride_alignment,
+                                     vpx_codec_frame_buffer_t *fb,
+                                     vpx_get_frame_buffer_cb_fn_t cb,
+                                     void *cb_priv);
 int vpx_free_frame_buffer(YV12_BUFFER_CONFIG *ybf);
 
 #ifdef __cplusplus
@@ -23,6 +23,8 @@ struct VPxWorkerImpl {
   pthread_mutex_t mutex_;
   pthread_cond_t condition_;
   pthread_t thread_;
+  // Next worker in the shared pool's queue.
+  VPxWorker *next_;
 };
 
 //------------------------------------------------------------------------------
@@ -158,6 +160,139 @@ static void end(VPxWorker *const worker) {
   assert(worker->status_ == NOT_OK);
 }
 
+//------------------------------------------------------------------------------
+// Shared worker pool. Workers do not own a thread: launch() hands the worker to
+// an idle pool thread, or runs the hook on the calling thread when all pool
+// threads are busy. Work is therefore never queued behind unrelated work, which
+// keeps workers that wait on each other from deadlocking, provided a worker
+// only waits on work already handed out to a running thread.
+
+#if CONFIG_MULTITHREAD
+
+typedef struct {
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;  // work was queued or the pool is shutting down
+  pthread_t *threads_;
+  int num_threads_;
+  int num_idle_;  // threads waiting for work, including those not yet woken
+  int shutdown_;
+  VPxWorker *queue_;  // workers handed to idle threads, not yet picked up
+  VPxWorkerInterface saved_interface_;
+} VPxThreadPool;
+
+static VPxThreadPool *g_pool = NULL;
+
+static THREADFN pool_thread_loop(void *ptr) {
+  VPxThreadPool *const pool = (VPxThreadPool *)ptr;
+  pthread_mutex_lock(&pool->mutex_);
+  while (1) {
+    VPxWorker *worker;
+    ++pool->num_idle_;
+    while (pool->queue_ == NULL && !pool->shutdown_) {
+      pthread_cond_wait(&pool->condition_, &pool->mutex_);
+    }
+    --pool->num_idle_;
+    if (pool->queue_ == NULL) break;  // shutdown
+
+    worker = pool->queue_;
+    pool->queue_ = worker->impl_->next_;
+    pthread_mutex_unlock(&pool->mutex_);
+
+    execute(worker);
+
+    pthread_mutex_lock(&pool->mutex_);
+    worker->status_ = OK;
+    pthread_cond_broadcast(&worker->impl_->condition_);
+  }
+  pthread_mutex_unlock(&pool->mutex_);
+  return THREAD_RETURN(NULL);
+}
+
+static int pool_sync(VPxWorker *const worker) {
+  if (worker->impl_ != NULL) {
+    pthread_mutex_lock(&g_pool->mutex_);
+    while (worker->status_ == WORK) {
+      pthread_cond_wait(&worker->impl_->condition_, &g_pool->mutex_);
+    }
+    pthread_mutex_unlock(&g_pool->mutex_);
+  }
+  assert(worker->status_ <= OK);
+  return !worker->had_error;
+}
+
+static int pool_reset(VPxWorker *const worker) {
+  int ok = 1;
+  worker->had_error = 0;
+  if (worker->status_ < OK) {
+    worker->impl_ = (VPxWorkerImpl *)vpx_calloc(1, sizeof(*worker->impl_));
+    if (worker->impl_ == NULL) return 0;
+    if (pthread_cond_init(&worker->impl_->condition_, NULL)) {
+      vpx_free(worker->impl_);
+      worker->impl_ = NULL;
+      return 0;
+    }
+    worker->status_ = OK;
+  } else if (worker->status_ > OK) {
+    ok = pool_sync(worker);
+  }
+  assert(!ok || (worker->status_ == OK));
+  return ok;
+}
+
+static void pool_launch(VPxWorker *const worker) {
+  VPxThreadPool *const pool = g_pool;
+  int queued = 0;
+  pthread_mutex_lock(&pool->mutex_);
+  while (worker->status_ == WORK) {
+    pthread_cond_wait(&worker->impl_->condition_, &pool->mutex_);
+  }
+  if (worker->status_ == OK) {
+    // Every queued worker has an idle thread about to pick it up.
+    int num_queued = 0;
+    VPxWorker **tail = &pool->queue_;
+    while (*tail != NULL) {
+      tail = &(*tail)->impl_->next_;
+      ++num_queued;
+    }
+    if (pool->num_idle_ > num_queued) {
+      worker->status_ = WORK;
+      worker->impl_->next_ = NULL;
+      *tail = worker;
+      pthread_cond_signal(&pool->condition_);
+      queued = 1;
+    }
+  }
+  pthread_mutex_unlock(&pool->mutex_);
+  if (!queued) execute(worker);
+}
+
+static void pool_end(VPxWorker *const worker) {
+  if (worker->impl_ != NULL) {
+    pool_sync(worker);
+    pthread_cond_destroy(&worker->impl_->condition_);
+    vpx_free(worker->impl_);
+    worker->impl_ = NULL;
+  }
+  worker->status_ = NOT_OK;
+}
+
+static void destroy_pool(VPxThreadPool *const pool) {
+  int i;
+  pthread_mutex_lock(&pool->mutex_);
+  pool->shutdown_ = 1;
+  pthread_cond_broadcast(&pool->condition_);
+  pthread_mutex_unlock(&pool->mutex_);
+  for (i = 0; i < pool->num_threads_; ++i) {
+    pthread_join(pool->threads_[i], NULL);
+  }
+  pthread_mutex_destroy(&pool->mutex_);
+  pthread_cond_destroy(&pool->condition_);
+  vpx_free(pool->threads_);
+  vpx_free(pool);
+}
+
+#endif  // CONFIG_MULTITHREAD
+
 //------------------------------------------------------------------------------
 
 static VPxWorkerInterface g_worker_interface = { init,   reset,   sync,
@@ -178,4 +313,71 @@ const VPxWorkerInterface *vpx_get_worker_interface(void) {
   return &g_worker_interface;
 }
 
+int vpx_thread_pool_init(int num_threads) {
+#if CONFIG_MULTITHREAD
+  VPxThreadPool *pool;
+  VPxWorkerInterface pool_interface;
+
+  if (g_pool != NULL || num_threads <= 0) return 0;
+  pool = (VPxThreadPool *)vpx_calloc(1, sizeof(*pool));
+  if (pool == NULL) return 0;
+  pool->threads_ =
+      (pthread_t *)vpx_calloc(num_threads, sizeof(*pool->threads_));
+  if (pool->threads_ == NULL) {
+    vpx_free(pool);
+    return 0;
+  }
+  if (pthread_mutex_init(&pool->mutex_, NULL)) {
+    vpx_free(pool->threads_);
+    vpx_free(pool);
+    return 0;
+  }
+  if (pthread_cond_init(&pool->condition_, NULL)) {
+    pthread_mutex_destroy(&pool->mutex_);
+    vpx_free(pool->threads_);
+    vpx_free(pool);
+    return 0;
+  }
+  for (; pool->num_threads_ < num_threads; ++pool->num_threads_) {
+    if (pthread_create(&pool->threads_[pool->num_threads_], NULL,
+                       pool_thread_loop, pool)) {
+      destroy_pool(pool);
+      return 0;
+    }
+  }
+
+  pool->saved_interface_ = g_worker_interface;
+  pool_interface.init = init;
+  pool_interface.reset = pool_reset;
+  pool_interface.sync = pool_sync;
+  pool_interface.launch = pool_launch;
+  pool_interface.execute = execute;
+  pool_interface.end = pool_end;
+  g_pool = pool;
+  g_worker_interface = pool_interface;
+  return 1;
+#else
+  (void)num_threads;
+  return 0;
+#endif
+}
+
+int vpx_thread_pool_active(void) {
+#if CONFIG_MULTITHREAD
+  return g_pool != NULL;
+#else
+  return 0;
+#endif
+}
+
+void vpx_thread_pool_destroy(void) {
+#if CONFIG_MULTITHREAD
+  if (g_pool != NULL) {
+    g_worker_interface = g_pool->saved_interface_;
+    destroy_pool(g_pool);
+    g_pool = NULL;
+  }
+#endif
+}
+
 //------------------------------------------------------------------------------
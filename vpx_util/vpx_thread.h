@@ -429,6 +429,20 @@ int vpx_set_worker_interface(const VPxWorkerInterface *const winterface);
 // Retrieve the currently set thread worker interface.
 const VPxWorkerInterface *vpx_get_worker_interface(void);
 
+// Start a pool of num_threads threads shared by all workers and install a
+// worker interface using it. Workers no longer own a thread; launch() runs the
+// hook on an idle pool thread, or on the calling thread when there is none.
+// Like vpx_set_worker_interface(), this must be done while no worker exists
+// and is not thread-safe. Returns false on error or if a pool already exists.
+int vpx_thread_pool_init(int num_threads);
+
+// Returns true if the shared pool is in use.
+int vpx_thread_pool_active(void);
+
+// Stop the shared pool and restore the previous worker interface. All workers
+// must have been ended.
+void vpx_thread_pool_destroy(void);
+
 //------------------------------------------------------------------------------
 
 #ifdef __cplusplus
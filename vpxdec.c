@@ -77,7 +77,7 @@ static const arg_def_t outputfile =
 static const arg_def_t threadsarg =
     ARG_DEF("t", "threads", 1, "Max threads to use");
 static const arg_def_t frameparallelarg =
-    ARG_DEF(NULL, "frame-parallel", 0, "Frame parallel decode (ignored)");
+    ARG_DEF(NULL, "frame-parallel", 0, "Frame parallel decode");
 static const arg_def_t verbosearg =
     ARG_DEF("v", "verbose", 0, "Show version string");
 static const arg_def_t error_concealment =
@@ -362,6 +362,31 @@ static void show_progress(int frame_in, int frame_out, uint64_t dx_time) {
           (double)frame_out * 1000000.0 / (double)dx_time);
 }
 
+#if CONFIG_VP9_DECODER
+static void add_frame_timing(vpx_frame_timing_t *sum,
+                             const vpx_frame_timing_t *timing) {
+  sum->total += timing->total;
+  sum->header += timing->header;
+  sum->parse += timing->parse;
+  sum->recon += timing->recon;
+  sum->inverse_transform += timing->inverse_transform;
+  sum->inter_pred += timing->inter_pred;
+  sum->loop_filter += timing->loop_filter;
+  sum->thread_wait += timing->thread_wait;
+}
+
+static void show_frame_timing(const vpx_frame_timing_t *timing) {
+  fprintf(stderr,
+          "Decoder stages: %" PRId64 " us total, %" PRId64 " header, %" PRId64
+          " parse, %" PRId64 " recon (%" PRId64 " inverse transform, %" PRId64
+          " inter prediction), %" PRId64 " loop filter, %" PRId64
+          " thread wait\n",
+          timing->total, timing->header, timing->parse, timing->recon,
+          timing->inverse_transform, timing->inter_pred, timing->loop_filter,
+          timing->thread_wait);
+}
+#endif  // CONFIG_VP9_DECODER
+
 struct ExternalFrameBuffer {
   uint8_t *data;
   size_t size;
@@ -530,6 +555,11 @@ static int main_loop(int argc, const char **argv_) {
   int keep_going = 0;
   int enable_row_mt = 0;
   int enable_lpf_opt = 0;
+  int frame_parallel = 0;
+#if CONFIG_VP9_DECODER
+  int frame_timing = 0;
+  vpx_frame_timing_t timing_sum;
+#endif
   const VpxInterface *interface = NULL;
   const VpxInterface *fourcc_interface = NULL;
   uint64_t dx_time = 0;
@@ -626,9 +656,8 @@ static int main_loop(int argc, const char **argv_) {
     else if (arg_match(&arg, &threadsarg, argi))
       cfg.threads = arg_parse_uint(&arg);
 #if CONFIG_VP9_DECODER
-    else if (arg_match(&arg, &frameparallelarg, argi)) {
-      /* ignored for compatibility */
-    }
+    else if (arg_match(&arg, &frameparallelarg, argi))
+      frame_parallel = 1;
 #endif
     else if (arg_match(&arg, &verbosearg, argi))
       quiet = 0;
@@ -794,8 +823,28 @@ static int main_loop(int argc, const char **argv_) {
             vpx_codec_error(&decoder));
     goto fail;
   }
+  if (interface->fourcc == VP9_FOURCC &&
+      vpx_codec_control(&decoder, VP9D_SET_FRAME_PARALLEL, frame_parallel)) {
+    fprintf(stderr, "Failed to set decoder in frame parallel mode: %s\n",
+            vpx_codec_error(&decoder));
+    goto fail;
+  }
   if (!quiet) fprintf(stderr, "%s\n", decoder.name);
 
+#if CONFIG_VP9_DECODER
+  // Getting the timing of each frame would wait for the frames decoded in
+  // parallel.
+  memset(&timing_sum, 0, sizeof(timing_sum));
+  if (summary && interface->fourcc == VP9_FOURCC && !frame_parallel) {
+    if (vpx_codec_control(&decoder, VP9D_SET_FRAME_TIMING, 1)) {
+      fprintf(stderr, "Failed to enable decoder frame timing: %s\n",
+              vpx_codec_error(&decoder));
+      goto fail;
+    }
+    frame_timing = 1;
+  }
+#endif
+
 #if CONFIG_VP8_DECODER
   if (vp8_pp_cfg.post_proc_flag &&
       vpx_codec_control(&decoder, VP8_SET_POSTPROC, &vp8_pp_cfg)) {
@@ -866,6 +915,14 @@ static int main_loop(int argc, const char **argv_) {
 
         vpx_usec_timer_mark(&timer);
         dx_time += vpx_usec_timer_elapsed(&timer);
+
+#if CONFIG_VP9_DECODER
+        if (frame_timing && !corrupted) {
+          vpx_frame_timing_t timing;
+          if (!vpx_codec_control(&decoder, VP9D_GET_FRAME_TIMING, &timing))
+            add_frame_timing(&timing_sum, &timing);
+        }
+#endif
       } else {
         flush_decoder = 1;
       }
@@ -1053,6 +1110,9 @@ static int main_loop(int argc, const char **argv_) {
     show_progress(frame_in, frame_out, dx_time);
     fprintf(stderr, "\n");
   }
+#if CONFIG_VP9_DECODER
+  if (frame_timing) show_frame_timing(&timing_sum);
+#endif
 
   if (frames_corrupted) {
     fprintf(stderr, "WARNING: %d frames corrupted.\n", frames_corrupted);